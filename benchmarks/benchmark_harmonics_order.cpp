@@ -0,0 +1,55 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include <filesystem>
+#include "model_handler.h"
+#include "model_calculator.h"
+
+/**
+ * Time the harmonics calculation of a model with its configured multipole order and trimmed to b1-b3,
+ * as configured by the parameter search for a sweep with only `OutputBMultipole(1..3)` criteria.
+ *
+ *   cctsim_benchmark_harmonics [model.json] [harmonics calculation name] [repeats]
+ */
+
+static double timeHarmonics(const std::filesystem::path &model_path, size_t repeats)
+{
+    CCTools::ModelCalculator calculator(model_path);
+    double fastest = std::numeric_limits<double>::infinity();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        CCTools::HarmonicsDataHandler handler;
+        auto start = std::chrono::steady_clock::now();
+        calculator.reload_and_calc_harmonics(model_path, handler);
+        fastest = std::min(fastest, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return fastest;
+}
+
+int main(int argc, char **argv)
+{
+    std::string model_path = argc > 1 ? argv[1] : "../examples/cct.json";
+    std::string calc_name = argc > 2 ? argv[2] : "Cylyndrical Harmonics";
+    size_t repeats = argc > 3 ? std::stoul(argv[3]) : 5;
+
+    // Separate model copies for both configurations
+    CCTools::ModelHandler full_handler(model_path);
+    CCTools::ModelHandler trimmed_handler(model_path);
+    Json::Value num_max = full_handler.getValueByName(calc_name, {}, "num_max");
+    trimmed_handler.setValueByName(calc_name, {}, "num_max", 3);
+
+    // The first calculation includes one-time setup
+    timeHarmonics(full_handler.getTempJsonPath(), 1);
+
+    double full = timeHarmonics(full_handler.getTempJsonPath(), repeats);
+    double trimmed = timeHarmonics(trimmed_handler.getTempJsonPath(), repeats);
+
+    std::cout << "harmonics calculation '" << calc_name << "', fastest of " << repeats << " runs\n"
+              << "  num_max = " << num_max.asString() << ": " << full << " s\n"
+              << "  num_max = 3: " << trimmed << " s\n"
+              << "  saved: " << (full - trimmed) << " s per step (" << 100.0 * (full - trimmed) / full << " %)\n";
+    return 0;
+}
@@ -4,12 +4,13 @@
 
 #include <rat/common/log.hh>
 #include <mutex>
-#include <sstream>
+#include <memory>
 #include <string>
 #include <cstdio>
+#include <cstdlib>
 #include <cstdarg>
-#include <algorithm>
 #include <cctype>
+#include "iteration_observer.hh"
 
 /**
  * @brief A custom log class that captures iteration values from log messages.
@@ -18,24 +19,23 @@
  * the most recent iteration log values (iteration number, function value,
  * edge regression constraint, length constraint, and optionally curvature constraint).
  * It does not output any messages.
+ *
+ * The log text is the fallback source of the iteration values for optimizers that do not report them as numbers.
+ * Every completed set of values is forwarded to an optional `IterationObserver` (see `setObserver()`),
+ * so consumers work with structured values independent of the log format.
+ * Parsing is done in place on a stack buffer and does not allocate.
  */
 class CustomIterationLog : public rat::cmn::Log {
 public:
     /**
      * @brief Structure holding iteration log values.
      */
-    struct IterationValues {
-        int iter;       /**< Iteration number */
-        double fval;    /**< Function value */
-        double ercf;    /**< Edge regression constraint function value */
-        double lcf;     /**< Length constraint function value */
-        double ccf;     /**< Curvature constraint function value (valid if has_ccf is true) */
-        bool has_ccf;   /**< Flag indicating if the curvature constraint value is valid */
-    };
+    using IterationValues = OptimizerIterationValues;
 
 private:
     mutable std::mutex iter_mutex_;  /**< Mutex protecting iteration values */
     IterationValues last_values_;    /**< Most recent iteration values */
+    std::shared_ptr<IterationObserver> observer_; /**< Optional observer notified for every completed iteration */
 
     // State for collecting one set of iteration data.
     enum class DataState {
@@ -54,34 +54,40 @@ private:
     double temp_ercf_;
     double temp_lcf_;
     double temp_ccf_;
-    bool temp_ccf_provided_ = false; // true if ccf was provided
-
-    // Helper function to trim whitespace.
-    std::string trim(const std::string &s) {
-        size_t start = s.find_first_not_of(" \t\r\n");
-        size_t end = s.find_last_not_of(" \t\r\n");
-        if (start == std::string::npos)
-            return "";
-        return s.substr(start, end - start + 1);
-    }
 
-    // Helper function to remove ANSI escape sequences.
-    std::string removeAnsi(const std::string &s) {
-        std::string result;
-        size_t i = 0;
-        while (i < s.size()) {
-            if (s[i] == '\033') { // ANSI escape sequence starts with ESC
+    static constexpr int BUFFER_SIZE = 1024;
+
+    // Helper function to remove ANSI escape sequences in place and skip leading whitespace.
+    // Returns a pointer to the first non-whitespace character of the cleaned message.
+    static char *clean(char *buffer) {
+        char *write = buffer;
+        for (const char *read = buffer; *read != '\0';) {
+            if (*read == '\033') { // ANSI escape sequence starts with ESC
                 // Skip until we hit 'm'
-                while (i < s.size() && s[i] != 'm')
-                    ++i;
-                if (i < s.size())
-                    ++i; // skip the 'm'
+                while (*read != '\0' && *read != 'm')
+                    ++read;
+                if (*read != '\0')
+                    ++read; // skip the 'm'
             } else {
-                result.push_back(s[i]);
-                ++i;
+                *write++ = *read++;
             }
         }
-        return result;
+        *write = '\0';
+
+        char *start = buffer;
+        while (*start != '\0' && std::isspace(static_cast<unsigned char>(*start)))
+            ++start;
+        return start;
+    }
+
+    // Helper function to parse a double. Returns false if no number could be parsed.
+    static bool parseDouble(const char *str, const char **end, double &value) {
+        char *parse_end;
+        value = std::strtod(str, &parse_end);
+        if (parse_end == str)
+            return false;
+        *end = parse_end;
+        return true;
     }
 
 public:
@@ -99,6 +105,15 @@ public:
         last_values_.has_ccf = false;
     }
 
+    /**
+     * @brief Set the observer to be notified for every completed iteration.
+     * @param observer The observer, nullptr to remove the observer.
+     */
+    void setObserver(std::shared_ptr<IterationObserver> observer) {
+        std::lock_guard<std::mutex> lock(iter_mutex_);
+        observer_ = observer;
+    }
+
     /**
      * @brief Logs a message without an indentation change.
      *
@@ -109,7 +124,6 @@ public:
      * @param ... Variable arguments.
      */
     void msg(const char* fmt, ...) override {
-        const int BUFFER_SIZE = 1024;
         char buffer[BUFFER_SIZE];
 
         va_list args;
@@ -117,43 +131,51 @@ public:
         vsnprintf(buffer, BUFFER_SIZE, fmt, args);
         va_end(args);
 
-        // Debug output.
-        //std::fprintf(stderr, "DEBUG: msg: %s\n", buffer);
-
-        std::lock_guard<std::mutex> lock(iter_mutex_);
-        std::string msgStr(buffer);
-        // Remove ANSI escape sequences.
-        std::string cleanStr = removeAnsi(msgStr);
-        std::string trimmed = trim(cleanStr);
-
-        // If we're in the start state, expect iter and fval.
-        if (current_state_ == DataState::WAIT_FOR_ITER_FVAL) {
-            if (!trimmed.empty()) {
-                std::istringstream iss(trimmed);
-                double iter_d, fval;
-                if (iss >> iter_d >> fval) {
-                    temp_iter_ = static_cast<int>(iter_d);
-                    temp_fval_ = fval;
-                    current_state_ = DataState::WAIT_FOR_ERCF;
+        const char *cleaned = clean(buffer);
+        bool blank = (*cleaned == '\0');
+
+        std::shared_ptr<IterationObserver> observer;
+        IterationValues committed;
+        {
+            std::lock_guard<std::mutex> lock(iter_mutex_);
+
+            // If we're in the start state, expect iter and fval.
+            if (current_state_ == DataState::WAIT_FOR_ITER_FVAL) {
+                if (!blank) {
+                    const char *end;
+                    double iter_d, fval;
+                    if (parseDouble(cleaned, &end, iter_d) && parseDouble(end, &end, fval)) {
+                        temp_iter_ = static_cast<int>(iter_d);
+                        temp_fval_ = fval;
+                        current_state_ = DataState::WAIT_FOR_ERCF;
+                    }
                 }
             }
+            // In either WAIT_FOR_OPTIONAL_CCF or WAIT_FOR_SET_END state,
+            // a blank message signals the end of the set.
+            else if ((current_state_ == DataState::WAIT_FOR_OPTIONAL_CCF ||
+                      current_state_ == DataState::WAIT_FOR_SET_END) &&
+                     blank) {
+                // Commit the collected values.
+                last_values_.iter = temp_iter_;
+                last_values_.fval = temp_fval_;
+                last_values_.ercf = temp_ercf_;
+                last_values_.lcf  = temp_lcf_;
+                last_values_.ccf  = (current_state_ == DataState::WAIT_FOR_SET_END) ? temp_ccf_ : 0.0;
+                last_values_.has_ccf = (current_state_ == DataState::WAIT_FOR_SET_END);
+                // Reset state for next set.
+                current_state_ = DataState::WAIT_FOR_ITER_FVAL;
+
+                observer = observer_;
+                committed = last_values_;
+            }
+            // Otherwise, ignore messages.
         }
-        // In either WAIT_FOR_OPTIONAL_CCF or WAIT_FOR_SET_END state,
-        // a blank message signals the end of the set.
-        else if ((current_state_ == DataState::WAIT_FOR_OPTIONAL_CCF ||
-                  current_state_ == DataState::WAIT_FOR_SET_END) &&
-                 trimmed.empty()) {
-            // Commit the collected values.
-            last_values_.iter = temp_iter_;
-            last_values_.fval = temp_fval_;
-            last_values_.ercf = temp_ercf_;
-            last_values_.lcf  = temp_lcf_;
-            last_values_.ccf  = (current_state_ == DataState::WAIT_FOR_SET_END) ? temp_ccf_ : 0.0;
-            last_values_.has_ccf = (current_state_ == DataState::WAIT_FOR_SET_END);
-            // Reset state for next set.
-            current_state_ = DataState::WAIT_FOR_ITER_FVAL;
+
+        // Notify the observer outside the lock
+        if (observer) {
+            observer->onIteration(committed);
         }
-        // Otherwise, ignore messages.
     }
 
     /**
@@ -167,7 +189,12 @@ public:
      * @param ... Variable arguments.
      */
     void msg(const int incr, const char* fmt, ...) override {
-        const int BUFFER_SIZE = 1024;
+        // If incr is non-zero, update indentation and exit.
+        if (incr != 0) {
+            num_indent_ += incr; // update parent's indentation if needed.
+            return;
+        }
+
         char buffer[BUFFER_SIZE];
 
         va_list args;
@@ -175,24 +202,14 @@ public:
         vsnprintf(buffer, BUFFER_SIZE, fmt, args);
         va_end(args);
 
-        // Debug output.
-        //std::fprintf(stderr, "DEBUG: msg(incr=%d): %s\n", incr, buffer);
+        const char *cleaned = clean(buffer);
+        if (*cleaned == '\0') return; // ignore blank messages here
 
-        // If incr is non-zero, update indentation and exit.
-        if (incr != 0) {
-            num_indent_ += incr; // update parent's indentation if needed.
-            return;
-        }
+        const char *end;
+        double value;
+        if (!parseDouble(cleaned, &end, value)) return; // if parsing fails, ignore
 
         std::lock_guard<std::mutex> lock(iter_mutex_);
-        std::string msgStr(buffer);
-        std::string cleanStr = removeAnsi(msgStr);
-        std::string trimmed = trim(cleanStr);
-        if (trimmed.empty()) return; // ignore blank messages here
-
-        std::istringstream iss(trimmed);
-        double value;
-        if (!(iss >> value)) return; // if parsing fails, ignore
 
         // Depending on the current state, assign the value.
         if (current_state_ == DataState::WAIT_FOR_ERCF) {
@@ -203,7 +220,6 @@ public:
             current_state_ = DataState::WAIT_FOR_OPTIONAL_CCF;
         } else if (current_state_ == DataState::WAIT_FOR_OPTIONAL_CCF) {
             temp_ccf_ = value;
-            temp_ccf_provided_ = true;
             current_state_ = DataState::WAIT_FOR_SET_END;
         }
         // Ignore messages if not expected.
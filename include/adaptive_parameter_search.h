@@ -0,0 +1,62 @@
+#ifndef ADAPTIVE_PARAMETER_SEARCH_H
+#define ADAPTIVE_PARAMETER_SEARCH_H
+
+#include "parameter_search.h"
+#include "adaptive_refinement.hh"
+
+/**
+ * @class AdaptiveParameterSearch
+ * @brief Class for running an adaptive grid search on the input parameters of a model.
+ *
+ * Starts from a coarse grid and recursively bisects the cells in which one output criterion changes most or crosses a threshold, see `AdaptiveRefinement`.
+ * The input parameters are sampled with `ParamRange::sample()`, i.e. linear and geometric ranges are refined continuously between their bounds.
+ * All evaluated points are written to the output file in the same format as the grid search, the index column holds the evaluation number.
+ * The refinement stops when the step or time budget is spent, see `ParameterSearch::setStepBudget()` and `ParameterSearch::setTimeBudget()`,
+ * or when no cell is left to refine.
+ */
+class AdaptiveParameterSearch : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct an AdaptiveParameterSearch object.
+     * @param inputParamsRanges The input parameter ranges.
+     * @param outputCriteria The output criteria.
+     * @param modelHandler The model handler.
+     * @param criterion_index The index of the output criterion that drives the refinement.
+     * @param initial_points_per_dim (Optional) The number of points per input parameter of the coarse grid. Must be at least 2. Default is 3.
+     *
+     * Throws an exception if `criterion_index` exceeds the number of output criteria.
+     */
+    AdaptiveParameterSearch(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, size_t criterion_index, size_t initial_points_per_dim = 3);
+
+    /**
+     * @brief Run the adaptive grid search.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory.
+     */
+    void run() override;
+
+    /**
+     * @brief Set a threshold of the refinement criterion.
+     * @param threshold Cells in which the criterion crosses the threshold (e.g. 0 for a multipole) are refined first.
+     */
+    void setThreshold(double threshold);
+
+    /**
+     * @brief Set the minimum cell size.
+     * @param min_cell_size The minimum edge length of a cell relative to the parameter ranges. Default is 1/64.
+     */
+    void setMinCellSize(double min_cell_size);
+
+    /**
+     * @brief Set the score tolerance.
+     * @param score_tolerance Cells in which the criterion changes by at most this value are not refined, unless they cross the threshold. Default is 0.
+     */
+    void setScoreTolerance(double score_tolerance);
+
+private:
+    size_t criterion_index_;
+    AdaptiveRefinement refinement_;
+};
+
+#endif // ADAPTIVE_PARAMETER_SEARCH_H
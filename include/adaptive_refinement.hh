@@ -0,0 +1,306 @@
+#ifndef ADAPTIVE_REFINEMENT_HH
+#define ADAPTIVE_REFINEMENT_HH
+
+#include <vector>
+#include <map>
+#include <queue>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <functional>
+#include <stdexcept>
+
+/**
+ * @class AdaptiveRefinement
+ * @brief Class for adaptively refining a grid on the unit cube.
+ *
+ * The refinement starts from a coarse grid with `initial_points_per_dim` points per dimension. Its cells are kept in a priority queue
+ * ordered by how much the criterion changes over the corners of the cell. Cells whose corner values enclose the threshold (if set) come first.
+ * The most interesting cell is bisected along the dimension in which the criterion changes most, and the two halves are pushed back
+ * into the queue. Refinement stops when the queue is empty, the largest remaining change is not above the score tolerance, or the stop condition is met.
+ * A cell is not bisected further if its halves would be smaller than the minimum cell size along every dimension.
+ * Every point is evaluated at most once, cells with a failed corner (NaN) are not refined.
+ */
+class AdaptiveRefinement
+{
+public:
+    /**
+     * @brief Function that evaluates the criterion at a point of the unit cube. Returns NaN if the evaluation failed.
+     */
+    using Evaluator = std::function<double(const std::vector<double> &)>;
+
+    /**
+     * @brief Function that returns true if no more points should be evaluated. Gets the number of points evaluated so far.
+     */
+    using StopCondition = std::function<bool(size_t)>;
+
+    /**
+     * @brief Construct an AdaptiveRefinement object.
+     * @param num_dims The number of dimensions. Must be at least 1.
+     * @param initial_points_per_dim The number of points per dimension of the coarse grid. Must be at least 2.
+     *
+     * Throws an exception if the arguments are invalid.
+     */
+    AdaptiveRefinement(size_t num_dims, size_t initial_points_per_dim = 3) : num_dims_(num_dims), initial_points_per_dim_(initial_points_per_dim)
+    {
+        if (num_dims < 1)
+        {
+            throw std::invalid_argument("num_dims must be at least 1");
+        }
+        if (initial_points_per_dim < 2)
+        {
+            throw std::invalid_argument("initial_points_per_dim must be at least 2");
+        }
+    }
+
+    /**
+     * @brief Set a threshold of the criterion.
+     * @param threshold Cells whose corner values enclose the threshold are refined first.
+     */
+    void setThreshold(double threshold)
+    {
+        threshold_ = threshold;
+        has_threshold_ = true;
+    }
+
+    /**
+     * @brief Set the minimum cell size.
+     * @param min_cell_size The minimum edge length of a cell in unit cube coordinates. Default is 1/64.
+     */
+    void setMinCellSize(double min_cell_size)
+    {
+        if (!(min_cell_size > 0.0))
+        {
+            throw std::invalid_argument("min_cell_size must be greater than 0");
+        }
+        min_cell_size_ = min_cell_size;
+    }
+
+    /**
+     * @brief Set the score tolerance.
+     * @param score_tolerance Cells over which the criterion changes by at most this value are not refined, unless they enclose the threshold. Default is 0.
+     */
+    void setScoreTolerance(double score_tolerance)
+    {
+        score_tolerance_ = score_tolerance;
+    }
+
+    /**
+     * @brief Run the refinement.
+     * @param evaluate The criterion evaluator.
+     * @param should_stop The stop condition, checked before every evaluation.
+     */
+    void run(const Evaluator &evaluate, const StopCondition &should_stop)
+    {
+        values_.clear();
+        points_.clear();
+        stopped_ = false;
+
+        std::priority_queue<Cell> queue;
+
+        // Coarse grid of (initial_points_per_dim - 1)^num_dims cells
+        size_t cells_per_dim = initial_points_per_dim_ - 1;
+        std::vector<size_t> position(num_dims_, 0);
+        while (!stopped_)
+        {
+            Cell cell;
+            cell.lo.resize(num_dims_);
+            cell.hi.resize(num_dims_);
+            for (size_t d = 0; d < num_dims_; d++)
+            {
+                cell.lo[d] = static_cast<double>(position[d]) / cells_per_dim;
+                cell.hi[d] = static_cast<double>(position[d] + 1) / cells_per_dim;
+            }
+            if (scoreCell(cell, evaluate, should_stop))
+            {
+                queue.push(cell);
+            }
+
+            // Advance to the next cell in mixed-radix order
+            size_t d = 0;
+            while (d < num_dims_ && ++position[d] == cells_per_dim)
+            {
+                position[d++] = 0;
+            }
+            if (d == num_dims_)
+            {
+                break;
+            }
+        }
+
+        // Refine the most interesting cells
+        while (!stopped_ && !queue.empty())
+        {
+            Cell cell = queue.top();
+            queue.pop();
+
+            if (!cell.crosses_threshold && cell.range <= score_tolerance_)
+            {
+                break;
+            }
+
+            Cell lower = cell;
+            Cell upper = cell;
+            double mid = 0.5 * (cell.lo[cell.split_dim] + cell.hi[cell.split_dim]);
+            lower.hi[cell.split_dim] = mid;
+            upper.lo[cell.split_dim] = mid;
+
+            if (scoreCell(lower, evaluate, should_stop))
+            {
+                queue.push(lower);
+            }
+            if (scoreCell(upper, evaluate, should_stop))
+            {
+                queue.push(upper);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the evaluated points in the order of evaluation.
+     * @return The points in unit cube coordinates.
+     */
+    const std::vector<std::vector<double>> &getPoints() const
+    {
+        return points_;
+    }
+
+    /**
+     * @brief Get the criterion value of an evaluated point.
+     * @param point The point in unit cube coordinates.
+     * @return The criterion value. Throws an exception if the point was not evaluated.
+     */
+    double getValue(const std::vector<double> &point) const
+    {
+        return values_.at(point);
+    }
+
+    /**
+     * @brief Check whether the last run was ended by the stop condition.
+     * @return True if the stop condition was met.
+     */
+    bool wasStopped() const
+    {
+        return stopped_;
+    }
+
+private:
+    /**
+     * @brief Cell of the refinement.
+     */
+    struct Cell
+    {
+        std::vector<double> lo;
+        std::vector<double> hi;
+        double range = 0.0;
+        bool crosses_threshold = false;
+        size_t split_dim = 0;
+
+        bool operator<(const Cell &other) const
+        {
+            if (crosses_threshold != other.crosses_threshold)
+            {
+                return !crosses_threshold;
+            }
+            return range < other.range;
+        }
+    };
+
+    /**
+     * @brief Evaluate the corners of a cell and compute its score and split dimension.
+     * @param cell The cell.
+     * @param evaluate The criterion evaluator.
+     * @param should_stop The stop condition.
+     * @return True if the cell can be refined.
+     */
+    bool scoreCell(Cell &cell, const Evaluator &evaluate, const StopCondition &should_stop)
+    {
+        size_t num_corners = static_cast<size_t>(1) << num_dims_;
+        std::vector<double> corner_values(num_corners);
+        std::vector<double> corner(num_dims_);
+        double min_value = std::numeric_limits<double>::infinity();
+        double max_value = -std::numeric_limits<double>::infinity();
+
+        for (size_t c = 0; c < num_corners; c++)
+        {
+            for (size_t d = 0; d < num_dims_; d++)
+            {
+                corner[d] = ((c >> d) & 1) ? cell.hi[d] : cell.lo[d];
+            }
+            double value = getOrEvaluate(corner, evaluate, should_stop);
+            if (std::isnan(value))
+            {
+                return false;
+            }
+            corner_values[c] = value;
+            min_value = std::min(min_value, value);
+            max_value = std::max(max_value, value);
+        }
+
+        cell.range = max_value - min_value;
+        cell.crosses_threshold = has_threshold_ && min_value <= threshold_ && max_value >= threshold_ && min_value < max_value;
+
+        // Split along the dimension with the largest mean change over the edges of the cell
+        double best_change = -1.0;
+        bool splittable = false;
+        for (size_t d = 0; d < num_dims_; d++)
+        {
+            if (0.5 * (cell.hi[d] - cell.lo[d]) < min_cell_size_)
+            {
+                continue;
+            }
+            double change = 0.0;
+            for (size_t c = 0; c < num_corners; c++)
+            {
+                if (((c >> d) & 1) == 0)
+                {
+                    change += std::abs(corner_values[c | (static_cast<size_t>(1) << d)] - corner_values[c]);
+                }
+            }
+            if (change > best_change)
+            {
+                best_change = change;
+                cell.split_dim = d;
+                splittable = true;
+            }
+        }
+        return splittable;
+    }
+
+    /**
+     * @brief Get the criterion value of a point, evaluating it if necessary.
+     * @param point The point in unit cube coordinates.
+     * @param evaluate The criterion evaluator.
+     * @param should_stop The stop condition.
+     * @return The criterion value, NaN if the evaluation failed or the stop condition is met.
+     */
+    double getOrEvaluate(const std::vector<double> &point, const Evaluator &evaluate, const StopCondition &should_stop)
+    {
+        auto it = values_.find(point);
+        if (it != values_.end())
+        {
+            return it->second;
+        }
+        if (stopped_ || should_stop(points_.size()))
+        {
+            stopped_ = true;
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        double value = evaluate(point);
+        values_[point] = value;
+        points_.push_back(point);
+        return value;
+    }
+
+    size_t num_dims_;
+    size_t initial_points_per_dim_;
+    double min_cell_size_ = 1.0 / 64;
+    double score_tolerance_ = 0.0;
+    double threshold_ = 0.0;
+    bool has_threshold_ = false;
+    bool stopped_ = false;
+    std::map<std::vector<double>, double> values_;
+    std::vector<std::vector<double>> points_;
+};
+
+#endif // ADAPTIVE_REFINEMENT_HH
@@ -0,0 +1,74 @@
+#ifndef BAYESIAN_OPTIMIZER_H
+#define BAYESIAN_OPTIMIZER_H
+
+#include "parameter_search.h"
+#include "optimization_objective.hh"
+#include "bayesian_proposer.hh"
+
+/**
+ * @class BayesianOptimizer
+ * @brief Class for minimizing an objective of the output criteria by Bayesian optimization.
+ *
+ * Evaluates an initial Latin hypercube design and then proposes batches of configurations by expected improvement on a Gaussian process surrogate
+ * of the completed steps, see `BayesianProposer`. Constraints of the objective are modelled by their own surrogates.
+ * The input parameters are sampled with `ParamRange::sample()`, i.e. linear and geometric ranges are optimized continuously between their bounds.
+ * Batches are distributed over the parallel workers, see `ParameterSearch::setNumWorkers()`.
+ * All evaluated configurations are written to the output file in the same format as the grid search, the index column holds the evaluation number.
+ * The optimization stops when the evaluation budget is spent. The step and time budgets of the parameter search apply as well.
+ */
+class BayesianOptimizer : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct a BayesianOptimizer object.
+     * @param inputParamsRanges The input parameter ranges.
+     * @param outputCriteria The output criteria.
+     * @param modelHandler The model handler.
+     * @param objective The objective to be minimized.
+     * @param max_evaluations The evaluation budget. Must be greater than 0.
+     * @param seed (Optional) The seed of the initial design and the proposals. Default is 0.
+     *
+     * Throws an exception if the objective refers to output criteria that do not exist.
+     */
+    BayesianOptimizer(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, OptimizationObjective objective, size_t max_evaluations, uint64_t seed = 0);
+
+    /**
+     * @brief Run the Bayesian optimization.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory.
+     */
+    void run() override;
+
+    /**
+     * @brief Set the size of the initial design.
+     * @param num_initial The number of configurations of the initial Latin hypercube design. Must be at least 2. Default is 10.
+     */
+    void setNumInitial(size_t num_initial);
+
+    /**
+     * @brief Set the number of configurations proposed per batch.
+     * @param batch_size The number of configurations per batch. Must be at least 1. Default is the number of workers.
+     */
+    void setBatchSize(size_t batch_size);
+
+    /**
+     * @brief Get the index of the best feasible configuration of the last run.
+     * @return The index in the output file, or -1 if no feasible configuration was found.
+     */
+    using ParameterSearch::getBestIndex;
+
+    /**
+     * @brief Get the objective of the best feasible configuration of the last run.
+     * @return The value of the objective, infinity if no feasible configuration was found.
+     */
+    using ParameterSearch::getBestObjective;
+
+private:
+    OptimizationObjective objective_;
+    size_t max_evaluations_;
+    uint64_t seed_;
+    size_t num_initial_ = 10;
+    size_t batch_size_ = 0;
+};
+
+#endif // BAYESIAN_OPTIMIZER_H
@@ -0,0 +1,370 @@
+#ifndef BAYESIAN_PROPOSER_HH
+#define BAYESIAN_PROPOSER_HH
+
+#include <vector>
+#include <cmath>
+#include <random>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <armadillo>
+#include "gaussian_process.hh"
+#include "sampler.hh"
+
+/**
+ * @class BayesianProposer
+ * @brief Class for proposing points of the unit cube by Bayesian optimization.
+ *
+ * Keeps the observations of the objective and the constraint slacks, fits a Gaussian process surrogate to each and proposes the points
+ * that maximize the expected improvement of the objective times the probability that all constraints are met.
+ * Batches are proposed with the kriging believer heuristic: after each proposal the surrogate of the objective assumes the predicted mean
+ * at the proposed point, which lowers the expected improvement around it so the next proposal lies elsewhere.
+ * The acquisition function is maximized over random candidates and perturbations of the best observations.
+ * Independent of the model, so it can be used and tested offline.
+ */
+class BayesianProposer
+{
+public:
+    /**
+     * @brief Construct a BayesianProposer object.
+     * @param num_dims The number of dimensions. Must be at least 1.
+     * @param num_constraints The number of constraints.
+     * @param seed The seed of the random number generator.
+     * @param num_candidates (Optional) The number of random candidates per proposal. Default is 2000.
+     */
+    BayesianProposer(size_t num_dims, size_t num_constraints, uint64_t seed, size_t num_candidates = 2000) : num_dims_(num_dims), num_constraints_(num_constraints), num_candidates_(num_candidates), rng_(seed)
+    {
+        if (num_dims < 1)
+        {
+            throw std::invalid_argument("num_dims must be at least 1");
+        }
+    }
+
+    /**
+     * @brief Add an observation.
+     * @param point The point of the unit cube.
+     * @param objective The value of the objective. NaN marks a failed evaluation, the point is not proposed again.
+     * @param slacks The constraint slacks, see `OptimizationObjective::getConstraintSlacks()`. Ignored for failed evaluations.
+     */
+    void addObservation(const std::vector<double> &point, double objective, const std::vector<double> &slacks)
+    {
+        if (point.size() != num_dims_)
+        {
+            throw std::invalid_argument("Point has the wrong number of dimensions");
+        }
+        if (std::isnan(objective))
+        {
+            failed_points_.push_back(point);
+            return;
+        }
+        if (slacks.size() != num_constraints_)
+        {
+            throw std::invalid_argument("Number of slacks does not match the number of constraints");
+        }
+        points_.push_back(point);
+        objectives_.push_back(objective);
+        slacks_.push_back(slacks);
+    }
+
+    /**
+     * @brief Get the number of successful observations.
+     * @return The number of successful observations.
+     */
+    size_t getNumObservations() const
+    {
+        return points_.size();
+    }
+
+    /**
+     * @brief Get the point of a successful observation.
+     * @param i The position of the observation.
+     * @return The point.
+     */
+    const std::vector<double> &getPoint(size_t i) const
+    {
+        return points_.at(i);
+    }
+
+    /**
+     * @brief Get the objective of a successful observation.
+     * @param i The position of the observation.
+     * @return The value of the objective.
+     */
+    double getObjective(size_t i) const
+    {
+        return objectives_.at(i);
+    }
+
+    /**
+     * @brief Get the position of the best feasible observation.
+     * @return The position in the order of the successful observations, or -1 if no observation is feasible.
+     */
+    long getBestObservation() const
+    {
+        long best = -1;
+        for (size_t i = 0; i < points_.size(); i++)
+        {
+            if (isFeasible(i) && (best < 0 || objectives_[i] < objectives_[best]))
+            {
+                best = static_cast<long>(i);
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Propose a batch of points.
+     * @param batch_size The number of points.
+     * @return The proposed points.
+     *
+     * Proposes a Latin hypercube design if fewer than two successful observations are available.
+     */
+    std::vector<std::vector<double>> propose(size_t batch_size)
+    {
+        if (points_.size() < 2)
+        {
+            return LatinHypercubeSampler(rng_()).generate(batch_size, num_dims_);
+        }
+
+        // Fit the surrogates of the objective and the constraints
+        arma::mat X = toMatrix(points_);
+        arma::vec y(objectives_.size());
+        for (size_t i = 0; i < objectives_.size(); i++)
+        {
+            y(i) = objectives_[i];
+        }
+        GaussianProcess objective_gp;
+        objective_gp.fit(X, y);
+
+        std::vector<GaussianProcess> constraint_gps(num_constraints_);
+        for (size_t c = 0; c < num_constraints_; c++)
+        {
+            arma::vec s(slacks_.size());
+            for (size_t i = 0; i < slacks_.size(); i++)
+            {
+                s(i) = slacks_[i][c];
+            }
+            constraint_gps[c].fit(X, s);
+        }
+
+        long best = getBestObservation();
+        bool has_feasible = best >= 0;
+        double best_objective = has_feasible ? objectives_[best] : 0.0;
+
+        std::vector<std::vector<double>> proposals;
+        std::vector<std::vector<double>> believer_points = points_;
+        std::vector<double> believer_objectives = objectives_;
+        for (size_t b = 0; b < batch_size; b++)
+        {
+            std::vector<std::vector<double>> candidates = getCandidates();
+
+            double best_acquisition = -1.0;
+            std::vector<double> best_candidate = candidates[0];
+            for (const std::vector<double> &candidate : candidates)
+            {
+                arma::rowvec x = toRow(candidate);
+
+                // Probability that all constraints are met
+                double probability = 1.0;
+                for (size_t c = 0; c < num_constraints_; c++)
+                {
+                    double mean, variance;
+                    constraint_gps[c].predict(x, mean, variance);
+                    probability *= normalCdf(mean / std::sqrt(variance + 1e-300));
+                }
+
+                double acquisition = probability;
+                if (has_feasible)
+                {
+                    double mean, variance;
+                    objective_gp.predict(x, mean, variance);
+                    acquisition *= expectedImprovement(mean, std::sqrt(variance), best_objective);
+                }
+
+                if (acquisition > best_acquisition)
+                {
+                    best_acquisition = acquisition;
+                    best_candidate = candidate;
+                }
+            }
+            proposals.push_back(best_candidate);
+
+            // Kriging believer: assume the predicted mean at the proposal and refit with the same hyperparameters
+            if (b + 1 < batch_size)
+            {
+                double mean, variance;
+                objective_gp.predict(toRow(best_candidate), mean, variance);
+                believer_points.push_back(best_candidate);
+                believer_objectives.push_back(mean);
+
+                arma::vec y_believer(believer_objectives.size());
+                for (size_t i = 0; i < believer_objectives.size(); i++)
+                {
+                    y_believer(i) = believer_objectives[i];
+                }
+                double length_scale = objective_gp.getLengthScale();
+                double noise = objective_gp.getNoise();
+                if (!objective_gp.fit(toMatrix(believer_points), y_believer, length_scale, noise))
+                {
+                    objective_gp.fit(toMatrix(believer_points), y_believer);
+                }
+            }
+        }
+        return proposals;
+    }
+
+    /**
+     * @brief Expected improvement for minimization.
+     * @param mean The predicted mean.
+     * @param stddev The predicted standard deviation.
+     * @param best The best observed value.
+     * @return The expected improvement over `best`.
+     */
+    static double expectedImprovement(double mean, double stddev, double best)
+    {
+        double improvement = best - mean;
+        if (!(stddev > 0.0))
+        {
+            return std::max(improvement, 0.0);
+        }
+        double z = improvement / stddev;
+        return improvement * normalCdf(z) + stddev * normalPdf(z);
+    }
+
+private:
+    /**
+     * @brief Check whether all constraint slacks of an observation are non-negative.
+     * @param i The position of the observation.
+     * @return True if the observation is feasible.
+     */
+    bool isFeasible(size_t i) const
+    {
+        for (double slack : slacks_[i])
+        {
+            if (!(slack >= 0.0))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get the candidates for the maximization of the acquisition function.
+     * @return Random points of the unit cube and perturbations of the best feasible observations.
+     */
+    std::vector<std::vector<double>> getCandidates()
+    {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::normal_distribution<double> normal(0.0, 0.05);
+
+        std::vector<std::vector<double>> candidates;
+        candidates.reserve(num_candidates_ + LOCAL_CANDIDATES * NUM_INCUMBENTS);
+        for (size_t i = 0; i < num_candidates_; i++)
+        {
+            std::vector<double> candidate(num_dims_);
+            for (double &x : candidate)
+            {
+                x = uniform(rng_);
+            }
+            candidates.push_back(candidate);
+        }
+
+        // Local candidates around the incumbents
+        std::vector<size_t> order(points_.size());
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [this](size_t a, size_t b)
+                  {
+                      if (isFeasible(a) != isFeasible(b))
+                      {
+                          return isFeasible(a);
+                      }
+                      return objectives_[a] < objectives_[b]; });
+        for (size_t k = 0; k < std::min(NUM_INCUMBENTS, order.size()); k++)
+        {
+            for (size_t i = 0; i < LOCAL_CANDIDATES; i++)
+            {
+                std::vector<double> candidate = points_[order[k]];
+                for (double &x : candidate)
+                {
+                    x = std::min(std::max(x + normal(rng_), 0.0), 1.0);
+                }
+                candidates.push_back(candidate);
+            }
+        }
+
+        // Do not propose failed points again
+        if (!failed_points_.empty())
+        {
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [this](const std::vector<double> &candidate)
+                                            { return std::find(failed_points_.begin(), failed_points_.end(), candidate) != failed_points_.end(); }),
+                             candidates.end());
+        }
+        if (candidates.empty())
+        {
+            candidates.push_back(std::vector<double>(num_dims_, 0.5));
+        }
+        return candidates;
+    }
+
+    /**
+     * @brief Convert points to a matrix with one point per row.
+     * @param points The points.
+     * @return The matrix.
+     */
+    arma::mat toMatrix(const std::vector<std::vector<double>> &points) const
+    {
+        arma::mat X(points.size(), num_dims_);
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            for (size_t d = 0; d < num_dims_; d++)
+            {
+                X(i, d) = points[i][d];
+            }
+        }
+        return X;
+    }
+
+    /**
+     * @brief Convert a point to a row vector.
+     * @param point The point.
+     * @return The row vector.
+     */
+    arma::rowvec toRow(const std::vector<double> &point) const
+    {
+        arma::rowvec x(num_dims_);
+        for (size_t d = 0; d < num_dims_; d++)
+        {
+            x(d) = point[d];
+        }
+        return x;
+    }
+
+    static double normalPdf(double z)
+    {
+        return std::exp(-0.5 * z * z) / std::sqrt(2.0 * arma::datum::pi);
+    }
+
+    static double normalCdf(double z)
+    {
+        return 0.5 * std::erfc(-z / std::sqrt(2.0));
+    }
+
+    static constexpr size_t NUM_INCUMBENTS = 5;
+    static constexpr size_t LOCAL_CANDIDATES = 100;
+
+    size_t num_dims_;
+    size_t num_constraints_;
+    size_t num_candidates_;
+    std::mt19937_64 rng_;
+    std::vector<std::vector<double>> points_;
+    std::vector<double> objectives_;
+    std::vector<std::vector<double>> slacks_;
+    std::vector<std::vector<double>> failed_points_;
+};
+
+#endif // BAYESIAN_PROPOSER_HH
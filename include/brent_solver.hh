@@ -0,0 +1,286 @@
+#ifndef BRENT_SOLVER_HH
+#define BRENT_SOLVER_HH
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+/**
+ * @class BrentSolver
+ * @brief Class for finding a root of a scalar function on the unit interval with bracketing and Brent's method.
+ *
+ * Evaluates both ends of the interval as one batch. If the residual does not change sign between them, equally spaced interior points are evaluated
+ * as a second batch and the first sign change is used. The bracket is then narrowed by Brent's method (inverse quadratic interpolation and secant steps
+ * with bisection as fallback, Brent, "Algorithms for Minimization without Derivatives", 1973), one evaluation per iteration.
+ * If no sign change is found, the point with the smallest absolute residual is reported.
+ */
+class BrentSolver
+{
+public:
+    /**
+     * @brief Function that evaluates the residual at a batch of points of the unit interval. Returns NaN for failed evaluations.
+     */
+    using BatchEvaluator = std::function<std::vector<double>(const std::vector<double> &)>;
+
+    /**
+     * @brief Function that returns true if the next batch must not be evaluated. Gets the number of points evaluated so far and the size of the next batch.
+     */
+    using StopCondition = std::function<bool(size_t, size_t)>;
+
+    /**
+     * @brief Construct a BrentSolver object.
+     * @param tolerance The residual is accepted if its absolute value is at most this value. Must be greater than 0.
+     * @param tol_x (Optional) The iteration also stops if the bracket is narrower than this value. Default is 1e-10.
+     */
+    BrentSolver(double tolerance, double tol_x = 1e-10) : tolerance_(tolerance), tol_x_(tol_x)
+    {
+        if (!(tolerance > 0.0))
+        {
+            throw std::invalid_argument("tolerance must be greater than 0");
+        }
+    }
+
+    /**
+     * @brief Set the number of interior points evaluated if the ends of the interval do not bracket a root.
+     * @param num_scan_points The number of points. Must be at least 1. Default is 7.
+     */
+    void setNumScanPoints(size_t num_scan_points)
+    {
+        if (num_scan_points < 1)
+        {
+            throw std::invalid_argument("num_scan_points must be at least 1");
+        }
+        num_scan_points_ = num_scan_points;
+    }
+
+    /**
+     * @brief Find a root.
+     * @param evaluate The batch evaluator.
+     * @param should_stop The stop condition.
+     */
+    void solve(const BatchEvaluator &evaluate, const StopCondition &should_stop)
+    {
+        num_evaluated_ = 0;
+        converged_ = false;
+        bracketed_ = false;
+        solution_ = std::numeric_limits<double>::quiet_NaN();
+        residual_ = std::numeric_limits<double>::quiet_NaN();
+
+        auto evaluate_batch = [&](const std::vector<double> &points, std::vector<double> &values) -> bool
+        {
+            if (should_stop(num_evaluated_, points.size()))
+            {
+                return false;
+            }
+            values = evaluate(points);
+            if (values.size() != points.size())
+            {
+                throw std::runtime_error("Evaluator returned the wrong number of values");
+            }
+            num_evaluated_ += points.size();
+            for (size_t k = 0; k < points.size(); k++)
+            {
+                if (std::isfinite(values[k]) && !(std::abs(values[k]) >= std::abs(residual_)))
+                {
+                    solution_ = points[k];
+                    residual_ = values[k];
+                }
+            }
+            converged_ = std::abs(residual_) <= tolerance_;
+            return true;
+        };
+
+        // Bracket with the ends of the interval, then with interior points
+        std::vector<double> points = {0.0, 1.0};
+        std::vector<double> values;
+        if (!evaluate_batch(points, values) || converged_)
+        {
+            return;
+        }
+        double a = 0.0, b = 1.0, fa = values[0], fb = values[1];
+        if (!hasSignChange(fa, fb))
+        {
+            std::vector<double> scan_points;
+            for (size_t k = 1; k <= num_scan_points_; k++)
+            {
+                scan_points.push_back(static_cast<double>(k) / (num_scan_points_ + 1));
+            }
+            std::vector<double> scan_values;
+            if (!evaluate_batch(scan_points, scan_values) || converged_)
+            {
+                return;
+            }
+
+            points.insert(points.begin() + 1, scan_points.begin(), scan_points.end());
+            values.insert(values.begin() + 1, scan_values.begin(), scan_values.end());
+            bool found = false;
+            for (size_t k = 0; k + 1 < points.size() && !found; k++)
+            {
+                if (hasSignChange(values[k], values[k + 1]))
+                {
+                    a = points[k];
+                    b = points[k + 1];
+                    fa = values[k];
+                    fb = values[k + 1];
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                return;
+            }
+        }
+        bracketed_ = true;
+
+        // Brent's method, b is the best estimate and [b, c] brackets the root
+        double c = a, fc = fa;
+        double d = b - a, e = d;
+        while (true)
+        {
+            if (hasSignChange(fb, fc) == false)
+            {
+                c = a;
+                fc = fa;
+                d = b - a;
+                e = d;
+            }
+            if (std::abs(fc) < std::abs(fb))
+            {
+                a = b;
+                b = c;
+                c = a;
+                fa = fb;
+                fb = fc;
+                fc = fa;
+            }
+
+            double tol = 2.0 * std::numeric_limits<double>::epsilon() * std::abs(b) + 0.5 * tol_x_;
+            double m = 0.5 * (c - b);
+            if (std::abs(m) <= tol || std::abs(fb) <= tolerance_)
+            {
+                return;
+            }
+
+            if (std::abs(e) >= tol && std::abs(fa) > std::abs(fb))
+            {
+                // Inverse quadratic interpolation or secant step
+                double s = fb / fa;
+                double p, q;
+                if (a == c)
+                {
+                    p = 2.0 * m * s;
+                    q = 1.0 - s;
+                }
+                else
+                {
+                    double r = fb / fc;
+                    double t = fa / fc;
+                    p = s * (2.0 * m * t * (t - r) - (b - a) * (r - 1.0));
+                    q = (t - 1.0) * (r - 1.0) * (s - 1.0);
+                }
+                if (p > 0.0)
+                {
+                    q = -q;
+                }
+                p = std::abs(p);
+                if (2.0 * p < std::min(3.0 * m * q - std::abs(tol * q), std::abs(e * q)))
+                {
+                    e = d;
+                    d = p / q;
+                }
+                else
+                {
+                    d = m;
+                    e = m;
+                }
+            }
+            else
+            {
+                d = m;
+                e = m;
+            }
+
+            a = b;
+            fa = fb;
+            b += std::abs(d) > tol ? d : (m > 0.0 ? tol : -tol);
+
+            std::vector<double> trial;
+            if (!evaluate_batch({b}, trial))
+            {
+                return;
+            }
+            fb = trial[0];
+            if (!std::isfinite(fb))
+            {
+                // The bracket cannot be narrowed without knowing the sign
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Check whether the last solve reached the tolerance.
+     * @return True if the absolute residual of the solution is at most the tolerance.
+     */
+    bool hasConverged() const
+    {
+        return converged_;
+    }
+
+    /**
+     * @brief Check whether the last solve found a sign change.
+     * @return True if a root was bracketed.
+     */
+    bool wasBracketed() const
+    {
+        return bracketed_;
+    }
+
+    /**
+     * @brief Get the point with the smallest absolute residual of the last solve.
+     * @return The point, NaN if no evaluation succeeded.
+     */
+    double getSolution() const
+    {
+        return solution_;
+    }
+
+    /**
+     * @brief Get the residual at the solution.
+     * @return The residual, NaN if no evaluation succeeded.
+     */
+    double getResidual() const
+    {
+        return residual_;
+    }
+
+    /**
+     * @brief Get the number of evaluations of the last solve.
+     * @return The number of evaluated points.
+     */
+    size_t getNumEvaluations() const
+    {
+        return num_evaluated_;
+    }
+
+private:
+    static bool hasSignChange(double fa, double fb)
+    {
+        return std::isfinite(fa) && std::isfinite(fb) && ((fa <= 0.0 && fb >= 0.0) || (fa >= 0.0 && fb <= 0.0));
+    }
+
+    double tolerance_;
+    double tol_x_;
+    size_t num_scan_points_ = 7;
+
+    size_t num_evaluated_ = 0;
+    bool converged_ = false;
+    bool bracketed_ = false;
+    double solution_ = std::numeric_limits<double>::quiet_NaN();
+    double residual_ = std::numeric_limits<double>::quiet_NaN();
+};
+
+#endif // BRENT_SOLVER_HH
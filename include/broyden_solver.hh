@@ -0,0 +1,321 @@
+#ifndef BROYDEN_SOLVER_HH
+#define BROYDEN_SOLVER_HH
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <armadillo>
+
+/**
+ * @class BroydenSolver
+ * @brief Class for solving a square system of residuals on the unit cube with Broyden's method.
+ *
+ * The initial Jacobian is estimated with forward differences; the start point and the n perturbed points are evaluated as one batch.
+ * Each iteration takes the quasi-Newton step, projected onto the unit cube, and halves it until the scaled residual norm decreases.
+ * The Jacobian is then corrected with Broyden's rank-one update (Broyden, "A class of methods for solving nonlinear simultaneous equations", 1965).
+ * If no halved step decreases the residuals, the Jacobian is estimated again once before giving up.
+ * Residuals are scaled by their tolerances, so targets of different magnitude are weighted equally.
+ */
+class BroydenSolver
+{
+public:
+    /**
+     * @brief Function that evaluates the residuals at a batch of points of the unit cube. Returns an empty vector for failed evaluations.
+     */
+    using BatchEvaluator = std::function<std::vector<std::vector<double>>(const std::vector<std::vector<double>> &)>;
+
+    /**
+     * @brief Function that returns true if the next batch must not be evaluated. Gets the number of points evaluated so far and the size of the next batch.
+     */
+    using StopCondition = std::function<bool(size_t, size_t)>;
+
+    /**
+     * @brief Construct a BroydenSolver object.
+     * @param tolerances The tolerance of each residual. Must be greater than 0. The number of tolerances is the number of unknowns.
+     * @param fd_step (Optional) The perturbation of the finite difference Jacobian in unit cube coordinates. Default is 1e-3.
+     */
+    BroydenSolver(const std::vector<double> &tolerances, double fd_step = 1e-3) : tolerances_(tolerances), fd_step_(fd_step)
+    {
+        if (tolerances.empty())
+        {
+            throw std::invalid_argument("At least one residual is required");
+        }
+        for (double tolerance : tolerances)
+        {
+            if (!(tolerance > 0.0))
+            {
+                throw std::invalid_argument("Tolerances must be greater than 0");
+            }
+        }
+        if (!(fd_step > 0.0 && fd_step < 0.5))
+        {
+            throw std::invalid_argument("fd_step must be greater than 0 and less than 0.5");
+        }
+    }
+
+    /**
+     * @brief Solve the system.
+     * @param start The start point in the unit cube.
+     * @param evaluate The batch evaluator.
+     * @param should_stop The stop condition.
+     */
+    void solve(const std::vector<double> &start, const BatchEvaluator &evaluate, const StopCondition &should_stop)
+    {
+        size_t n = tolerances_.size();
+        if (start.size() != n)
+        {
+            throw std::invalid_argument("Start point has the wrong number of dimensions");
+        }
+        num_evaluated_ = 0;
+        converged_ = false;
+        solution_.clear();
+        residuals_.clear();
+        double best_norm = std::numeric_limits<double>::infinity();
+
+        auto evaluate_batch = [&](const std::vector<std::vector<double>> &points, std::vector<std::vector<double>> &values) -> bool
+        {
+            if (should_stop(num_evaluated_, points.size()))
+            {
+                return false;
+            }
+            values = evaluate(points);
+            if (values.size() != points.size())
+            {
+                throw std::runtime_error("Evaluator returned the wrong number of values");
+            }
+            num_evaluated_ += points.size();
+            for (size_t k = 0; k < points.size(); k++)
+            {
+                double norm = scaledNorm(values[k]);
+                if (norm < best_norm)
+                {
+                    best_norm = norm;
+                    solution_ = points[k];
+                    residuals_ = values[k];
+                }
+            }
+            converged_ = isConverged(residuals_);
+            return true;
+        };
+
+        std::vector<double> x(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] = std::min(std::max(start[i], 0.0), 1.0);
+        }
+
+        std::vector<double> r;
+        arma::mat J;
+        if (!estimateJacobian(x, r, J, true, evaluate_batch) || converged_)
+        {
+            return;
+        }
+        bool fresh_jacobian = true;
+
+        for (int iteration = 0; !converged_ && iteration < MAX_ITERATIONS; iteration++)
+        {
+            // Quasi-Newton step
+            arma::vec dx;
+            arma::vec rhs(n);
+            for (size_t i = 0; i < n; i++)
+            {
+                rhs(i) = -r[i];
+            }
+            bool solved = arma::solve(dx, J, rhs);
+
+            // Halve the step until the scaled residual norm decreases
+            bool accepted = false;
+            std::vector<double> x_next, r_next;
+            double lambda = 1.0;
+            for (int k = 0; solved && k < MAX_STEP_HALVINGS && !accepted; k++, lambda *= 0.5)
+            {
+                std::vector<double> trial(n);
+                for (size_t i = 0; i < n; i++)
+                {
+                    trial[i] = std::min(std::max(x[i] + lambda * dx(i), 0.0), 1.0);
+                }
+                if (trial == x)
+                {
+                    break;
+                }
+
+                std::vector<std::vector<double>> values;
+                if (!evaluate_batch({trial}, values))
+                {
+                    return;
+                }
+                if (scaledNorm(values[0]) < scaledNorm(r))
+                {
+                    x_next = trial;
+                    r_next = values[0];
+                    accepted = true;
+                }
+            }
+
+            if (!accepted)
+            {
+                if (fresh_jacobian)
+                {
+                    return;
+                }
+                if (!estimateJacobian(x, r, J, false, evaluate_batch))
+                {
+                    return;
+                }
+                fresh_jacobian = true;
+                continue;
+            }
+
+            // Broyden's update with the step actually taken
+            arma::vec s(n), y(n);
+            for (size_t i = 0; i < n; i++)
+            {
+                s(i) = x_next[i] - x[i];
+                y(i) = r_next[i] - r[i];
+            }
+            J = J + (y - J * s) * s.t() / arma::dot(s, s);
+            x = x_next;
+            r = r_next;
+            fresh_jacobian = false;
+        }
+    }
+
+    /**
+     * @brief Check whether the last solve reached the tolerances.
+     * @return True if every residual of the solution is within its tolerance.
+     */
+    bool hasConverged() const
+    {
+        return converged_;
+    }
+
+    /**
+     * @brief Get the point with the smallest scaled residual norm of the last solve.
+     * @return The point, empty if no evaluation succeeded.
+     */
+    const std::vector<double> &getSolution() const
+    {
+        return solution_;
+    }
+
+    /**
+     * @brief Get the residuals at the solution.
+     * @return The residuals, empty if no evaluation succeeded.
+     */
+    const std::vector<double> &getResiduals() const
+    {
+        return residuals_;
+    }
+
+    /**
+     * @brief Get the number of evaluations of the last solve.
+     * @return The number of evaluated points.
+     */
+    size_t getNumEvaluations() const
+    {
+        return num_evaluated_;
+    }
+
+private:
+    /**
+     * @brief Estimate the Jacobian with forward differences, perturbing inwards at the upper bound.
+     * @param x The point.
+     * @param r The residuals at the point. Evaluated in the same batch if `evaluate_center` is true.
+     * @param J The Jacobian.
+     * @param evaluate_center Whether the point itself is evaluated.
+     * @return False if the stop condition was met or an evaluation failed.
+     */
+    template <typename EvaluateBatch>
+    bool estimateJacobian(const std::vector<double> &x, std::vector<double> &r, arma::mat &J, bool evaluate_center, EvaluateBatch &evaluate_batch)
+    {
+        size_t n = x.size();
+        std::vector<std::vector<double>> points;
+        if (evaluate_center)
+        {
+            points.push_back(x);
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            std::vector<double> point = x;
+            point[i] = x[i] + fd_step_ <= 1.0 ? x[i] + fd_step_ : x[i] - fd_step_;
+            points.push_back(point);
+        }
+
+        std::vector<std::vector<double>> values;
+        if (!evaluate_batch(points, values))
+        {
+            return false;
+        }
+        size_t offset = evaluate_center ? 1 : 0;
+        if (evaluate_center)
+        {
+            r = values[0];
+        }
+        if (r.size() != n)
+        {
+            return false;
+        }
+
+        J = arma::mat(n, n);
+        for (size_t j = 0; j < n; j++)
+        {
+            const std::vector<double> &r_j = values[offset + j];
+            if (r_j.size() != n)
+            {
+                return false;
+            }
+            double h = points[offset + j][j] - x[j];
+            for (size_t i = 0; i < n; i++)
+            {
+                J(i, j) = (r_j[i] - r[i]) / h;
+            }
+        }
+        return true;
+    }
+
+    double scaledNorm(const std::vector<double> &residuals) const
+    {
+        if (residuals.size() != tolerances_.size())
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        double sum = 0.0;
+        for (size_t i = 0; i < residuals.size(); i++)
+        {
+            sum += (residuals[i] / tolerances_[i]) * (residuals[i] / tolerances_[i]);
+        }
+        return std::isnan(sum) ? std::numeric_limits<double>::infinity() : std::sqrt(sum);
+    }
+
+    bool isConverged(const std::vector<double> &residuals) const
+    {
+        if (residuals.size() != tolerances_.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < residuals.size(); i++)
+        {
+            if (!(std::abs(residuals[i]) <= tolerances_[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static constexpr int MAX_STEP_HALVINGS = 6;
+    static constexpr int MAX_ITERATIONS = 100;
+
+    std::vector<double> tolerances_;
+    double fd_step_;
+
+    size_t num_evaluated_ = 0;
+    bool converged_ = false;
+    std::vector<double> solution_;
+    std::vector<double> residuals_;
+};
+
+#endif // BROYDEN_SOLVER_HH
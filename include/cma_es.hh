@@ -0,0 +1,250 @@
+#ifndef CMA_ES_HH
+#define CMA_ES_HH
+
+#include <vector>
+#include <random>
+#include <numeric>
+#include <cstdint>
+#include <armadillo>
+#include "local_optimizer.hh"
+
+/**
+ * @class CMAES
+ * @brief Covariance matrix adaptation evolution strategy on the unit cube.
+ *
+ * (mu/mu_w, lambda)-CMA-ES with the default parameters of Hansen's tutorial (arXiv:1604.00772).
+ * Every `ask()` returns a whole population, which can be evaluated in parallel. Samples outside the unit cube are redrawn,
+ * after 100 failed attempts they are clamped. Converges when the step size times the largest standard deviation of the search distribution is below the tolerance.
+ */
+class CMAES : public LocalOptimizer
+{
+public:
+    /**
+     * @brief Construct a CMAES object.
+     * @param start The initial mean in the unit cube.
+     * @param sigma The initial step size. Must be greater than 0.
+     * @param seed The seed of the random number generator.
+     * @param population_size (Optional) The population size lambda. Default (0) is 4 + floor(3 ln n).
+     * @param tol_x (Optional) The tolerance of the search distribution. Default is 1e-6.
+     */
+    CMAES(const std::vector<double> &start, double sigma, uint64_t seed, size_t population_size = 0, double tol_x = 1e-6) : sigma_(sigma), tol_x_(tol_x), rng_(seed)
+    {
+        if (start.empty())
+        {
+            throw std::invalid_argument("start cannot be empty");
+        }
+        if (!(sigma > 0.0))
+        {
+            throw std::invalid_argument("sigma must be greater than 0");
+        }
+
+        n_ = start.size();
+        mean_ = toVec(clampToUnitCube(start));
+        lambda_ = population_size > 0 ? population_size : 4 + static_cast<size_t>(std::floor(3.0 * std::log(static_cast<double>(n_))));
+        mu_ = std::max<size_t>(lambda_ / 2, 1);
+
+        // Recombination weights
+        weights_ = arma::vec(mu_);
+        for (size_t i = 0; i < mu_; i++)
+        {
+            weights_(i) = std::log(mu_ + 0.5) - std::log(i + 1.0);
+        }
+        weights_ = weights_ / arma::accu(weights_);
+        mueff_ = 1.0 / arma::dot(weights_, weights_);
+
+        // Adaptation parameters
+        double n = static_cast<double>(n_);
+        cc_ = (4.0 + mueff_ / n) / (n + 4.0 + 2.0 * mueff_ / n);
+        cs_ = (mueff_ + 2.0) / (n + mueff_ + 5.0);
+        c1_ = 2.0 / ((n + 1.3) * (n + 1.3) + mueff_);
+        cmu_ = std::min(1.0 - c1_, 2.0 * (mueff_ - 2.0 + 1.0 / mueff_) / ((n + 2.0) * (n + 2.0) + mueff_));
+        damps_ = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff_ - 1.0) / (n + 1.0)) - 1.0) + cs_;
+        chi_n_ = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+        pc_ = arma::vec(n_, arma::fill::zeros);
+        ps_ = arma::vec(n_, arma::fill::zeros);
+        B_ = arma::eye<arma::mat>(n_, n_);
+        D_ = arma::vec(n_);
+        for (size_t i = 0; i < n_; i++)
+        {
+            D_(i) = 1.0;
+        }
+        C_ = arma::eye<arma::mat>(n_, n_);
+        inv_sqrt_C_ = arma::eye<arma::mat>(n_, n_);
+    }
+
+    std::vector<std::vector<double>> ask() override
+    {
+        std::normal_distribution<double> normal(0.0, 1.0);
+        population_.clear();
+        for (size_t k = 0; k < lambda_; k++)
+        {
+            arma::vec x(n_);
+            bool inside = false;
+            for (int attempt = 0; attempt < MAX_RESAMPLES && !inside; attempt++)
+            {
+                arma::vec z(n_);
+                for (size_t i = 0; i < n_; i++)
+                {
+                    z(i) = normal(rng_);
+                }
+                x = mean_ + sigma_ * (B_ * (D_ % z));
+                inside = isInside(x);
+            }
+            population_.push_back(clampToUnitCube(toStd(x)));
+        }
+        return population_;
+    }
+
+    void tell(const std::vector<double> &values) override
+    {
+        if (values.size() != population_.size() || population_.empty())
+        {
+            throw std::invalid_argument("Number of values does not match the population size");
+        }
+        generation_++;
+
+        // Rank the population
+        std::vector<double> fitness(values.size());
+        for (size_t k = 0; k < values.size(); k++)
+        {
+            fitness[k] = sanitize(values[k]);
+            updateBest(population_[k], fitness[k]);
+        }
+        std::vector<size_t> order(lambda_);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&fitness](size_t a, size_t b)
+                         { return fitness[a] < fitness[b]; });
+
+        // Recombination
+        arma::vec old_mean = mean_;
+        arma::mat steps(n_, mu_);
+        mean_ = arma::vec(n_, arma::fill::zeros);
+        for (size_t i = 0; i < mu_; i++)
+        {
+            arma::vec x = toVec(population_[order[i]]);
+            mean_ = mean_ + weights_(i) * x;
+            arma::vec step = (x - old_mean) / sigma_;
+            for (size_t d = 0; d < n_; d++)
+            {
+                steps(d, i) = step(d);
+            }
+        }
+        arma::vec mean_step = (mean_ - old_mean) / sigma_;
+
+        // Evolution paths
+        ps_ = (1.0 - cs_) * ps_ + std::sqrt(cs_ * (2.0 - cs_) * mueff_) * (inv_sqrt_C_ * mean_step);
+        double ps_norm = arma::norm(ps_);
+        bool hsig = ps_norm / std::sqrt(1.0 - std::pow(1.0 - cs_, 2.0 * generation_)) / chi_n_ < 1.4 + 2.0 / (n_ + 1.0);
+        pc_ = (1.0 - cc_) * pc_ + (hsig ? std::sqrt(cc_ * (2.0 - cc_) * mueff_) : 0.0) * mean_step;
+
+        // Covariance matrix
+        arma::mat rank_one = pc_ * pc_.t();
+        arma::mat rank_mu = steps * arma::diagmat(weights_) * steps.t();
+        C_ = (1.0 - c1_ - cmu_) * C_ + c1_ * (rank_one + (hsig ? 0.0 : cc_ * (2.0 - cc_)) * C_) + cmu_ * rank_mu;
+
+        // Step size
+        sigma_ *= std::exp((cs_ / damps_) * (ps_norm / chi_n_ - 1.0));
+
+        // Eigendecomposition of the covariance matrix
+        C_ = arma::symmatu(C_);
+        arma::vec eigval;
+        arma::mat eigvec;
+        if (arma::eig_sym(eigval, eigvec, C_))
+        {
+            B_ = eigvec;
+            for (size_t i = 0; i < n_; i++)
+            {
+                D_(i) = std::sqrt(std::max(eigval(i), 1e-20));
+            }
+            arma::vec inv_D(n_);
+            for (size_t i = 0; i < n_; i++)
+            {
+                inv_D(i) = 1.0 / D_(i);
+            }
+            inv_sqrt_C_ = B_ * arma::diagmat(inv_D) * B_.t();
+        }
+        population_.clear();
+    }
+
+    bool hasConverged() const override
+    {
+        return generation_ > 0 && sigma_ * arma::max(D_) < tol_x_;
+    }
+
+    /**
+     * @brief Get the population size.
+     * @return The population size lambda.
+     */
+    size_t getPopulationSize() const
+    {
+        return lambda_;
+    }
+
+    /**
+     * @brief Get the current step size.
+     * @return The step size sigma.
+     */
+    double getSigma() const
+    {
+        return sigma_;
+    }
+
+private:
+    static constexpr int MAX_RESAMPLES = 100;
+
+    bool isInside(const arma::vec &x) const
+    {
+        for (size_t i = 0; i < n_; i++)
+        {
+            if (x(i) < 0.0 || x(i) > 1.0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    arma::vec toVec(const std::vector<double> &point) const
+    {
+        arma::vec x(point.size());
+        for (size_t i = 0; i < point.size(); i++)
+        {
+            x(i) = point[i];
+        }
+        return x;
+    }
+
+    std::vector<double> toStd(const arma::vec &x) const
+    {
+        std::vector<double> point(n_);
+        for (size_t i = 0; i < n_; i++)
+        {
+            point[i] = x(i);
+        }
+        return point;
+    }
+
+    size_t n_;
+    size_t lambda_;
+    size_t mu_;
+    double sigma_;
+    double tol_x_;
+    std::mt19937_64 rng_;
+    size_t generation_ = 0;
+
+    arma::vec weights_;
+    double mueff_;
+    double cc_, cs_, c1_, cmu_, damps_, chi_n_;
+
+    arma::vec mean_;
+    arma::vec pc_;
+    arma::vec ps_;
+    arma::mat B_;
+    arma::vec D_;
+    arma::mat C_;
+    arma::mat inv_sqrt_C_;
+    std::vector<std::vector<double>> population_;
+};
+
+#endif // CMA_ES_HH
@@ -0,0 +1,165 @@
+#ifndef FAILURE_PREDICTOR_HH
+#define FAILURE_PREDICTOR_HH
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @enum FailurePolicy
+ * @brief What the parameter search does with configurations that are predicted to fail.
+ */
+enum FailurePolicy
+{
+    DEFER_LIKELY_FAILURES, ///< Evaluate them after all other steps.
+    SKIP_LIKELY_FAILURES   ///< Do not evaluate them.
+};
+
+/**
+ * @class FailurePredictor
+ * @brief Class for predicting failed evaluations from the outcomes of previous ones with a k-nearest-neighbor classifier.
+ *
+ * The configurations are given as points of the unit cube (see `ParamRange::getUnitPosition()`), so all inputs have the same scale.
+ * The predicted failure probability of a point is the fraction of failed evaluations among its k nearest observations.
+ * The classifier learns online; until `min_observations` outcomes have been added, every point is predicted to succeed.
+ */
+class FailurePredictor
+{
+public:
+    /**
+     * @brief Construct a FailurePredictor object.
+     * @param k (Optional) The number of neighbors. Must be at least 1. Default is 5.
+     * @param min_observations (Optional) The number of outcomes before failures are predicted. Must be at least `k`. Default is 10.
+     */
+    FailurePredictor(size_t k = 5, size_t min_observations = 10) : k_(k), min_observations_(min_observations)
+    {
+        if (k < 1)
+        {
+            throw std::invalid_argument("k must be at least 1");
+        }
+        if (min_observations < k)
+        {
+            throw std::invalid_argument("min_observations must be at least k");
+        }
+    }
+
+    /**
+     * @brief Add the outcome of an evaluation.
+     * @param point The configuration in unit cube coordinates.
+     * @param failed Whether the evaluation failed.
+     */
+    void addObservation(const std::vector<double> &point, bool failed)
+    {
+        if (!points_.empty() && point.size() != points_[0].size())
+        {
+            throw std::invalid_argument("Point has the wrong number of dimensions");
+        }
+        points_.push_back(point);
+        failed_.push_back(failed);
+    }
+
+    /**
+     * @brief Predict the failure probability of a configuration.
+     * @param point The configuration in unit cube coordinates.
+     * @return The fraction of failures among the k nearest observations, 0 if there are fewer than `min_observations` observations.
+     */
+    double predictFailureProbability(const std::vector<double> &point) const
+    {
+        if (points_.size() < min_observations_)
+        {
+            return 0.0;
+        }
+
+        std::vector<double> distances(points_.size());
+        for (size_t i = 0; i < points_.size(); i++)
+        {
+            double sum = 0.0;
+            for (size_t d = 0; d < point.size(); d++)
+            {
+                sum += (point[d] - points_[i][d]) * (point[d] - points_[i][d]);
+            }
+            distances[i] = sum;
+        }
+
+        std::vector<size_t> order(points_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + k_, order.end(), [&](size_t a, size_t b)
+                          { return distances[a] < distances[b]; });
+
+        size_t num_failed = 0;
+        for (size_t n = 0; n < k_; n++)
+        {
+            num_failed += failed_[order[n]] ? 1 : 0;
+        }
+        return static_cast<double>(num_failed) / k_;
+    }
+
+    /**
+     * @brief Get the number of observations.
+     * @return The number of outcomes added.
+     */
+    size_t getNumObservations() const
+    {
+        return points_.size();
+    }
+
+private:
+    size_t k_;
+    size_t min_observations_;
+    std::vector<std::vector<double>> points_;
+    std::vector<bool> failed_;
+};
+
+/**
+ * @struct FailurePredictionStatistics
+ * @brief Confusion counts of failure predictions against the outcomes of the evaluations.
+ */
+struct FailurePredictionStatistics
+{
+    size_t true_positives = 0;  ///< Predicted to fail and failed.
+    size_t false_positives = 0; ///< Predicted to fail but succeeded.
+    size_t false_negatives = 0; ///< Predicted to succeed but failed.
+    size_t true_negatives = 0;  ///< Predicted to succeed and succeeded.
+
+    /**
+     * @brief Add the outcome of a prediction.
+     * @param predicted_failure Whether the evaluation was predicted to fail.
+     * @param failed Whether the evaluation failed.
+     */
+    void add(bool predicted_failure, bool failed)
+    {
+        if (predicted_failure)
+        {
+            (failed ? true_positives : false_positives)++;
+        }
+        else
+        {
+            (failed ? false_negatives : true_negatives)++;
+        }
+    }
+
+    /**
+     * @brief Get the precision of the failure predictions.
+     * @return The fraction of predicted failures that failed, NaN if no failure was predicted.
+     */
+    double getPrecision() const
+    {
+        size_t predicted = true_positives + false_positives;
+        return predicted > 0 ? static_cast<double>(true_positives) / predicted : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    /**
+     * @brief Get the recall of the failure predictions.
+     * @return The fraction of failures that were predicted, NaN if no evaluation failed.
+     */
+    double getRecall() const
+    {
+        size_t failed = true_positives + false_negatives;
+        return failed > 0 ? static_cast<double>(true_positives) / failed : std::numeric_limits<double>::quiet_NaN();
+    }
+};
+
+#endif // FAILURE_PREDICTOR_HH
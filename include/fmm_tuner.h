@@ -0,0 +1,107 @@
+#ifndef FMM_TUNER_H
+#define FMM_TUNER_H
+
+#include "parameter_search.h"
+
+/**
+ * @class FmmTuner
+ * @brief Class for finding the fastest FMM settings that reproduce a high-accuracy reference within a tolerance.
+ *
+ * The input parameters are the FMM settings to be tuned, see `InputFmmSetting`. First the reference configuration (e.g. a high 'num_exp') is evaluated,
+ * then every configuration of the grid over the settings. Each is timed and compared to the reference: the error is the largest absolute (or relative,
+ * see the constructor) deviation of an output criterion from its reference value, e.g. of the multipoles for the harmonics calculation or of
+ * `OutputMaxVonMises` for the mesh calculation. Configurations are evaluated serially, so the runtimes are comparable; workers are not used.
+ * Every evaluation is written to the output file in the same format as the grid search, the index column holds the evaluation number (0 is the reference).
+ * Runtimes and errors are written to a second file with the suffix `_tuning.csv`. The step and time budgets apply.
+ */
+class FmmTuner : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct a FmmTuner object.
+     * @param fmmSettings The FMM settings to be tuned with their candidate values, usually `InputFmmSetting` objects.
+     * @param outputCriteria The output criteria the accuracy is measured on.
+     * @param modelHandler The model handler.
+     * @param reference_config The value of each FMM setting for the high-accuracy reference.
+     * @param tolerance The largest accepted deviation of a criterion from its reference value. Must be greater than 0.
+     * @param relative (Optional) Whether the tolerance is relative to the reference value. Default is false.
+     *
+     * Throws an exception if the size of the reference configuration does not match the number of FMM settings or the tolerance is not positive.
+     */
+    FmmTuner(std::vector<std::shared_ptr<InputParamRangeInterface>> fmmSettings, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, std::vector<Json::Value> reference_config, double tolerance, bool relative = false);
+
+    /**
+     * @brief Run the tuning.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory, the runtimes and errors to a second CSV next to it.
+     */
+    void run() override;
+
+    /**
+     * @brief Set the number of timed repetitions of each configuration.
+     * @param num_repeats The number of repetitions, the fastest counts. Must be at least 1. Default is 1.
+     */
+    void setNumRepeats(size_t num_repeats);
+
+    /**
+     * @brief Check whether the last run found settings that meet the tolerance.
+     * @return True if a configuration meets the tolerance.
+     */
+    bool hasMetTarget() const;
+
+    /**
+     * @brief Get the index of the fastest configuration that meets the tolerance.
+     * @return The index in the output file, or -1 if none meets the tolerance.
+     */
+    using ParameterSearch::getBestIndex;
+
+    /**
+     * @brief Get the fastest configuration that meets the tolerance.
+     * @return The value of each FMM setting, empty if none meets the tolerance.
+     */
+    using ParameterSearch::getBestConfiguration;
+
+    /**
+     * @brief Get the runtime of the fastest configuration that meets the tolerance.
+     * @return The runtime in seconds, infinity if none meets the tolerance.
+     */
+    double getBestRuntime() const;
+
+    /**
+     * @brief Get the runtime of the reference configuration.
+     * @return The runtime in seconds, NaN if the reference failed.
+     */
+    double getReferenceRuntime() const;
+
+    /**
+     * @brief Write a copy of the model with the fastest configuration that meets the tolerance.
+     * @param model_path The path of the copy.
+     *
+     * Throws an exception if no configuration met the tolerance.
+     */
+    void writeTunedModel(const std::filesystem::path &model_path);
+
+private:
+    /**
+     * @brief Evaluate and time a configuration.
+     * @param index The index written to the output file.
+     * @param config The configuration.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     * @param runtime The fastest runtime of the repetitions in seconds.
+     * @return The values of the output criteria. Throws an exception if the evaluation fails.
+     */
+    std::vector<double> evaluateTimed(size_t index, std::vector<Json::Value> &config, const std::vector<std::type_index> &required_calculations, double &runtime);
+
+    /**
+     * @brief Largest deviation of criterion values from the reference.
+     */
+    double getError(const std::vector<double> &values, const std::vector<double> &reference) const;
+
+    std::vector<Json::Value> reference_config_;
+    double tolerance_;
+    bool relative_;
+    size_t num_repeats_ = 1;
+    double reference_runtime_ = std::numeric_limits<double>::quiet_NaN();
+};
+
+#endif // FMM_TUNER_H
@@ -0,0 +1,184 @@
+#ifndef GAUSSIAN_PROCESS_HH
+#define GAUSSIAN_PROCESS_HH
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <armadillo>
+
+/**
+ * @class GaussianProcess
+ * @brief Gaussian process regression with a Matern 5/2 kernel.
+ *
+ * Surrogate model for the Bayesian optimizer. The training inputs are points of the unit cube, the training outputs are standardized internally.
+ * The length scale and the noise level are selected from a fixed grid by maximizing the log marginal likelihood, see `fit()`.
+ */
+class GaussianProcess
+{
+public:
+    /**
+     * @brief Fit the Gaussian process and select the hyperparameters.
+     * @param X The training inputs, one point per row.
+     * @param y The training outputs.
+     *
+     * Throws an exception if `X` and `y` do not match or if no hyperparameters yield a positive definite kernel matrix.
+     */
+    void fit(const arma::mat &X, const arma::vec &y)
+    {
+        static const double length_scales[] = {0.05, 0.1, 0.2, 0.4, 0.8, 1.6};
+        static const double noise_levels[] = {1e-6, 1e-4, 1e-2, 1e-1};
+
+        double best_lml = -std::numeric_limits<double>::infinity();
+        double best_length_scale = 0.0;
+        double best_noise = 0.0;
+        for (double length_scale : length_scales)
+        {
+            for (double noise : noise_levels)
+            {
+                if (fit(X, y, length_scale, noise) && log_marginal_likelihood_ > best_lml)
+                {
+                    best_lml = log_marginal_likelihood_;
+                    best_length_scale = length_scale;
+                    best_noise = noise;
+                }
+            }
+        }
+
+        if (!std::isfinite(best_lml) || !fit(X, y, best_length_scale, best_noise))
+        {
+            throw std::runtime_error("Gaussian process could not be fitted");
+        }
+    }
+
+    /**
+     * @brief Fit the Gaussian process with fixed hyperparameters.
+     * @param X The training inputs, one point per row.
+     * @param y The training outputs.
+     * @param length_scale The length scale of the kernel.
+     * @param noise The noise variance relative to the variance of the standardized outputs.
+     * @return True if the kernel matrix is positive definite.
+     *
+     * Throws an exception if `X` and `y` do not match.
+     */
+    bool fit(const arma::mat &X, const arma::vec &y, double length_scale, double noise)
+    {
+        if (X.n_rows != y.n_elem || X.n_rows == 0)
+        {
+            throw std::invalid_argument("Number of training inputs and outputs must match and be greater than 0");
+        }
+
+        X_ = X;
+        length_scale_ = length_scale;
+        noise_ = noise;
+
+        // Standardize the outputs
+        y_mean_ = arma::mean(y);
+        y_std_ = y.n_elem > 1 ? arma::stddev(y) : 0.0;
+        if (!(y_std_ > 0.0))
+        {
+            y_std_ = 1.0;
+        }
+        arma::vec y_standardized = (y - y_mean_) / y_std_;
+
+        // Cholesky factorization of the kernel matrix
+        arma::uword n = X.n_rows;
+        arma::mat K(n, n);
+        for (arma::uword i = 0; i < n; i++)
+        {
+            for (arma::uword j = 0; j <= i; j++)
+            {
+                K(i, j) = kernel(X.row(i), X.row(j));
+                K(j, i) = K(i, j);
+            }
+            K(i, i) += noise + JITTER;
+        }
+        if (!arma::chol(L_, K, "lower"))
+        {
+            return false;
+        }
+
+        alpha_ = arma::solve(arma::trimatu(L_.t()), arma::solve(arma::trimatl(L_), y_standardized));
+        log_marginal_likelihood_ = -0.5 * arma::dot(y_standardized, alpha_) - arma::sum(arma::log(L_.diag())) - 0.5 * n * std::log(2.0 * arma::datum::pi);
+        return true;
+    }
+
+    /**
+     * @brief Predict the mean and variance at a point.
+     * @param x The point.
+     * @param mean The predicted mean.
+     * @param variance The predicted variance of the latent function.
+     *
+     * Throws an exception if the Gaussian process has not been fitted.
+     */
+    void predict(const arma::rowvec &x, double &mean, double &variance) const
+    {
+        if (X_.n_rows == 0)
+        {
+            throw std::runtime_error("Gaussian process has not been fitted");
+        }
+
+        arma::vec k_star(X_.n_rows);
+        for (arma::uword i = 0; i < X_.n_rows; i++)
+        {
+            k_star(i) = kernel(x, X_.row(i));
+        }
+
+        arma::vec v = arma::solve(arma::trimatl(L_), k_star);
+        mean = y_mean_ + y_std_ * arma::dot(k_star, alpha_);
+        variance = std::max(1.0 - arma::dot(v, v), 0.0) * y_std_ * y_std_;
+    }
+
+    /**
+     * @brief Get the selected length scale.
+     * @return The length scale.
+     */
+    double getLengthScale() const
+    {
+        return length_scale_;
+    }
+
+    /**
+     * @brief Get the selected noise variance.
+     * @return The noise variance relative to the variance of the standardized outputs.
+     */
+    double getNoise() const
+    {
+        return noise_;
+    }
+
+    /**
+     * @brief Get the log marginal likelihood of the last fit.
+     * @return The log marginal likelihood.
+     */
+    double getLogMarginalLikelihood() const
+    {
+        return log_marginal_likelihood_;
+    }
+
+private:
+    static constexpr double JITTER = 1e-10;
+
+    /**
+     * @brief Matern 5/2 kernel with unit signal variance.
+     * @param a The first point.
+     * @param b The second point.
+     * @return The covariance of the points.
+     */
+    double kernel(const arma::rowvec &a, const arma::rowvec &b) const
+    {
+        double r = std::sqrt(5.0) * arma::norm(a - b) / length_scale_;
+        return (1.0 + r + r * r / 3.0) * std::exp(-r);
+    }
+
+    arma::mat X_;
+    arma::mat L_;
+    arma::vec alpha_;
+    double y_mean_ = 0.0;
+    double y_std_ = 1.0;
+    double length_scale_ = 1.0;
+    double noise_ = 0.0;
+    double log_marginal_likelihood_ = -std::numeric_limits<double>::infinity();
+};
+
+#endif // GAUSSIAN_PROCESS_HH
@@ -0,0 +1,86 @@
+#ifndef GEOMETRY_DATA_HANDLER_H
+#define GEOMETRY_DATA_HANDLER_H
+
+#include <vector>
+#include <utility>
+#include <limits>
+#include <armadillo>
+#include <calc_result_handler_base.h>
+#include <mesh_data_handler.h>
+#include <rat/models/modelgroup.hh>
+#include <rat/models/modelcoil.hh>
+
+/**
+ * @class GeometryDataHandler
+ * @brief Calculation result handler for the geometry of the model, without any field or stress calculation.
+ *
+ * The coil meshes of the model tree are built (paths and cross sections, with the transformations of the model tree) to get the extents of the conductor.
+ * The conductor length is the length of the input paths of the coils. Use this handler for criteria that only depend on the geometry, e.g. `OutputMaxZ`,
+ * the mesh calculation (`CCTools::MeshDataHandler`) is orders of magnitude more expensive.
+ */
+class GeometryDataHandler : public CCTools::CalcResultHandlerBase
+{
+public:
+    GeometryDataHandler() = default;
+
+    /**
+     * @brief Construct a GeometryDataHandler object from a model tree.
+     * @param model_tree The model tree, e.g. from `CCTools::ModelCalculator::get_model_tree()`.
+     *
+     * Throws an exception if the model tree contains no enabled meshes.
+     */
+    GeometryDataHandler(const rat::mdl::ShModelGroupPr &model_tree);
+
+    /**
+     * @brief Add the nodes of a conductor mesh.
+     * @param nodes The coordinates of the nodes (m), one node per column.
+     */
+    void addNodes(const arma::Mat<double> &nodes);
+
+    /**
+     * @brief Add the length of a conductor.
+     * @param length The length (m).
+     */
+    void addConductorLength(double length);
+
+    /**
+     * @brief Get the min and max z coordinate of the conductor.
+     * @return The min and max z value (m).
+     *
+     * Throws an exception if no nodes have been added.
+     */
+    std::pair<double, double> getMinMaxZValues() const;
+
+    /**
+     * @brief Get the bounding box of the conductor.
+     * @return The axis-aligned bounding box (m).
+     *
+     * Throws an exception if no nodes have been added.
+     */
+    CCTools::Cube3D getBoundingBox() const;
+
+    /**
+     * @brief Get the total conductor length.
+     * @return The sum of the lengths of the conductors (m).
+     */
+    double getConductorLength() const;
+
+private:
+    /**
+     * @brief Add the lengths of the input paths of the enabled coils of a model tree.
+     */
+    void addCoilLengths(const rat::mdl::ShModelPr &model);
+
+    /**
+     * @brief Length of a polyline.
+     * @param coords The coordinates of the points (m), one point per column.
+     */
+    static double getPolylineLength(const arma::Mat<double> &coords);
+
+    double min_[3] = {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+    double max_[3] = {-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    size_t num_nodes_ = 0;
+    double conductor_length_ = 0.0;
+};
+
+#endif // GEOMETRY_DATA_HANDLER_H
@@ -0,0 +1,83 @@
+#ifndef GRADIENT_OPTIMIZER_H
+#define GRADIENT_OPTIMIZER_H
+
+#include "parameter_search.h"
+#include "optimization_objective.hh"
+#include "lbfgsb.hh"
+
+/**
+ * @class GradientOptimizer
+ * @brief Class for minimizing a smooth objective of the output criteria with L-BFGS-B and finite difference gradients.
+ *
+ * The input parameters are treated as continuous variables bounded by their ranges and sampled with `ParamRange::sample()`,
+ * so the inputs must be constructed with linear or geometric ranges, e.g. `InputLayerPitch` with a `LinearParamRange`. Discrete ranges have a zero gradient almost everywhere and are rejected.
+ * Minimizes the penalized objective, see `OptimizationObjective::getPenalizedValue()`, with `LBFGSB`. The 2n perturbed configurations of a gradient
+ * and the backtracking steps of the line search are evaluated as batches, i.e. in parallel if workers are set, see `ParameterSearch::setNumWorkers()`.
+ * Every evaluation is written to the output file in the same format as the grid search, the index column holds the evaluation number.
+ * The optimization stops when it has converged or the evaluation budget does not allow the next batch. The step and time budgets of the parameter search apply as well.
+ */
+class GradientOptimizer : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct a GradientOptimizer object.
+     * @param inputParamsRanges The input parameter ranges.
+     * @param outputCriteria The output criteria.
+     * @param modelHandler The model handler.
+     * @param objective The objective to be minimized.
+     * @param max_evaluations The evaluation budget. Must be greater than 0.
+     *
+     * Throws an exception if the objective refers to output criteria that do not exist or if an input parameter has a discrete range, see `ParamRange::isContinuous()`.
+     */
+    GradientOptimizer(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, OptimizationObjective objective, size_t max_evaluations);
+
+    /**
+     * @brief Run the optimization.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory.
+     */
+    void run() override;
+
+    /**
+     * @brief Set the start configuration.
+     * @param config The value of each input parameter, in the units of the output file.
+     *
+     * Default is the center of the parameter ranges. Throws an exception if the number of values does not match the number of input parameters
+     * or if a value is not part of a discrete parameter range.
+     */
+    using ParameterSearch::setStartConfiguration;
+
+    /**
+     * @brief Set the initial finite difference perturbation of an input parameter.
+     * @param input_index The position of the input parameter.
+     * @param step The perturbation relative to the parameter range, at most 0.1. Default is 1e-3.
+     *
+     * The perturbation is adapted to the numerical noise of the objective during the run.
+     */
+    void setFiniteDifferenceStep(size_t input_index, double step);
+
+    /**
+     * @brief Set the absolute noise level of the objective.
+     * @param noise_level The noise level, e.g. from a previous run. By default the noise level is estimated from a few evaluations at the start.
+     */
+    void setNoiseLevel(double noise_level);
+
+    /**
+     * @brief Get the index of the best configuration of the last run.
+     * @return The index in the output file, or -1 if no evaluation succeeded.
+     */
+    using ParameterSearch::getBestIndex;
+
+    /**
+     * @brief Get the penalized objective of the best configuration of the last run.
+     * @return The value of the penalized objective, infinity if no evaluation succeeded.
+     */
+    using ParameterSearch::getBestObjective;
+
+private:
+    OptimizationObjective objective_;
+    size_t max_evaluations_;
+    LBFGSB lbfgsb_;
+};
+
+#endif // GRADIENT_OPTIMIZER_H
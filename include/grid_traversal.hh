@@ -0,0 +1,373 @@
+#ifndef GRID_TRAVERSAL_HH
+#define GRID_TRAVERSAL_HH
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+
+/**
+ * @enum TraversalOrder
+ * @brief Enum for the order in which the steps of a grid search are visited.
+ *
+ * LEXICOGRAPHIC visits the grid in plain mixed-radix order, i.e. the last input parameter changes fastest.
+ * GRAY_CODE visits the grid in reflected mixed-radix Gray code order, i.e. consecutive steps differ in exactly one input parameter by one range position.
+ * COARSE_TO_FINE visits the grid in refinement levels. Each parameter range is ordered by bisection: both ends first, then the van der Corput sequence.
+ * Level `l` adds all grid points whose positions are among the first 2^l + 1 positions of every range, so level 0 is the corners of the grid.
+ * Any prefix of the traversal thus covers the whole parameter space evenly.
+ */
+enum TraversalOrder
+{
+    LEXICOGRAPHIC,
+    GRAY_CODE,
+    COARSE_TO_FINE
+};
+
+// To string function for TraversalOrder that returns the string representation of the enum value
+inline std::string to_string(TraversalOrder order)
+{
+    switch (order)
+    {
+    case LEXICOGRAPHIC:
+        return "LEXICOGRAPHIC";
+    case GRAY_CODE:
+        return "GRAY_CODE";
+    case COARSE_TO_FINE:
+        return "COARSE_TO_FINE";
+    default:
+        throw std::invalid_argument("Invalid TraversalOrder value");
+    }
+}
+
+/**
+ * @class GridTraversal
+ * @brief Class for mapping the steps of a grid search to positions in the parameter ranges.
+ *
+ * The grid is spanned by the parameter ranges with the given sizes. Every grid point has a canonical grid index, which is its
+ * position in plain mixed-radix (lexicographic) order. The traversal order only changes the order in which grid points are visited,
+ * the canonical grid index of a grid point is the same for every traversal order.
+ * Sizes and strides are computed once on construction.
+ */
+class GridTraversal
+{
+public:
+    /**
+     * @brief Construct a GridTraversal object.
+     * @param sizes The number of values of each parameter range.
+     * @param order The traversal order. Default is LEXICOGRAPHIC.
+     *
+     * Throws an exception if `sizes` is empty or if the number of grid points exceeds the range of size_t.
+     */
+    GridTraversal(std::vector<size_t> sizes, TraversalOrder order = LEXICOGRAPHIC) : sizes_(sizes), order_(order)
+    {
+        if (sizes_.empty())
+        {
+            throw std::invalid_argument("sizes cannot be empty");
+        }
+
+        // An empty range yields no grid points
+        size_t n = sizes_.size();
+        bool has_empty_range = std::find(sizes_.begin(), sizes_.end(), 0) != sizes_.end();
+
+        // Calculate strides and total number of steps with overflow detection
+        strides_.resize(n);
+        strides_[n - 1] = 1;
+        for (size_t i = n - 1; i > 0; --i)
+        {
+            strides_[i - 1] = has_empty_range ? 0 : checkedMultiply(sizes_[i], strides_[i]);
+        }
+        num_steps_ = has_empty_range ? 0 : checkedMultiply(sizes_[0], strides_[0]);
+
+        if (order_ == COARSE_TO_FINE && num_steps_ > 0)
+        {
+            setupCoarseToFine();
+        }
+    }
+
+    /**
+     * @brief Get the number of steps of the traversal.
+     * @return The number of grid points.
+     */
+    size_t getNumSteps() const
+    {
+        return num_steps_;
+    }
+
+    /**
+     * @brief Get the traversal order.
+     * @return The traversal order.
+     */
+    TraversalOrder getOrder() const
+    {
+        return order_;
+    }
+
+    /**
+     * @brief Get the positions in the parameter ranges for a step.
+     * @param step_num The step number (0-indexed) in traversal order.
+     * @return The position in each parameter range.
+     *
+     * Throws an exception if `step_num` exceeds the number of steps.
+     */
+    std::vector<size_t> getIndices(size_t step_num) const
+    {
+        if (step_num >= num_steps_)
+        {
+            throw std::out_of_range("step_num exceeds total configurations");
+        }
+
+        if (order_ == COARSE_TO_FINE)
+        {
+            return getCoarseToFineIndices(step_num);
+        }
+
+        std::vector<size_t> indices(sizes_.size());
+        for (size_t i = 0; i < sizes_.size(); ++i)
+        {
+            // Number formed by the digits 0..i in mixed-radix representation
+            size_t prefix = step_num / strides_[i];
+            indices[i] = prefix % sizes_[i];
+
+            // Reflect the digit if the digits before it have rolled over an odd number of times
+            if (order_ == GRAY_CODE && (prefix / sizes_[i]) % 2 == 1)
+            {
+                indices[i] = sizes_[i] - 1 - indices[i];
+            }
+        }
+
+        return indices;
+    }
+
+    /**
+     * @brief Get the canonical grid index of a grid point.
+     * @param indices The position in each parameter range.
+     * @return The canonical (lexicographic) grid index.
+     */
+    size_t getGridIndex(const std::vector<size_t> &indices) const
+    {
+        if (indices.size() != sizes_.size())
+        {
+            throw std::invalid_argument("Number of indices does not match the number of parameter ranges");
+        }
+
+        size_t grid_index = 0;
+        for (size_t i = 0; i < sizes_.size(); ++i)
+        {
+            grid_index += indices[i] * strides_[i];
+        }
+        return grid_index;
+    }
+
+    /**
+     * @brief Get the bisection order of the positions of a range.
+     * @param size The number of values of the range.
+     * @return The positions of the range in bisection order.
+     *
+     * The k-th point of the bisection sequence (0, 1, then the van der Corput sequence in base 2 from 1/2) is scaled to the range and rounded
+     * to the nearest position. Positions are listed in order of their first appearance, so both ends come first and the next positions are spread evenly over the range.
+     */
+    static std::vector<size_t> getBisectionOrder(size_t size)
+    {
+        std::vector<size_t> order;
+        std::vector<bool> visited(size, false);
+        order.reserve(size);
+
+        for (size_t k = 0; order.size() < size; k++)
+        {
+            size_t position = static_cast<size_t>(bisectionPoint(k) * (size - 1) + 0.5);
+            if (!visited[position])
+            {
+                visited[position] = true;
+                order.push_back(position);
+            }
+        }
+
+        return order;
+    }
+
+private:
+    /**
+     * @brief Multiply two sizes with overflow detection.
+     * @param a The first factor.
+     * @param b The second factor.
+     * @return The product.
+     *
+     * Throws an exception if the product exceeds the range of size_t.
+     */
+    static size_t checkedMultiply(size_t a, size_t b)
+    {
+        if (a != 0 && b > std::numeric_limits<size_t>::max() / a)
+        {
+            throw std::overflow_error("Number of grid points exceeds the range of size_t");
+        }
+        return a * b;
+    }
+
+    /**
+     * @brief Get the k-th element of the van der Corput sequence in base 2.
+     * @param k The index of the element.
+     * @return The element in [0, 1).
+     */
+    static double vanDerCorput(size_t k)
+    {
+        double value = 0.0;
+        double denominator = 1.0;
+        while (k > 0)
+        {
+            denominator *= 2.0;
+            value += static_cast<double>(k % 2) / denominator;
+            k /= 2;
+        }
+        return value;
+    }
+
+    /**
+     * @brief Get the k-th point of the bisection sequence.
+     * @param k The index of the point.
+     * @return 0 and 1 for the first two points, the van der Corput element k - 1 for the others.
+     */
+    static double bisectionPoint(size_t k)
+    {
+        if (k < 2)
+        {
+            return static_cast<double>(k);
+        }
+        return vanDerCorput(k - 1);
+    }
+
+    /**
+     * @brief Precompute the van der Corput orders and refinement levels for COARSE_TO_FINE.
+     *
+     * For every range, the number of positions within each level is the number of distinct positions among the first 2^l + 1 bisection points.
+     */
+    void setupCoarseToFine()
+    {
+        size_t n = sizes_.size();
+        range_orders_.resize(n);
+        level_counts_.resize(n);
+
+        size_t num_levels = 1;
+        for (size_t i = 0; i < n; ++i)
+        {
+            range_orders_[i] = getBisectionOrder(sizes_[i]);
+
+            // Count the distinct positions among the first 2^l + 1 bisection points
+            std::vector<bool> visited(sizes_[i], false);
+            size_t num_visited = 0;
+            size_t num_elements = 0;
+            for (size_t level = 0; num_visited < sizes_[i]; level++)
+            {
+                for (; num_elements < (size_t(1) << level) + 1; num_elements++)
+                {
+                    size_t position = static_cast<size_t>(bisectionPoint(num_elements) * (sizes_[i] - 1) + 0.5);
+                    if (!visited[position])
+                    {
+                        visited[position] = true;
+                        num_visited++;
+                    }
+                }
+                level_counts_[i].push_back(num_visited);
+            }
+            num_levels = std::max(num_levels, level_counts_[i].size());
+        }
+
+        // Number of grid points up to and including each level
+        level_ends_.resize(num_levels);
+        for (size_t level = 0; level < num_levels; ++level)
+        {
+            level_ends_[level] = 1;
+            for (size_t i = 0; i < n; ++i)
+            {
+                level_ends_[level] *= getLevelCount(i, level);
+            }
+        }
+    }
+
+    /**
+     * @brief Get the number of positions of a range within a refinement level.
+     * @param i The index of the range.
+     * @param level The refinement level.
+     * @return The number of positions.
+     */
+    size_t getLevelCount(size_t i, size_t level) const
+    {
+        return level < level_counts_[i].size() ? level_counts_[i][level] : sizes_[i];
+    }
+
+    /**
+     * @brief Get the positions in the parameter ranges for a step in COARSE_TO_FINE order.
+     * @param step_num The step number (0-indexed).
+     * @return The position in each parameter range.
+     *
+     * The grid points added in level `l` are split into disjoint blocks by the first range `j` whose rank is new in level `l`:
+     * ranges before `j` are restricted to ranks of level `l-1`, range `j` to the new ranks of level `l`, ranges after `j` to ranks of level `l`.
+     * Level 0 is treated as refining an empty level, so its only block is the corners of the grid.
+     * Within a block, the ranks are enumerated in mixed-radix order.
+     */
+    std::vector<size_t> getCoarseToFineIndices(size_t step_num) const
+    {
+        size_t n = sizes_.size();
+        std::vector<size_t> ranks(n, 0);
+
+        // Find the level of the step
+        size_t level = 0;
+        while (step_num >= level_ends_[level])
+        {
+            level++;
+        }
+
+        // Level 0 refines an empty level
+        size_t offset = level > 0 ? step_num - level_ends_[level - 1] : step_num;
+        auto previous_count = [&](size_t i)
+        {
+            return level > 0 ? getLevelCount(i, level - 1) : 0;
+        };
+
+        // Find the block of the step
+        for (size_t j = 0; j < n; ++j)
+        {
+            std::vector<size_t> low(n), high(n);
+            size_t block_size = 1;
+            for (size_t i = 0; i < n; ++i)
+            {
+                low[i] = (i == j) ? previous_count(i) : 0;
+                high[i] = (i < j) ? previous_count(i) : getLevelCount(i, level);
+                block_size *= high[i] - low[i];
+            }
+
+            if (offset < block_size)
+            {
+                // Enumerate the block in mixed-radix order
+                for (size_t i = n; i > 0; --i)
+                {
+                    size_t extent = high[i - 1] - low[i - 1];
+                    ranks[i - 1] = low[i - 1] + offset % extent;
+                    offset /= extent;
+                }
+                break;
+            }
+            offset -= block_size;
+        }
+
+        // Map the ranks to positions in the ranges
+        std::vector<size_t> indices(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            indices[i] = range_orders_[i][ranks[i]];
+        }
+        return indices;
+    }
+
+    std::vector<size_t> sizes_;
+    std::vector<size_t> strides_;
+    size_t num_steps_;
+    TraversalOrder order_;
+
+    // Precomputed data for COARSE_TO_FINE
+    std::vector<std::vector<size_t>> range_orders_;
+    std::vector<std::vector<size_t>> level_counts_;
+    std::vector<size_t> level_ends_;
+};
+
+#endif // GRID_TRAVERSAL_HH
@@ -0,0 +1,102 @@
+#ifndef HARMONIC_CORRECTION_H
+#define HARMONIC_CORRECTION_H
+
+#include "parameter_search.h"
+#include "linear_response.hh"
+
+/**
+ * @class HarmonicCorrection
+ * @brief Class for cancelling unwanted harmonics by solving a linear response model of the multipoles.
+ *
+ * The multipoles respond almost linearly to the scaling function values of custom CCT harmonics, see `InputMultipoleScaling`.
+ * The Jacobian of the corrected output criteria with respect to the correction inputs is measured with forward differences; the reference configuration
+ * and the n perturbed ones are evaluated as one batch, i.e. in parallel if workers are set, see `ParameterSearch::setNumWorkers()`.
+ * The correction inputs that bring the linear model to the targets (least squares if there are more criteria than inputs) are then verified with one more evaluation.
+ * Only if a criterion is still off by more than the tolerance, the Jacobian is measured again around the best configuration.
+ * The Jacobian is kept between runs, so a second run (e.g. after changing other parameters of the model) starts with the solve, see `resetJacobian()`.
+ *
+ * All output criteria must be computable from the harmonics calculation alone, so every evaluation is a harmonics-only calculation.
+ * The correction inputs are treated as continuous between the bounds of their ranges, the other input parameters are held at the start configuration.
+ * Every evaluation is written to the output file in the same format as the grid search, the index column holds the evaluation number.
+ */
+class HarmonicCorrection : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct a HarmonicCorrection object.
+     * @param inputParamsRanges The input parameter ranges.
+     * @param outputCriteria The output criteria. Must only require the harmonics calculation.
+     * @param modelHandler The model handler.
+     * @param correction_inputs The positions of the input parameters used for the correction, e.g. `InputMultipoleScaling` parameters.
+     * @param corrected_criteria The positions of the output criteria to be corrected, e.g. `OutputBMultipole` criteria.
+     * @param tolerance The accepted absolute deviation of each corrected criterion from its target. Must be greater than 0.
+     * @param max_evaluations The evaluation budget. Must be greater than 0.
+     *
+     * Throws an exception if the positions do not exist or repeat, if a correction input has a discrete range (see `ParamRange::isContinuous()`),
+     * or if an output criterion requires another calculation than the harmonics.
+     */
+    HarmonicCorrection(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, std::vector<size_t> correction_inputs, std::vector<size_t> corrected_criteria, double tolerance, size_t max_evaluations);
+
+    /**
+     * @brief Run the correction.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory.
+     */
+    void run() override;
+
+    /**
+     * @brief Set the targets of the corrected criteria.
+     * @param targets The target of each corrected criterion, in the order of `corrected_criteria`. Default is 0 for all.
+     */
+    void setTargets(const std::vector<double> &targets);
+
+    /**
+     * @brief Set the perturbation of the finite differences.
+     * @param relative_step The perturbation of each correction input relative to the width of its range. Default is 0.05.
+     */
+    void setRelativeStep(double relative_step);
+
+    /**
+     * @brief Set the start configuration.
+     * @param config The value of each input parameter, in the units of the output file.
+     *
+     * Default is the center of the parameter ranges. Throws an exception if the number of values does not match the number of input parameters
+     * or if a value is not part of a discrete parameter range.
+     */
+    using ParameterSearch::setStartConfiguration;
+
+    /**
+     * @brief Discard the Jacobian, so the next run measures it again.
+     */
+    void resetJacobian();
+
+    /**
+     * @brief Check whether the last run reached all targets within the tolerance.
+     * @return True if all targets were reached.
+     */
+    bool hasConverged() const;
+
+    /**
+     * @brief Get the index of the corrected configuration of the last run.
+     * @return The index in the output file of the configuration closest to the targets, or -1 if no evaluation succeeded.
+     */
+    long getSolutionIndex() const;
+
+    /**
+     * @brief Get the corrected configuration of the last run.
+     * @return The value of each input parameter, empty if no evaluation succeeded.
+     */
+    std::vector<Json::Value> getSolution() const;
+
+private:
+    std::vector<size_t> correction_inputs_;
+    std::vector<size_t> corrected_criteria_;
+    std::vector<double> targets_;
+    double tolerance_;
+    size_t max_evaluations_;
+    double relative_step_ = 0.05;
+    LinearResponse response_;
+    bool converged_ = false;
+};
+
+#endif // HARMONIC_CORRECTION_H
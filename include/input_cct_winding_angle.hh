@@ -21,11 +21,7 @@ public:
      * Values are to be provided in [deg] and will be converted to [rad] in the JSON file.
      */
     InputCCTWindingAngle(std::string JSON_name, std::vector<Json::Value> value_range, std::string column_name_suffix="") {
-        column_name_ = "cct_winding_angle" + column_name_suffix;
-
-        JSON_name_ = JSON_name;
-        JSON_children_ = {"rho"};
-        JSON_target_ = "alpha"; // unit of field is rad
+        setup(JSON_name, column_name_suffix);
         
         range_ = value_range;
 
@@ -35,7 +31,33 @@ public:
         }
     }
 
+    /**
+     * @brief Construct a InputCCTWindingAngle object with a lazy range.
+     * @param JSON_name The 'name' field of the custom CCT object (rat::mdl::pathcctcustom).
+     * @param value_range The lazy range of the winding angle (deg)
+     * @param column_name_suffix The suffix to be added to the column name in the output file. Default column name is 'cct_winding_angle'.
+     * 
+     * Values are produced on demand and converted to [rad] when they are produced.
+     */
+    InputCCTWindingAngle(std::string JSON_name, std::shared_ptr<ParamRange> value_range, std::string column_name_suffix="") {
+        setup(JSON_name, column_name_suffix);
+
+        // Convert range to rad
+        param_range_ = std::make_shared<ScaledParamRange>(value_range, PI / 180.0);
+    }
+
 private:
+    /**
+     * @brief Setup function called by constructors.
+     */
+    void setup(std::string JSON_name, std::string column_name_suffix) {
+        column_name_ = "cct_winding_angle" + column_name_suffix;
+
+        JSON_name_ = JSON_name;
+        JSON_children_ = {"rho"};
+        JSON_target_ = "alpha"; // unit of field is rad
+    }
+
     static constexpr double PI = 3.14159265358979323846;
 };
 
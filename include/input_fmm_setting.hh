@@ -0,0 +1,56 @@
+#ifndef INPUT_FMM_SETTING_HH
+#define INPUT_FMM_SETTING_HH
+
+#include "input_param_range_interface.h"
+#include <json/json.h>
+
+/**
+ * @class InputFmmSetting
+ * @brief Class for defining one FMM setting of a calculation as an input parameter, e.g. to trade accuracy against runtime.
+ */
+class InputFmmSetting : public InputParamRangeInterface
+{
+public:
+    /**
+     * @brief Construct a InputFmmSetting object.
+     * @param JSON_name The 'name' field of the calculation (e.g. rat::mdl::calcharmonics, rat::mdl::calcmesh).
+     * @param setting The field of the FMM settings of the calculation (rat::fmm::settings), e.g. 'num_exp', 'num_refine' or 'max_levels'.
+     * @param value_range The range of the setting, in the type of the field (integer for 'num_exp' and 'max_levels').
+     * @param column_name_suffix The suffix to be added to the column name in the output file. Default column name is 'fmm_`setting`'.
+     */
+    InputFmmSetting(std::string JSON_name, std::string setting, std::vector<Json::Value> value_range, std::string column_name_suffix = "")
+    {
+        setup(JSON_name, setting, column_name_suffix);
+
+        range_ = value_range;
+    }
+
+    /**
+     * @brief Construct a InputFmmSetting object with a lazy range.
+     * @param JSON_name The 'name' field of the calculation (e.g. rat::mdl::calcharmonics, rat::mdl::calcmesh).
+     * @param setting The field of the FMM settings of the calculation (rat::fmm::settings), e.g. 'num_exp', 'num_refine' or 'max_levels'.
+     * @param value_range The lazy range of the setting.
+     * @param column_name_suffix The suffix to be added to the column name in the output file. Default column name is 'fmm_`setting`'.
+     */
+    InputFmmSetting(std::string JSON_name, std::string setting, std::shared_ptr<ParamRange> value_range, std::string column_name_suffix = "")
+    {
+        setup(JSON_name, setting, column_name_suffix);
+
+        param_range_ = value_range;
+    }
+
+private:
+    /**
+     * @brief Setup function called by constructors.
+     */
+    void setup(std::string JSON_name, std::string setting, std::string column_name_suffix)
+    {
+        column_name_ = "fmm_" + setting + column_name_suffix;
+
+        JSON_name_ = JSON_name;
+        JSON_children_ = {"stngs"};
+        JSON_target_ = setting;
+    }
+};
+
+#endif // INPUT_FMM_SETTING_HH
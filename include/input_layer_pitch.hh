@@ -21,11 +21,7 @@ public:
      * Values are to be provided in [mm] and will be converted to [m] in the JSON file.
      */
     InputLayerPitch(std::string JSON_name, std::vector<Json::Value> value_range, std::string column_name_suffix="") {
-        column_name_ = "layer_pitch" + column_name_suffix;
-
-        JSON_name_ = JSON_name;
-        JSON_children_ = {"omega"};
-        JSON_target_ = "scaling"; // unit of field is m
+        setup(JSON_name, column_name_suffix);
         
         range_ = value_range;
 
@@ -35,6 +31,33 @@ public:
         }
     }
 
+    /**
+     * @brief Construct a InputLayerPitch object with a lazy range.
+     * @param JSON_name The 'name' field of the custom CCT object (rat::mdl::pathcctcustom).
+     * @param value_range The lazy range of pitch [mm].
+     * @param column_name_suffix The suffix to be added to the column name in the output file. Default column name is 'layer_pitch'.
+     * 
+     * Values are produced on demand and converted to [m] when they are produced.
+     */
+    InputLayerPitch(std::string JSON_name, std::shared_ptr<ParamRange> value_range, std::string column_name_suffix="") {
+        setup(JSON_name, column_name_suffix);
+
+        // Convert range to m
+        param_range_ = std::make_shared<ScaledParamRange>(value_range, 1.0 / 1000.0);
+    }
+
+private:
+    /**
+     * @brief Setup function called by constructors.
+     */
+    void setup(std::string JSON_name, std::string column_name_suffix) {
+        column_name_ = "layer_pitch" + column_name_suffix;
+
+        JSON_name_ = JSON_name;
+        JSON_children_ = {"omega"};
+        JSON_target_ = "scaling"; // unit of field is m
+    }
+
 };
 
 #endif // INPUT_LAYER_PITCH_HH
\ No newline at end of file
@@ -51,6 +51,32 @@ public:
      * Values are to be provided in [m] or [m/coil], depending on the type of target.
      */
     InputMultipoleScaling(std::string multipole, std::string JSON_name, HarmonicScalingFunctionTarget scaling_function_target, std::vector<Json::Value> value_range, std::string column_name_suffix="") {
+        setup(multipole, JSON_name, scaling_function_target, column_name_suffix);
+        
+        range_ = value_range;
+    }
+
+    /**
+     * @brief Construct a InputMultipoleScaling object with a lazy range.
+     * @param multipole The type of multipole in the format 'a1', 'b10', etc.
+     * @param JSON_name The 'name' field of the custom CCT harmonic (rat::mdl::cctharmonicdrive).
+     * @param scaling_function_target The targeted scaling function value of the custom harmonic.
+     * @param value_range The lazy range of the targeted value [m] or [m/coil].
+     * @param column_name_suffix The suffix to be added to the column name in the output file. Default column name is `multipole` + `scaling_function_target`.
+     * 
+     * Values are produced on demand.
+     */
+    InputMultipoleScaling(std::string multipole, std::string JSON_name, HarmonicScalingFunctionTarget scaling_function_target, std::shared_ptr<ParamRange> value_range, std::string column_name_suffix="") {
+        setup(multipole, JSON_name, scaling_function_target, column_name_suffix);
+
+        param_range_ = value_range;
+    }
+
+private:
+    /**
+     * @brief Setup function called by constructors.
+     */
+    void setup(std::string multipole, std::string JSON_name, HarmonicScalingFunctionTarget scaling_function_target, std::string column_name_suffix) {
         column_name_ = multipole + "_" + to_string(scaling_function_target) + column_name_suffix;
 
 
@@ -70,8 +96,6 @@ public:
             default:
             throw std::invalid_argument("Invalid HarmonicScalingFunctionTarget value");
         }
-        
-        range_ = value_range;
     }
 
 };
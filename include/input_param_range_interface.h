@@ -4,8 +4,11 @@
 #include <vector>
 #include <string>
 #include <typeindex>
+#include <functional>
+#include <ostream>
 #include <json/json.h>
 #include <model_handler.h>
+#include "param_range.hh"
 
 /**
  * @interface InputParamRangeInterface
@@ -47,6 +50,36 @@ public:
         return value.asString();
     }
 
+    /**
+     * @brief Write a value of the input parameter to the output file.
+     * @param out The stream.
+     * @param value The value, an element of the range.
+     *
+     * Writes one cell per column of `getColumnName()`, each followed by a comma. Arrays and objects (e.g. the x vectors of `InputPathConnectV2UVW`)
+     * are written as compact JSON in one quoted cell, so the commas inside do not split the cell. Strings are quoted as well.
+     */
+    virtual void writeValue(std::ostream &out, const Json::Value &value){
+        if (!value.isArray() && !value.isObject() && !value.isString()) {
+            out << value << ",";
+            return;
+        }
+        std::string text;
+        if (value.isString()) {
+            text = value.asString();
+        }
+        else {
+            Json::StreamWriterBuilder builder;
+            builder["indentation"] = "";
+            text = Json::writeString(builder, value);
+        }
+        // Quotes inside a quoted cell are doubled
+        out << "\"";
+        for (char c : text) {
+            out << (c == '"' ? "\"\"" : std::string(1, c));
+        }
+        out << "\",";
+    }
+
     /**
      * @brief Get the column name of the input range.
      * @return The column name of the as a string.
@@ -63,11 +96,56 @@ public:
      * @return The range of the input parameter as a Json::Value vector.
      * 
      * Get the range of the input parameter as a Json::Value vector to be put into the respective JSON field for this parameter.
+     * Lazy ranges are materialized, use `getParamRange()` to access the values on demand.
      */
     virtual std::vector<Json::Value> getRange(){
+        if (param_range_ != nullptr) {
+            return param_range_->materialize();
+        }
         return range_;
     }
 
+    /**
+     * @brief Get the lazy range of the input parameter.
+     * @return The range of the input parameter as a ParamRange.
+     * 
+     * Get the range of the input parameter as a ParamRange that produces the values on demand.
+     * If the input parameter has been constructed with a Json::Value vector, the vector is wrapped in a ListParamRange.
+     */
+    virtual std::shared_ptr<ParamRange> getParamRange(){
+        if (param_range_ != nullptr) {
+            return param_range_;
+        }
+        return std::make_shared<ListParamRange>(range_);
+    }
+
+    /**
+     * @brief Set a feasibility predicate for the values of the input parameter.
+     * @param predicate Returns false for values that are known to fail, in the units of the model (the values of `getParamRange()`).
+     *
+     * Configurations with an infeasible value are pruned by the parameter search before they are applied to the model.
+     */
+    void setFeasibilityPredicate(std::function<bool(const Json::Value &)> predicate){
+        predicate_ = predicate;
+    }
+
+    /**
+     * @brief Check a value of the input parameter with the feasibility predicate.
+     * @param value The value, in the units of the model.
+     * @return False if the value is known to be infeasible, true if it is feasible or no predicate is set.
+     */
+    virtual bool isFeasible(const Json::Value &value){
+        return !predicate_ || predicate_(value);
+    }
+
+    /**
+     * @brief Check whether a feasibility predicate is set.
+     * @return True if values can be infeasible.
+     */
+    virtual bool hasFeasibilityPredicate(){
+        return static_cast<bool>(predicate_);
+    }
+
     /**
      * @brief Get the JSON name for the input parameter.
      * @return The JSON name for the input parameter as a string.
@@ -121,9 +199,11 @@ protected:
 
         std::string column_name_;
         std::vector<Json::Value> range_;
+        std::shared_ptr<ParamRange> param_range_ = nullptr; // lazy range, takes precedence over range_ if set
         std::string JSON_name_;
         std::vector<CCTools::JSONChildrenIdentifierType> JSON_children_;
         CCTools::JSONChildrenIdentifierType JSON_target_;
+        std::function<bool(const Json::Value &)> predicate_; // feasibility predicate, empty if all values are feasible
 
 };
 
@@ -24,6 +24,42 @@ public:
      * Values are to be provided in [mm] and will be converted to [m] in the JSON file.
      */
     InputPathConnectV2Value(std::string JSON_name, std::string control_point_group, size_t control_point_id, std::string control_point_dimension, std::vector<Json::Value> value_range, std::string column_name_suffix = "")
+    {
+        setup(JSON_name, control_point_group, control_point_id, control_point_dimension, column_name_suffix);
+
+        range_ = value_range;
+
+        // Convert range to m
+        for (size_t i = 0; i < range_.size(); i++)
+        {
+            range_[i] = range_[i].asDouble() / 1000.0;
+        }
+    }
+
+    /**
+     * @brief Construct a InputPathConnectV2Value object with a lazy range.
+     * @param JSON_name The 'name' field of the Path ConnectV2 object (rat::mdl::pathconnect2).
+     * @param control_point_group Group of desired control point. Either "start" or "end".
+     * @param control_point_id Id of the desired control point within the group.
+     * @param control_point_dimension Desired dimension within control point. Either "u", "v", or "w".
+     * @param value_range The lazy range of value [mm].
+     * @param column_name_suffix The suffix to be added to the column name in the output file. Default column name is 'pathconnectv2_`control_point_group`_`control_point_id`_`control_point_dimension`'.
+     *
+     * Values are produced on demand and converted to [m] when they are produced.
+     */
+    InputPathConnectV2Value(std::string JSON_name, std::string control_point_group, size_t control_point_id, std::string control_point_dimension, std::shared_ptr<ParamRange> value_range, std::string column_name_suffix = "")
+    {
+        setup(JSON_name, control_point_group, control_point_id, control_point_dimension, column_name_suffix);
+
+        // Convert range to m
+        param_range_ = std::make_shared<ScaledParamRange>(value_range, 1.0 / 1000.0);
+    }
+
+private:
+    /**
+     * @brief Setup function called by constructors.
+     */
+    void setup(std::string JSON_name, std::string control_point_group, size_t control_point_id, std::string control_point_dimension, std::string column_name_suffix)
     {
         column_name_ = "pathconnectv2_" + control_point_group + "_" + std::to_string(control_point_id) + "_" + control_point_dimension + column_name_suffix;
 
@@ -47,14 +83,6 @@ public:
             throw std::invalid_argument("control_point_dimension must be either 'u', 'v', or 'w'");
         }
         JSON_target_ = control_point_dimension; // unit of field is m
-
-        range_ = value_range;
-
-        // Convert range to m
-        for (size_t i = 0; i < range_.size(); i++)
-        {
-            range_[i] = range_[i].asDouble() / 1000.0;
-        }
     }
 };
 
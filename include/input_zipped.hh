@@ -0,0 +1,107 @@
+#ifndef INPUT_ZIPPED_HH
+#define INPUT_ZIPPED_HH
+
+#include "input_param_range_interface.h"
+#include <json/json.h>
+
+/**
+ * @class InputZipped
+ * @brief Class for input parameters whose ranges advance in lockstep, e.g. the pitch of the inner and outer layer.
+ *
+ * The zipped parameters form a single dimension of the search: the i-th configuration applies the i-th value of every range,
+ * so a grid over N values takes N steps instead of N^2. Each parameter keeps its own columns in the output file, see `writeValue()`.
+ */
+class InputZipped : public InputParamRangeInterface
+{
+public:
+    /**
+     * @brief Construct a InputZipped object.
+     * @param inputs The input parameters. Their ranges must have the same size.
+     *
+     * Throws an exception if fewer than two input parameters are given or the sizes of the ranges differ.
+     */
+    InputZipped(std::vector<std::shared_ptr<InputParamRangeInterface>> inputs) : inputs_(inputs)
+    {
+        if (inputs_.size() < 2)
+        {
+            throw std::invalid_argument("At least two input parameters must be zipped");
+        }
+
+        std::vector<std::shared_ptr<ParamRange>> ranges;
+        for (size_t i = 0; i < inputs_.size(); i++)
+        {
+            ranges.push_back(inputs_[i]->getParamRange());
+            column_name_ += (i > 0 ? "," : "") + inputs_[i]->getColumnName();
+        }
+        param_range_ = std::make_shared<ZippedParamRange>(ranges);
+
+        // The location of the first parameter identifies the group
+        JSON_name_ = inputs_[0]->getJSONName();
+        JSON_children_ = inputs_[0]->getJSONChildren();
+        JSON_target_ = inputs_[0]->getJSONTarget();
+    }
+
+    void applyParamConfig(CCTools::ModelHandler &model_handler, Json::Value value) override
+    {
+        for (size_t i = 0; i < inputs_.size(); i++)
+        {
+            inputs_[i]->applyParamConfig(model_handler, value[static_cast<Json::ArrayIndex>(i)]);
+        }
+    }
+
+    std::string getConfigAsString(Json::Value value) override
+    {
+        std::string config;
+        for (size_t i = 0; i < inputs_.size(); i++)
+        {
+            config += (i > 0 ? ", " : "") + inputs_[i]->getConfigAsString(value[static_cast<Json::ArrayIndex>(i)]);
+        }
+        return config;
+    }
+
+    void writeValue(std::ostream &out, const Json::Value &value) override
+    {
+        for (size_t i = 0; i < inputs_.size(); i++)
+        {
+            inputs_[i]->writeValue(out, value[static_cast<Json::ArrayIndex>(i)]);
+        }
+    }
+
+    bool isFeasible(const Json::Value &value) override
+    {
+        for (size_t i = 0; i < inputs_.size(); i++)
+        {
+            if (!inputs_[i]->isFeasible(value[static_cast<Json::ArrayIndex>(i)]))
+            {
+                return false;
+            }
+        }
+        return InputParamRangeInterface::isFeasible(value);
+    }
+
+    bool hasFeasibilityPredicate() override
+    {
+        for (const std::shared_ptr<InputParamRangeInterface> &input : inputs_)
+        {
+            if (input->hasFeasibilityPredicate())
+            {
+                return true;
+            }
+        }
+        return InputParamRangeInterface::hasFeasibilityPredicate();
+    }
+
+    /**
+     * @brief Get the zipped input parameters.
+     * @return The input parameters in the order of their columns.
+     */
+    std::vector<std::shared_ptr<InputParamRangeInterface>> getInputs()
+    {
+        return inputs_;
+    }
+
+private:
+    std::vector<std::shared_ptr<InputParamRangeInterface>> inputs_;
+};
+
+#endif // INPUT_ZIPPED_HH
@@ -0,0 +1,174 @@
+#ifndef ITERATION_OBSERVER_HH
+#define ITERATION_OBSERVER_HH
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <ostream>
+#include <limits>
+#include <iomanip>
+#include <stdexcept>
+#include <algorithm>
+
+/**
+ * @brief Structure holding the values of one optimizer iteration.
+ */
+struct OptimizerIterationValues
+{
+    int iter;     /**< Iteration number */
+    double fval;  /**< Function value */
+    double ercf;  /**< Edge regression constraint function value */
+    double lcf;   /**< Length constraint function value */
+    double ccf;   /**< Curvature constraint function value (valid if has_ccf is true) */
+    bool has_ccf; /**< Flag indicating if the curvature constraint value is valid */
+};
+
+/**
+ * @interface IterationObserver
+ * @brief Interface for receiving the values of optimizer iterations as numbers.
+ *
+ * An observer is notified once per completed optimizer iteration.
+ * Producers (e.g., `CustomIterationLog`) call `onIteration()` with the values of the iteration.
+ */
+class IterationObserver
+{
+public:
+    /**
+     * @brief Receive the values of one completed optimizer iteration.
+     * @param values The values of the iteration.
+     */
+    virtual void onIteration(const OptimizerIterationValues &values) = 0;
+
+    virtual ~IterationObserver() = default;
+};
+
+/**
+ * @class IterationHistory
+ * @brief Iteration observer that keeps the full iteration history in a preallocated buffer.
+ *
+ * The buffer is allocated once in the constructor. Recording an iteration does not allocate unless the capacity is exceeded,
+ * in which case the buffer grows geometrically.
+ */
+class IterationHistory : public IterationObserver
+{
+public:
+    /**
+     * @brief Construct an IterationHistory object.
+     * @param capacity The number of iterations to preallocate. Default is 1024.
+     */
+    explicit IterationHistory(size_t capacity = 1024) : buffer_(capacity), size_(0) {}
+
+    void onIteration(const OptimizerIterationValues &values) override
+    {
+        if (size_ == buffer_.size())
+        {
+            buffer_.resize(std::max<size_t>(1, 2 * buffer_.size()));
+        }
+        buffer_[size_++] = values;
+    }
+
+    /**
+     * @brief Get the number of recorded iterations.
+     * @return The number of recorded iterations.
+     */
+    size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Check whether no iteration has been recorded.
+     * @return True if no iteration has been recorded, false otherwise.
+     */
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Get the values of a recorded iteration.
+     * @param i The index of the recorded iteration (0-indexed, in recording order).
+     * @return The values of the iteration.
+     */
+    const OptimizerIterationValues &at(size_t i) const
+    {
+        if (i >= size_)
+        {
+            throw std::out_of_range("Iteration index exceeds the iteration history");
+        }
+        return buffer_[i];
+    }
+
+    /**
+     * @brief Get the values of the most recent iteration.
+     * @return The values of the most recent iteration.
+     */
+    const OptimizerIterationValues &last() const
+    {
+        if (size_ == 0)
+        {
+            throw std::out_of_range("Iteration history is empty");
+        }
+        return buffer_[size_ - 1];
+    }
+
+    /**
+     * @brief Clear the history without releasing the buffer.
+     */
+    void clear()
+    {
+        size_ = 0;
+    }
+
+    /**
+     * @brief Write the column names of the history CSV.
+     * @param os The output stream.
+     */
+    static void writeCSVHeader(std::ostream &os)
+    {
+        os << "iter,fval,ercf,lcf,ccf" << std::endl;
+    }
+
+    /**
+     * @brief Write the history as CSV rows.
+     * @param os The output stream.
+     * @param prefix (Optional) String to prepend to every row, e.g. the step index followed by a comma.
+     *
+     * Writes one row per iteration with the columns `iter,fval,ercf,lcf,ccf`. The `ccf` column is empty if no curvature constraint value was provided.
+     */
+    void writeCSV(std::ostream &os, const std::string &prefix = "") const
+    {
+        os << std::setprecision(std::numeric_limits<double>::max_digits10);
+        for (size_t i = 0; i < size_; i++)
+        {
+            const OptimizerIterationValues &values = buffer_[i];
+            os << prefix << values.iter << "," << values.fval << "," << values.ercf << "," << values.lcf << ",";
+            if (values.has_ccf)
+            {
+                os << values.ccf;
+            }
+            os << "\n";
+        }
+    }
+
+    /**
+     * @brief Export the history to a CSV file.
+     * @param path The path of the CSV file. The file is overwritten if it exists.
+     */
+    void exportToCSV(const std::string &path) const
+    {
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open iteration history file " + path);
+        }
+        writeCSVHeader(file);
+        writeCSV(file);
+    }
+
+private:
+    std::vector<OptimizerIterationValues> buffer_;
+    size_t size_;
+};
+
+#endif // ITERATION_OBSERVER_HH
@@ -2,9 +2,11 @@
 #define CCTSIM_JSON_RANGE_HH
 
 #include <vector>
+#include <utility>
 #include <json/json.h>
 #include <rat/models/pathconnect2.hh>
 #include <Logger.hh>
+#include "param_range.hh"
 
 /**
  * @class JsonRange
@@ -21,29 +23,15 @@ public:
      * @return The linear range of doubles.
      * 
      * Create a linear range of doubles from `start` to `end` with `num_steps` steps. Throws an exception if `num_steps` is less than 2 or if `start` > `end`.
+     * For a range that produces its values on demand, see `LinearParamRange`.
      */
     static std::vector<Json::Value> double_linear(double start, double end, int num_steps) {
         // Check that inputs are valid
         if (num_steps < 2) {
             throw std::invalid_argument("num_steps must be at least 2");
         }
-        if (start > end) {
-            throw std::invalid_argument("start must be less than or equal to end");
-        }
-        if (start == end) {
-            // Return a vector with the same value repeated num_steps times
-            return std::vector<Json::Value>(num_steps, Json::Value(start));
-        }
 
-        std::vector<Json::Value> range;
-        double step = (end - start) / (num_steps - 1);
-
-        for (int i = 0; i < num_steps; ++i) {
-            double value = start + i * step;
-            range.push_back(Json::Value(value));
-        }
-
-        return range;
+        return LinearParamRange(start, end, static_cast<size_t>(num_steps)).materialize();
     }
 
     /**
@@ -56,6 +44,7 @@ public:
      * The first config in the returned vector is the default config used when use_previous is disabled, see `pathconnect2_default_config()`.
      * It is advisable to set `symmetric`, `enable_w` and the number of control points before calling this function as the format of the configs
      * depend on these values.
+     * For a range that produces its configs on demand, see `PathConnect2ParamRange`.
      */
     static std::vector<Json::Value> pathconnect2_range(rat::mdl::ShPathConnect2Pr pathconnect2, size_t num_configs) {
         // Seed the random number generator with the current time
@@ -143,6 +132,68 @@ public:
     
         return config;
     }
+
+    /**
+     * @brief Decodes an x configuration into the control points of a pathconnect2 node.
+     * @param x The x configuration (format: see rat::mdl::PathConnect2:get_x0()) in [m].
+     * @param num_control_points The number of control points of uvw1 and uvw2, the order of the node plus one.
+     * @param is_symmetric The `is_symmetric` flag of the node. If set, uvw2 equals uvw1.
+     * @param enable_w The `enable_w` flag of the node.
+     * @return uvw1 and uvw2 in a pair, with the rows u, v and w and one column per control point.
+     *
+     * Analogous to rat::mdl::PathConnect2:set_uvw(), used by `pathconnect2_apply_config()` and `InputPathConnectV2UVW`.
+     * Throws an exception if the number of elements in `x` does not match the format.
+     */
+    static std::pair<arma::Mat<double>, arma::Mat<double>> pathconnect2_decode_config(const Json::Value &x, arma::uword num_control_points, bool is_symmetric, bool enable_w){
+        // Initialize uvw matrices with zeros (3 rows, one column per control point).
+        arma::Mat<double> uvw1(3, num_control_points, arma::fill::zeros);
+        arma::Mat<double> uvw2(3, num_control_points, arma::fill::zeros);
+
+        Json::Value::ArrayIndex cnt = 0;
+
+        // Fill in one set of control points from the differences in x
+        auto fill_uvw = [&](arma::Mat<double> &uvw) {
+            for (arma::uword i = 1; i < num_control_points; i++) {
+                uvw(0, i) = uvw(0, i - 1) + x[cnt++].asDouble();
+            }
+            for (arma::uword i = 4; i < num_control_points; i++) {
+                uvw(1, i) = uvw(1, i - 1) + x[cnt++].asDouble();
+            }
+            if (enable_w) {
+                for (arma::uword i = 7; i < num_control_points; i++) {
+                    uvw(2, i) = uvw(2, i - 1) + x[cnt++].asDouble();
+                }
+            }
+        };
+
+        fill_uvw(uvw1);
+        if (is_symmetric) {
+            uvw2 = uvw1;
+        } else {
+            fill_uvw(uvw2);
+        }
+
+        if (cnt != x.size()) {
+            throw std::invalid_argument("x vector has incorrect number of elements");
+        }
+
+        return std::make_pair(uvw1, uvw2);
+    }
+
+    /**
+     * @brief Applies an x configuration to a pathconnect2 node.
+     * @param pathconnect2 The pathconnect2 node.
+     * @param x The x configuration (format: see rat::mdl::PathConnect2:get_x0()) in [m].
+     *
+     * Sets uvw1 and uvw2 of the pathconnect2 node from the x configuration, see `pathconnect2_decode_config()`.
+     * This is the inverse of the configurations returned by `pathconnect2_range()`.
+     * Throws an exception if the number of elements in `x` does not match the format of the node.
+     */
+    static void pathconnect2_apply_config(rat::mdl::ShPathConnect2Pr pathconnect2, const Json::Value &x){
+        auto [uvw1, uvw2] = pathconnect2_decode_config(x, pathconnect2->get_order() + 1, pathconnect2->get_is_symmetric(), pathconnect2->get_enable_w());
+        pathconnect2->set_uvw1(uvw1);
+        pathconnect2->set_uvw2(uvw2);
+    }
 };
 
 #endif // CCTSIM_JSON_RANGE_HH
\ No newline at end of file
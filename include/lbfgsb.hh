@@ -0,0 +1,636 @@
+#ifndef LBFGSB_HH
+#define LBFGSB_HH
+
+#include <vector>
+#include <deque>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @class LBFGSB
+ * @brief Limited-memory BFGS with bounds on the unit cube and batched finite difference gradients.
+ *
+ * The gradient is estimated with central differences; all 2n perturbed points of an iteration are passed to the evaluator as one batch.
+ * Each iteration takes a quasi-Newton step on the variables that are not held at a bound by the projected gradient (projected L-BFGS, the bound
+ * handling of L-BFGS-B without the generalized Cauchy point) and backtracks along the projected path until the Armijo condition holds.
+ * Several backtracking steps can be evaluated as one batch, see `setLineSearchBatchSize()`.
+ *
+ * The perturbation of each dimension starts at its configured value and is adapted to the numerical noise of the function:
+ * if the second difference of the perturbed values is not well above the noise level, the perturbation is increased, if it is far above, decreased
+ * (the curvature test of Gill, Murray, Saunders and Wright, "Computing forward-difference intervals for numerical optimization", 1983).
+ * Unless set, the noise level is estimated from the higher-order differences of a few closely spaced evaluations at the start
+ * (Moré and Wild, "Estimating computational noise", 2011). Failed evaluations (NaN) fail the Armijo condition and fall back to one-sided differences.
+ */
+class LBFGSB
+{
+public:
+    /**
+     * @brief Function that evaluates a batch of points of the unit cube. Returns NaN for failed evaluations.
+     */
+    using BatchEvaluator = std::function<std::vector<double>(const std::vector<std::vector<double>> &)>;
+
+    /**
+     * @brief Function that returns true if the next batch must not be evaluated. Gets the number of points evaluated so far and the size of the next batch.
+     */
+    using StopCondition = std::function<bool(size_t, size_t)>;
+
+    /**
+     * @brief Construct a LBFGSB object.
+     * @param num_dims The number of dimensions. Must be at least 1.
+     * @param history_size (Optional) The number of correction pairs kept for the inverse Hessian approximation. Default is 6.
+     */
+    LBFGSB(size_t num_dims, size_t history_size = 6) : num_dims_(num_dims), history_size_(history_size), steps_(num_dims, DEFAULT_STEP)
+    {
+        if (num_dims < 1)
+        {
+            throw std::invalid_argument("num_dims must be at least 1");
+        }
+        if (history_size < 1)
+        {
+            throw std::invalid_argument("history_size must be at least 1");
+        }
+    }
+
+    /**
+     * @brief Set the initial finite difference perturbation of a dimension.
+     * @param dim The dimension.
+     * @param step The perturbation in unit cube coordinates. Default is 1e-3.
+     */
+    void setFiniteDifferenceStep(size_t dim, double step)
+    {
+        if (dim >= num_dims_)
+        {
+            throw std::out_of_range("Dimension " + std::to_string(dim) + " does not exist");
+        }
+        if (!(step > 0.0 && step <= MAX_STEP))
+        {
+            throw std::invalid_argument("step must be greater than 0 and at most " + std::to_string(MAX_STEP));
+        }
+        steps_[dim] = step;
+    }
+
+    /**
+     * @brief Set the absolute noise level of the function instead of estimating it.
+     * @param noise_level The noise level. Must be non-negative.
+     */
+    void setNoiseLevel(double noise_level)
+    {
+        if (!(noise_level >= 0.0))
+        {
+            throw std::invalid_argument("noise_level must be non-negative");
+        }
+        noise_level_ = noise_level;
+        has_noise_level_ = true;
+    }
+
+    /**
+     * @brief Set the number of backtracking steps evaluated per batch.
+     * @param batch_size The number of steps. Must be at least 1. Default is 1.
+     */
+    void setLineSearchBatchSize(size_t batch_size)
+    {
+        if (batch_size < 1)
+        {
+            throw std::invalid_argument("batch_size must be at least 1");
+        }
+        line_search_batch_size_ = batch_size;
+    }
+
+    /**
+     * @brief Set the convergence tolerance of the projected gradient.
+     * @param tol_g The tolerance of the largest component of the projected gradient. Default is 1e-6.
+     */
+    void setGradientTolerance(double tol_g)
+    {
+        tol_g_ = tol_g;
+    }
+
+    /**
+     * @brief Minimize the function.
+     * @param start The start point in the unit cube.
+     * @param evaluate The batch evaluator.
+     * @param should_stop The stop condition.
+     *
+     * Returns without iterating if the function cannot be evaluated at the start point.
+     */
+    void minimize(const std::vector<double> &start, const BatchEvaluator &evaluate, const StopCondition &should_stop)
+    {
+        if (start.size() != num_dims_)
+        {
+            throw std::invalid_argument("Start point has the wrong number of dimensions");
+        }
+        num_evaluated_ = 0;
+        num_iterations_ = 0;
+        converged_ = false;
+        best_value_ = std::numeric_limits<double>::infinity();
+        best_point_.clear();
+        s_history_.clear();
+        y_history_.clear();
+
+        auto evaluate_batch = [&](const std::vector<std::vector<double>> &points, std::vector<double> &values) -> bool
+        {
+            if (should_stop(num_evaluated_, points.size()))
+            {
+                return false;
+            }
+            values = evaluate(points);
+            if (values.size() != points.size())
+            {
+                throw std::runtime_error("Evaluator returned the wrong number of values");
+            }
+            num_evaluated_ += points.size();
+            for (size_t k = 0; k < points.size(); k++)
+            {
+                if (values[k] < best_value_)
+                {
+                    best_value_ = values[k];
+                    best_point_ = points[k];
+                }
+            }
+            return true;
+        };
+
+        // Start point, together with the noise probes unless the noise level is set
+        std::vector<double> x = clampToUnitCube(start);
+        std::vector<std::vector<double>> initial = {x};
+        if (!has_noise_level_)
+        {
+            std::vector<std::vector<double>> probes = getNoiseProbes(x);
+            initial.insert(initial.end(), probes.begin(), probes.end());
+        }
+        std::vector<double> initial_values;
+        if (!evaluate_batch(initial, initial_values))
+        {
+            return;
+        }
+        double f = initial_values[0];
+        if (!std::isfinite(f))
+        {
+            return;
+        }
+        if (!has_noise_level_)
+        {
+            noise_level_ = estimateNoise(std::vector<double>(initial_values.begin() + 1, initial_values.end()));
+            if (!std::isfinite(noise_level_))
+            {
+                noise_level_ = 0.0;
+            }
+        }
+        noise_level_ = std::max(noise_level_, MACHINE_NOISE * std::max(std::abs(f), 1.0));
+
+        std::vector<double> g;
+        std::vector<double> x_prev, g_prev;
+        while (true)
+        {
+            if (!estimateGradient(x, f, g, evaluate_batch))
+            {
+                return;
+            }
+
+            // Convergence of the projected gradient
+            double projected_gradient = 0.0;
+            for (size_t i = 0; i < num_dims_; i++)
+            {
+                projected_gradient = std::max(projected_gradient, std::abs(std::min(std::max(x[i] - g[i], 0.0), 1.0) - x[i]));
+            }
+            if (projected_gradient <= tol_g_)
+            {
+                converged_ = true;
+                return;
+            }
+
+            // Correction pair of the last step
+            if (!x_prev.empty())
+            {
+                std::vector<double> s(num_dims_), y(num_dims_);
+                for (size_t i = 0; i < num_dims_; i++)
+                {
+                    s[i] = x[i] - x_prev[i];
+                    y[i] = g[i] - g_prev[i];
+                }
+                if (dot(s, y) > CURVATURE_EPS * dot(y, y))
+                {
+                    s_history_.push_back(s);
+                    y_history_.push_back(y);
+                    if (s_history_.size() > history_size_)
+                    {
+                        s_history_.pop_front();
+                        y_history_.pop_front();
+                    }
+                }
+            }
+
+            std::vector<double> d = getDirection(x, g);
+            double max_d = 0.0;
+            for (double d_i : d)
+            {
+                max_d = std::max(max_d, std::abs(d_i));
+            }
+            if (!(max_d > 0.0))
+            {
+                converged_ = true;
+                return;
+            }
+
+            // Backtracking along the projected path, the first step is limited without curvature information
+            double alpha = s_history_.empty() ? std::min(1.0, INITIAL_MAX_STEP / max_d) : 1.0;
+            std::vector<double> x_next;
+            double f_next = f;
+            bool accepted = false;
+            for (size_t trial = 0; trial < MAX_BACKTRACKS && !accepted; trial += line_search_batch_size_)
+            {
+                std::vector<std::vector<double>> points;
+                for (size_t k = 0; k < line_search_batch_size_ && trial + k < MAX_BACKTRACKS; k++)
+                {
+                    std::vector<double> point(num_dims_);
+                    for (size_t i = 0; i < num_dims_; i++)
+                    {
+                        point[i] = std::min(std::max(x[i] + alpha * d[i], 0.0), 1.0);
+                    }
+                    points.push_back(point);
+                    alpha *= 0.5;
+                }
+
+                std::vector<double> values;
+                if (!evaluate_batch(points, values))
+                {
+                    return;
+                }
+                for (size_t k = 0; k < points.size() && !accepted; k++)
+                {
+                    std::vector<double> step(num_dims_);
+                    for (size_t i = 0; i < num_dims_; i++)
+                    {
+                        step[i] = points[k][i] - x[i];
+                    }
+                    if (std::isfinite(values[k]) && values[k] <= f + ARMIJO * dot(g, step))
+                    {
+                        x_next = points[k];
+                        f_next = values[k];
+                        accepted = true;
+                    }
+                }
+            }
+            if (!accepted)
+            {
+                // No decrease along the direction within the resolution of the finite differences
+                converged_ = true;
+                return;
+            }
+
+            x_prev = x;
+            g_prev = g;
+            double decrease = f - f_next;
+            x = x_next;
+            f = f_next;
+            num_iterations_++;
+
+            if (decrease <= noise_level_)
+            {
+                converged_ = true;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Check whether the last minimization converged.
+     * @return True if the projected gradient vanished or no further decrease was found, false if it was stopped by the stop condition.
+     */
+    bool hasConverged() const
+    {
+        return converged_;
+    }
+
+    /**
+     * @brief Get the best point evaluated by the last minimization.
+     * @return The point, empty if no evaluation succeeded.
+     */
+    const std::vector<double> &getBestPoint() const
+    {
+        return best_point_;
+    }
+
+    /**
+     * @brief Get the best value evaluated by the last minimization.
+     * @return The value, infinity if no evaluation succeeded.
+     */
+    double getBestValue() const
+    {
+        return best_value_;
+    }
+
+    /**
+     * @brief Get the number of accepted steps of the last minimization.
+     * @return The number of iterations.
+     */
+    size_t getNumIterations() const
+    {
+        return num_iterations_;
+    }
+
+    /**
+     * @brief Get the number of evaluations of the last minimization.
+     * @return The number of evaluated points.
+     */
+    size_t getNumEvaluations() const
+    {
+        return num_evaluated_;
+    }
+
+    /**
+     * @brief Get the noise level used by the last minimization.
+     * @return The set or estimated absolute noise level.
+     */
+    double getNoiseLevel() const
+    {
+        return noise_level_;
+    }
+
+    /**
+     * @brief Get the current finite difference perturbations.
+     * @return The perturbation of each dimension in unit cube coordinates, as adapted by the last minimization.
+     */
+    const std::vector<double> &getFiniteDifferenceSteps() const
+    {
+        return steps_;
+    }
+
+    /**
+     * @brief Estimate the noise level from evaluations at equally spaced points on a line.
+     * @param values The values, at least 4.
+     * @return The estimated standard deviation of the noise, NaN if a value is not finite.
+     *
+     * Computes the noise estimate of every difference order and returns the first one that agrees with the next order within a factor of 4,
+     * or the smallest one if none agree.
+     */
+    static double estimateNoise(const std::vector<double> &values)
+    {
+        if (values.size() < 4)
+        {
+            throw std::invalid_argument("At least 4 values are required to estimate the noise");
+        }
+        for (double value : values)
+        {
+            if (!std::isfinite(value))
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+
+        std::vector<double> differences = values;
+        std::vector<double> sigmas;
+        double gamma = 1.0;
+        for (size_t k = 1; k < values.size() - 1; k++)
+        {
+            for (size_t i = 0; i + 1 < differences.size(); i++)
+            {
+                differences[i] = differences[i + 1] - differences[i];
+            }
+            differences.pop_back();
+
+            // gamma_k = (k!)^2 / (2k)!
+            gamma *= static_cast<double>(k) / (2.0 * (2.0 * k - 1.0));
+            double sum = 0.0;
+            for (double difference : differences)
+            {
+                sum += difference * difference;
+            }
+            sigmas.push_back(std::sqrt(gamma * sum / differences.size()));
+        }
+
+        for (size_t k = 1; k + 1 < sigmas.size(); k++)
+        {
+            double low = std::min(sigmas[k], sigmas[k + 1]);
+            double high = std::max(sigmas[k], sigmas[k + 1]);
+            if (high <= 4.0 * low)
+            {
+                return sigmas[k];
+            }
+        }
+        return *std::min_element(sigmas.begin(), sigmas.end());
+    }
+
+private:
+    /**
+     * @brief Estimate the gradient with central differences and adapt the perturbations.
+     * @return False if the stop condition was met.
+     */
+    template <typename EvaluateBatch>
+    bool estimateGradient(const std::vector<double> &x, double f, std::vector<double> &g, EvaluateBatch &evaluate_batch)
+    {
+        std::vector<std::vector<double>> points;
+        for (size_t i = 0; i < num_dims_; i++)
+        {
+            std::vector<double> plus = x;
+            std::vector<double> minus = x;
+            plus[i] = std::min(x[i] + steps_[i], 1.0);
+            minus[i] = std::max(x[i] - steps_[i], 0.0);
+            points.push_back(plus);
+            points.push_back(minus);
+        }
+
+        std::vector<double> values;
+        if (!evaluate_batch(points, values))
+        {
+            return false;
+        }
+
+        g.assign(num_dims_, 0.0);
+        for (size_t i = 0; i < num_dims_; i++)
+        {
+            double x_plus = points[2 * i][i];
+            double x_minus = points[2 * i + 1][i];
+            double f_plus = values[2 * i];
+            double f_minus = values[2 * i + 1];
+            bool plus_ok = std::isfinite(f_plus) && x_plus > x[i];
+            bool minus_ok = std::isfinite(f_minus) && x_minus < x[i];
+
+            if (plus_ok && minus_ok)
+            {
+                g[i] = (f_plus - f_minus) / (x_plus - x_minus);
+            }
+            else if (plus_ok)
+            {
+                g[i] = (f_plus - f) / (x_plus - x[i]);
+            }
+            else if (minus_ok)
+            {
+                g[i] = (f - f_minus) / (x[i] - x_minus);
+            }
+
+            // Curvature test, only for symmetric perturbations
+            if (plus_ok && minus_ok && std::abs((x_plus - x[i]) - (x[i] - x_minus)) < 1e-15)
+            {
+                double second_difference = std::abs(f_plus - 2.0 * f + f_minus);
+                double cancellation = second_difference > 0.0 ? 4.0 * noise_level_ / second_difference : std::numeric_limits<double>::infinity();
+                if (cancellation > MAX_CANCELLATION)
+                {
+                    steps_[i] = std::min(steps_[i] * 4.0, MAX_STEP);
+                }
+                else if (cancellation < MIN_CANCELLATION)
+                {
+                    steps_[i] = std::max(steps_[i] / 4.0, MIN_STEP);
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get the quasi-Newton direction on the free variables.
+     * @param x The current point.
+     * @param g The gradient.
+     * @return The direction, 0 for variables held at a bound.
+     */
+    std::vector<double> getDirection(const std::vector<double> &x, const std::vector<double> &g) const
+    {
+        std::vector<bool> is_free(num_dims_);
+        for (size_t i = 0; i < num_dims_; i++)
+        {
+            is_free[i] = !((x[i] <= 0.0 && g[i] > 0.0) || (x[i] >= 1.0 && g[i] < 0.0));
+        }
+        auto mask = [&](std::vector<double> v)
+        {
+            for (size_t i = 0; i < num_dims_; i++)
+            {
+                if (!is_free[i])
+                {
+                    v[i] = 0.0;
+                }
+            }
+            return v;
+        };
+
+        // Two-loop recursion on the free subspace
+        std::vector<double> q = mask(g);
+        size_t m = s_history_.size();
+        std::vector<double> alphas(m, 0.0), rhos(m, 0.0);
+        std::vector<std::vector<double>> s_free(m), y_free(m);
+        for (size_t j = 0; j < m; j++)
+        {
+            s_free[j] = mask(s_history_[j]);
+            y_free[j] = mask(y_history_[j]);
+            double sy = dot(s_free[j], y_free[j]);
+            rhos[j] = sy > 0.0 ? 1.0 / sy : 0.0;
+        }
+        for (size_t j = m; j-- > 0;)
+        {
+            alphas[j] = rhos[j] * dot(s_free[j], q);
+            for (size_t i = 0; i < num_dims_; i++)
+            {
+                q[i] -= alphas[j] * y_free[j][i];
+            }
+        }
+        double gamma = 1.0;
+        if (m > 0 && rhos[m - 1] > 0.0 && dot(y_free[m - 1], y_free[m - 1]) > 0.0)
+        {
+            gamma = 1.0 / (rhos[m - 1] * dot(y_free[m - 1], y_free[m - 1]));
+        }
+        for (double &q_i : q)
+        {
+            q_i *= gamma;
+        }
+        for (size_t j = 0; j < m; j++)
+        {
+            double beta = rhos[j] * dot(y_free[j], q);
+            for (size_t i = 0; i < num_dims_; i++)
+            {
+                q[i] += (alphas[j] - beta) * s_free[j][i];
+            }
+        }
+
+        std::vector<double> d(num_dims_);
+        for (size_t i = 0; i < num_dims_; i++)
+        {
+            d[i] = -q[i];
+        }
+
+        // Fall back to steepest descent if the direction does not descend
+        if (!(dot(d, g) < 0.0))
+        {
+            d = mask(g);
+            for (double &d_i : d)
+            {
+                d_i = -d_i;
+            }
+        }
+        return d;
+    }
+
+    /**
+     * @brief Get equally spaced points on a line through the point for the noise estimation.
+     * @param x The point.
+     * @return The points.
+     */
+    std::vector<std::vector<double>> getNoiseProbes(const std::vector<double> &x) const
+    {
+        double half_width = NOISE_PROBE_SPACING * (NUM_NOISE_PROBES - 1) / 2.0;
+        std::vector<std::vector<double>> probes;
+        for (size_t k = 0; k < NUM_NOISE_PROBES; k++)
+        {
+            std::vector<double> probe(num_dims_);
+            for (size_t i = 0; i < num_dims_; i++)
+            {
+                double center = std::min(std::max(x[i], half_width), 1.0 - half_width);
+                probe[i] = center + (static_cast<double>(k) * NOISE_PROBE_SPACING - half_width) / std::sqrt(static_cast<double>(num_dims_));
+            }
+            probes.push_back(probe);
+        }
+        return probes;
+    }
+
+    static std::vector<double> clampToUnitCube(std::vector<double> x)
+    {
+        for (double &x_i : x)
+        {
+            x_i = std::min(std::max(x_i, 0.0), 1.0);
+        }
+        return x;
+    }
+
+    static double dot(const std::vector<double> &a, const std::vector<double> &b)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    static constexpr double DEFAULT_STEP = 1e-3;
+    static constexpr double MIN_STEP = 1e-7;
+    static constexpr double MAX_STEP = 0.1;
+    static constexpr double MIN_CANCELLATION = 1e-3;
+    static constexpr double MAX_CANCELLATION = 0.1;
+    static constexpr double MACHINE_NOISE = 1e-14;
+    static constexpr double NOISE_PROBE_SPACING = 1e-4;
+    static constexpr size_t NUM_NOISE_PROBES = 7;
+    static constexpr double INITIAL_MAX_STEP = 0.1;
+    static constexpr double ARMIJO = 1e-4;
+    static constexpr double CURVATURE_EPS = 1e-10;
+    static constexpr size_t MAX_BACKTRACKS = 20;
+
+    size_t num_dims_;
+    size_t history_size_;
+    std::vector<double> steps_;
+    double noise_level_ = 0.0;
+    bool has_noise_level_ = false;
+    size_t line_search_batch_size_ = 1;
+    double tol_g_ = 1e-6;
+
+    size_t num_evaluated_ = 0;
+    size_t num_iterations_ = 0;
+    bool converged_ = false;
+    double best_value_ = std::numeric_limits<double>::infinity();
+    std::vector<double> best_point_;
+    std::deque<std::vector<double>> s_history_;
+    std::deque<std::vector<double>> y_history_;
+};
+
+#endif // LBFGSB_HH
@@ -0,0 +1,216 @@
+#ifndef LINEAR_RESPONSE_HH
+#define LINEAR_RESPONSE_HH
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <armadillo>
+
+/**
+ * @class LinearResponse
+ * @brief Class for a linear model of outputs around a reference point, e.g. of the multipoles with respect to harmonic scaling parameters.
+ *
+ * The Jacobian is measured with one forward difference per input. `solve()` returns the inputs at which the linear model reaches the targets:
+ * the least-squares solution if there are more outputs than inputs, the minimum-norm step if there are fewer. Inputs are kept within their bounds
+ * by fixing the inputs that would leave them at the bound and solving again for the others.
+ */
+class LinearResponse
+{
+public:
+    /**
+     * @brief Construct a LinearResponse object.
+     * @param num_inputs The number of inputs. Must be at least 1.
+     * @param num_outputs The number of outputs. Must be at least 1.
+     */
+    LinearResponse(size_t num_inputs, size_t num_outputs) : num_inputs_(num_inputs), num_outputs_(num_outputs)
+    {
+        if (num_inputs < 1 || num_outputs < 1)
+        {
+            throw std::invalid_argument("num_inputs and num_outputs must be at least 1");
+        }
+    }
+
+    /**
+     * @brief Measure the Jacobian from forward differences.
+     * @param x The reference inputs.
+     * @param y The outputs at the reference inputs.
+     * @param steps The perturbation of each input. Must not be 0.
+     * @param perturbed_y The outputs with one input perturbed by its step, in the order of the inputs.
+     *
+     * Throws an exception if the sizes do not match.
+     */
+    void setFromDifferences(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &steps, const std::vector<std::vector<double>> &perturbed_y)
+    {
+        if (x.size() != num_inputs_ || steps.size() != num_inputs_ || perturbed_y.size() != num_inputs_ || y.size() != num_outputs_)
+        {
+            throw std::invalid_argument("Sizes of the differences do not match the linear response");
+        }
+
+        jacobian_ = arma::mat(num_outputs_, num_inputs_);
+        for (size_t j = 0; j < num_inputs_; j++)
+        {
+            if (perturbed_y[j].size() != num_outputs_ || steps[j] == 0.0)
+            {
+                throw std::invalid_argument("Invalid perturbation of input " + std::to_string(j));
+            }
+            for (size_t i = 0; i < num_outputs_; i++)
+            {
+                jacobian_(i, j) = (perturbed_y[j][i] - y[i]) / steps[j];
+            }
+        }
+        has_jacobian_ = true;
+    }
+
+    /**
+     * @brief Check whether the Jacobian has been measured.
+     * @return True if the Jacobian is available.
+     */
+    bool hasJacobian() const
+    {
+        return has_jacobian_;
+    }
+
+    /**
+     * @brief Discard the Jacobian.
+     */
+    void reset()
+    {
+        has_jacobian_ = false;
+    }
+
+    /**
+     * @brief Get the Jacobian.
+     * @return The derivative of each output (row) with respect to each input (column).
+     */
+    const arma::mat &getJacobian() const
+    {
+        return jacobian_;
+    }
+
+    /**
+     * @brief Solve the linear model for the targets.
+     * @param x The inputs at which the outputs were evaluated.
+     * @param y The outputs at `x`.
+     * @param targets The target of each output.
+     * @param lower The lower bound of each input.
+     * @param upper The upper bound of each input.
+     * @return The inputs at which the linear model is closest to the targets.
+     *
+     * Throws an exception if the Jacobian has not been measured or the sizes do not match.
+     */
+    std::vector<double> solve(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &targets, const std::vector<double> &lower, const std::vector<double> &upper) const
+    {
+        if (!has_jacobian_)
+        {
+            throw std::runtime_error("Jacobian has not been measured");
+        }
+        if (x.size() != num_inputs_ || lower.size() != num_inputs_ || upper.size() != num_inputs_ || y.size() != num_outputs_ || targets.size() != num_outputs_)
+        {
+            throw std::invalid_argument("Sizes do not match the linear response");
+        }
+
+        std::vector<double> solution = x;
+        std::vector<bool> is_fixed(num_inputs_, false);
+        for (size_t pass = 0; pass < num_inputs_; pass++)
+        {
+            std::vector<size_t> free_inputs;
+            for (size_t j = 0; j < num_inputs_; j++)
+            {
+                if (!is_fixed[j])
+                {
+                    free_inputs.push_back(j);
+                }
+            }
+            if (free_inputs.empty())
+            {
+                break;
+            }
+
+            // Residual of the linear model with the fixed inputs at their bounds and the free inputs at x
+            arma::vec rhs(num_outputs_);
+            for (size_t i = 0; i < num_outputs_; i++)
+            {
+                rhs(i) = targets[i] - y[i];
+                for (size_t j = 0; j < num_inputs_; j++)
+                {
+                    if (is_fixed[j])
+                    {
+                        rhs(i) -= jacobian_(i, j) * (solution[j] - x[j]);
+                    }
+                }
+            }
+            arma::mat J(num_outputs_, free_inputs.size());
+            for (size_t i = 0; i < num_outputs_; i++)
+            {
+                for (size_t k = 0; k < free_inputs.size(); k++)
+                {
+                    J(i, k) = jacobian_(i, free_inputs[k]);
+                }
+            }
+
+            arma::vec dx = solveLeastSquares(J, rhs);
+
+            // Fix the inputs that leave their bounds and solve again for the others
+            bool violated = false;
+            for (size_t k = 0; k < free_inputs.size(); k++)
+            {
+                size_t j = free_inputs[k];
+                solution[j] = x[j] + dx(k);
+                if (solution[j] < lower[j] || solution[j] > upper[j])
+                {
+                    solution[j] = std::min(std::max(solution[j], lower[j]), upper[j]);
+                    is_fixed[j] = true;
+                    violated = true;
+                }
+            }
+            if (!violated)
+            {
+                break;
+            }
+        }
+        return solution;
+    }
+
+private:
+    /**
+     * @brief Least-squares solution for tall systems, minimum-norm solution for wide systems, with a small ridge against singular Jacobians.
+     * @param J The matrix.
+     * @param b The right-hand side.
+     * @return The solution.
+     */
+    static arma::vec solveLeastSquares(const arma::mat &J, const arma::vec &b)
+    {
+        bool tall = J.n_rows >= J.n_cols;
+        arma::mat A = tall ? arma::mat(J.t() * J) : arma::mat(J * J.t());
+        arma::vec rhs = tall ? arma::vec(J.t() * b) : b;
+
+        double trace = 0.0;
+        for (arma::uword i = 0; i < A.n_rows; i++)
+        {
+            trace += A(i, i);
+        }
+        double ridge = RIDGE * std::max(trace / A.n_rows, 1e-300);
+        for (arma::uword i = 0; i < A.n_rows; i++)
+        {
+            A(i, i) += ridge;
+        }
+
+        arma::vec z;
+        if (!arma::solve(z, A, rhs))
+        {
+            throw std::runtime_error("Linear response could not be solved");
+        }
+        return tall ? z : arma::vec(J.t() * z);
+    }
+
+    static constexpr double RIDGE = 1e-12;
+
+    size_t num_inputs_;
+    size_t num_outputs_;
+    bool has_jacobian_ = false;
+    arma::mat jacobian_;
+};
+
+#endif // LINEAR_RESPONSE_HH
@@ -0,0 +1,128 @@
+#ifndef LOCAL_OPTIMIZER_HH
+#define LOCAL_OPTIMIZER_HH
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @enum OptimizerMethod
+ * @brief Enum for the derivative-free local optimization methods.
+ */
+enum OptimizerMethod
+{
+    NELDER_MEAD,
+    CMA_ES
+};
+
+// To string function for OptimizerMethod that returns the string representation of the enum value
+inline std::string to_string(OptimizerMethod method)
+{
+    switch (method)
+    {
+    case NELDER_MEAD:
+        return "NELDER_MEAD";
+    case CMA_ES:
+        return "CMA_ES";
+    default:
+        throw std::invalid_argument("Invalid OptimizerMethod value");
+    }
+}
+
+/**
+ * @interface LocalOptimizer
+ * @brief Interface for derivative-free optimizers on the unit cube in ask-and-tell form.
+ *
+ * `ask()` returns the points to be evaluated next, `tell()` takes their objective values in the same order.
+ * Failed evaluations are passed as infinity. All points lie in [0, 1]^n. The optimizer minimizes the objective.
+ */
+class LocalOptimizer
+{
+public:
+    /**
+     * @brief Get the points to be evaluated next.
+     * @return The points. May contain several points which can be evaluated in parallel.
+     */
+    virtual std::vector<std::vector<double>> ask() = 0;
+
+    /**
+     * @brief Pass the objective values of the points of the last `ask()`.
+     * @param values The objective values in the order of the points.
+     *
+     * Throws an exception if the number of values does not match the number of points.
+     */
+    virtual void tell(const std::vector<double> &values) = 0;
+
+    /**
+     * @brief Check whether the optimizer has converged.
+     * @return True if the optimizer has converged.
+     */
+    virtual bool hasConverged() const = 0;
+
+    /**
+     * @brief Get the best point evaluated so far.
+     * @return The best point, empty if no point has been evaluated.
+     */
+    const std::vector<double> &getBestPoint() const
+    {
+        return best_point_;
+    }
+
+    /**
+     * @brief Get the best objective value evaluated so far.
+     * @return The best objective value, infinity if no point has been evaluated.
+     */
+    double getBestValue() const
+    {
+        return best_value_;
+    }
+
+    virtual ~LocalOptimizer() = default;
+
+protected:
+    /**
+     * @brief Update the best point.
+     * @param point The point.
+     * @param value The objective value of the point.
+     */
+    void updateBest(const std::vector<double> &point, double value)
+    {
+        if (value < best_value_)
+        {
+            best_value_ = value;
+            best_point_ = point;
+        }
+    }
+
+    /**
+     * @brief Clamp a point to the unit cube.
+     * @param point The point.
+     * @return The clamped point.
+     */
+    static std::vector<double> clampToUnitCube(std::vector<double> point)
+    {
+        for (double &x : point)
+        {
+            x = std::min(std::max(x, 0.0), 1.0);
+        }
+        return point;
+    }
+
+    /**
+     * @brief Replace NaN values by infinity.
+     * @param value The objective value.
+     * @return The value, infinity if it is NaN.
+     */
+    static double sanitize(double value)
+    {
+        return std::isnan(value) ? std::numeric_limits<double>::infinity() : value;
+    }
+
+    std::vector<double> best_point_;
+    double best_value_ = std::numeric_limits<double>::infinity();
+};
+
+#endif // LOCAL_OPTIMIZER_HH
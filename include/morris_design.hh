@@ -0,0 +1,184 @@
+#ifndef MORRIS_DESIGN_HH
+#define MORRIS_DESIGN_HH
+
+#include <vector>
+#include <cmath>
+#include <random>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @struct MorrisStatistics
+ * @brief Statistics of the elementary effects of one input on one output.
+ */
+struct MorrisStatistics
+{
+    double mu = 0.0;         ///< Mean of the elementary effects.
+    double mu_star = 0.0;    ///< Mean of the absolute elementary effects, the importance of the input.
+    double sigma = 0.0;      ///< Standard deviation of the elementary effects, large for nonlinear effects and interactions.
+    size_t num_effects = 0;  ///< Number of elementary effects with successful evaluations.
+};
+
+/**
+ * @class MorrisDesign
+ * @brief Class for the elementary effects screening method of Morris on the unit cube.
+ *
+ * Morris, "Factorial sampling plans for preliminary computational experiments", Technometrics 33(2), 1991, with the absolute mean mu* of Campolongo et al., 2007.
+ * A trajectory starts at a random point of a grid with `num_levels` levels per dimension and moves along every dimension once, in random order,
+ * by Delta = num_levels / (2 (num_levels - 1)). Each move gives one elementary effect of that dimension, so a trajectory has num_dims + 1 points.
+ */
+class MorrisDesign
+{
+public:
+    /**
+     * @brief Construct a MorrisDesign object.
+     * @param num_dims The number of dimensions. Must be at least 1.
+     * @param num_levels (Optional) The number of grid levels per dimension. Must be even and at least 2. Default is 4.
+     * @param seed (Optional) The seed of the random number generator. Default is 0.
+     */
+    MorrisDesign(size_t num_dims, size_t num_levels = 4, uint64_t seed = 0) : num_dims_(num_dims), num_levels_(num_levels), rng_(seed)
+    {
+        if (num_dims < 1)
+        {
+            throw std::invalid_argument("num_dims must be at least 1");
+        }
+        if (num_levels < 2 || num_levels % 2 != 0)
+        {
+            throw std::invalid_argument("num_levels must be even and at least 2");
+        }
+    }
+
+    /**
+     * @brief Get the step of the elementary effects.
+     * @return Delta in unit cube coordinates.
+     */
+    double getDelta() const
+    {
+        return static_cast<double>(num_levels_) / (2.0 * (num_levels_ - 1));
+    }
+
+    /**
+     * @brief Generate trajectories.
+     * @param num_trajectories The number of trajectories.
+     * @return The points of each trajectory.
+     */
+    std::vector<std::vector<std::vector<double>>> generate(size_t num_trajectories)
+    {
+        double delta = getDelta();
+        std::uniform_int_distribution<size_t> level(0, num_levels_ - 1);
+
+        std::vector<std::vector<std::vector<double>>> trajectories;
+        for (size_t t = 0; t < num_trajectories; t++)
+        {
+            std::vector<double> x(num_dims_);
+            for (double &x_i : x)
+            {
+                x_i = static_cast<double>(level(rng_)) / (num_levels_ - 1);
+            }
+
+            std::vector<size_t> order(num_dims_);
+            std::iota(order.begin(), order.end(), 0);
+            std::shuffle(order.begin(), order.end(), rng_);
+
+            // With an even number of levels exactly one direction stays on the grid
+            std::vector<std::vector<double>> trajectory = {x};
+            for (size_t i : order)
+            {
+                x[i] = x[i] + delta <= 1.0 + 1e-12 ? x[i] + delta : x[i] - delta;
+                x[i] = std::min(std::max(x[i], 0.0), 1.0);
+                trajectory.push_back(x);
+            }
+            trajectories.push_back(trajectory);
+        }
+        return trajectories;
+    }
+
+    /**
+     * @brief Compute the statistics of the elementary effects.
+     * @param trajectories The trajectories, see `generate()`.
+     * @param outputs The outputs at each point of each trajectory. An empty vector marks a failed evaluation, its effects are skipped.
+     * @param num_outputs The number of outputs.
+     * @return The statistics of each dimension (outer) and output (inner).
+     */
+    static std::vector<std::vector<MorrisStatistics>> analyze(const std::vector<std::vector<std::vector<double>>> &trajectories, const std::vector<std::vector<std::vector<double>>> &outputs, size_t num_outputs)
+    {
+        if (trajectories.size() != outputs.size())
+        {
+            throw std::invalid_argument("Number of outputs does not match the number of trajectories");
+        }
+        size_t num_dims = trajectories.empty() ? 0 : trajectories[0][0].size();
+
+        // Elementary effects of each dimension and output
+        std::vector<std::vector<std::vector<double>>> effects(num_dims, std::vector<std::vector<double>>(num_outputs));
+        for (size_t t = 0; t < trajectories.size(); t++)
+        {
+            if (outputs[t].size() != trajectories[t].size())
+            {
+                throw std::invalid_argument("Number of outputs does not match the trajectory length");
+            }
+            for (size_t k = 0; k + 1 < trajectories[t].size(); k++)
+            {
+                const std::vector<double> &a = trajectories[t][k];
+                const std::vector<double> &b = trajectories[t][k + 1];
+                if (outputs[t][k].size() != num_outputs || outputs[t][k + 1].size() != num_outputs)
+                {
+                    continue;
+                }
+                for (size_t i = 0; i < num_dims; i++)
+                {
+                    double step = b[i] - a[i];
+                    if (step == 0.0)
+                    {
+                        continue;
+                    }
+                    for (size_t o = 0; o < num_outputs; o++)
+                    {
+                        double effect = (outputs[t][k + 1][o] - outputs[t][k][o]) / step;
+                        if (std::isfinite(effect))
+                        {
+                            effects[i][o].push_back(effect);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::vector<std::vector<MorrisStatistics>> statistics(num_dims, std::vector<MorrisStatistics>(num_outputs));
+        for (size_t i = 0; i < num_dims; i++)
+        {
+            for (size_t o = 0; o < num_outputs; o++)
+            {
+                const std::vector<double> &e = effects[i][o];
+                MorrisStatistics &s = statistics[i][o];
+                s.num_effects = e.size();
+                if (e.empty())
+                {
+                    s.mu = s.mu_star = s.sigma = std::numeric_limits<double>::quiet_NaN();
+                    continue;
+                }
+                for (double effect : e)
+                {
+                    s.mu += effect / e.size();
+                    s.mu_star += std::abs(effect) / e.size();
+                }
+                double sum = 0.0;
+                for (double effect : e)
+                {
+                    sum += (effect - s.mu) * (effect - s.mu);
+                }
+                s.sigma = e.size() > 1 ? std::sqrt(sum / (e.size() - 1)) : 0.0;
+            }
+        }
+        return statistics;
+    }
+
+private:
+    size_t num_dims_;
+    size_t num_levels_;
+    std::mt19937_64 rng_;
+};
+
+#endif // MORRIS_DESIGN_HH
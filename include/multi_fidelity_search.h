@@ -0,0 +1,100 @@
+#ifndef MULTI_FIDELITY_SEARCH_H
+#define MULTI_FIDELITY_SEARCH_H
+
+#include "parameter_search.h"
+#include "optimization_objective.hh"
+#include "input_fmm_setting.hh"
+
+/**
+ * @class MultiFidelitySearch
+ * @brief Class for a parameter sweep at reduced FMM accuracy that re-runs only the promising configurations at full accuracy.
+ *
+ * The FMM settings of the calculations (e.g. a lower 'num_exp') are overridden for the low-fidelity sweep, see `setLowFidelitySetting()`.
+ * The whole grid (or the sample points, see `ParameterSearch::setSampler()`) is evaluated with the overrides, the configurations are ranked by the
+ * penalized objective (see `OptimizationObjective::getPenalizedValue()`), and the best `top_fraction` of them, plus those close to a constraint bound
+ * (see `setBoundaryMargin()`), are evaluated again with the settings of the model.
+ * Each overridden setting is an extra column of the output file (see `InputFmmSetting`), so every row shows its fidelity; the index column holds the evaluation number.
+ * The pairs of low- and full-fidelity values are written to a second file with the suffix `_fidelity.csv` to check the low-fidelity error.
+ * Batches are evaluated in parallel if workers are set, see `ParameterSearch::setNumWorkers()`. The step and time budgets cover both sweeps.
+ */
+class MultiFidelitySearch : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct a MultiFidelitySearch object.
+     * @param inputParamsRanges The input parameter ranges.
+     * @param outputCriteria The output criteria.
+     * @param modelHandler The model handler.
+     * @param objective The objective used to rank the low-fidelity results.
+     * @param top_fraction The fraction of the successful low-fidelity configurations re-run at full fidelity. Must be in (0, 1].
+     *
+     * Throws an exception if the objective refers to output criteria that do not exist or the fraction is out of range.
+     */
+    MultiFidelitySearch(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, OptimizationObjective objective, double top_fraction);
+
+    /**
+     * @brief Run the low-fidelity sweep and the full-fidelity re-runs.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory, the fidelity pairs to a second CSV next to it.
+     * Throws an exception if no low-fidelity setting is set.
+     */
+    void run() override;
+
+    /**
+     * @brief Override an FMM setting for the low-fidelity sweep.
+     * @param calc_name The 'name' field of the calculation, e.g. of the harmonics or mesh calculation.
+     * @param setting The field of its FMM settings, e.g. 'num_exp'.
+     * @param value The low-fidelity value. The full-fidelity value is the value in the model.
+     *
+     * Throws an exception if the setting cannot be located in the model.
+     */
+    void setLowFidelitySetting(const std::string &calc_name, const std::string &setting, const Json::Value &value);
+
+    /**
+     * @brief Also re-run configurations close to a constraint bound of the objective.
+     * @param margin The largest distance to a bound, in the units of the criterion. Default is 0, i.e. only the top fraction is re-run.
+     */
+    void setBoundaryMargin(double margin);
+
+    /**
+     * @brief Get the index of the best full-fidelity configuration of the last run.
+     * @return The index in the output file of the full-fidelity configuration with the lowest penalized objective, or -1 if none succeeded.
+     */
+    using ParameterSearch::getBestIndex;
+
+    /**
+     * @brief Get the objective of the best full-fidelity configuration of the last run.
+     * @return The penalized objective, infinity if no full-fidelity evaluation succeeded.
+     */
+    using ParameterSearch::getBestObjective;
+
+private:
+    /**
+     * @brief Write the pairs of low- and full-fidelity values to their own output file.
+     * @param output_file_path The path of the output file of all evaluations.
+     * @return The path of the fidelity file.
+     */
+    std::string writeFidelityFile(const std::string &output_file_path);
+
+    /**
+     * @brief A configuration evaluated at both fidelities.
+     */
+    struct FidelityPair
+    {
+        size_t low_index;
+        size_t high_index;
+        std::vector<Json::Value> config;
+        std::vector<double> low_values;
+        std::vector<double> high_values;
+    };
+
+    OptimizationObjective objective_;
+    double top_fraction_;
+    double boundary_margin_ = 0.0;
+    size_t num_model_inputs_;
+    std::vector<Json::Value> low_fidelity_values_;
+    std::vector<Json::Value> full_fidelity_values_;
+    std::vector<FidelityPair> pairs_;
+};
+
+#endif // MULTI_FIDELITY_SEARCH_H
@@ -0,0 +1,69 @@
+#ifndef MULTI_OBJECTIVE_SEARCH_H
+#define MULTI_OBJECTIVE_SEARCH_H
+
+#include "parameter_search.h"
+#include "optimization_objective.hh"
+#include "nsga2.hh"
+
+/**
+ * @class MultiObjectiveSearch
+ * @brief Class for approximating the Pareto front of several objectives of the output criteria with NSGA-II.
+ *
+ * Every objective is an `OptimizationObjective`, e.g. |b3| + |b5| for the field quality, `OutputMaxVonMises` for the mechanics
+ * and `OutputMaxZ` minus `OutputMinZ` (a term with weight -1) for the length. The constraints of all objectives must be met by every member of the front.
+ * Each generation is evaluated as one batch, i.e. in parallel if workers are set, see `ParameterSearch::setNumWorkers()`.
+ * All evaluated configurations are written to the output file in the same format as the grid search, the index column holds the evaluation number.
+ * After the run, the feasible non-dominated configurations of all evaluations are written to a second file with the suffix `_pareto.csv` in the same format.
+ * The step and time budgets of the parameter search apply; a generation is only started if it fits into the remaining step budget.
+ */
+class MultiObjectiveSearch : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct a MultiObjectiveSearch object.
+     * @param inputParamsRanges The input parameter ranges.
+     * @param outputCriteria The output criteria.
+     * @param modelHandler The model handler.
+     * @param objectives The objectives to be minimized. Must contain at least 2 objectives.
+     * @param population_size The number of configurations per generation. Must be at least 4.
+     * @param num_generations The number of generations, including the initial Latin hypercube design. Must be greater than 0.
+     * @param seed (Optional) The seed of the initial design and the variation operators. Default is 0.
+     *
+     * Throws an exception if an objective refers to output criteria that do not exist.
+     */
+    MultiObjectiveSearch(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, std::vector<OptimizationObjective> objectives, size_t population_size, size_t num_generations, uint64_t seed = 0);
+
+    /**
+     * @brief Run the multi-objective search.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory, the Pareto front to a second CSV next to it.
+     */
+    void run() override;
+
+    /**
+     * @brief Get the indices of the Pareto front of the last run.
+     * @return The indices in the output file of the feasible non-dominated configurations, in ascending order.
+     */
+    std::vector<size_t> getParetoFront() const;
+
+private:
+    /**
+     * @brief Write the Pareto front to its own output file.
+     * @param output_file_path The path of the output file of all evaluations.
+     * @return The path of the Pareto front file.
+     */
+    std::string writeParetoFile(const std::string &output_file_path);
+
+    std::vector<OptimizationObjective> objectives_;
+    size_t population_size_;
+    size_t num_generations_;
+    uint64_t seed_;
+
+    // All successful evaluations of the last run
+    std::vector<size_t> archive_indices_;
+    std::vector<std::vector<Json::Value>> archive_configs_;
+    std::vector<std::vector<double>> archive_results_;
+    std::vector<size_t> pareto_front_;
+};
+
+#endif // MULTI_OBJECTIVE_SEARCH_H
@@ -0,0 +1,273 @@
+#ifndef NELDER_MEAD_HH
+#define NELDER_MEAD_HH
+
+#include <vector>
+#include <numeric>
+#include "local_optimizer.hh"
+
+/**
+ * @class NelderMead
+ * @brief Nelder-Mead simplex method on the unit cube.
+ *
+ * Standard reflection (1), expansion (2), contraction (0.5) and shrink (0.5) coefficients. Points outside the unit cube are clamped.
+ * The initial simplex is evaluated as one batch, shrink steps as one batch of n points, all other steps ask for a single point.
+ * Converges when the spread of the objective values and the size of the simplex are below the tolerances.
+ */
+class NelderMead : public LocalOptimizer
+{
+public:
+    /**
+     * @brief Construct a NelderMead object.
+     * @param start The start point in the unit cube.
+     * @param step_size The edge length of the initial simplex. Must be greater than 0.
+     * @param tol_f (Optional) The tolerance of the spread of the objective values. Default is 1e-8.
+     * @param tol_x (Optional) The tolerance of the size of the simplex. Default is 1e-6.
+     */
+    NelderMead(const std::vector<double> &start, double step_size, double tol_f = 1e-8, double tol_x = 1e-6) : tol_f_(tol_f), tol_x_(tol_x)
+    {
+        if (start.empty())
+        {
+            throw std::invalid_argument("start cannot be empty");
+        }
+        if (!(step_size > 0.0))
+        {
+            throw std::invalid_argument("step_size must be greater than 0");
+        }
+
+        // Initial simplex along the coordinate axes, stepping inwards at the upper bound
+        size_t n = start.size();
+        simplex_.push_back(clampToUnitCube(start));
+        for (size_t i = 0; i < n; i++)
+        {
+            std::vector<double> vertex = simplex_[0];
+            vertex[i] += vertex[i] + step_size <= 1.0 ? step_size : -step_size;
+            simplex_.push_back(clampToUnitCube(vertex));
+        }
+        values_.assign(n + 1, std::numeric_limits<double>::infinity());
+    }
+
+    std::vector<std::vector<double>> ask() override
+    {
+        pending_ = getNextPoints();
+        return pending_;
+    }
+
+    void tell(const std::vector<double> &values) override
+    {
+        if (values.size() != pending_.size())
+        {
+            throw std::invalid_argument("Number of values does not match the number of points");
+        }
+        std::vector<std::vector<double>> points = pending_;
+        pending_.clear();
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            updateBest(points[i], sanitize(values[i]));
+        }
+
+        size_t n = simplex_.size() - 1;
+        double value = sanitize(values[0]);
+        switch (phase_)
+        {
+        case INIT:
+            for (size_t i = 0; i <= n; i++)
+            {
+                values_[i] = sanitize(values[i]);
+            }
+            phase_ = REFLECT;
+            break;
+        case REFLECT:
+            reflected_value_ = value;
+            if (value < values_[0])
+            {
+                phase_ = EXPAND;
+            }
+            else if (value < values_[n - 1])
+            {
+                replaceWorst(reflected_, value);
+                phase_ = REFLECT;
+            }
+            else
+            {
+                phase_ = value < values_[n] ? CONTRACT_OUTSIDE : CONTRACT_INSIDE;
+            }
+            break;
+        case EXPAND:
+            if (value < reflected_value_)
+            {
+                replaceWorst(points[0], value);
+            }
+            else
+            {
+                replaceWorst(reflected_, reflected_value_);
+            }
+            phase_ = REFLECT;
+            break;
+        case CONTRACT_OUTSIDE:
+        case CONTRACT_INSIDE:
+            if ((phase_ == CONTRACT_OUTSIDE && value <= reflected_value_) || (phase_ == CONTRACT_INSIDE && value < values_[n]))
+            {
+                replaceWorst(points[0], value);
+                phase_ = REFLECT;
+            }
+            else
+            {
+                phase_ = SHRINK;
+            }
+            break;
+        case SHRINK:
+            for (size_t i = 1; i <= n; i++)
+            {
+                simplex_[i] = points[i - 1];
+                values_[i] = sanitize(values[i - 1]);
+            }
+            phase_ = REFLECT;
+            break;
+        }
+    }
+
+    bool hasConverged() const override
+    {
+        if (phase_ == INIT)
+        {
+            return false;
+        }
+        double min_value = *std::min_element(values_.begin(), values_.end());
+        double max_value = *std::max_element(values_.begin(), values_.end());
+        if (!std::isfinite(max_value) || max_value - min_value > tol_f_)
+        {
+            return false;
+        }
+        for (size_t i = 1; i < simplex_.size(); i++)
+        {
+            for (size_t d = 0; d < simplex_[0].size(); d++)
+            {
+                if (std::abs(simplex_[i][d] - simplex_[0][d]) > tol_x_)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    enum Phase
+    {
+        INIT,
+        REFLECT,
+        EXPAND,
+        CONTRACT_OUTSIDE,
+        CONTRACT_INSIDE,
+        SHRINK
+    };
+
+    /**
+     * @brief Get the points of the current phase.
+     * @return The points to be evaluated.
+     */
+    std::vector<std::vector<double>> getNextPoints()
+    {
+        size_t n = simplex_.size() - 1;
+        switch (phase_)
+        {
+        case INIT:
+            return simplex_;
+        case REFLECT:
+        {
+            order();
+            centroid_ = getCentroid();
+            reflected_ = affine(centroid_, simplex_[n], -1.0);
+            return {reflected_};
+        }
+        case EXPAND:
+            return {affine(centroid_, reflected_, 2.0)};
+        case CONTRACT_OUTSIDE:
+            return {affine(centroid_, reflected_, 0.5)};
+        case CONTRACT_INSIDE:
+            return {affine(centroid_, simplex_[n], 0.5)};
+        case SHRINK:
+        {
+            std::vector<std::vector<double>> points;
+            for (size_t i = 1; i <= n; i++)
+            {
+                points.push_back(affine(simplex_[0], simplex_[i], 0.5));
+            }
+            return points;
+        }
+        }
+        return {};
+    }
+
+    /**
+     * @brief Sort the simplex by objective value, best first.
+     */
+    void order()
+    {
+        std::vector<size_t> idx(values_.size());
+        std::iota(idx.begin(), idx.end(), 0);
+        std::stable_sort(idx.begin(), idx.end(), [this](size_t a, size_t b)
+                         { return values_[a] < values_[b]; });
+        std::vector<std::vector<double>> simplex;
+        std::vector<double> values;
+        for (size_t i : idx)
+        {
+            simplex.push_back(simplex_[i]);
+            values.push_back(values_[i]);
+        }
+        simplex_ = simplex;
+        values_ = values;
+    }
+
+    /**
+     * @brief Get the centroid of all vertices but the worst.
+     * @return The centroid.
+     */
+    std::vector<double> getCentroid() const
+    {
+        size_t n = simplex_.size() - 1;
+        std::vector<double> centroid(simplex_[0].size(), 0.0);
+        for (size_t i = 0; i < n; i++)
+        {
+            for (size_t d = 0; d < centroid.size(); d++)
+            {
+                centroid[d] += simplex_[i][d] / n;
+            }
+        }
+        return centroid;
+    }
+
+    /**
+     * @brief Get the clamped point a + t * (b - a).
+     */
+    static std::vector<double> affine(const std::vector<double> &a, const std::vector<double> &b, double t)
+    {
+        std::vector<double> point(a.size());
+        for (size_t d = 0; d < a.size(); d++)
+        {
+            point[d] = a[d] + t * (b[d] - a[d]);
+        }
+        return clampToUnitCube(point);
+    }
+
+    /**
+     * @brief Replace the worst vertex of the ordered simplex.
+     */
+    void replaceWorst(const std::vector<double> &point, double value)
+    {
+        simplex_.back() = point;
+        values_.back() = value;
+    }
+
+    double tol_f_;
+    double tol_x_;
+    Phase phase_ = INIT;
+    std::vector<std::vector<double>> simplex_;
+    std::vector<double> values_;
+    std::vector<std::vector<double>> pending_;
+    std::vector<double> centroid_;
+    std::vector<double> reflected_;
+    double reflected_value_ = std::numeric_limits<double>::infinity();
+};
+
+#endif // NELDER_MEAD_HH
@@ -0,0 +1,356 @@
+#ifndef NSGA2_HH
+#define NSGA2_HH
+
+#include <vector>
+#include <random>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include "sampler.hh"
+
+/**
+ * @class NSGA2
+ * @brief Non-dominated sorting genetic algorithm II on the unit cube in ask-and-tell form.
+ *
+ * Deb et al., "A fast and elitist multiobjective genetic algorithm: NSGA-II", IEEE TEC 6(2), 2002.
+ * `ask()` returns a generation (a Latin hypercube design for the first one, offspring by binary tournament selection,
+ * simulated binary crossover and polynomial mutation afterwards), `tell()` takes the objective values and constraint violations
+ * of the generation and selects the next parents from parents and offspring by non-dominated rank and crowding distance.
+ * Constraints are handled by constrained domination: a feasible individual dominates an infeasible one, and of two infeasible individuals
+ * the one with the smaller violation dominates. All objectives are minimized. Failed evaluations are passed with infinite violation.
+ */
+class NSGA2
+{
+public:
+    /**
+     * @brief Construct a NSGA2 object.
+     * @param num_dims The number of dimensions. Must be at least 1.
+     * @param population_size The population size. Must be at least 4.
+     * @param seed The seed of the random number generator.
+     */
+    NSGA2(size_t num_dims, size_t population_size, uint64_t seed) : num_dims_(num_dims), population_size_(population_size), rng_(seed)
+    {
+        if (num_dims < 1)
+        {
+            throw std::invalid_argument("num_dims must be at least 1");
+        }
+        if (population_size < 4)
+        {
+            throw std::invalid_argument("population_size must be at least 4");
+        }
+    }
+
+    /**
+     * @brief Get the next generation to be evaluated.
+     * @return The points of the generation.
+     */
+    std::vector<std::vector<double>> ask()
+    {
+        if (parents_.empty())
+        {
+            offspring_ = LatinHypercubeSampler(rng_()).generate(population_size_, num_dims_);
+            return offspring_;
+        }
+
+        offspring_.clear();
+        while (offspring_.size() < population_size_)
+        {
+            const Individual &a = tournament();
+            const Individual &b = tournament();
+            std::pair<std::vector<double>, std::vector<double>> children = crossover(a.point, b.point);
+            mutate(children.first);
+            mutate(children.second);
+            offspring_.push_back(children.first);
+            if (offspring_.size() < population_size_)
+            {
+                offspring_.push_back(children.second);
+            }
+        }
+        return offspring_;
+    }
+
+    /**
+     * @brief Pass the results of the generation of the last `ask()`.
+     * @param objectives The objective values of each point.
+     * @param violations The constraint violation of each point, 0 for feasible points.
+     *
+     * Throws an exception if the number of results does not match the generation.
+     */
+    void tell(const std::vector<std::vector<double>> &objectives, const std::vector<double> &violations)
+    {
+        if (objectives.size() != offspring_.size() || violations.size() != offspring_.size() || offspring_.empty())
+        {
+            throw std::invalid_argument("Number of results does not match the generation size");
+        }
+
+        std::vector<Individual> combined = parents_;
+        for (size_t i = 0; i < offspring_.size(); i++)
+        {
+            combined.push_back({offspring_[i], objectives[i], std::isnan(violations[i]) ? std::numeric_limits<double>::infinity() : violations[i], 0, 0.0});
+        }
+        offspring_.clear();
+
+        // Select the next parents front by front, the last front by crowding distance
+        std::vector<std::vector<size_t>> fronts = nonDominatedSort(getObjectives(combined), getViolations(combined));
+        parents_.clear();
+        for (size_t rank = 0; rank < fronts.size() && parents_.size() < population_size_; rank++)
+        {
+            std::vector<double> distances = crowdingDistance(fronts[rank], getObjectives(combined));
+            std::vector<size_t> order(fronts[rank].size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&distances](size_t a, size_t b)
+                             { return distances[a] > distances[b]; });
+            for (size_t k = 0; k < order.size() && parents_.size() < population_size_; k++)
+            {
+                Individual individual = combined[fronts[rank][order[k]]];
+                individual.rank = rank;
+                individual.crowding = distances[order[k]];
+                parents_.push_back(individual);
+            }
+        }
+        generation_++;
+    }
+
+    /**
+     * @brief Get the number of completed generations.
+     * @return The number of generations passed to `tell()`.
+     */
+    size_t getGeneration() const
+    {
+        return generation_;
+    }
+
+    /**
+     * @brief Check whether a objective vector dominates another under constrained domination.
+     * @param a The objectives of the first individual.
+     * @param violation_a The constraint violation of the first individual.
+     * @param b The objectives of the second individual.
+     * @param violation_b The constraint violation of the second individual.
+     * @return True if the first individual dominates the second.
+     */
+    static bool dominates(const std::vector<double> &a, double violation_a, const std::vector<double> &b, double violation_b)
+    {
+        if (violation_a > 0.0 || violation_b > 0.0)
+        {
+            return violation_a < violation_b;
+        }
+        bool strictly_better = false;
+        for (size_t m = 0; m < a.size(); m++)
+        {
+            if (!(a[m] <= b[m]))
+            {
+                return false;
+            }
+            strictly_better = strictly_better || a[m] < b[m];
+        }
+        return strictly_better;
+    }
+
+    /**
+     * @brief Sort individuals into non-dominated fronts.
+     * @param objectives The objective values of each individual.
+     * @param violations The constraint violation of each individual.
+     * @return The positions of the individuals of each front, best front first.
+     */
+    static std::vector<std::vector<size_t>> nonDominatedSort(const std::vector<std::vector<double>> &objectives, const std::vector<double> &violations)
+    {
+        size_t n = objectives.size();
+        std::vector<std::vector<size_t>> dominated(n);
+        std::vector<size_t> domination_count(n, 0);
+        std::vector<std::vector<size_t>> fronts(1);
+
+        for (size_t p = 0; p < n; p++)
+        {
+            for (size_t q = 0; q < n; q++)
+            {
+                if (p == q)
+                {
+                    continue;
+                }
+                if (dominates(objectives[p], violations[p], objectives[q], violations[q]))
+                {
+                    dominated[p].push_back(q);
+                }
+                else if (dominates(objectives[q], violations[q], objectives[p], violations[p]))
+                {
+                    domination_count[p]++;
+                }
+            }
+            if (domination_count[p] == 0)
+            {
+                fronts[0].push_back(p);
+            }
+        }
+
+        while (!fronts.back().empty())
+        {
+            std::vector<size_t> next;
+            for (size_t p : fronts.back())
+            {
+                for (size_t q : dominated[p])
+                {
+                    if (--domination_count[q] == 0)
+                    {
+                        next.push_back(q);
+                    }
+                }
+            }
+            fronts.push_back(next);
+        }
+        fronts.pop_back();
+        return fronts;
+    }
+
+    /**
+     * @brief Compute the crowding distance of the individuals of a front.
+     * @param front The positions of the individuals of the front.
+     * @param objectives The objective values of all individuals.
+     * @return The crowding distance of each individual of the front, infinity at the boundaries.
+     */
+    static std::vector<double> crowdingDistance(const std::vector<size_t> &front, const std::vector<std::vector<double>> &objectives)
+    {
+        std::vector<double> distances(front.size(), 0.0);
+        if (front.size() <= 2)
+        {
+            std::fill(distances.begin(), distances.end(), std::numeric_limits<double>::infinity());
+            return distances;
+        }
+
+        size_t num_objectives = objectives[front[0]].size();
+        std::vector<size_t> order(front.size());
+        for (size_t m = 0; m < num_objectives; m++)
+        {
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                      { return objectives[front[a]][m] < objectives[front[b]][m]; });
+
+            double min_value = objectives[front[order.front()]][m];
+            double max_value = objectives[front[order.back()]][m];
+            distances[order.front()] = std::numeric_limits<double>::infinity();
+            distances[order.back()] = std::numeric_limits<double>::infinity();
+            if (!(max_value > min_value) || !std::isfinite(max_value - min_value))
+            {
+                continue;
+            }
+            for (size_t k = 1; k + 1 < order.size(); k++)
+            {
+                distances[order[k]] += (objectives[front[order[k + 1]]][m] - objectives[front[order[k - 1]]][m]) / (max_value - min_value);
+            }
+        }
+        return distances;
+    }
+
+private:
+    /**
+     * @brief Individual of the population.
+     */
+    struct Individual
+    {
+        std::vector<double> point;
+        std::vector<double> objectives;
+        double violation;
+        size_t rank;
+        double crowding;
+    };
+
+    /**
+     * @brief Binary tournament selection by rank and crowding distance.
+     * @return The selected parent.
+     */
+    const Individual &tournament()
+    {
+        std::uniform_int_distribution<size_t> pick(0, parents_.size() - 1);
+        const Individual &a = parents_[pick(rng_)];
+        const Individual &b = parents_[pick(rng_)];
+        if (a.rank != b.rank)
+        {
+            return a.rank < b.rank ? a : b;
+        }
+        return a.crowding >= b.crowding ? a : b;
+    }
+
+    /**
+     * @brief Simulated binary crossover.
+     */
+    std::pair<std::vector<double>, std::vector<double>> crossover(const std::vector<double> &a, const std::vector<double> &b)
+    {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<double> c1 = a;
+        std::vector<double> c2 = b;
+        if (uniform(rng_) > CROSSOVER_PROBABILITY)
+        {
+            return {c1, c2};
+        }
+        for (size_t i = 0; i < num_dims_; i++)
+        {
+            if (uniform(rng_) > 0.5)
+            {
+                continue;
+            }
+            double u = uniform(rng_);
+            double beta = u <= 0.5 ? std::pow(2.0 * u, 1.0 / (ETA_CROSSOVER + 1.0)) : std::pow(1.0 / (2.0 * (1.0 - u)), 1.0 / (ETA_CROSSOVER + 1.0));
+            c1[i] = clamp(0.5 * ((1.0 + beta) * a[i] + (1.0 - beta) * b[i]));
+            c2[i] = clamp(0.5 * ((1.0 - beta) * a[i] + (1.0 + beta) * b[i]));
+        }
+        return {c1, c2};
+    }
+
+    /**
+     * @brief Polynomial mutation with probability 1 / num_dims per coordinate.
+     */
+    void mutate(std::vector<double> &x)
+    {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (size_t i = 0; i < num_dims_; i++)
+        {
+            if (uniform(rng_) > 1.0 / num_dims_)
+            {
+                continue;
+            }
+            double u = uniform(rng_);
+            double delta = u < 0.5 ? std::pow(2.0 * u, 1.0 / (ETA_MUTATION + 1.0)) - 1.0 : 1.0 - std::pow(2.0 * (1.0 - u), 1.0 / (ETA_MUTATION + 1.0));
+            x[i] = clamp(x[i] + delta);
+        }
+    }
+
+    static double clamp(double x)
+    {
+        return std::min(std::max(x, 0.0), 1.0);
+    }
+
+    static std::vector<std::vector<double>> getObjectives(const std::vector<Individual> &individuals)
+    {
+        std::vector<std::vector<double>> objectives;
+        for (const Individual &individual : individuals)
+        {
+            objectives.push_back(individual.objectives);
+        }
+        return objectives;
+    }
+
+    static std::vector<double> getViolations(const std::vector<Individual> &individuals)
+    {
+        std::vector<double> violations;
+        for (const Individual &individual : individuals)
+        {
+            violations.push_back(individual.violation);
+        }
+        return violations;
+    }
+
+    static constexpr double CROSSOVER_PROBABILITY = 0.9;
+    static constexpr double ETA_CROSSOVER = 15.0;
+    static constexpr double ETA_MUTATION = 20.0;
+
+    size_t num_dims_;
+    size_t population_size_;
+    std::mt19937_64 rng_;
+    size_t generation_ = 0;
+    std::vector<Individual> parents_;
+    std::vector<std::vector<double>> offspring_;
+};
+
+#endif // NSGA2_HH
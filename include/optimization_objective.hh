@@ -0,0 +1,185 @@
+#ifndef OPTIMIZATION_OBJECTIVE_HH
+#define OPTIMIZATION_OBJECTIVE_HH
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+
+/**
+ * @class OptimizationObjective
+ * @brief Class for combining the output criteria into an objective to be minimized.
+ *
+ * The objective is a weighted sum of output criteria, optionally of their absolute values, e.g. |b3| + |b5|.
+ * Constraints bound single output criteria from above or below, e.g. max_von_mises <= limit.
+ * Output criteria are referred to by their position in the output criteria vector of the parameter search.
+ */
+class OptimizationObjective
+{
+public:
+    /**
+     * @brief Add a term to the objective.
+     * @param criterion_index The position of the output criterion.
+     * @param weight (Optional) The weight of the term. Default is 1.
+     * @param absolute (Optional) Whether the absolute value of the criterion is used. Default is false.
+     */
+    void addTerm(size_t criterion_index, double weight = 1.0, bool absolute = false)
+    {
+        terms_.push_back({criterion_index, weight, absolute});
+    }
+
+    /**
+     * @brief Add an upper bound constraint.
+     * @param criterion_index The position of the output criterion.
+     * @param bound The criterion must be less than or equal to this value.
+     */
+    void addUpperBound(size_t criterion_index, double bound)
+    {
+        constraints_.push_back({criterion_index, bound, true});
+    }
+
+    /**
+     * @brief Add a lower bound constraint.
+     * @param criterion_index The position of the output criterion.
+     * @param bound The criterion must be greater than or equal to this value.
+     */
+    void addLowerBound(size_t criterion_index, double bound)
+    {
+        constraints_.push_back({criterion_index, bound, false});
+    }
+
+    /**
+     * @brief Get the number of constraints.
+     * @return The number of constraints.
+     */
+    size_t getNumConstraints() const
+    {
+        return constraints_.size();
+    }
+
+    /**
+     * @brief Check that all criterion positions are valid.
+     * @param num_criteria The number of output criteria.
+     *
+     * Throws an exception if the objective has no terms or refers to a criterion position that does not exist.
+     */
+    void validate(size_t num_criteria) const
+    {
+        if (terms_.empty())
+        {
+            throw std::invalid_argument("Objective must have at least one term");
+        }
+        for (const Term &term : terms_)
+        {
+            if (term.criterion_index >= num_criteria)
+            {
+                throw std::invalid_argument("Objective term refers to criterion " + std::to_string(term.criterion_index) + " which does not exist");
+            }
+        }
+        for (const Constraint &constraint : constraints_)
+        {
+            if (constraint.criterion_index >= num_criteria)
+            {
+                throw std::invalid_argument("Constraint refers to criterion " + std::to_string(constraint.criterion_index) + " which does not exist");
+            }
+        }
+    }
+
+    /**
+     * @brief Evaluate the objective.
+     * @param criterion_values The values of the output criteria.
+     * @return The value of the objective.
+     */
+    double evaluate(const std::vector<double> &criterion_values) const
+    {
+        double value = 0.0;
+        for (const Term &term : terms_)
+        {
+            double criterion = criterion_values.at(term.criterion_index);
+            value += term.weight * (term.absolute ? std::abs(criterion) : criterion);
+        }
+        return value;
+    }
+
+    /**
+     * @brief Set the penalty weight of constraint violations.
+     * @param penalty_weight The weight of the summed constraint violations in `getPenalizedValue()`. Default is 1e6.
+     */
+    void setPenaltyWeight(double penalty_weight)
+    {
+        penalty_weight_ = penalty_weight;
+    }
+
+    /**
+     * @brief Evaluate the objective with a penalty for violated constraints.
+     * @param criterion_values The values of the output criteria.
+     * @return The value of the objective plus the penalty weight times the sum of the constraint violations.
+     *
+     * Used by optimizers that do not model the constraints themselves.
+     */
+    double getPenalizedValue(const std::vector<double> &criterion_values) const
+    {
+        double violation = 0.0;
+        for (double slack : getConstraintSlacks(criterion_values))
+        {
+            violation += std::max(-slack, 0.0);
+        }
+        return evaluate(criterion_values) + penalty_weight_ * violation;
+    }
+
+    /**
+     * @brief Get the slacks of the constraints.
+     * @param criterion_values The values of the output criteria.
+     * @return The slack of each constraint, i.e. the distance to its bound. Non-negative slacks are feasible.
+     */
+    std::vector<double> getConstraintSlacks(const std::vector<double> &criterion_values) const
+    {
+        std::vector<double> slacks;
+        slacks.reserve(constraints_.size());
+        for (const Constraint &constraint : constraints_)
+        {
+            double criterion = criterion_values.at(constraint.criterion_index);
+            slacks.push_back(constraint.is_upper ? constraint.bound - criterion : criterion - constraint.bound);
+        }
+        return slacks;
+    }
+
+    /**
+     * @brief Check whether all constraints are met.
+     * @param criterion_values The values of the output criteria.
+     * @return True if all constraints are met.
+     */
+    bool isFeasible(const std::vector<double> &criterion_values) const
+    {
+        for (double slack : getConstraintSlacks(criterion_values))
+        {
+            if (!(slack >= 0.0))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct Term
+    {
+        size_t criterion_index;
+        double weight;
+        bool absolute;
+    };
+
+    struct Constraint
+    {
+        size_t criterion_index;
+        double bound;
+        bool is_upper;
+    };
+
+    std::vector<Term> terms_;
+    std::vector<Constraint> constraints_;
+    double penalty_weight_ = 1e6;
+};
+
+#endif // OPTIMIZATION_OBJECTIVE_HH
@@ -44,6 +44,10 @@ public:
         return value;
     }
 
+    size_t getMaxHarmonicOrder() override {
+        return n_poles_;
+    }
+
 private:
     size_t n_poles_;
 
@@ -0,0 +1,43 @@
+#ifndef OUTPUT_CONDUCTOR_LENGTH_HH
+#define OUTPUT_CONDUCTOR_LENGTH_HH
+
+#include "output_criterion_interface.h"
+#include "geometry_data_handler.h"
+#include <json/json.h>
+
+/**
+ * @class OutputConductorLength
+ * @brief Class for defining the total conductor length (m) of the coils in the model as an output criterion.
+ */
+class OutputConductorLength : public OutputCriterionInterface
+{
+public:
+    /**
+     * @brief Construct a new OutputConductorLength object.
+     *
+     * Construct a new OutputConductorLength object. This object will compute the sum of the lengths of the input paths of all enabled coils.
+     * Only the geometry is built, no field is calculated.
+     */
+    OutputConductorLength()
+    {
+        column_name_ = "conductor_length";
+        required_calculations_ = {std::type_index(typeid(GeometryDataHandler))};
+    }
+
+    double computeCriterion(std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> calcResults)
+    {
+        // Assert that the passed calculation result handlers are of the correct type
+        if (!checkCalcResultHandlerTypes(calcResults))
+        {
+            throw std::runtime_error("Calculation result handlers of the wrong type have been passed to the conductor length criterion.");
+        }
+
+        // Extract the geometry data handler from the calculation result handlers
+        auto geometry_data_handler = std::dynamic_pointer_cast<GeometryDataHandler>(calcResults[0]);
+
+        // Return the value
+        return geometry_data_handler->getConductorLength();
+    }
+};
+
+#endif // OUTPUT_CONDUCTOR_LENGTH_HH
@@ -7,6 +7,7 @@
 #include <memory>
 #include <rat/models/calc.hh>
 #include <any>
+#include <json/json.h>
 #include <calc_result_handler_base.h>
 
 
@@ -51,6 +52,55 @@ public:
      */
     virtual double computeCriterion(std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> calcResults) = 0;
 
+    /**
+     * @brief Get the highest multipole order the criterion reads from the harmonics calculation.
+     * @return The order, or 0 if the criterion does not declare it (e.g. it reads all orders).
+     *
+     * Only relevant for criteria that require the harmonics calculation, see `ParameterSearch::getMaxHarmonicOrder()`.
+     */
+    virtual size_t getMaxHarmonicOrder(){
+        return 0;
+    }
+
+    /**
+     * @brief Set the index of the step whose criteria are computed next.
+     * @param index The index of the step in the output file of the parameter search.
+     *
+     * Called by the parameter search before the criteria of a step are computed, e.g. to name files written per step.
+     * Steps on parallel workers do not set the index, so criteria that use it must not support parallel evaluation, see `supportsParallelEvaluation()`.
+     */
+    virtual void setStepIndex(size_t index){
+    }
+
+    /**
+     * @brief Get the state that the last computation left in the criterion.
+     * @return The state as JSON value, null if the criterion keeps no state.
+     *
+     * Steps with a timeout compute the criteria in a child process, see `ParameterSearch::setCalculationTimeout()`.
+     * The parameter search sends the state of every criterion back from the child and restores it with `setState()`,
+     * so that getters of the criterion report the last computation. Steps that time out do not return a state.
+     */
+    virtual Json::Value getState(){
+        return Json::Value();
+    }
+
+    /**
+     * @brief Restore a state returned by `getState()`.
+     * @param state The state as JSON value, never null.
+     */
+    virtual void setState(const Json::Value &state){
+    }
+
+    /**
+     * @brief Check whether the criterion can be computed on parallel workers.
+     * @return True if the criterion only depends on the passed calculation results.
+     *
+     * Criteria that keep their own reference to the model of the parameter search must return false, the parameter search then evaluates all steps serially.
+     */
+    virtual bool supportsParallelEvaluation(){
+        return true;
+    }
+
     /**
      * @brief Assert that the calculation result handler types match the required types.
      * @param calcResults The calculation result handlers to be checked.
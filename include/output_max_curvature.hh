@@ -32,6 +32,8 @@ public:
      * Construct a new OutputMaxCurvature object.
      * This object will compute the max curvature in the magnet with respect to the 'magnitude' field component.
      * Only curvature values for nodes inside `filter_cube` will be considered.
+     * The cube filters the results only: the mesh calculation still computes the field on the whole mesh,
+     * because the calcmesh node of the model uses the same meshes as sources and targets and has no setting to restrict the targets.
      */
     OutputMaxCurvature(Cube3DFactory &filter_cube, std::string column_suffix="") : filter_cube_(filter_cube.getCube())
     {
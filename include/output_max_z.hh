@@ -2,7 +2,7 @@
 #define OUTPUT_MAX_Z_HH
 
 #include "output_criterion_interface.h"
-#include "mesh_data_handler.h"
+#include "geometry_data_handler.h"
 #include <json/json.h>
 
 /**
@@ -20,7 +20,7 @@ public:
     OutputMaxZ()
     {
         column_name_ = "z_max";
-        required_calculations_ = {std::type_index(typeid(CCTools::MeshDataHandler))};
+        required_calculations_ = {std::type_index(typeid(GeometryDataHandler))};
     }
 
     double computeCriterion(std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> calcResults)
@@ -31,11 +31,11 @@ public:
             throw std::runtime_error("Calculation result handlers of the wrong type have been passed to the max Z criterion.");
         }
 
-        // Extract the mesh data handler from the calculation result handlers
-        auto mesh_data_handler = std::dynamic_pointer_cast<CCTools::MeshDataHandler>(calcResults[0]);
+        // Extract the geometry data handler from the calculation result handlers
+        auto geometry_data_handler = std::dynamic_pointer_cast<GeometryDataHandler>(calcResults[0]);
 
         // Get the max_z value
-        auto max_z = mesh_data_handler->getMinMaxZValues().second;
+        auto max_z = geometry_data_handler->getMinMaxZValues().second;
 
         // Return the value
         return max_z;
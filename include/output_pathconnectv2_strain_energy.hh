@@ -6,7 +6,13 @@
 #include <json/json.h>
 #include <rat/models/pathconnect2.hh>
 #include <rat/models/path.hh>
+#include <thread>
+#include <exception>
+#include <cmath>
+#include <filesystem>
 #include "CustomIterationLog.hh"
+#include "iteration_observer.hh"
+#include "json_range.hh"
 
 using CCTools::Logger;
 
@@ -17,23 +23,56 @@ using CCTools::Logger;
 class OutputPathConnectV2StrainEnergy : public OutputCriterionInterface
 {
 public:
+    /**
+     * @brief Statistics of the optimizer starts of the last computation.
+     */
+    struct MultiStartResult
+    {
+        size_t best_start;         /**< Index of the start with the lowest strain energy (start 0 is the configured state) */
+        double best;               /**< Lowest strain energy of all successful starts */
+        double worst;              /**< Highest strain energy of all successful starts */
+        double mean;               /**< Mean strain energy of all successful starts */
+        double stddev;             /**< Standard deviation of the strain energy of all successful starts */
+        size_t num_failed;         /**< Number of starts that threw an exception */
+        std::vector<double> fvals; /**< Strain energy of every start, NaN for failed starts */
+    };
+
     /**
      * @brief Construct a new OutputPathConnectV2StrainEnergy object.
      * @param model_calculator The model calculator.
      * @param findConnectV2 The function to find the pathconnect2 node in the model tree.
      * @param column_suffix (Optional) String to append to the column name. Default column name is 'pathconnect2_strain_energy'.
+     * @param num_starts (Optional) Number of optimizer starts per computation. Default is 1.
      *
      * Construct a new OutputPathConnectV2StrainEnergy object.
      * This object will compute the objective function (integrated strain energy) of a pathconnect2 optimizer.
      * For every output calculation, the model calculator will be re-loaded to extract the current model tree and
      * the pathconnect2 node will be found in the model tree using the `findConnectV2` function.
+     *
+     * If `num_starts` is greater than 1, the optimizer is run `num_starts` times concurrently on separate threads for the same model state.
+     * The first start uses the configuration set in the input param range, the other starts use random configurations (see `JsonRange::pathconnect2_range()`).
+     * The lowest strain energy is returned, the spread of all starts is logged and can be retrieved with `getLastMultiStartResult()`.
      */
-    OutputPathConnectV2StrainEnergy(CCTools::ModelCalculator model_calculator, rat::mdl::ShPathConnect2Pr (*findConnectV2)(rat::mdl::ShModelGroupPr), std::string column_suffix = "") : model_calculator_(model_calculator), findConnectV2_(findConnectV2)
+    OutputPathConnectV2StrainEnergy(CCTools::ModelCalculator model_calculator, rat::mdl::ShPathConnect2Pr (*findConnectV2)(rat::mdl::ShModelGroupPr), std::string column_suffix = "", size_t num_starts = 1) : model_calculator_(model_calculator), findConnectV2_(findConnectV2), num_starts_(num_starts)
     {
+        if (num_starts_ < 1)
+        {
+            throw std::invalid_argument("num_starts must be greater than 0");
+        }
+
         column_name_ = "pathconnect2_strain_energy" + column_suffix;
         required_calculations_ = {};
     }
 
+    /**
+     * @brief The criterion reloads the model from its own model calculator, which always points to the model of the parameter search.
+     * @return False, the parameter search evaluates all steps serially.
+     */
+    bool supportsParallelEvaluation() override
+    {
+        return false;
+    }
+
     double computeCriterion(std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> calcResults)
     {
         // Assert that the passed calculation result handlers are of the correct type
@@ -42,47 +81,308 @@ public:
             throw std::runtime_error("Calculation result handlers of the wrong type have been passed to the pathconnect2 strain energy criterion.");
         }
 
-        // Reload the model calculator and extract the connectV2
-        model_calculator_.reload();
-        rat::mdl::ShModelGroupPr model_tree = model_calculator_.get_model_tree();
-        rat::mdl::ShPathConnect2Pr connectV2 = findConnectV2_(model_tree);
+        // Load one independent model tree per start. Loading is done sequentially, only the optimizations run concurrently.
+        std::vector<rat::mdl::ShPathConnect2Pr> connectV2_starts(num_starts_);
+        for (size_t k = 0; k < num_starts_; k++)
+        {
+            CCTools::ModelCalculator start_calculator = model_calculator_;
+            start_calculator.reload();
+            connectV2_starts[k] = findConnectV2_(start_calculator.get_model_tree());
+        }
+
+        // Set the random start configurations. The first start keeps the configuration set in the input param range.
+        if (num_starts_ > 1)
+        {
+            // pathconnect2_range() changes the uvw of the node it is called on, use the last node as it is configured afterwards
+            std::vector<Json::Value> start_configs = JsonRange::pathconnect2_range(connectV2_starts.back(), num_starts_);
+            for (size_t k = 1; k < num_starts_; k++)
+            {
+                JsonRange::pathconnect2_apply_config(connectV2_starts[k], start_configs[k]);
+            }
+        }
+
+        // Run all optimizations
+        std::vector<OptimizationResult> results(num_starts_);
+        std::vector<std::exception_ptr> errors(num_starts_, nullptr);
+        if (num_starts_ == 1)
+        {
+            results[0] = optimize(connectV2_starts[0], history_capacity_);
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+            for (size_t k = 0; k < num_starts_; k++)
+            {
+                threads.emplace_back([&, k]()
+                                     {
+                    try
+                    {
+                        results[k] = optimize(connectV2_starts[k], history_capacity_);
+                    }
+                    catch (...)
+                    {
+                        errors[k] = std::current_exception();
+                    } });
+            }
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        // Keep the best result and compute the spread
+        last_multi_start_result_ = summarizeStarts(results, errors);
+        const OptimizationResult &best = results[last_multi_start_result_.best_start];
+        last_iteration_history_ = best.history;
+
+        // Export the iteration histories
+        if (!history_export_dir_.empty())
+        {
+            exportIterationHistories(results, errors);
+        }
+
+        // Log all values
+        Logger::info("Strain energy: " + std::to_string(best.values.fval));
+        Logger::info("Edge regression constraint: " + std::to_string(best.values.ercf));
+        Logger::info("Length constraint: " + std::to_string(best.values.lcf));
+        Logger::info("Curvature constraint: " + std::to_string(best.values.has_ccf ? best.values.ccf : 0.0));
+
+        if (num_starts_ > 1)
+        {
+            Logger::info("Best start: " + std::to_string(last_multi_start_result_.best_start) + " / " + std::to_string(num_starts_ - 1) +
+                         ", failed starts: " + std::to_string(last_multi_start_result_.num_failed));
+            Logger::info("Strain energy spread: min " + std::to_string(last_multi_start_result_.best) +
+                         ", max " + std::to_string(last_multi_start_result_.worst) +
+                         ", mean " + std::to_string(last_multi_start_result_.mean) +
+                         ", stddev " + std::to_string(last_multi_start_result_.stddev));
+        }
+
+        // Log the uvw configuration
+        Logger::info("uvw1:\n" + matrix_to_string(best.uvw1));
+        Logger::info("uvw2:\n" + matrix_to_string(best.uvw2));
+
+        // return fval
+        return best.values.fval;
+    }
+
+    void setStepIndex(size_t index) override
+    {
+        step_index_ = index;
+    }
+
+    /**
+     * @brief Get the multi-start statistics and the iteration history of the last computation.
+     * @return The state as JSON value, null if no computation has been done yet.
+     */
+    Json::Value getState() override
+    {
+        if (!last_iteration_history_)
+        {
+            return Json::Value();
+        }
+        Json::Value state;
+        state["best_start"] = static_cast<Json::UInt64>(last_multi_start_result_.best_start);
+        state["best"] = last_multi_start_result_.best;
+        state["worst"] = last_multi_start_result_.worst;
+        state["mean"] = last_multi_start_result_.mean;
+        state["stddev"] = last_multi_start_result_.stddev;
+        state["num_failed"] = static_cast<Json::UInt64>(last_multi_start_result_.num_failed);
+        state["fvals"] = Json::Value(Json::arrayValue);
+        for (double fval : last_multi_start_result_.fvals)
+        {
+            state["fvals"].append(fval);
+        }
+        state["history"] = Json::Value(Json::arrayValue);
+        for (size_t i = 0; i < last_iteration_history_->size(); i++)
+        {
+            const OptimizerIterationValues &values = last_iteration_history_->at(i);
+            Json::Value iteration(Json::arrayValue);
+            iteration.append(values.iter);
+            iteration.append(values.fval);
+            iteration.append(values.ercf);
+            iteration.append(values.lcf);
+            iteration.append(values.has_ccf ? Json::Value(values.ccf) : Json::Value());
+            state["history"].append(iteration);
+        }
+        return state;
+    }
+
+    void setState(const Json::Value &state) override
+    {
+        last_multi_start_result_.best_start = state["best_start"].asUInt64();
+        last_multi_start_result_.best = state["best"].asDouble();
+        last_multi_start_result_.worst = state["worst"].asDouble();
+        last_multi_start_result_.mean = state["mean"].asDouble();
+        last_multi_start_result_.stddev = state["stddev"].asDouble();
+        last_multi_start_result_.num_failed = state["num_failed"].asUInt64();
+        last_multi_start_result_.fvals.clear();
+        for (const Json::Value &fval : state["fvals"])
+        {
+            last_multi_start_result_.fvals.push_back(fval.asDouble());
+        }
+        auto history = std::make_shared<IterationHistory>(state["history"].size());
+        for (const Json::Value &iteration : state["history"])
+        {
+            history->onIteration(OptimizerIterationValues{iteration[0].asInt(), iteration[1].asDouble(), iteration[2].asDouble(), iteration[3].asDouble(),
+                                                          iteration[4].isNull() ? 0.0 : iteration[4].asDouble(), !iteration[4].isNull()});
+        }
+        last_iteration_history_ = history;
+    }
 
-        // set use_previous to true so that the strain energy is computed with configuration set in the input param range
+    /**
+     * @brief Get the statistics of the optimizer starts of the last computation.
+     * @return The multi-start statistics. For a single start, the statistics contain only that start.
+     */
+    MultiStartResult getLastMultiStartResult() const
+    {
+        return last_multi_start_result_;
+    }
+
+    /**
+     * @brief Get the iteration history of the best start of the last computation.
+     * @return The iteration history, nullptr if no computation has been done yet.
+     */
+    std::shared_ptr<const IterationHistory> getLastIterationHistory() const
+    {
+        return last_iteration_history_;
+    }
+
+    /**
+     * @brief Export the iteration history of every computation to CSV files.
+     * @param directory The directory for the CSV files. Will be created if it does not exist.
+     * @param capacity (Optional) The number of iterations to preallocate per start. Default is 1024.
+     *
+     * After every computation, the iteration histories of all starts are written to `<directory>/<column name>_history_<step index>.csv`
+     * with the columns `start,iter,fval,ercf,lcf,ccf`. The step index is the index of the step in the output file of the parameter search,
+     * see `setStepIndex()`, and 0 if the criterion is computed outside a parameter search.
+     */
+    void enableIterationHistoryExport(const std::string &directory, size_t capacity = 1024)
+    {
+        history_export_dir_ = directory;
+        history_capacity_ = capacity;
+    }
+
+private:
+    /**
+     * @brief Result of a single optimizer start.
+     */
+    struct OptimizationResult
+    {
+        CustomIterationLog::IterationValues values;
+        std::shared_ptr<IterationHistory> history;
+        arma::dmat uvw1;
+        arma::dmat uvw2;
+    };
+
+    /**
+     * @brief Run the optimization for one pathconnect2 node.
+     * @param connectV2 The pathconnect2 node. Its current uvw configuration is used as the start.
+     * @param history_capacity The number of iterations to preallocate for the iteration history.
+     * @return The values of the last iteration, the iteration history and the optimized uvw configuration.
+     */
+    static OptimizationResult optimize(rat::mdl::ShPathConnect2Pr connectV2, size_t history_capacity)
+    {
+        // set use_previous to true so that the strain energy is computed with the configuration of the node
         connectV2->set_use_previous(true);
 
-        // Create custom logger. Does not log anything but captures the last iteration values.
+        OptimizationResult result;
+
+        // Create custom logger. Does not log anything but captures the iteration values into the history.
         std::shared_ptr<CustomIterationLog> custom_logger = std::make_shared<CustomIterationLog>();
+        result.history = std::make_shared<IterationHistory>(history_capacity);
+        custom_logger->setObserver(result.history);
 
         // call the optimization
         connectV2->optimize_control_points(custom_logger);
 
-        // get all values from the last iteration
-        CustomIterationLog::IterationValues last_values = custom_logger->get_last_iteration_values();
+        // get all values from the last iteration and the uvw configuration
+        result.values = custom_logger->get_last_iteration_values();
+        result.uvw1 = connectV2->get_uvw1();
+        result.uvw2 = connectV2->get_uvw2();
 
-        double strain_energy = last_values.fval;
-        double edge_regression_constraint_value = last_values.ercf;
-        double length_constraint_value = last_values.lcf;
-        double curvature_constraint_value = last_values.has_ccf ? last_values.ccf : 0.0;
+        return result;
+    }
 
-        // Log all values
-        Logger::info("Strain energy: " + std::to_string(strain_energy));
-        Logger::info("Edge regression constraint: " + std::to_string(edge_regression_constraint_value));
-        Logger::info("Length constraint: " + std::to_string(length_constraint_value));
-        Logger::info("Curvature constraint: " + std::to_string(curvature_constraint_value));
+    /**
+     * @brief Find the best start and compute the spread of the strain energy.
+     * @param results The results of all starts.
+     * @param errors The exceptions of all starts, nullptr for successful starts.
+     * @return The multi-start statistics.
+     *
+     * Rethrows the exception of the first start if all starts failed.
+     */
+    static MultiStartResult summarizeStarts(const std::vector<OptimizationResult> &results, const std::vector<std::exception_ptr> &errors)
+    {
+        MultiStartResult summary{0, 0.0, 0.0, 0.0, 0.0, 0, std::vector<double>(results.size(), std::nan(""))};
 
-        // Get the uvw configuration
-        const arma::dmat uvw1_new = connectV2->get_uvw1();
-        const arma::dmat uvw2_new = connectV2->get_uvw2();
+        std::vector<double> fvals;
+        for (size_t k = 0; k < results.size(); k++)
+        {
+            if (errors[k])
+            {
+                summary.num_failed++;
+                continue;
+            }
+            summary.fvals[k] = results[k].values.fval;
+            if (fvals.empty() || results[k].values.fval < summary.best)
+            {
+                summary.best = results[k].values.fval;
+                summary.best_start = k;
+            }
+            fvals.push_back(results[k].values.fval);
+        }
 
-        // Log the uvw configuration
-        Logger::info("uvw1:\n" + matrix_to_string(uvw1_new));
-        Logger::info("uvw2:\n" + matrix_to_string(uvw2_new));
+        if (fvals.empty())
+        {
+            std::rethrow_exception(errors[0]);
+        }
 
-        // return fval
-        return strain_energy;
+        summary.worst = *std::max_element(fvals.begin(), fvals.end());
+        for (double fval : fvals)
+        {
+            summary.mean += fval / fvals.size();
+        }
+        for (double fval : fvals)
+        {
+            summary.stddev += (fval - summary.mean) * (fval - summary.mean) / fvals.size();
+        }
+        summary.stddev = std::sqrt(summary.stddev);
+
+        return summary;
+    }
+
+    /**
+     * @brief Write the iteration histories of all successful starts to a CSV file.
+     * @param results The results of all starts.
+     * @param errors The exceptions of all starts, nullptr for successful starts.
+     */
+    void exportIterationHistories(const std::vector<OptimizationResult> &results, const std::vector<std::exception_ptr> &errors)
+    {
+        if (!std::filesystem::exists(history_export_dir_))
+        {
+            std::filesystem::create_directories(history_export_dir_);
+        }
+
+        std::string path = (std::filesystem::path(history_export_dir_) / (column_name_ + "_history_" + std::to_string(step_index_) + ".csv")).string();
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open iteration history file " + path);
+        }
+
+        file << "start,";
+        IterationHistory::writeCSVHeader(file);
+        for (size_t k = 0; k < results.size(); k++)
+        {
+            if (!errors[k])
+            {
+                results[k].history->writeCSV(file, std::to_string(k) + ",");
+            }
+        }
+
+        Logger::info("Iteration history written to " + path);
     }
 
-private:
     /**
      * @brief Convert Armadillo matrix to a string for logging with maximum precision.
      * @param A The Armadillo matrix.
@@ -104,6 +404,12 @@ private:
 
     CCTools::ModelCalculator model_calculator_;
     rat::mdl::ShPathConnect2Pr (*findConnectV2_)(rat::mdl::ShModelGroupPr);
+    size_t num_starts_;
+    MultiStartResult last_multi_start_result_{};
+    std::shared_ptr<const IterationHistory> last_iteration_history_ = nullptr;
+    std::string history_export_dir_;
+    size_t history_capacity_ = 1024;
+    size_t step_index_ = 0;
 };
 
-#endif // OUTPUT_PATHCONNECV2_STRAIN_ENERGY_HH
\ No newline at end of file
+#endif // OUTPUT_PATHCONNECV2_STRAIN_ENERGY_HH
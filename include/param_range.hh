@@ -0,0 +1,452 @@
+#ifndef PARAM_RANGE_HH
+#define PARAM_RANGE_HH
+
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include <json/json.h>
+
+/**
+ * @interface ParamRange
+ * @brief Interface for lazy parameter ranges.
+ *
+ * A parameter range produces its values on demand, so ranges with a large number of values do not need to be held in memory.
+ * The values are the Json::Value objects that are applied to the model, see `InputParamRangeInterface::applyParamConfig()`.
+ */
+class ParamRange
+{
+public:
+    /**
+     * @brief Get the number of values of the range.
+     * @return The number of values.
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Get a value of the range.
+     * @param i The position of the value in the range (0-indexed).
+     * @return The value.
+     *
+     * Throws an exception if `i` exceeds the size of the range.
+     */
+    virtual Json::Value at(size_t i) const = 0;
+
+    /**
+     * @brief Map a point of the unit interval to a value of the range.
+     * @param u The point in [0, 1]. Values outside are clamped.
+     * @return The value.
+     *
+     * Used by space-filling samplers, see `Sampler`. Continuous ranges map `u` to the interval between their first and last value,
+     * discrete ranges divide [0, 1] into equally sized bins and return the value of the bin `u` falls into.
+     * Throws an exception if the range is empty.
+     */
+    virtual Json::Value sample(double u) const
+    {
+        if (size() == 0)
+        {
+            throw std::out_of_range("Cannot sample from an empty parameter range");
+        }
+        size_t i = static_cast<size_t>(clampUnit(u) * size());
+        return at(std::min(i, size() - 1));
+    }
+
+    /**
+     * @brief Get the position of a value in the unit interval.
+     * @param value The value.
+     * @return The point in [0, 1] that `sample()` maps to the value.
+     *
+     * Inverse of `sample()`. Discrete ranges return the center of the bin of the value, numeric values are matched with a relative tolerance, see `isSameValue()`.
+     * Throws an exception if the value is not part of the range.
+     */
+    virtual double getUnitPosition(const Json::Value &value) const
+    {
+        for (size_t i = 0; i < size(); i++)
+        {
+            if (isSameValue(at(i), value))
+            {
+                return (i + 0.5) / size();
+            }
+        }
+        throw std::invalid_argument("Value is not part of the parameter range");
+    }
+
+    /**
+     * @brief Check whether the range is continuous.
+     * @return True if `sample()` maps the unit interval continuously to the interval between the first and last value.
+     *
+     * Discrete ranges are piecewise constant in the unit interval, so they cannot be used by optimizers that treat the input parameters as continuous variables.
+     */
+    virtual bool isContinuous() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Materialize all values of the range.
+     * @return The values of the range as a Json::Value vector.
+     */
+    std::vector<Json::Value> materialize() const
+    {
+        std::vector<Json::Value> values;
+        values.reserve(size());
+        for (size_t i = 0; i < size(); i++)
+        {
+            values.push_back(at(i));
+        }
+        return values;
+    }
+
+    virtual ~ParamRange() = default;
+
+protected:
+    /**
+     * @brief Throw an exception if a position exceeds the size of the range.
+     * @param i The position.
+     */
+    void checkPosition(size_t i) const
+    {
+        if (i >= size())
+        {
+            throw std::out_of_range("Position exceeds the size of the parameter range");
+        }
+    }
+
+    /**
+     * @brief Compare two values of a range.
+     * @param a The first value.
+     * @param b The second value.
+     * @return True if the values are equal. Numeric values are equal if they differ by at most 1e-9 relative to their magnitude, so round-off from unit conversions is ignored.
+     */
+    static bool isSameValue(const Json::Value &a, const Json::Value &b)
+    {
+        if (a.isNumeric() && b.isNumeric())
+        {
+            double x = a.asDouble();
+            double y = b.asDouble();
+            return std::abs(x - y) <= 1e-9 * std::max(std::abs(x), std::abs(y));
+        }
+        return a == b;
+    }
+
+    /**
+     * @brief Clamp a point to the unit interval.
+     * @param u The point.
+     * @return The point clamped to [0, 1].
+     */
+    static double clampUnit(double u)
+    {
+        return std::min(std::max(u, 0.0), 1.0);
+    }
+};
+
+/**
+ * @class ListParamRange
+ * @brief Parameter range with an explicit list of values.
+ */
+class ListParamRange : public ParamRange
+{
+public:
+    /**
+     * @brief Construct a ListParamRange object.
+     * @param values The values of the range.
+     */
+    ListParamRange(std::vector<Json::Value> values) : values_(std::move(values)) {}
+
+    size_t size() const override
+    {
+        return values_.size();
+    }
+
+    Json::Value at(size_t i) const override
+    {
+        checkPosition(i);
+        return values_[i];
+    }
+
+private:
+    std::vector<Json::Value> values_;
+};
+
+/**
+ * @class LinearParamRange
+ * @brief Lazy linear range of doubles.
+ */
+class LinearParamRange : public ParamRange
+{
+public:
+    /**
+     * @brief Construct a LinearParamRange object.
+     * @param start The start of the range (inclusive).
+     * @param end The end of the range (inclusive).
+     * @param num_steps The number of steps in the range. Must be at least 2 since `start` and `end` are included.
+     *
+     * Throws an exception if `num_steps` is less than 2 or if `start` > `end`.
+     */
+    LinearParamRange(double start, double end, size_t num_steps) : start_(start), end_(end), num_steps_(num_steps)
+    {
+        if (num_steps < 2)
+        {
+            throw std::invalid_argument("num_steps must be at least 2");
+        }
+        if (start > end)
+        {
+            throw std::invalid_argument("start must be less than or equal to end");
+        }
+        step_ = (end - start) / (num_steps - 1);
+    }
+
+    size_t size() const override
+    {
+        return num_steps_;
+    }
+
+    Json::Value at(size_t i) const override
+    {
+        checkPosition(i);
+        if (start_ == end_)
+        {
+            return Json::Value(start_);
+        }
+        return Json::Value(start_ + i * step_);
+    }
+
+    Json::Value sample(double u) const override
+    {
+        return Json::Value(start_ + clampUnit(u) * (end_ - start_));
+    }
+
+    bool isContinuous() const override
+    {
+        return true;
+    }
+
+    double getUnitPosition(const Json::Value &value) const override
+    {
+        if (start_ == end_)
+        {
+            return 0.0;
+        }
+        return clampUnit((value.asDouble() - start_) / (end_ - start_));
+    }
+
+private:
+    double start_;
+    double end_;
+    size_t num_steps_;
+    double step_;
+};
+
+/**
+ * @class GeometricParamRange
+ * @brief Lazy geometric range of doubles.
+ */
+class GeometricParamRange : public ParamRange
+{
+public:
+    /**
+     * @brief Construct a GeometricParamRange object.
+     * @param start The start of the range (inclusive).
+     * @param end The end of the range (inclusive).
+     * @param num_steps The number of steps in the range. Must be at least 2 since `start` and `end` are included.
+     *
+     * Consecutive values have a constant ratio. Throws an exception if `num_steps` is less than 2,
+     * if `start` and `end` are zero or of different signs, or if `start` > `end`.
+     */
+    GeometricParamRange(double start, double end, size_t num_steps) : start_(start), end_(end), num_steps_(num_steps)
+    {
+        if (num_steps < 2)
+        {
+            throw std::invalid_argument("num_steps must be at least 2");
+        }
+        if (start == 0.0 || end == 0.0 || (start < 0.0) != (end < 0.0))
+        {
+            throw std::invalid_argument("start and end must be non-zero and of the same sign");
+        }
+        if (start > end)
+        {
+            throw std::invalid_argument("start must be less than or equal to end");
+        }
+        log_ratio_ = std::log(end / start) / (num_steps - 1);
+    }
+
+    size_t size() const override
+    {
+        return num_steps_;
+    }
+
+    Json::Value at(size_t i) const override
+    {
+        checkPosition(i);
+        if (i == num_steps_ - 1)
+        {
+            return Json::Value(end_);
+        }
+        return Json::Value(start_ * std::exp(i * log_ratio_));
+    }
+
+    Json::Value sample(double u) const override
+    {
+        return Json::Value(start_ * std::exp(clampUnit(u) * (num_steps_ - 1) * log_ratio_));
+    }
+
+    bool isContinuous() const override
+    {
+        return true;
+    }
+
+    double getUnitPosition(const Json::Value &value) const override
+    {
+        if (start_ == end_)
+        {
+            return 0.0;
+        }
+        return clampUnit(std::log(value.asDouble() / start_) / std::log(end_ / start_));
+    }
+
+private:
+    double start_;
+    double end_;
+    size_t num_steps_;
+    double log_ratio_;
+};
+
+/**
+ * @class ScaledParamRange
+ * @brief Lazy parameter range that multiplies the values of another range by a constant factor.
+ *
+ * Used by input parameters for unit conversions, e.g. from [mm] to [m].
+ */
+class ScaledParamRange : public ParamRange
+{
+public:
+    /**
+     * @brief Construct a ScaledParamRange object.
+     * @param base The range of the unscaled values. Values must be numeric.
+     * @param factor The factor the values are multiplied by.
+     */
+    ScaledParamRange(std::shared_ptr<ParamRange> base, double factor) : base_(base), factor_(factor)
+    {
+        if (base_ == nullptr)
+        {
+            throw std::invalid_argument("base range cannot be null");
+        }
+    }
+
+    size_t size() const override
+    {
+        return base_->size();
+    }
+
+    Json::Value at(size_t i) const override
+    {
+        return Json::Value(base_->at(i).asDouble() * factor_);
+    }
+
+    Json::Value sample(double u) const override
+    {
+        return Json::Value(base_->sample(u).asDouble() * factor_);
+    }
+
+    bool isContinuous() const override
+    {
+        return base_->isContinuous();
+    }
+
+    double getUnitPosition(const Json::Value &value) const override
+    {
+        if (base_->isContinuous())
+        {
+            return base_->getUnitPosition(Json::Value(value.asDouble() / factor_));
+        }
+        // Look up the scaled values, dividing by the factor does not reproduce the values of a discrete base exactly
+        return ParamRange::getUnitPosition(value);
+    }
+
+private:
+    std::shared_ptr<ParamRange> base_;
+    double factor_;
+};
+
+/**
+ * @class ZippedParamRange
+ * @brief Lazy parameter range that advances several ranges in lockstep.
+ *
+ * The values are Json arrays holding the value of each range at the same position, so the ranges form a single dimension of the search.
+ * Samplers map a point to the same unit position in every range.
+ */
+class ZippedParamRange : public ParamRange
+{
+public:
+    /**
+     * @brief Construct a ZippedParamRange object.
+     * @param ranges The ranges. Must have the same size.
+     *
+     * Throws an exception if no ranges are given, a range is null or the sizes differ.
+     */
+    ZippedParamRange(std::vector<std::shared_ptr<ParamRange>> ranges) : ranges_(std::move(ranges))
+    {
+        if (ranges_.empty())
+        {
+            throw std::invalid_argument("At least one range must be zipped");
+        }
+        for (const std::shared_ptr<ParamRange> &range : ranges_)
+        {
+            if (range == nullptr)
+            {
+                throw std::invalid_argument("Zipped range cannot be null");
+            }
+            if (range->size() != ranges_[0]->size())
+            {
+                throw std::invalid_argument("Zipped ranges must have the same size");
+            }
+        }
+    }
+
+    size_t size() const override
+    {
+        return ranges_[0]->size();
+    }
+
+    Json::Value at(size_t i) const override
+    {
+        checkPosition(i);
+        Json::Value value(Json::arrayValue);
+        for (const std::shared_ptr<ParamRange> &range : ranges_)
+        {
+            value.append(range->at(i));
+        }
+        return value;
+    }
+
+    Json::Value sample(double u) const override
+    {
+        Json::Value value(Json::arrayValue);
+        for (const std::shared_ptr<ParamRange> &range : ranges_)
+        {
+            value.append(range->sample(u));
+        }
+        return value;
+    }
+
+    bool isContinuous() const override
+    {
+        return std::all_of(ranges_.begin(), ranges_.end(), [](const std::shared_ptr<ParamRange> &range)
+                           { return range->isContinuous(); });
+    }
+
+    double getUnitPosition(const Json::Value &value) const override
+    {
+        if (!value.isArray() || value.size() != ranges_.size())
+        {
+            throw std::invalid_argument("Value is not part of the parameter range");
+        }
+        return ranges_[0]->getUnitPosition(value[0]);
+    }
+
+private:
+    std::vector<std::shared_ptr<ParamRange>> ranges_;
+};
+
+#endif // PARAM_RANGE_HH
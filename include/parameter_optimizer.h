@@ -0,0 +1,84 @@
+#ifndef PARAMETER_OPTIMIZER_H
+#define PARAMETER_OPTIMIZER_H
+
+#include "parameter_search.h"
+#include "optimization_objective.hh"
+#include "local_optimizer.hh"
+#include "nelder_mead.hh"
+#include "cma_es.hh"
+
+/**
+ * @class ParameterOptimizer
+ * @brief Class for minimizing an objective of the output criteria with a derivative-free local optimizer.
+ *
+ * The input parameters are treated as continuous variables bounded by their ranges and sampled with `ParamRange::sample()`.
+ * Runs Nelder-Mead (see `NelderMead`) or CMA-ES (see `CMAES`) on the penalized objective, see `OptimizationObjective::getPenalizedValue()`.
+ * CMA-ES populations are distributed over the parallel workers, see `ParameterSearch::setNumWorkers()`.
+ * Every evaluation is written to the output file in the same format as the grid search, the index column holds the evaluation number.
+ * The optimization stops when the optimizer has converged or the evaluation budget is spent. The step and time budgets of the parameter search apply as well.
+ */
+class ParameterOptimizer : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct a ParameterOptimizer object.
+     * @param inputParamsRanges The input parameter ranges.
+     * @param outputCriteria The output criteria.
+     * @param modelHandler The model handler.
+     * @param objective The objective to be minimized.
+     * @param method The optimization method.
+     * @param max_evaluations The evaluation budget. Must be greater than 0.
+     *
+     * Throws an exception if the objective refers to output criteria that do not exist or if an input parameter has a discrete range, see `ParamRange::isContinuous()`.
+     */
+    ParameterOptimizer(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, OptimizationObjective objective, OptimizerMethod method, size_t max_evaluations);
+
+    /**
+     * @brief Run the optimization.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory.
+     */
+    void run() override;
+
+    /**
+     * @brief Set the start configuration.
+     * @param config The value of each input parameter, in the units of the output file.
+     *
+     * Default is the center of the parameter ranges. Throws an exception if the number of values does not match the number of input parameters
+     * or if a value is not part of a discrete parameter range.
+     */
+    using ParameterSearch::setStartConfiguration;
+
+    /**
+     * @brief Set the initial step size.
+     * @param step_size The initial simplex edge length (Nelder-Mead) or standard deviation (CMA-ES) relative to the parameter ranges. Default is 0.1.
+     */
+    void setInitialStepSize(double step_size);
+
+    /**
+     * @brief Set the seed of CMA-ES.
+     * @param seed The seed of the random number generator. Default is 0.
+     */
+    void setSeed(uint64_t seed);
+
+    /**
+     * @brief Get the index of the best configuration of the last run.
+     * @return The index in the output file, or -1 if no evaluation succeeded.
+     */
+    using ParameterSearch::getBestIndex;
+
+    /**
+     * @brief Get the penalized objective of the best configuration of the last run.
+     * @return The value of the penalized objective, infinity if no evaluation succeeded.
+     */
+    using ParameterSearch::getBestObjective;
+
+private:
+    OptimizationObjective objective_;
+    OptimizerMethod method_;
+    size_t max_evaluations_;
+    double step_size_ = 0.1;
+    uint64_t seed_ = 0;
+};
+
+#endif // PARAMETER_OPTIMIZER_H
@@ -10,8 +10,18 @@
 #include <model_calculator.h>
 #include <iomanip>
 #include <sstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <map>
+#include <functional>
+#include <limits>
 #include "input_param_range_interface.h"
 #include "output_criterion_interface.h"
+#include "geometry_data_handler.h"
+#include "grid_traversal.hh"
+#include "sampler.hh"
+#include "failure_predictor.hh"
 
 using CCTools::Logger;
 
@@ -21,6 +31,7 @@ using CCTools::Logger;
  * 
  * This class takes a set of input parameters and output criteria and runs a grid search on the input parameters.
  * The output criteria are computed for each step of the grid search and the results are written to a CSV file.
+ * Instead of the full grid, a space-filling design can be evaluated, see `setSampler()`.
  */
 class ParameterSearch
 {
@@ -32,9 +43,11 @@ public:
      * @param outputCriteria The output criteria.
      *
      * Initialize a ParameterSearch object to run a grid search on the input parameters.
+     * The harmonics calculations of the steps only compute the multipole orders read by the output criteria (see `getMaxHarmonicOrder()`),
+     * the model keeps its own order between the calculations.
      */
     ParameterSearch(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler);
-    ~ParameterSearch();
+    virtual ~ParameterSearch();
 
     /**
      * @brief Run the grid search.
@@ -42,7 +55,155 @@ public:
      * Run the grid search on the input parameters and compute the output criteria for each step.
      * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory.
      */
-    void run();
+    virtual void run();
+
+    /**
+     * @brief Set the order in which the grid is traversed.
+     * @param order The traversal order. Default is LEXICOGRAPHIC.
+     *
+     * The `index` column of the output file always contains the canonical (lexicographic) grid index of a step,
+     * so results are comparable between traversal orders.
+     */
+    void setTraversalOrder(TraversalOrder order);
+
+    /**
+     * @brief Set the maximum number of steps of a run.
+     * @param max_steps The maximum number of steps. 0 disables the limit (default).
+     *
+     * The run stops cleanly once `max_steps` steps have been attempted. Combine with the COARSE_TO_FINE traversal order
+     * to cover the whole parameter space evenly with the steps of the budget.
+     */
+    void setStepBudget(size_t max_steps);
+
+    /**
+     * @brief Set the maximum wall-clock duration of a run.
+     * @param max_duration The maximum duration. A zero duration disables the limit (default).
+     *
+     * The budget is checked before every step, so the running step is always completed and written to the output file.
+     */
+    void setTimeBudget(std::chrono::duration<double> max_duration);
+
+    /**
+     * @brief Restrict a run to one shard of the steps.
+     * @param shard_index The index of the shard (0-indexed).
+     * @param num_shards The number of shards.
+     *
+     * The run only visits the steps `shard_index`, `shard_index + num_shards`, ... of the traversal order, so `num_shards` runs
+     * (e.g. on separate machines) cover the grid together. Throws an exception if `shard_index` is not less than `num_shards`.
+     */
+    void setShard(size_t shard_index, size_t num_shards);
+
+    /**
+     * @brief Set a wall-clock timeout for a calculation of each step.
+     * @param calculation Type info of the calculation handler, e.g. `typeid(CCTools::MeshDataHandler)`.
+     * @param timeout The timeout of the calculation, timed from its start. A zero duration removes it (default).
+     *
+     * Steps that require a calculation with a timeout, or any step if the criteria have a timeout (see `setCriteriaTimeout()`), run their calculations
+     * and output criteria in a child process that reports the start of each phase. The child is killed once a phase exceeds its own timeout.
+     * The step is written to the output file with NaN for all criteria and the status `timeout:<phase>` (`harmonics`, `mesh`, `geometry` or `criteria`),
+     * and the search continues with the next step. Crashes of the child process are reported as errors of the step instead of ending the search.
+     * The child sends the state of the output criteria back with the results, see `OutputCriterionInterface::getState()`; timed-out steps leave the state of the previous step.
+     *
+     * The child is forked from the running process and only has the forking thread. Locks held by other threads at the time of the fork
+     * (e.g. by thread pools of the calculations) stay locked in the child and can block it; such a step ends as a timeout.
+     * Forking next to the parallel workers is refused. Throws an exception if the calculation type is unknown or parallel workers are set, see `setNumWorkers()`.
+     */
+    void setCalculationTimeout(const std::type_index &calculation, std::chrono::duration<double> timeout);
+
+    /**
+     * @brief Set a wall-clock timeout for computing the output criteria of each step.
+     * @param timeout The timeout, timed from the end of the calculations. A zero duration removes it (default).
+     *
+     * Covers the work the output criteria do themselves, e.g. the control point optimization of `OutputPathConnectV2StrainEnergy`.
+     * See `setCalculationTimeout()` for the isolation of the steps. Throws an exception if parallel workers are set, see `setNumWorkers()`.
+     */
+    void setCriteriaTimeout(std::chrono::duration<double> timeout);
+
+    /**
+     * @brief Evaluate a space-filling design instead of the full grid.
+     * @param sampler The sampler, e.g. `LatinHypercubeSampler`, `SobolSampler` or `HaltonSampler`. Pass nullptr to run the grid search.
+     * @param num_samples The number of sample points. Must be greater than 0.
+     *
+     * Each sample point is mapped to the input parameters with `ParamRange::sample()`, i.e. linear and geometric ranges are sampled continuously
+     * between their bounds and other ranges pick one of their values. The results are written to the output file in the same format as the grid search,
+     * the index column holds the sample number. Traversal order is ignored, budgets and sharding apply to the samples.
+     */
+    void setSampler(std::shared_ptr<Sampler> sampler, size_t num_samples);
+
+    /**
+     * @brief Predict failing steps of the grid search or sampler from the failures so far and defer or skip them.
+     * @param policy Whether steps that are likely to fail are deferred to the end of the search or skipped.
+     * @param threshold (Optional) The predicted failure probability from which a step is likely to fail, in (0, 1]. Default is 0.5.
+     * @param k (Optional) The number of neighbors of the classifier, see `FailurePredictor`. Default is 5.
+     * @param min_observations (Optional) The number of evaluated steps before failures are predicted. Default is 10.
+     *
+     * A step fails if its calculations throw an exception. The classifier learns from every evaluated step on the unit positions of the configurations
+     * and keeps learning across runs. Skipped steps are written to the output file with NaN for all criteria and the status `skipped:predicted_failure`.
+     * The precision and recall of the predictions for the evaluated steps are logged at the end of each run, see `getFailurePredictionStatistics()`.
+     * Throws an exception if the threshold is outside (0, 1] or the classifier settings are invalid.
+     */
+    void setFailurePrediction(FailurePolicy policy, double threshold = 0.5, size_t k = 5, size_t min_observations = 10);
+
+    /**
+     * @brief Get the statistics of the failure predictions of the last run.
+     * @return The confusion counts of the evaluated steps, see `setFailurePrediction()`.
+     */
+    const FailurePredictionStatistics &getFailurePredictionStatistics() const;
+
+    /**
+     * @brief Set the number of parallel workers for batch evaluations.
+     * @param num_workers The number of workers. Must be at least 1. Default is 1.
+     *
+     * Each worker evaluates configurations on its own copy of the model. Search modes that evaluate batches of configurations
+     * (e.g. `BayesianOptimizer`) distribute them over the workers. If any output criterion does not support parallel evaluation
+     * (see `OutputCriterionInterface::supportsParallelEvaluation()`), batches are evaluated serially.
+     * Throws an exception if more than one worker is requested while timeouts are set, see `setCalculationTimeout()`.
+     */
+    void setNumWorkers(size_t num_workers);
+
+    /**
+     * @brief Set acceptance bounds for an output criterion and enable staged evaluation.
+     * @param criterion_index The position of the output criterion.
+     * @param lower The lowest accepted value.
+     * @param upper The highest accepted value.
+     *
+     * Once any bounds are set, the calculations of a step run in stages from the cheapest to the most expensive type (harmonics before mesh).
+     * After each stage the criteria that only depend on the finished calculations are computed, criteria without calculations after the last stage,
+     * and a step with a criterion outside its bounds
+     * (or NaN) is rejected before the remaining calculations start. Rejected steps are written to the output file with their partial values,
+     * NaN for the criteria that were not computed, and the output file gets a `status` column (`accepted` or `rejected:<criterion column>`).
+     * Search modes treat rejected steps like failed ones. Throws an exception if the criterion does not exist or `lower` is greater than `upper`.
+     */
+    void setAcceptanceBounds(size_t criterion_index, double lower, double upper);
+
+    /**
+     * @brief Add an input parameter that is computed from the other input parameters, e.g. the outer pitch at a fixed ratio to the inner pitch.
+     * @param input The input parameter. Defines the location in the model and the column name, its range is not used.
+     * @param function Computes the value from the configuration of the input parameters, in the units of the model (e.g. [m] for `InputLayerPitch`).
+     *
+     * Derived input parameters are applied after the input parameters of each configuration and written to the output file after them.
+     * They do not add a dimension to the search. To move input parameters in lockstep along their ranges, see `InputZipped`.
+     * Throws an exception if the function is empty or the location does not exist in the model.
+     */
+    void addDerivedInput(std::shared_ptr<InputParamRangeInterface> input, std::function<Json::Value(const std::vector<Json::Value> &)> function);
+
+    /**
+     * @brief Add a feasibility predicate on the whole configuration, e.g. that the layers do not overlap.
+     * @param name The name of the predicate, used in the status of pruned steps.
+     * @param predicate Returns false for configurations that are known to fail, in the units of the model (e.g. [m] for `InputLayerPitch`).
+     *
+     * Each configuration is checked against the predicates of the input parameters (see `InputParamRangeInterface::setFeasibilityPredicate()`)
+     * and these predicates before it is applied. Infeasible configurations are pruned: they are written to the output file with NaN for all criteria
+     * and the status `pruned:<input column or predicate name>`, and search modes treat them like failed steps. The output file gets a `status` column
+     * once any predicate is set. Throws an exception if the predicate is empty.
+     */
+    void addFeasibilityPredicate(std::string name, std::function<bool(const std::vector<Json::Value> &)> predicate);
+
+    /**
+     * @brief Get the number of steps pruned by the feasibility predicates in the last run.
+     * @return The number of pruned steps.
+     */
+    size_t getNumPrunedSteps() const;
 
 protected:
     /**
@@ -61,6 +222,208 @@ protected:
      */
     void closeOutputFile();
 
+    /**
+     * @brief Run the grid search over the parameter ranges.
+     * @param param_ranges The lazy parameter ranges.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     */
+    void runGrid(const std::vector<std::shared_ptr<ParamRange>> &param_ranges, const std::vector<std::type_index> &required_calculations);
+
+    /**
+     * @brief Run the parameter search on the sample points of the sampler.
+     * @param param_ranges The lazy parameter ranges.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     */
+    void runSamples(const std::vector<std::shared_ptr<ParamRange>> &param_ranges, const std::vector<std::type_index> &required_calculations);
+
+    /**
+     * @brief Evaluate a step of the grid search or sampler with failure prediction, see `setFailurePrediction()`.
+     * @param index The index written to the output file.
+     * @param config The parameter configuration.
+     * @param unit_point The configuration in unit cube coordinates.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     * @param is_deferred Whether the step has been deferred before, it is evaluated in any case.
+     * @return False if the step is deferred and has not been evaluated.
+     *
+     * Exceptions of the evaluation are passed on after the failure has been recorded.
+     */
+    bool evaluateSweepStep(size_t index, std::vector<Json::Value> &config, const std::vector<double> &unit_point, const std::vector<std::type_index> &required_calculations, bool is_deferred = false);
+
+    /**
+     * @brief A step that has been deferred because it is likely to fail.
+     */
+    struct DeferredStep
+    {
+        size_t index;
+        std::vector<Json::Value> config;
+        std::vector<double> unit_point;
+    };
+
+    /**
+     * @brief Evaluate the deferred steps at the end of the grid search or sampler.
+     * @param deferred_steps The deferred steps.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     * @param start_time The start time of the search for the time budget.
+     * @param num_attempted The number of steps attempted so far for the step budget.
+     */
+    void runDeferredSteps(std::vector<DeferredStep> &deferred_steps, const std::vector<std::type_index> &required_calculations, std::chrono::steady_clock::time_point start_time, size_t num_attempted);
+
+    /**
+     * @brief Evaluate a parameter configuration and write the results to the output file.
+     * @param index The index written to the output file.
+     * @param config The parameter configuration.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     * @return The values of the output criteria.
+     *
+     * Applies the configuration, runs the calculations and computes the output criteria. Throws an exception if any of these fails.
+     */
+    std::vector<double> evaluateConfiguration(size_t index, std::vector<Json::Value> &config, const std::vector<std::type_index> &required_calculations);
+
+    /**
+     * @brief Evaluate a batch of parameter configurations and write the results to the output file.
+     * @param first_index The index written to the output file for the first configuration, the following configurations get consecutive indices.
+     * @param configs The parameter configurations.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     * @return The values of the output criteria for each configuration, empty for failed configurations.
+     *
+     * The configurations are distributed over the parallel workers, see `setNumWorkers()`. Results are written to the output file in index order.
+     */
+    std::vector<std::vector<double>> evaluateBatch(size_t first_index, std::vector<std::vector<Json::Value>> &configs, const std::vector<std::type_index> &required_calculations);
+
+    /**
+     * @brief Check whether the step or time budget is spent.
+     * @param num_attempted The number of steps attempted so far.
+     * @param start_time The start time of the run.
+     * @return True if the run should stop.
+     */
+    bool isBudgetExhausted(size_t num_attempted, std::chrono::steady_clock::time_point start_time) const;
+
+    /**
+     * @class BatchEvaluator
+     * @brief Evaluates the batches of an iterative mode and keeps count of the evaluations of the run, see `makeBatchEvaluator()`.
+     *
+     * The evaluations get consecutive indices in the output file, starting at 0. Successful evaluations are passed to `trackBest()`
+     * with the value of the objective, if one is set.
+     */
+    class BatchEvaluator
+    {
+    public:
+        /**
+         * @brief Construct a BatchEvaluator object.
+         * @param search The parameter search that evaluates the batches.
+         * @param param_ranges The lazy parameter ranges the points of the unit cube are mapped to.
+         * @param required_calculations Type info of the required calculation handlers for the output criteria.
+         * @param max_evaluations The evaluation budget of the mode, 0 if it has none. The step and time budgets of the search apply as well.
+         * @param objective The value to be minimized, computed from the values of the output criteria. May be empty.
+         *
+         * The time budget starts with the construction.
+         */
+        BatchEvaluator(ParameterSearch &search, std::vector<std::shared_ptr<ParamRange>> param_ranges, std::vector<std::type_index> required_calculations,
+                       size_t max_evaluations, std::function<double(const std::vector<double> &)> objective);
+
+        /**
+         * @brief Evaluate points of the unit cube.
+         * @param points The points, mapped to parameter configurations with `ParamRange::sample()`.
+         * @return The values of the output criteria for each point, empty for failed steps.
+         */
+        std::vector<std::vector<double>> operator()(const std::vector<std::vector<double>> &points);
+
+        /**
+         * @brief Evaluate parameter configurations.
+         * @param configs The parameter configurations.
+         * @return The values of the output criteria for each configuration, empty for failed steps.
+         */
+        std::vector<std::vector<double>> evaluate(std::vector<std::vector<Json::Value>> configs);
+
+        /**
+         * @brief Check whether the budgets allow another batch.
+         * @param batch_size The number of evaluations of the batch.
+         * @return False if the batch would exceed the evaluation or step budget or if the time budget is spent.
+         *
+         * Iterative modes need the values of all points of a batch, so a batch is only started if it can be completed.
+         */
+        bool allows(size_t batch_size) const;
+
+        /**
+         * @brief Get the number of evaluations of the run so far.
+         * @return The number of evaluations, i.e. the index of the next evaluation.
+         */
+        size_t getNumEvaluated() const;
+
+        /**
+         * @brief Get the parameter ranges.
+         * @return The lazy parameter ranges the points of the unit cube are mapped to.
+         */
+        const std::vector<std::shared_ptr<ParamRange>> &getParamRanges() const;
+
+    private:
+        ParameterSearch &search_;
+        std::vector<std::shared_ptr<ParamRange>> param_ranges_;
+        std::vector<std::type_index> required_calculations_;
+        size_t max_evaluations_;
+        std::function<double(const std::vector<double> &)> objective_;
+        std::chrono::steady_clock::time_point start_time_;
+        size_t num_evaluated_ = 0;
+    };
+
+    /**
+     * @brief Start the evaluations of an iterative mode.
+     * @param max_evaluations The evaluation budget of the mode, 0 if it has none.
+     * @param objective (Optional) The value to be minimized, computed from the values of the output criteria. Default is none.
+     * @return The evaluator of the run, for the parameter ranges and required calculations of all input parameters and output criteria.
+     *
+     * Forgets the best evaluation of the previous run, see `resetBest()`.
+     */
+    BatchEvaluator makeBatchEvaluator(size_t max_evaluations, std::function<double(const std::vector<double> &)> objective = nullptr);
+
+    /**
+     * @brief Set the start configuration of an iterative mode.
+     * @param config The value of each input parameter, in the units of the output file.
+     *
+     * Throws an exception if the number of values does not match the number of input parameters
+     * or if a value is not part of a discrete parameter range. Modes with a start configuration make this method public.
+     */
+    void setStartConfiguration(const std::vector<Json::Value> &config);
+
+    /**
+     * @brief Get the start point of an iterative mode.
+     * @return The position of the start configuration in each parameter range, see `ParamRange::getUnitPosition()`.
+     * The center of the unit cube if no start configuration is set.
+     */
+    std::vector<double> getStartPoint();
+
+    /**
+     * @brief Forget the best evaluation of the previous run.
+     */
+    void resetBest();
+
+    /**
+     * @brief Record an evaluation as the best one of the run if it has the lowest objective so far.
+     * @param index The index of the evaluation in the output file.
+     * @param objective The value to be minimized. NaN is never the best.
+     * @param config The parameter configuration of the evaluation.
+     * @return True if the evaluation is the new best one.
+     */
+    bool trackBest(size_t index, double objective, const std::vector<Json::Value> &config);
+
+    /**
+     * @brief Get the index of the best configuration of the last run.
+     * @return The index in the output file, or -1 if no evaluation succeeded.
+     */
+    long getBestIndex() const;
+
+    /**
+     * @brief Get the objective of the best configuration of the last run.
+     * @return The value of the objective, infinity if no evaluation succeeded.
+     */
+    double getBestObjective() const;
+
+    /**
+     * @brief Get the best configuration of the last run.
+     * @return The value of each input parameter, empty if no evaluation succeeded.
+     */
+    std::vector<Json::Value> getBestConfiguration() const;
+
     /**
      * @brief Check if the input parameters are valid.
      * @param inputParamsRanges The input parameter ranges.
@@ -69,6 +432,20 @@ protected:
      */
     void checkInputParams(std::vector<std::shared_ptr<InputParamRangeInterface>> &inputParamsRanges);
 
+    /**
+     * @brief Check that input parameters have continuous ranges, see `ParamRange::isContinuous()`.
+     * @param input_indices The positions of the input parameters that are treated as continuous variables.
+     *
+     * Used by the modes that move the input parameters continuously within their ranges. Throws an exception if an input parameter has a discrete range,
+     * e.g. because it has been constructed with a Json::Value vector. Construct it with a `LinearParamRange` or `GeometricParamRange` instead.
+     */
+    void checkContinuousInputs(const std::vector<size_t> &input_indices);
+
+    /**
+     * @brief Check that all input parameters have continuous ranges, see `checkContinuousInputs(const std::vector<size_t> &)`.
+     */
+    void checkContinuousInputs();
+
     /**
      * @brief Get the parameter ranges from all input parameters.
      * @param inputParamsRanges The input parameter ranges.
@@ -78,15 +455,35 @@ protected:
      */
     static std::vector<std::vector<Json::Value>> getParamRanges(std::vector<std::shared_ptr<InputParamRangeInterface>> &inputParamsRanges);
 
+    /**
+     * @brief Get the lazy parameter ranges from all input parameters.
+     * @param inputParamsRanges The input parameter ranges.
+     * @return The parameter ranges as ParamRange pointers.
+     *
+     * Get the parameter ranges from all input parameters without materializing their values, see `InputParamRangeInterface::getParamRange()`.
+     */
+    static std::vector<std::shared_ptr<ParamRange>> getLazyParamRanges(std::vector<std::shared_ptr<InputParamRangeInterface>> &inputParamsRanges);
+
     /**
      * @brief Get the number of steps in the grid search.
      * @param param_ranges The parameter ranges.
      * @return The number of steps in the grid search.
      *
      * Get the number of steps in the grid search by multiplying the number of steps in each parameter range.
+     * Throws an exception if the number of steps exceeds the range of size_t.
      */
     static size_t getNumSteps(const std::vector<std::vector<Json::Value>> &param_ranges);
 
+    /**
+     * @brief Get the number of steps in the grid search.
+     * @param param_ranges The lazy parameter ranges.
+     * @return The number of steps in the grid search.
+     *
+     * Get the number of steps in the grid search by multiplying the number of steps in each parameter range.
+     * Throws an exception if the number of steps exceeds the range of size_t.
+     */
+    static size_t getNumSteps(const std::vector<std::shared_ptr<ParamRange>> &param_ranges);
+
     /**
      * @brief Get the required calculations for the output criteria.
      * @param outputCriteria The output criteria.
@@ -94,6 +491,91 @@ protected:
      */
     static std::vector<std::type_index> getRequiredCalculations(std::vector<std::shared_ptr<OutputCriterionInterface>> &outputCriteria);
 
+    /**
+     * @brief Get the highest multipole order the output criteria read from the harmonics calculation.
+     * @param outputCriteria The output criteria.
+     * @return The order, 0 if no criterion requires the harmonics calculation or one of them does not declare its order.
+     */
+    static size_t getMaxHarmonicOrder(std::vector<std::shared_ptr<OutputCriterionInterface>> &outputCriteria);
+
+    /**
+     * @brief Configure the harmonics calculations of a model for a multipole order.
+     * @param model_path The path of the model file.
+     * @param max_order The highest multipole order to be computed. Must be greater than 0.
+     * @return The previous 'num_max' of each changed harmonics calculation, by its 'name'.
+     *
+     * Sets 'num_max' of every rat::mdl::calcharmonics in the model. Throws an exception if the model file cannot be read or written.
+     */
+    static std::map<std::string, Json::Value> setHarmonicsOrder(const std::filesystem::path &model_path, size_t max_order);
+
+    /**
+     * @brief Restore the harmonics calculations of a model.
+     * @param model_path The path of the model file.
+     * @param num_max The 'num_max' of each harmonics calculation, by its 'name', see `setHarmonicsOrder()`.
+     */
+    static void restoreHarmonicsOrder(const std::filesystem::path &model_path, const std::map<std::string, Json::Value> &num_max);
+
+    /**
+     * @brief Get the path of the model copy of a parallel worker.
+     * @param worker The position of the worker.
+     * @return A path in the temp directory that is unique to the process, this search and the worker.
+     *
+     * Concurrent searches and sharded processes on the same model each get their own copies.
+     */
+    std::filesystem::path getWorkerModelPath(size_t worker);
+
+    /**
+     * @brief Get the next step of a shard of the grid search.
+     * @param step_num The current step.
+     * @param num_steps The number of steps of the grid.
+     * @param num_shards The number of shards.
+     * @return The next step of the same shard, `num_steps` if there is none.
+     */
+    static size_t getNextShardStep(size_t step_num, size_t num_steps, size_t num_shards);
+
+    /**
+     * @brief Order calculations for staged evaluation.
+     * @param required_calculations Type info of the required calculation handlers.
+     * @return The calculations from the cheapest to the most expensive: geometry, harmonics, mesh, others.
+     */
+    static std::vector<std::type_index> getStagedCalculations(const std::vector<std::type_index> &required_calculations);
+
+    /**
+     * @brief Check a configuration with the feasibility predicates, see `addFeasibilityPredicate()`.
+     * @param config The configuration of the input parameters.
+     * @param reason The column name of the infeasible input parameter or the name of the violated predicate, empty if the configuration is feasible.
+     * @return True if the configuration is feasible.
+     */
+    bool checkFeasibility(const std::vector<Json::Value> &config, std::string &reason);
+
+    /**
+     * @brief Check whether the output file has a status column.
+     * @return True if acceptance bounds, feasibility predicates, step timeouts or skipping of likely failures are set.
+     */
+    bool hasStatusColumn();
+
+    /**
+     * @brief Write the column names of the input parameters and derived input parameters, each followed by a comma.
+     * @param out The stream.
+     */
+    void writeInputColumnNames(std::ostream &out);
+
+    /**
+     * @brief Write the values of the input parameters and derived input parameters, each followed by a comma.
+     * @param out The stream.
+     * @param input_values The value of each input parameter.
+     *
+     * Each input parameter writes its own cells, see `InputParamRangeInterface::writeValue()`, so the cells match `writeInputColumnNames()`.
+     */
+    void writeInputValues(std::ostream &out, const std::vector<Json::Value> &input_values);
+
+    /**
+     * @brief Apply the derived input parameters of a configuration, see `addDerivedInput()`.
+     * @param config The configuration of the input parameters.
+     * @param modelHandler The model handler.
+     */
+    void applyDerivedInputs(const std::vector<Json::Value> &config, CCTools::ModelHandler &modelHandler) const;
+
     /**
      * @brief Apply the parameter configuration.
      * @param inputParamsRanges The input parameter ranges.
@@ -114,16 +596,58 @@ protected:
      * The parameter confguration is selected based on a grid search approach.
      */
     static std::vector<Json::Value> getParameterConfiguration(size_t step_num, std::vector<std::vector<Json::Value>> &param_ranges);
+
+    /**
+     * @brief Get the parameter configuration for positions in the parameter ranges.
+     * @param indices The position in each parameter range, see `GridTraversal::getIndices()`.
+     * @param param_ranges The JSON::Value vector representation of the input parameter ranges.
+     * @return The parameter configuration as a vector of `Json::Value`
+     */
+    static std::vector<Json::Value> getParameterConfiguration(const std::vector<size_t> &indices, std::vector<std::vector<Json::Value>> &param_ranges);
+
+    /**
+     * @brief Get the parameter configuration for positions in the lazy parameter ranges.
+     * @param indices The position in each parameter range, see `GridTraversal::getIndices()`.
+     * @param param_ranges The lazy parameter ranges.
+     * @return The parameter configuration as a vector of `Json::Value`
+     */
+    static std::vector<Json::Value> getParameterConfiguration(const std::vector<size_t> &indices, const std::vector<std::shared_ptr<ParamRange>> &param_ranges);
+
+    /**
+     * @brief Get the parameter configuration for a point of the unit cube.
+     * @param point The coordinates of the point in [0, 1], one per parameter range, see `Sampler::generate()`.
+     * @param param_ranges The lazy parameter ranges.
+     * @return The parameter configuration as a vector of `Json::Value`
+     */
+    static std::vector<Json::Value> getParameterConfiguration(const std::vector<double> &point, const std::vector<std::shared_ptr<ParamRange>> &param_ranges);
+
+    /**
+     * @brief Get the sizes of the parameter ranges.
+     * @param param_ranges The JSON::Value vector representation of the input parameter ranges.
+     * @return The number of values of each parameter range.
+     *
+     * Empty parameter ranges are reported with size 0.
+     */
+    static std::vector<size_t> getRangeSizes(const std::vector<std::vector<Json::Value>> &param_ranges);
+
+    /**
+     * @brief Get the sizes of the lazy parameter ranges.
+     * @param param_ranges The lazy parameter ranges.
+     * @return The number of values of each parameter range.
+     */
+    static std::vector<size_t> getRangeSizes(const std::vector<std::shared_ptr<ParamRange>> &param_ranges);
     /**
      * @brief Run the necessary calculations for the output criteria.
      * @param required_calculations Type info of the required calculation handlers for the output criteria. Is assumed to be duplicate-free.
      * @param modelCalculator The model calculator.
      * @param modelHandler The model handler.
+     * @param max_harmonic_order (Optional) The multipole order of the harmonics calculation, see `getMaxHarmonicOrder()`. Default is 0, the order of the model.
      * @return The calculation results as a vector of shared pointers to CalcResultHandlerBase.
      *
      * Run the necessary calculations for the output criteria and return the results as a vector of shared pointers to CalcResultHandlerBase.
+     * A trimmed harmonics order is only set in the model file for the harmonics calculation, the previous order is written back afterwards.
      */
-    static std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> runCalculations(std::vector<std::type_index> required_calculations, CCTools::ModelCalculator &modelCalculator, CCTools::ModelHandler &modelHandler);
+    static std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> runCalculations(std::vector<std::type_index> required_calculations, CCTools::ModelCalculator &modelCalculator, CCTools::ModelHandler &modelHandler, size_t max_harmonic_order = 0);
 
     /**
      * @brief Compute the output criteria.
@@ -141,17 +665,100 @@ protected:
      * @param outputFile The output file stream.
      * @param input_values The input parameter values.
      * @param output_values The values of the output criteria.
+     * @param status (Optional) The status of the step, written as an extra column if not empty. Default is empty.
      *
      * Write the values of the output criteria for the current step to the output file. Assumes that file is present and open.
      */
-    void writeStepToOutputFile(size_t step_num, std::ofstream &outputFile, std::vector<Json::Value> &input_values, std::vector<double> &output_values);
+    void writeStepToOutputFile(size_t step_num, std::ofstream &outputFile, std::vector<Json::Value> &input_values, std::vector<double> &output_values, const std::string &status = "");
 
-private:
+protected:
     std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges_;
     std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria_;
     std::ofstream outputFile_;
     CCTools::ModelHandler modelHandler_;
     CCTools::ModelCalculator modelCalculator_;
+    TraversalOrder traversal_order_ = LEXICOGRAPHIC;
+    size_t step_budget_ = 0;
+    std::chrono::duration<double> time_budget_ = std::chrono::duration<double>::zero();
+    std::map<std::string, std::chrono::duration<double>> phase_timeouts_; ///< Timeouts by calculation name, or `criteria`.
+    std::function<void(const std::string &)> phase_listener_;               ///< Called with the name of each phase `computeOutputs()` starts, if set.
+    size_t shard_index_ = 0;
+    size_t num_shards_ = 1;
+    std::shared_ptr<Sampler> sampler_ = nullptr;
+    size_t num_samples_ = 0;
+    size_t num_workers_ = 1;
+    std::map<size_t, std::pair<double, double>> acceptance_bounds_;
+    std::vector<std::pair<std::shared_ptr<InputParamRangeInterface>, std::function<Json::Value(const std::vector<Json::Value> &)>>> derived_inputs_;
+    std::vector<std::pair<std::string, std::function<bool(const std::vector<Json::Value> &)>>> feasibility_predicates_;
+    size_t num_pruned_steps_ = 0;
+    std::shared_ptr<FailurePredictor> failure_predictor_ = nullptr;
+    FailurePolicy failure_policy_ = DEFER_LIKELY_FAILURES;
+    double failure_threshold_ = 0.5;
+    FailurePredictionStatistics failure_statistics_;
+    size_t max_harmonic_order_ = 0;                            ///< The multipole order of the harmonics calculations of the steps, 0 for the order of the model.
+    std::vector<Json::Value> start_config_;                   ///< The start configuration of an iterative mode, empty for the center of the ranges.
+    long best_index_ = -1;
+    double best_objective_ = std::numeric_limits<double>::infinity();
+    std::vector<Json::Value> best_config_;
+
+private:
+    /**
+     * @brief Model copy of a parallel worker.
+     */
+    struct WorkerContext
+    {
+        CCTools::ModelHandler model_handler;
+        CCTools::ModelCalculator model_calculator;
+    };
+
+    /**
+     * @brief Create the worker contexts with copies of the current model.
+     *
+     * Does nothing if the worker contexts already exist.
+     */
+    void initWorkers();
+
+    /**
+     * @brief Run the calculations and compute the output criteria of the applied configuration.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     * @param modelCalculator The model calculator.
+     * @param modelHandler The model handler with the applied configuration.
+     * @param status The status of the step, empty if no acceptance bounds are set.
+     * @return The values of the output criteria, NaN for criteria not computed because the step was rejected.
+     *
+     * Runs all calculations at once if no acceptance bounds are set, in stages otherwise, see `setAcceptanceBounds()`.
+     */
+    std::vector<double> computeOutputs(const std::vector<std::type_index> &required_calculations, CCTools::ModelCalculator &modelCalculator, CCTools::ModelHandler &modelHandler, std::string &status) const;
+
+    /**
+     * @brief Get the name of a calculation as used for timeouts.
+     * @param calculation Type info of the calculation handler.
+     * @return `harmonics`, `mesh` or `geometry`.
+     *
+     * Throws an exception if the calculation type is unknown.
+     */
+    static std::string getCalculationName(const std::type_index &calculation);
+
+    /**
+     * @brief Check whether a step has a phase with a timeout, see `setCalculationTimeout()`.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     * @return True if the step must run in a child process.
+     */
+    bool hasStepTimeout(const std::vector<std::type_index> &required_calculations) const;
+
+    /**
+     * @brief Run `computeOutputs()` for the applied configuration in a child process that is killed when a phase exceeds its timeout.
+     * @param required_calculations Type info of the required calculation handlers for the output criteria.
+     * @param status The status of the step, `timeout:<phase>` if the child process was killed.
+     * @return The values of the output criteria, NaN for all criteria if the step timed out.
+     *
+     * Throws an exception if parallel workers exist, the calculations fail or the child process ends without results.
+     */
+    std::vector<double> computeOutputsIsolated(const std::vector<std::type_index> &required_calculations, std::string &status);
+
+    std::vector<std::unique_ptr<WorkerContext>> workers_;
+    inline static std::atomic<size_t> next_search_id_{0};
+    const size_t search_id_ = next_search_id_++; ///< Unique within the process, names the model copies of the workers.
 };
 
 #endif // PARAMETER_SEARCH_H
\ No newline at end of file
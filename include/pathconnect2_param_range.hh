@@ -0,0 +1,104 @@
+#ifndef PATHCONNECT2_PARAM_RANGE_HH
+#define PATHCONNECT2_PARAM_RANGE_HH
+
+#include <cstdint>
+#include <ctime>
+#include <algorithm>
+#include <json/json.h>
+#include <rat/models/pathconnect2.hh>
+#include "param_range.hh"
+#include "json_range.hh"
+
+/**
+ * @class PathConnect2ParamRange
+ * @brief Lazy range of random uvw configs for a pathconnect2 node.
+ *
+ * Lazy counterpart of `JsonRange::pathconnect2_range()`. The first config is the default config (see `JsonRange::pathconnect2_default_config()`),
+ * all other configs are random configs within the clamped lower and upper bounds of the node.
+ * Every config is generated from the seed and its position in the range, so only the bounds and the default config are held in memory
+ * and the same seed always yields the same configs.
+ */
+class PathConnect2ParamRange : public ParamRange
+{
+public:
+    /**
+     * @brief Construct a PathConnect2ParamRange object.
+     * @param pathconnect2 The pathconnect2 node.
+     * @param num_configs The number of configs. Must be at least 1.
+     * @param seed (Optional) The seed of the random configs. Default is the current time.
+     *
+     * It is advisable to set `symmetric`, `enable_w` and the number of control points before calling this function as the format of the configs
+     * depend on these values. Note that the uvw of the node are set to the default config, see `JsonRange::pathconnect2_default_config()`.
+     */
+    PathConnect2ParamRange(rat::mdl::ShPathConnect2Pr pathconnect2, size_t num_configs, uint64_t seed = static_cast<uint64_t>(time(nullptr))) : num_configs_(num_configs), seed_(seed)
+    {
+        if (num_configs < 1)
+        {
+            throw std::invalid_argument("num_configs must be greater than 0");
+        }
+
+        // get lb and ub
+        lb_ = pathconnect2->get_lb();
+        ub_ = pathconnect2->get_ub();
+
+        // clamp ub and lb to +-ell/(num_control_points+1) so the sum of u cannot be longer than ell
+        unsigned int num_control_points = pathconnect2->get_order() + 1;
+        double ell = pathconnect2->get_ell();
+        for (size_t i = 0; i < ub_.size() - 1; i++)
+        { // do not clamp w
+            ub_[i] = std::min(ub_[i], ell / (num_control_points + 1));
+        }
+        for (size_t i = 0; i < lb_.size() - 1; i++)
+        { // do not clamp w
+            lb_[i] = std::max(lb_[i], -ell / (num_control_points + 1));
+        }
+
+        default_config_ = JsonRange::pathconnect2_default_config(pathconnect2);
+    }
+
+    size_t size() const override
+    {
+        return num_configs_;
+    }
+
+    Json::Value at(size_t i) const override
+    {
+        checkPosition(i);
+        if (i == 0)
+        {
+            return default_config_;
+        }
+
+        // create a random config from the seed and the position
+        uint64_t state = seed_ ^ (static_cast<uint64_t>(i) * 0x9E3779B97F4A7C15ULL);
+        Json::Value config(Json::arrayValue);
+        for (size_t j = 0; j < lb_.size(); ++j)
+        {
+            double unit = static_cast<double>(splitmix64(state) >> 11) * 0x1.0p-53;
+            config.append(lb_[j] + unit * (ub_[j] - lb_[j]));
+        }
+        return config;
+    }
+
+private:
+    /**
+     * @brief SplitMix64 pseudo random number generator.
+     * @param state The state of the generator, advanced by the call.
+     * @return The next pseudo random number.
+     */
+    static uint64_t splitmix64(uint64_t &state)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    size_t num_configs_;
+    uint64_t seed_;
+    std::vector<double> lb_;
+    std::vector<double> ub_;
+    Json::Value default_config_;
+};
+
+#endif // PATHCONNECT2_PARAM_RANGE_HH
@@ -0,0 +1,224 @@
+#ifndef POLYNOMIAL_CHAOS_SURROGATE_HH
+#define POLYNOMIAL_CHAOS_SURROGATE_HH
+
+#include "surrogate_model.hh"
+#include <armadillo>
+
+/**
+ * @class PolynomialChaosSurrogate
+ * @brief Class for a least-squares polynomial chaos expansion in Legendre polynomials.
+ *
+ * The expansion contains all products of Legendre polynomials up to a total degree; the degree of each input is further limited
+ * to one less than its number of distinct values in the data. Smooths noisy data instead of interpolating it.
+ * The leave-one-out errors follow from the diagonal of the hat matrix without refitting.
+ */
+class PolynomialChaosSurrogate : public SurrogateModel
+{
+public:
+    /**
+     * @brief Construct a PolynomialChaosSurrogate object.
+     * @param max_degree (Optional) The total degree. Default is 0, the largest degree up to 6 with at most half as many terms as data points.
+     */
+    PolynomialChaosSurrogate(size_t max_degree = 0) : max_degree_(max_degree)
+    {
+    }
+
+    std::string getType() const override
+    {
+        return "pce";
+    }
+
+    /**
+     * @brief Get the number of terms of the fitted expansion.
+     * @return The number of terms.
+     */
+    size_t getNumTerms() const
+    {
+        return terms_.size();
+    }
+
+protected:
+    double fitUnit(const std::vector<std::vector<double>> &u, const std::vector<double> &y) override
+    {
+        size_t n = u.size();
+
+        // Choose the degree
+        size_t degree = max_degree_;
+        if (degree == 0)
+        {
+            degree = 1;
+            while (degree < AUTO_MAX_DEGREE && 2 * multiIndices(degree + 1).size() <= n)
+            {
+                degree++;
+            }
+        }
+        terms_ = multiIndices(degree);
+        size_t num_terms = terms_.size();
+        if (num_terms >= n)
+        {
+            throw std::invalid_argument("Polynomial chaos surrogate with " + std::to_string(num_terms) + " terms requires more data points");
+        }
+
+        arma::mat Psi(n, num_terms);
+        for (size_t i = 0; i < n; i++)
+        {
+            std::vector<double> basis = evaluateBasis(u[i]);
+            for (size_t t = 0; t < num_terms; t++)
+            {
+                Psi(i, t) = basis[t];
+            }
+        }
+
+        // Normal equations with a small ridge against collinear terms
+        arma::mat G = Psi.t() * Psi;
+        for (size_t t = 0; t < num_terms; t++)
+        {
+            G(t, t) += RIDGE * std::max(G(t, t), 1.0);
+        }
+        arma::mat G_inv;
+        if (!arma::inv(G_inv, G))
+        {
+            throw std::runtime_error("Polynomial chaos normal equations are singular");
+        }
+        arma::vec rhs(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            rhs(i) = y[i];
+        }
+        arma::vec c = G_inv * arma::vec(Psi.t() * rhs);
+        coefficients_.assign(num_terms, 0.0);
+        for (size_t t = 0; t < num_terms; t++)
+        {
+            coefficients_[t] = c(t);
+        }
+
+        // Leave-one-out residual r_i / (1 - h_ii)
+        std::vector<double> residuals(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            double prediction = 0.0, leverage = 0.0;
+            for (size_t s = 0; s < num_terms; s++)
+            {
+                prediction += Psi(i, s) * coefficients_[s];
+                for (size_t t = 0; t < num_terms; t++)
+                {
+                    leverage += Psi(i, s) * G_inv(s, t) * Psi(i, t);
+                }
+            }
+            residuals[i] = (y[i] - prediction) / std::max(1.0 - leverage, 1e-12);
+        }
+        return rootMeanSquare(residuals);
+    }
+
+    double predictUnit(const std::vector<double> &u) const override
+    {
+        std::vector<double> basis = evaluateBasis(u);
+        double value = 0.0;
+        for (size_t t = 0; t < terms_.size(); t++)
+        {
+            value += coefficients_[t] * basis[t];
+        }
+        return value;
+    }
+
+    void writeParameters(std::ostream &out) const override
+    {
+        out << terms_.size() << " " << active_inputs_.size() << "\n";
+        for (size_t t = 0; t < terms_.size(); t++)
+        {
+            out << coefficients_[t];
+            for (size_t degree : terms_[t])
+            {
+                out << " " << degree;
+            }
+            out << "\n";
+        }
+    }
+
+    void readParameters(std::istream &in) override
+    {
+        size_t num_terms = 0, d = 0;
+        in >> num_terms >> d;
+        terms_.assign(num_terms, std::vector<size_t>(d));
+        coefficients_.assign(num_terms, 0.0);
+        for (size_t t = 0; t < num_terms && in; t++)
+        {
+            in >> coefficients_[t];
+            for (size_t &degree : terms_[t])
+            {
+                in >> degree;
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief All multi-indices of the active inputs up to a total degree, each input limited by its number of levels.
+     */
+    std::vector<std::vector<size_t>> multiIndices(size_t degree) const
+    {
+        std::vector<std::vector<size_t>> indices;
+        std::vector<size_t> index(active_inputs_.size(), 0);
+        addMultiIndices(0, degree, index, indices);
+        return indices;
+    }
+
+    void addMultiIndices(size_t k, size_t remaining, std::vector<size_t> &index, std::vector<std::vector<size_t>> &indices) const
+    {
+        if (k == index.size())
+        {
+            indices.push_back(index);
+            return;
+        }
+        size_t max_k = std::min(remaining, num_levels_[k] - 1);
+        for (size_t p = 0; p <= max_k; p++)
+        {
+            index[k] = p;
+            addMultiIndices(k + 1, remaining - p, index, indices);
+        }
+        index[k] = 0;
+    }
+
+    std::vector<double> evaluateBasis(const std::vector<double> &u) const
+    {
+        // Legendre polynomials of each input on [-1, 1]
+        std::vector<std::vector<double>> legendre(u.size());
+        for (size_t k = 0; k < u.size(); k++)
+        {
+            size_t max_p = 0;
+            for (const std::vector<size_t> &term : terms_)
+            {
+                max_p = std::max(max_p, term[k]);
+            }
+            double z = 2.0 * u[k] - 1.0;
+            legendre[k].assign(max_p + 1, 1.0);
+            if (max_p >= 1)
+            {
+                legendre[k][1] = z;
+            }
+            for (size_t p = 1; p < max_p; p++)
+            {
+                legendre[k][p + 1] = ((2.0 * p + 1.0) * z * legendre[k][p] - p * legendre[k][p - 1]) / (p + 1.0);
+            }
+        }
+
+        std::vector<double> basis(terms_.size(), 1.0);
+        for (size_t t = 0; t < terms_.size(); t++)
+        {
+            for (size_t k = 0; k < u.size(); k++)
+            {
+                basis[t] *= legendre[k][terms_[t][k]];
+            }
+        }
+        return basis;
+    }
+
+    static constexpr size_t AUTO_MAX_DEGREE = 6;
+    static constexpr double RIDGE = 1e-10;
+
+    size_t max_degree_;
+    std::vector<std::vector<size_t>> terms_;
+    std::vector<double> coefficients_;
+};
+
+#endif // POLYNOMIAL_CHAOS_SURROGATE_HH
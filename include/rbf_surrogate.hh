@@ -0,0 +1,157 @@
+#ifndef RBF_SURROGATE_HH
+#define RBF_SURROGATE_HH
+
+#include "surrogate_model.hh"
+#include <armadillo>
+
+/**
+ * @class RbfSurrogate
+ * @brief Class for a cubic radial basis function interpolant with a linear polynomial tail.
+ *
+ * Interpolates scattered data exactly. The leave-one-out errors follow from the inverse of the interpolation matrix without refitting
+ * (Rippa, "An algorithm for selecting a good value for the parameter c in radial basis function interpolation", 1999).
+ * Fitting costs O(n^3) in the number of data points n, a prediction O(n).
+ */
+class RbfSurrogate : public SurrogateModel
+{
+public:
+    std::string getType() const override
+    {
+        return "rbf";
+    }
+
+protected:
+    double fitUnit(const std::vector<std::vector<double>> &u, const std::vector<double> &y) override
+    {
+        size_t n = u.size();
+        size_t d = u[0].size();
+        size_t m = d + 1;
+        if (n < m + 1)
+        {
+            throw std::invalid_argument("RBF surrogate requires at least " + std::to_string(m + 1) + " data points");
+        }
+
+        // Interpolation matrix [Phi P; P^T 0]
+        arma::mat A(n + m, n + m, arma::fill::zeros);
+        for (size_t i = 0; i < n; i++)
+        {
+            for (size_t j = 0; j < n; j++)
+            {
+                A(i, j) = kernel(distance(u[i], u[j]));
+            }
+            A(i, n) = A(n, i) = 1.0;
+            for (size_t k = 0; k < d; k++)
+            {
+                A(i, n + 1 + k) = A(n + 1 + k, i) = u[i][k];
+            }
+        }
+        arma::mat A_inv;
+        if (!arma::inv(A_inv, A))
+        {
+            throw std::runtime_error("RBF interpolation matrix is singular, the data may contain duplicate points");
+        }
+
+        arma::vec rhs(n + m, arma::fill::zeros);
+        for (size_t i = 0; i < n; i++)
+        {
+            rhs(i) = y[i];
+        }
+        arma::vec coefficients = A_inv * rhs;
+
+        centers_ = u;
+        weights_.assign(n, 0.0);
+        for (size_t i = 0; i < n; i++)
+        {
+            weights_[i] = coefficients(i);
+        }
+        tail_.assign(m, 0.0);
+        for (size_t k = 0; k < m; k++)
+        {
+            tail_[k] = coefficients(n + k);
+        }
+
+        std::vector<double> residuals(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            residuals[i] = coefficients(i) / A_inv(i, i);
+        }
+        return rootMeanSquare(residuals);
+    }
+
+    double predictUnit(const std::vector<double> &u) const override
+    {
+        double value = tail_[0];
+        for (size_t k = 0; k < u.size(); k++)
+        {
+            value += tail_[k + 1] * u[k];
+        }
+        for (size_t i = 0; i < centers_.size(); i++)
+        {
+            value += weights_[i] * kernel(distance(u, centers_[i]));
+        }
+        return value;
+    }
+
+    void writeParameters(std::ostream &out) const override
+    {
+        size_t d = tail_.size() - 1;
+        out << centers_.size() << " " << d << "\n";
+        for (size_t i = 0; i < centers_.size(); i++)
+        {
+            out << weights_[i];
+            for (double c : centers_[i])
+            {
+                out << " " << c;
+            }
+            out << "\n";
+        }
+        for (double t : tail_)
+        {
+            out << t << " ";
+        }
+        out << "\n";
+    }
+
+    void readParameters(std::istream &in) override
+    {
+        size_t n = 0, d = 0;
+        in >> n >> d;
+        centers_.assign(n, std::vector<double>(d));
+        weights_.assign(n, 0.0);
+        for (size_t i = 0; i < n && in; i++)
+        {
+            in >> weights_[i];
+            for (double &c : centers_[i])
+            {
+                in >> c;
+            }
+        }
+        tail_.assign(d + 1, 0.0);
+        for (double &t : tail_)
+        {
+            in >> t;
+        }
+    }
+
+private:
+    static double kernel(double r)
+    {
+        return r * r * r;
+    }
+
+    static double distance(const std::vector<double> &a, const std::vector<double> &b)
+    {
+        double sum = 0.0;
+        for (size_t k = 0; k < a.size(); k++)
+        {
+            sum += (a[k] - b[k]) * (a[k] - b[k]);
+        }
+        return std::sqrt(sum);
+    }
+
+    std::vector<std::vector<double>> centers_;
+    std::vector<double> weights_;
+    std::vector<double> tail_;
+};
+
+#endif // RBF_SURROGATE_HH
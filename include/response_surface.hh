@@ -0,0 +1,327 @@
+#ifndef RESPONSE_SURFACE_HH
+#define RESPONSE_SURFACE_HH
+
+#include "surrogate_model.hh"
+#include "rbf_surrogate.hh"
+#include "polynomial_chaos_surrogate.hh"
+#include "tensor_spline_surrogate.hh"
+#include <memory>
+#include <fstream>
+#include <sstream>
+
+/**
+ * @class ResponseSurface
+ * @brief Class for surrogates of all output criteria of a results CSV, saved to and loaded from a surrogate file.
+ *
+ * Reads an output file of a parameter search (`index,<inputs>,<criteria>`) and fits one `SurrogateModel` per output criterion:
+ * `rbf` (`RbfSurrogate`), `pce` (`PolynomialChaosSurrogate`) or `spline` (`TensorSplineSurrogate`, grid search results only).
+ * Rows of failed steps, and rows with values that are not numbers, are skipped; a criterion that is not finite in a row (e.g. not computed because
+ * the step was rejected, see `ParameterSearch::setAcceptanceBounds()`) is skipped for that criterion only. A trailing `status` column is ignored.
+ */
+class ResponseSurface
+{
+public:
+    /**
+     * @brief Fit the surrogates to a results CSV.
+     * @param results_path The path of the output file of a parameter search.
+     * @param num_inputs The number of input parameter columns after the index column.
+     * @param type The type of the surrogates, `rbf`, `pce` or `spline`.
+     *
+     * Throws an exception if the file cannot be read, has no output criteria or too few usable rows.
+     */
+    void fit(const std::string &results_path, size_t num_inputs, const std::string &type)
+    {
+        std::ifstream file(results_path);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Results file could not be opened: " + results_path);
+        }
+
+        std::string line;
+        std::getline(file, line);
+        std::vector<std::string> header = splitLine(line);
+
+        // The status column of staged evaluation is not a criterion
+        bool has_status = !header.empty() && header.back() == "status";
+        if (has_status)
+        {
+            header.pop_back();
+        }
+        if (header.size() < num_inputs + 2)
+        {
+            throw std::invalid_argument("Results file has no output criteria after " + std::to_string(num_inputs) + " inputs");
+        }
+        input_names_.assign(header.begin() + 1, header.begin() + 1 + num_inputs);
+        criterion_names_.assign(header.begin() + 1 + num_inputs, header.end());
+
+        std::vector<std::vector<double>> x;
+        std::vector<std::vector<double>> y;
+        num_skipped_rows_ = 0;
+        while (std::getline(file, line))
+        {
+            std::vector<std::string> fields = splitLine(line);
+            if (has_status && !fields.empty())
+            {
+                fields.pop_back();
+            }
+            std::vector<double> values;
+            if (fields.size() != header.size() || !parseNumbers(fields, values))
+            {
+                num_skipped_rows_ += line.empty() ? 0 : 1;
+                continue;
+            }
+            x.emplace_back(values.begin() + 1, values.begin() + 1 + num_inputs);
+            y.emplace_back(values.begin() + 1 + num_inputs, values.end());
+        }
+
+        models_.clear();
+        for (size_t c = 0; c < criterion_names_.size(); c++)
+        {
+            std::vector<std::vector<double>> x_c;
+            std::vector<double> y_c;
+            for (size_t i = 0; i < x.size(); i++)
+            {
+                if (std::isfinite(y[i][c]))
+                {
+                    x_c.push_back(x[i]);
+                    y_c.push_back(y[i][c]);
+                }
+            }
+            if (x_c.empty())
+            {
+                throw std::invalid_argument("No usable rows for output criterion " + criterion_names_[c]);
+            }
+            models_.push_back(createModel(type));
+            models_.back()->fit(x_c, y_c);
+        }
+    }
+
+    /**
+     * @brief Save the surrogates.
+     * @param path The path of the surrogate file.
+     */
+    void save(const std::string &path) const
+    {
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Surrogate file could not be opened: " + path);
+        }
+        file << FILE_TAG << " " << FILE_VERSION << "\n"
+             << input_names_.size() << "\n";
+        for (const std::string &name : input_names_)
+        {
+            file << name << "\n";
+        }
+        file << criterion_names_.size() << "\n";
+        for (size_t c = 0; c < criterion_names_.size(); c++)
+        {
+            file << criterion_names_[c] << "\n";
+            models_[c]->write(file);
+        }
+    }
+
+    /**
+     * @brief Load surrogates saved with `save()`.
+     * @param path The path of the surrogate file.
+     */
+    void load(const std::string &path)
+    {
+        std::ifstream file(path);
+        std::string tag;
+        int version = 0;
+        file >> tag >> version;
+        if (tag != FILE_TAG || version != FILE_VERSION)
+        {
+            throw std::runtime_error("Not a surrogate file of version " + std::to_string(FILE_VERSION) + ": " + path);
+        }
+
+        size_t num_inputs = 0;
+        file >> num_inputs >> std::ws;
+        input_names_.assign(num_inputs, "");
+        for (std::string &name : input_names_)
+        {
+            std::getline(file, name);
+        }
+        size_t num_criteria = 0;
+        file >> num_criteria >> std::ws;
+        criterion_names_.assign(num_criteria, "");
+        models_.clear();
+        for (std::string &name : criterion_names_)
+        {
+            std::getline(file, name);
+            std::string type;
+            file >> type;
+            models_.push_back(createModel(type));
+            models_.back()->read(file);
+            file >> std::ws;
+        }
+        if (!file)
+        {
+            throw std::runtime_error("Surrogate file could not be read: " + path);
+        }
+    }
+
+    /**
+     * @brief Predict the output criteria.
+     * @param points The inputs of each point, in the order of the input columns.
+     * @return The predicted value of each output criterion at each point.
+     */
+    std::vector<std::vector<double>> predict(const std::vector<std::vector<double>> &points) const
+    {
+        std::vector<std::vector<double>> predictions(points.size(), std::vector<double>(models_.size()));
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            for (size_t c = 0; c < models_.size(); c++)
+            {
+                predictions[i][c] = models_[c]->predict(points[i]);
+            }
+        }
+        return predictions;
+    }
+
+    /**
+     * @brief Get the cross-validation errors.
+     * @return The leave-one-out root mean square error of each output criterion.
+     */
+    std::vector<double> getCrossValidationErrors() const
+    {
+        std::vector<double> errors;
+        for (const std::unique_ptr<SurrogateModel> &model : models_)
+        {
+            errors.push_back(model->getCrossValidationError());
+        }
+        return errors;
+    }
+
+    /**
+     * @brief Get the names of the input columns.
+     * @return The column names.
+     */
+    const std::vector<std::string> &getInputNames() const
+    {
+        return input_names_;
+    }
+
+    /**
+     * @brief Get the names of the output criterion columns.
+     * @return The column names.
+     */
+    const std::vector<std::string> &getCriterionNames() const
+    {
+        return criterion_names_;
+    }
+
+    /**
+     * @brief Get the number of rows skipped by the last `fit()`.
+     * @return The number of rows of failed steps or with values that are not numbers.
+     */
+    size_t getNumSkippedRows() const
+    {
+        return num_skipped_rows_;
+    }
+
+    /**
+     * @brief Create an unfitted surrogate.
+     * @param type The type, `rbf`, `pce` or `spline`.
+     * @return The surrogate.
+     */
+    static std::unique_ptr<SurrogateModel> createModel(const std::string &type)
+    {
+        if (type == "rbf")
+        {
+            return std::make_unique<RbfSurrogate>();
+        }
+        if (type == "pce")
+        {
+            return std::make_unique<PolynomialChaosSurrogate>();
+        }
+        if (type == "spline")
+        {
+            return std::make_unique<TensorSplineSurrogate>();
+        }
+        throw std::invalid_argument("Unknown surrogate type: " + type);
+    }
+
+    /**
+     * @brief Split a CSV line at commas.
+     * @param line The line.
+     * @return The fields. Quoted fields may contain commas, see `InputParamRangeInterface::writeValue()`, their quotes are removed.
+     */
+    static std::vector<std::string> splitLine(const std::string &line)
+    {
+        std::vector<std::string> fields;
+        std::string field;
+        bool in_quotes = false;
+        for (size_t i = 0; i < line.size(); i++)
+        {
+            char c = line[i];
+            if (c == '"')
+            {
+                // A doubled quote inside a quoted field is a literal quote
+                if (in_quotes && i + 1 < line.size() && line[i + 1] == '"')
+                {
+                    field += '"';
+                    i++;
+                }
+                else
+                {
+                    in_quotes = !in_quotes;
+                }
+            }
+            else if (c == ',' && !in_quotes)
+            {
+                fields.push_back(field);
+                field.clear();
+            }
+            else
+            {
+                field += c;
+            }
+        }
+        if (!line.empty())
+        {
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+    /**
+     * @brief Parse fields as numbers.
+     * @param fields The fields.
+     * @param values The parsed numbers.
+     * @return False if a field is not a number.
+     */
+    static bool parseNumbers(const std::vector<std::string> &fields, std::vector<double> &values)
+    {
+        values.clear();
+        for (const std::string &field : fields)
+        {
+            try
+            {
+                size_t end = 0;
+                values.push_back(std::stod(field, &end));
+                if (field.find_first_not_of(" \t\r\n", end) != std::string::npos)
+                {
+                    return false;
+                }
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static constexpr const char *FILE_TAG = "CCTSIM_SURROGATE";
+    static constexpr int FILE_VERSION = 1;
+
+    std::vector<std::string> input_names_;
+    std::vector<std::string> criterion_names_;
+    std::vector<std::unique_ptr<SurrogateModel>> models_;
+    size_t num_skipped_rows_ = 0;
+};
+
+#endif // RESPONSE_SURFACE_HH
@@ -0,0 +1,330 @@
+#ifndef SAMPLER_HH
+#define SAMPLER_HH
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @interface Sampler
+ * @brief Interface for space-filling designs on the unit cube.
+ *
+ * A sampler generates points in [0, 1)^d which are mapped to the input parameters with `ParamRange::sample()`.
+ * Compared to the full grid, a few thousand well-spread points cover a parameter space with many input parameters.
+ */
+class Sampler
+{
+public:
+    /**
+     * @brief Generate the sample points.
+     * @param num_samples The number of points.
+     * @param num_dims The number of dimensions, i.e. the number of input parameters.
+     * @return The points, each a vector of `num_dims` coordinates in [0, 1).
+     *
+     * The same sampler object always generates the same points for the same arguments.
+     */
+    virtual std::vector<std::vector<double>> generate(size_t num_samples, size_t num_dims) const = 0;
+
+    /**
+     * @brief Get the name of the sampler.
+     * @return The name of the sampler.
+     */
+    virtual std::string getName() const = 0;
+
+    virtual ~Sampler() = default;
+};
+
+/**
+ * @class LatinHypercubeSampler
+ * @brief Seeded Latin hypercube design.
+ *
+ * Each dimension is divided into `num_samples` equally sized strata and every stratum contains exactly one point.
+ * The point is placed at a random position inside its stratum.
+ */
+class LatinHypercubeSampler : public Sampler
+{
+public:
+    /**
+     * @brief Construct a LatinHypercubeSampler object.
+     * @param seed The seed of the random number generator.
+     */
+    LatinHypercubeSampler(uint64_t seed) : seed_(seed) {}
+
+    std::vector<std::vector<double>> generate(size_t num_samples, size_t num_dims) const override
+    {
+        std::mt19937_64 rng(seed_);
+        std::uniform_real_distribution<double> jitter(0.0, 1.0);
+
+        std::vector<std::vector<double>> points(num_samples, std::vector<double>(num_dims));
+        std::vector<size_t> strata(num_samples);
+        for (size_t d = 0; d < num_dims; d++)
+        {
+            std::iota(strata.begin(), strata.end(), 0);
+            std::shuffle(strata.begin(), strata.end(), rng);
+            for (size_t i = 0; i < num_samples; i++)
+            {
+                points[i][d] = (strata[i] + jitter(rng)) / num_samples;
+            }
+        }
+        return points;
+    }
+
+    std::string getName() const override
+    {
+        return "LATIN_HYPERCUBE";
+    }
+
+private:
+    uint64_t seed_;
+};
+
+/**
+ * @class SobolSampler
+ * @brief Scrambled Sobol sequence.
+ *
+ * Sobol points with the direction numbers of Joe and Kuo (new-joe-kuo-6.21201) for up to 21 dimensions.
+ * The points are scrambled with a seeded random digital shift, which keeps the stratification of the sequence:
+ * for every power of two 2^k, the first 2^k points place exactly one point in every interval [j/2^k, (j+1)/2^k) of each dimension.
+ */
+class SobolSampler : public Sampler
+{
+public:
+    /**
+     * @brief Construct a SobolSampler object.
+     * @param seed The seed of the digital shift. A seed of 0 disables the scrambling.
+     */
+    SobolSampler(uint64_t seed) : seed_(seed) {}
+
+    /**
+     * @brief Get the maximum number of dimensions.
+     * @return The maximum number of dimensions.
+     */
+    static size_t getMaxDims()
+    {
+        return directionTable().size() + 1;
+    }
+
+    std::vector<std::vector<double>> generate(size_t num_samples, size_t num_dims) const override
+    {
+        if (num_dims > getMaxDims())
+        {
+            throw std::invalid_argument("SobolSampler supports at most " + std::to_string(getMaxDims()) + " dimensions");
+        }
+        if (num_samples > (static_cast<uint64_t>(1) << BITS))
+        {
+            throw std::invalid_argument("SobolSampler supports at most 2^32 samples");
+        }
+
+        // Direction numbers and digital shift of each dimension
+        std::vector<std::vector<uint32_t>> directions(num_dims);
+        std::vector<uint32_t> shifts(num_dims, 0);
+        std::mt19937_64 rng(seed_);
+        for (size_t d = 0; d < num_dims; d++)
+        {
+            directions[d] = getDirections(d);
+            if (seed_ != 0)
+            {
+                shifts[d] = static_cast<uint32_t>(rng() >> 32);
+            }
+        }
+
+        std::vector<std::vector<double>> points(num_samples, std::vector<double>(num_dims));
+        for (size_t i = 0; i < num_samples; i++)
+        {
+            // Point i is the XOR of the direction numbers of the set bits of the Gray code of i
+            uint64_t gray = static_cast<uint64_t>(i) ^ (static_cast<uint64_t>(i) >> 1);
+            for (size_t d = 0; d < num_dims; d++)
+            {
+                uint32_t x = shifts[d];
+                for (unsigned int k = 0; k < BITS && (gray >> k) != 0; k++)
+                {
+                    if ((gray >> k) & 1)
+                    {
+                        x ^= directions[d][k];
+                    }
+                }
+                points[i][d] = x * 0x1.0p-32;
+            }
+        }
+        return points;
+    }
+
+    std::string getName() const override
+    {
+        return "SOBOL";
+    }
+
+private:
+    static constexpr unsigned int BITS = 32;
+
+    /**
+     * @brief Primitive polynomial and initial direction numbers of a dimension.
+     */
+    struct DirectionEntry
+    {
+        unsigned int s;
+        uint32_t a;
+        std::vector<uint32_t> m;
+    };
+
+    /**
+     * @brief Get the direction number table for the dimensions 2 to 21.
+     * @return The direction number table.
+     */
+    static const std::vector<DirectionEntry> &directionTable()
+    {
+        static const std::vector<DirectionEntry> table = {
+            {1, 0, {1}},
+            {2, 1, {1, 3}},
+            {3, 1, {1, 3, 1}},
+            {3, 2, {1, 1, 1}},
+            {4, 1, {1, 1, 3, 3}},
+            {4, 4, {1, 3, 5, 13}},
+            {5, 2, {1, 1, 5, 5, 17}},
+            {5, 4, {1, 1, 5, 5, 5}},
+            {5, 7, {1, 1, 7, 11, 19}},
+            {5, 11, {1, 1, 5, 1, 1}},
+            {5, 13, {1, 1, 1, 3, 11}},
+            {5, 14, {1, 3, 5, 5, 31}},
+            {6, 1, {1, 3, 3, 9, 7, 49}},
+            {6, 13, {1, 1, 1, 15, 21, 21}},
+            {6, 16, {1, 3, 1, 13, 27, 49}},
+            {6, 19, {1, 1, 1, 15, 7, 5}},
+            {6, 22, {1, 3, 1, 15, 13, 25}},
+            {6, 25, {1, 1, 5, 5, 19, 61}},
+            {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+            {7, 4, {1, 3, 7, 13, 13, 15, 69}}};
+        return table;
+    }
+
+    /**
+     * @brief Get the direction numbers of a dimension.
+     * @param dim The dimension (0-indexed).
+     * @return The direction numbers scaled to 32 bits.
+     */
+    static std::vector<uint32_t> getDirections(size_t dim)
+    {
+        std::vector<uint32_t> v(BITS);
+        if (dim == 0)
+        {
+            // The first dimension is the van der Corput sequence in base 2
+            for (unsigned int k = 0; k < BITS; k++)
+            {
+                v[k] = static_cast<uint32_t>(1) << (BITS - 1 - k);
+            }
+            return v;
+        }
+
+        const DirectionEntry &entry = directionTable()[dim - 1];
+        for (unsigned int k = 0; k < BITS; k++)
+        {
+            if (k < entry.s)
+            {
+                v[k] = entry.m[k] << (BITS - 1 - k);
+            }
+            else
+            {
+                // Recurrence of the primitive polynomial
+                v[k] = v[k - entry.s] ^ (v[k - entry.s] >> entry.s);
+                for (unsigned int j = 1; j < entry.s; j++)
+                {
+                    if ((entry.a >> (entry.s - 1 - j)) & 1)
+                    {
+                        v[k] ^= v[k - j];
+                    }
+                }
+            }
+        }
+        return v;
+    }
+
+    uint64_t seed_;
+};
+
+/**
+ * @class HaltonSampler
+ * @brief Halton sequence.
+ *
+ * Dimension `d` is the radical inverse in the `d`-th prime base. The point at index 0, which lies at the origin, is skipped.
+ * The Halton sequence is deterministic and needs no seed. Its points become correlated in high dimensions, prefer `SobolSampler` for more than ~10 input parameters.
+ */
+class HaltonSampler : public Sampler
+{
+public:
+    std::vector<std::vector<double>> generate(size_t num_samples, size_t num_dims) const override
+    {
+        std::vector<unsigned int> bases = getPrimes(num_dims);
+
+        std::vector<std::vector<double>> points(num_samples, std::vector<double>(num_dims));
+        for (size_t i = 0; i < num_samples; i++)
+        {
+            for (size_t d = 0; d < num_dims; d++)
+            {
+                points[i][d] = radicalInverse(i + 1, bases[d]);
+            }
+        }
+        return points;
+    }
+
+    std::string getName() const override
+    {
+        return "HALTON";
+    }
+
+    /**
+     * @brief Get the radical inverse of an index.
+     * @param i The index.
+     * @param base The base.
+     * @return The digits of `i` in base `base` mirrored at the decimal point.
+     */
+    static double radicalInverse(size_t i, unsigned int base)
+    {
+        double result = 0.0;
+        double factor = 1.0 / base;
+        while (i > 0)
+        {
+            result += (i % base) * factor;
+            i /= base;
+            factor /= base;
+        }
+        return result;
+    }
+
+private:
+    /**
+     * @brief Get the first primes.
+     * @param n The number of primes.
+     * @return The first `n` primes.
+     */
+    static std::vector<unsigned int> getPrimes(size_t n)
+    {
+        std::vector<unsigned int> primes;
+        for (unsigned int candidate = 2; primes.size() < n; candidate++)
+        {
+            bool is_prime = true;
+            for (unsigned int p : primes)
+            {
+                if (p * p > candidate)
+                {
+                    break;
+                }
+                if (candidate % p == 0)
+                {
+                    is_prime = false;
+                    break;
+                }
+            }
+            if (is_prime)
+            {
+                primes.push_back(candidate);
+            }
+        }
+        return primes;
+    }
+};
+
+#endif // SAMPLER_HH
@@ -0,0 +1,59 @@
+#ifndef SENSITIVITY_SCREENING_H
+#define SENSITIVITY_SCREENING_H
+
+#include "parameter_search.h"
+#include "morris_design.hh"
+
+/**
+ * @class SensitivityScreening
+ * @brief Class for screening which input parameters matter for each output criterion with the elementary effects method of Morris.
+ *
+ * Evaluates a Morris trajectory design (see `MorrisDesign`) over the input parameter ranges, sampled with `ParamRange::sample()`,
+ * and reports mu* (the importance) and sigma (nonlinearity and interactions) of every (input parameter, output criterion) pair.
+ * Elementary effects are given per unit of the range, i.e. the change of the criterion over the whole range of the input parameter.
+ * Whole trajectories are evaluated as batches, i.e. in parallel if workers are set, see `ParameterSearch::setNumWorkers()`.
+ * Every evaluation is written to the output file in the same format as the grid search, the index column holds the evaluation number.
+ * The statistics are written to a second file with the suffix `_morris.csv`. A trajectory is only started if it fits into the step budget.
+ */
+class SensitivityScreening : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct a SensitivityScreening object.
+     * @param inputParamsRanges The input parameter ranges.
+     * @param outputCriteria The output criteria.
+     * @param modelHandler The model handler.
+     * @param num_trajectories The number of trajectories, each has one more step than there are input parameters. Must be at least 2.
+     * @param num_levels (Optional) The number of grid levels per input parameter. Must be even and at least 2. Default is 4.
+     * @param seed (Optional) The seed of the design. Default is 0.
+     */
+    SensitivityScreening(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, size_t num_trajectories, size_t num_levels = 4, uint64_t seed = 0);
+
+    /**
+     * @brief Run the screening.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory, the statistics to a second CSV next to it.
+     */
+    void run() override;
+
+    /**
+     * @brief Get the statistics of the last run.
+     * @return The statistics of each input parameter (outer) and output criterion (inner).
+     */
+    std::vector<std::vector<MorrisStatistics>> getStatistics() const;
+
+private:
+    /**
+     * @brief Write the statistics to their own output file.
+     * @param output_file_path The path of the output file of all evaluations.
+     * @return The path of the statistics file.
+     */
+    std::string writeSummaryFile(const std::string &output_file_path);
+
+    size_t num_trajectories_;
+    size_t num_levels_;
+    uint64_t seed_;
+    std::vector<std::vector<MorrisStatistics>> statistics_;
+};
+
+#endif // SENSITIVITY_SCREENING_H
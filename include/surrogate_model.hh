@@ -0,0 +1,221 @@
+#ifndef SURROGATE_MODEL_HH
+#define SURROGATE_MODEL_HH
+
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <iomanip>
+#include <stdexcept>
+
+/**
+ * @class SurrogateModel
+ * @brief Base class for response surfaces of one output criterion over the input parameters.
+ *
+ * The inputs are mapped to the unit cube spanned by the fitted data. Inputs that take a single value in the data are dropped.
+ * Derived classes fit and evaluate the model in these unit coordinates and report the leave-one-out cross-validation error of the fit.
+ */
+class SurrogateModel
+{
+public:
+    virtual ~SurrogateModel() = default;
+
+    /**
+     * @brief Fit the model.
+     * @param x The inputs of each data point.
+     * @param y The output of each data point.
+     *
+     * Throws an exception if the sizes do not match or there are too few data points for the model.
+     */
+    void fit(const std::vector<std::vector<double>> &x, const std::vector<double> &y)
+    {
+        if (x.empty() || x.size() != y.size())
+        {
+            throw std::invalid_argument("Number of data points does not match the number of outputs");
+        }
+        num_inputs_ = x[0].size();
+        lower_.assign(num_inputs_, std::numeric_limits<double>::infinity());
+        upper_.assign(num_inputs_, -std::numeric_limits<double>::infinity());
+        for (const std::vector<double> &point : x)
+        {
+            if (point.size() != num_inputs_)
+            {
+                throw std::invalid_argument("Data points have different numbers of inputs");
+            }
+            for (size_t i = 0; i < num_inputs_; i++)
+            {
+                lower_[i] = std::min(lower_[i], point[i]);
+                upper_[i] = std::max(upper_[i], point[i]);
+            }
+        }
+
+        // Inputs that do not vary carry no information
+        active_inputs_.clear();
+        num_levels_.clear();
+        for (size_t i = 0; i < num_inputs_; i++)
+        {
+            if (upper_[i] > lower_[i])
+            {
+                std::set<double> levels;
+                for (const std::vector<double> &point : x)
+                {
+                    levels.insert(point[i]);
+                }
+                active_inputs_.push_back(i);
+                num_levels_.push_back(levels.size());
+            }
+        }
+
+        std::vector<std::vector<double>> u;
+        for (const std::vector<double> &point : x)
+        {
+            u.push_back(toUnit(point));
+        }
+        cv_error_ = fitUnit(u, y);
+    }
+
+    /**
+     * @brief Evaluate the model.
+     * @param x The inputs.
+     * @return The predicted output.
+     */
+    double predict(const std::vector<double> &x) const
+    {
+        if (x.size() != num_inputs_)
+        {
+            throw std::invalid_argument("Point has the wrong number of inputs");
+        }
+        return predictUnit(toUnit(x));
+    }
+
+    /**
+     * @brief Get the leave-one-out cross-validation error of the fit.
+     * @return The root mean square error of the predictions of the left-out data points, NaN if it could not be estimated.
+     */
+    double getCrossValidationError() const
+    {
+        return cv_error_;
+    }
+
+    /**
+     * @brief Get the type of the model.
+     * @return The name of the model as used in surrogate files.
+     */
+    virtual std::string getType() const = 0;
+
+    /**
+     * @brief Write the fitted model.
+     * @param out The stream, the type is written first.
+     */
+    void write(std::ostream &out) const
+    {
+        out << std::setprecision(17) << getType() << " " << cv_error_ << "\n"
+            << num_inputs_;
+        for (size_t i = 0; i < num_inputs_; i++)
+        {
+            out << " " << lower_[i] << " " << upper_[i];
+        }
+        out << "\n"
+            << active_inputs_.size();
+        for (size_t k = 0; k < active_inputs_.size(); k++)
+        {
+            out << " " << active_inputs_[k] << " " << num_levels_[k];
+        }
+        out << "\n";
+        writeParameters(out);
+    }
+
+    /**
+     * @brief Read a fitted model written by `write()`.
+     * @param in The stream, positioned after the type.
+     *
+     * Throws an exception if the stream ends early.
+     */
+    void read(std::istream &in)
+    {
+        // NaN is written as "nan", which operator>> does not parse
+        std::string cv_error;
+        in >> cv_error >> num_inputs_;
+        cv_error_ = cv_error == "nan" || cv_error == "-nan" ? std::numeric_limits<double>::quiet_NaN() : std::stod(cv_error);
+        lower_.assign(num_inputs_, 0.0);
+        upper_.assign(num_inputs_, 0.0);
+        for (size_t i = 0; i < num_inputs_; i++)
+        {
+            in >> lower_[i] >> upper_[i];
+        }
+        size_t num_active = 0;
+        in >> num_active;
+        active_inputs_.assign(num_active, 0);
+        num_levels_.assign(num_active, 0);
+        for (size_t k = 0; k < num_active; k++)
+        {
+            in >> active_inputs_[k] >> num_levels_[k];
+        }
+        readParameters(in);
+        if (!in)
+        {
+            throw std::runtime_error("Surrogate model of type " + getType() + " could not be read");
+        }
+    }
+
+protected:
+    /**
+     * @brief Fit the model in unit coordinates.
+     * @param u The unit coordinates of the active inputs of each data point.
+     * @param y The output of each data point.
+     * @return The leave-one-out cross-validation error.
+     */
+    virtual double fitUnit(const std::vector<std::vector<double>> &u, const std::vector<double> &y) = 0;
+
+    /**
+     * @brief Evaluate the model in unit coordinates.
+     * @param u The unit coordinates of the active inputs.
+     * @return The predicted output.
+     */
+    virtual double predictUnit(const std::vector<double> &u) const = 0;
+
+    virtual void writeParameters(std::ostream &out) const = 0;
+    virtual void readParameters(std::istream &in) = 0;
+
+    /**
+     * @brief Root mean square of the residuals, skipping non-finite ones.
+     */
+    static double rootMeanSquare(const std::vector<double> &residuals)
+    {
+        double sum = 0.0;
+        size_t count = 0;
+        for (double r : residuals)
+        {
+            if (std::isfinite(r))
+            {
+                sum += r * r;
+                count++;
+            }
+        }
+        return count > 0 ? std::sqrt(sum / count) : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    std::vector<double> toUnit(const std::vector<double> &x) const
+    {
+        std::vector<double> u(active_inputs_.size());
+        for (size_t k = 0; k < active_inputs_.size(); k++)
+        {
+            size_t i = active_inputs_[k];
+            u[k] = (x[i] - lower_[i]) / (upper_[i] - lower_[i]);
+        }
+        return u;
+    }
+
+    size_t num_inputs_ = 0;
+    std::vector<double> lower_;
+    std::vector<double> upper_;
+    std::vector<size_t> active_inputs_;
+    std::vector<size_t> num_levels_; ///< Number of distinct values of each active input in the fitted data.
+    double cv_error_ = std::numeric_limits<double>::quiet_NaN();
+};
+
+#endif // SURROGATE_MODEL_HH
@@ -0,0 +1,88 @@
+#ifndef TARGET_SOLVER_H
+#define TARGET_SOLVER_H
+
+#include "parameter_search.h"
+#include "brent_solver.hh"
+#include "broyden_solver.hh"
+
+/**
+ * @struct SolveTarget
+ * @brief An input parameter that is varied to bring an output criterion to a target value.
+ */
+struct SolveTarget
+{
+    size_t input_index;     ///< The position of the input parameter that is varied.
+    size_t criterion_index; ///< The position of the output criterion.
+    double target;          ///< The target value of the output criterion.
+    double tolerance;       ///< The accepted absolute deviation from the target.
+};
+
+/**
+ * @class TargetSolver
+ * @brief Class for finding the input parameter values at which output criteria reach target values.
+ *
+ * E.g. the layer pitch that yields a required `OutputMaxZ`, or the multipole scaling that zeroes a multipole.
+ * Each target pairs one input parameter with one output criterion. A single target is solved with bracketing and Brent's method (see `BrentSolver`),
+ * several targets as a square system with Broyden's method (see `BroydenSolver`). The varied input parameters are treated as continuous
+ * and sampled with `ParamRange::sample()`, so they should have linear or geometric ranges. All other input parameters are held at the start configuration.
+ * Batches (the bracketing points, the finite difference Jacobian) are evaluated in parallel if workers are set, see `ParameterSearch::setNumWorkers()`.
+ * Every evaluation is written to the output file in the same format as the grid search, the index column holds the evaluation number.
+ */
+class TargetSolver : public ParameterSearch
+{
+public:
+    /**
+     * @brief Construct a TargetSolver object.
+     * @param inputParamsRanges The input parameter ranges.
+     * @param outputCriteria The output criteria.
+     * @param modelHandler The model handler.
+     * @param targets The targets. Each input parameter can be varied for one target only.
+     * @param max_evaluations The evaluation budget. Must be greater than 0.
+     *
+     * Throws an exception if the targets are empty, refer to input parameters or output criteria that do not exist, share an input parameter
+     * or have a non-positive tolerance, or if a varied input parameter has a discrete range, see `ParamRange::isContinuous()`.
+     */
+    TargetSolver(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler, std::vector<SolveTarget> targets, size_t max_evaluations);
+
+    /**
+     * @brief Run the solver.
+     *
+     * The results will be written to a CSV in the `OUTPUT_DIR_PATH` directory.
+     */
+    void run() override;
+
+    /**
+     * @brief Set the start configuration.
+     * @param config The value of each input parameter, in the units of the output file.
+     *
+     * The values of the input parameters that are not varied are held fixed, the values of the varied ones are the start point of Broyden's method.
+     * Default is the center of the parameter ranges. Throws an exception if the number of values does not match the number of input parameters
+     * or if a value is not part of a discrete parameter range.
+     */
+    using ParameterSearch::setStartConfiguration;
+
+    /**
+     * @brief Check whether the last run reached all targets within their tolerances.
+     * @return True if all targets were reached.
+     */
+    bool hasConverged() const;
+
+    /**
+     * @brief Get the index of the solution of the last run.
+     * @return The index in the output file of the configuration closest to the targets, or -1 if no evaluation succeeded.
+     */
+    long getSolutionIndex() const;
+
+    /**
+     * @brief Get the configuration of the solution of the last run.
+     * @return The value of each input parameter, empty if no evaluation succeeded.
+     */
+    std::vector<Json::Value> getSolution() const;
+
+private:
+    std::vector<SolveTarget> targets_;
+    size_t max_evaluations_;
+    bool converged_ = false;
+};
+
+#endif // TARGET_SOLVER_H
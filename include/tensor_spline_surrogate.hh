@@ -0,0 +1,270 @@
+#ifndef TENSOR_SPLINE_SURROGATE_HH
+#define TENSOR_SPLINE_SURROGATE_HH
+
+#include "surrogate_model.hh"
+#include <map>
+#include <armadillo>
+
+/**
+ * @class TensorSplineSurrogate
+ * @brief Class for a tensor product of natural cubic splines through gridded data, e.g. the results of a grid search.
+ *
+ * The data must contain every combination of the distinct values of the inputs exactly once. Inputs with two values are interpolated linearly.
+ * Points outside the grid are clamped to its boundary. A prediction contracts the grid values with the spline weights of one input after the other,
+ * so it costs O(N) in the number of grid points N. The cross-validation error leaves out each interior grid value along each grid line
+ * and predicts it with the spline through the remaining values of that line; it is NaN if no input has more than two values.
+ */
+class TensorSplineSurrogate : public SurrogateModel
+{
+public:
+    std::string getType() const override
+    {
+        return "spline";
+    }
+
+protected:
+    double fitUnit(const std::vector<std::vector<double>> &u, const std::vector<double> &y) override
+    {
+        size_t d = u[0].size();
+
+        // Grid nodes of each input
+        nodes_.assign(d, {});
+        for (size_t k = 0; k < d; k++)
+        {
+            std::set<double> levels;
+            for (const std::vector<double> &point : u)
+            {
+                levels.insert(point[k]);
+            }
+            nodes_[k].assign(levels.begin(), levels.end());
+        }
+        size_t num_grid_points = 1;
+        for (const std::vector<double> &nodes : nodes_)
+        {
+            num_grid_points *= nodes.size();
+        }
+        if (num_grid_points != u.size())
+        {
+            throw std::invalid_argument("Spline surrogate requires gridded data: " + std::to_string(u.size()) + " data points for " +
+                                        std::to_string(num_grid_points) + " grid points");
+        }
+
+        // Grid values in row-major order, the last input varies fastest
+        values_.assign(num_grid_points, std::numeric_limits<double>::quiet_NaN());
+        std::vector<bool> is_set(num_grid_points, false);
+        for (size_t i = 0; i < u.size(); i++)
+        {
+            size_t flat = 0;
+            for (size_t k = 0; k < d; k++)
+            {
+                size_t position = std::lower_bound(nodes_[k].begin(), nodes_[k].end(), u[i][k]) - nodes_[k].begin();
+                flat = flat * nodes_[k].size() + position;
+            }
+            if (is_set[flat])
+            {
+                throw std::invalid_argument("Spline surrogate requires gridded data: grid point of data point " + std::to_string(i) + " repeats");
+            }
+            is_set[flat] = true;
+            values_[flat] = y[i];
+        }
+        initSecondDerivatives();
+
+        // Leave out interior values along each grid line
+        std::vector<double> residuals;
+        size_t stride = 1;
+        for (size_t k = d; k-- > 0;)
+        {
+            size_t n_k = nodes_[k].size();
+            if (n_k >= 3)
+            {
+                for (size_t flat = 0; flat < num_grid_points; flat++)
+                {
+                    size_t position = (flat / stride) % n_k;
+                    if (position == 0 || position == n_k - 1)
+                    {
+                        continue;
+                    }
+                    std::vector<double> t, line;
+                    for (size_t p = 0; p < n_k; p++)
+                    {
+                        if (p != position)
+                        {
+                            t.push_back(nodes_[k][p]);
+                            line.push_back(values_[flat + (p - position) * stride]);
+                        }
+                    }
+                    std::vector<double> w = weights(t, secondDerivativeMatrix(t), nodes_[k][position]);
+                    double prediction = 0.0;
+                    for (size_t p = 0; p < w.size(); p++)
+                    {
+                        prediction += w[p] * line[p];
+                    }
+                    residuals.push_back(values_[flat] - prediction);
+                }
+            }
+            stride *= n_k;
+        }
+        return rootMeanSquare(residuals);
+    }
+
+    double predictUnit(const std::vector<double> &u) const override
+    {
+        // Contract the last input first
+        std::vector<double> current = values_;
+        for (size_t k = nodes_.size(); k-- > 0;)
+        {
+            std::vector<double> w = weights(nodes_[k], second_derivatives_[k], u[k]);
+            size_t n_k = nodes_[k].size();
+            std::vector<double> next(current.size() / n_k, 0.0);
+            for (size_t i = 0; i < next.size(); i++)
+            {
+                for (size_t p = 0; p < n_k; p++)
+                {
+                    next[i] += w[p] * current[i * n_k + p];
+                }
+            }
+            current.swap(next);
+        }
+        return current[0];
+    }
+
+    void writeParameters(std::ostream &out) const override
+    {
+        out << nodes_.size() << "\n";
+        for (const std::vector<double> &nodes : nodes_)
+        {
+            out << nodes.size();
+            for (double node : nodes)
+            {
+                out << " " << node;
+            }
+            out << "\n";
+        }
+        for (double value : values_)
+        {
+            out << value << " ";
+        }
+        out << "\n";
+    }
+
+    void readParameters(std::istream &in) override
+    {
+        size_t d = 0;
+        in >> d;
+        nodes_.assign(d, {});
+        size_t num_grid_points = 1;
+        for (std::vector<double> &nodes : nodes_)
+        {
+            size_t n_k = 0;
+            in >> n_k;
+            nodes.assign(n_k, 0.0);
+            for (double &node : nodes)
+            {
+                in >> node;
+            }
+            num_grid_points *= n_k;
+        }
+        values_.assign(num_grid_points, 0.0);
+        for (double &value : values_)
+        {
+            in >> value;
+        }
+        if (in)
+        {
+            initSecondDerivatives();
+        }
+    }
+
+private:
+    void initSecondDerivatives()
+    {
+        second_derivatives_.clear();
+        for (const std::vector<double> &nodes : nodes_)
+        {
+            second_derivatives_.push_back(secondDerivativeMatrix(nodes));
+        }
+    }
+
+    /**
+     * @brief Matrix that maps the values at the nodes to the second derivatives of the natural cubic spline.
+     */
+    static arma::mat secondDerivativeMatrix(const std::vector<double> &t)
+    {
+        size_t n = t.size();
+        arma::mat S(n, n, arma::fill::zeros);
+        if (n < 3)
+        {
+            return S;
+        }
+
+        // Tridiagonal system for the interior second derivatives, natural end conditions
+        size_t m = n - 2;
+        arma::mat T(m, m, arma::fill::zeros);
+        arma::mat R(m, n, arma::fill::zeros);
+        for (size_t i = 1; i + 1 < n; i++)
+        {
+            double h0 = t[i] - t[i - 1];
+            double h1 = t[i + 1] - t[i];
+            T(i - 1, i - 1) = 2.0 * (h0 + h1);
+            if (i > 1)
+            {
+                T(i - 1, i - 2) = h0;
+            }
+            if (i + 2 < n)
+            {
+                T(i - 1, i) = h1;
+            }
+            R(i - 1, i - 1) = 6.0 / h0;
+            R(i - 1, i) = -6.0 / h0 - 6.0 / h1;
+            R(i - 1, i + 1) = 6.0 / h1;
+        }
+        arma::mat T_inv;
+        if (!arma::inv(T_inv, T))
+        {
+            throw std::runtime_error("Spline system is singular");
+        }
+        arma::mat interior = T_inv * R;
+        for (size_t i = 0; i < m; i++)
+        {
+            for (size_t j = 0; j < n; j++)
+            {
+                S(i + 1, j) = interior(i, j);
+            }
+        }
+        return S;
+    }
+
+    /**
+     * @brief Weights of the values at the nodes in the natural cubic spline at x, clamped to the nodes.
+     */
+    static std::vector<double> weights(const std::vector<double> &t, const arma::mat &S, double x)
+    {
+        size_t n = t.size();
+        std::vector<double> w(n, 0.0);
+        if (n == 1)
+        {
+            w[0] = 1.0;
+            return w;
+        }
+        x = std::min(std::max(x, t.front()), t.back());
+        size_t j = std::min<size_t>(std::upper_bound(t.begin(), t.end(), x) - t.begin(), n - 1) - 1;
+        double h = t[j + 1] - t[j];
+        double a = (t[j + 1] - x) / h;
+        double b = 1.0 - a;
+        double ca = (a * a * a - a) * h * h / 6.0;
+        double cb = (b * b * b - b) * h * h / 6.0;
+        w[j] += a;
+        w[j + 1] += b;
+        for (size_t p = 0; p < n; p++)
+        {
+            w[p] += ca * S(j, p) + cb * S(j + 1, p);
+        }
+        return w;
+    }
+
+    std::vector<std::vector<double>> nodes_;
+    std::vector<double> values_;
+    std::vector<arma::mat> second_derivatives_;
+};
+
+#endif // TENSOR_SPLINE_SURROGATE_HH
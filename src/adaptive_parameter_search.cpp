@@ -0,0 +1,87 @@
+#include "adaptive_parameter_search.h"
+
+AdaptiveParameterSearch::AdaptiveParameterSearch(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
+                                                 std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler,
+                                                 size_t criterion_index, size_t initial_points_per_dim) : ParameterSearch(inputParamsRanges, outputCriteria, modelHandler),
+                                                                                                          criterion_index_(criterion_index),
+                                                                                                          refinement_(std::max<size_t>(inputParamsRanges.size(), 1), initial_points_per_dim)
+{
+    if (criterion_index >= outputCriteria_.size())
+    {
+        throw std::invalid_argument("criterion_index exceeds the number of output criteria");
+    }
+}
+
+void AdaptiveParameterSearch::run()
+{
+    Logger::info("=== Starting adaptive parameter search ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+    Logger::info("Refinement criterion: " + outputCriteria_[criterion_index_]->getColumnName());
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    // Get all parameter ranges, values are produced on demand
+    std::vector<std::shared_ptr<ParamRange>> param_ranges = getLazyParamRanges(inputParamsRanges_);
+
+    // Check what computations are necessary for the output criteria
+    std::vector<std::type_index> required_calculations = getRequiredCalculations(outputCriteria_);
+
+    // Start time for the time budget
+    auto start_time = std::chrono::steady_clock::now();
+    size_t eval_num = 0;
+
+    auto evaluate = [&](const std::vector<double> &point) -> double
+    {
+        size_t index = eval_num++;
+        try
+        {
+            std::vector<Json::Value> next_config = getParameterConfiguration(point, param_ranges);
+
+            Logger::info("== Starting evaluation " + std::to_string(index) + " ==");
+
+            // Pruned, rejected and timed-out steps have no values and count as failed
+            std::vector<double> output_values = evaluateConfiguration(index, next_config, required_calculations);
+            if (output_values.empty())
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            return output_values[criterion_index_];
+        }
+        catch (const std::exception &e)
+        {
+            Logger::error("Error in evaluation with index " + std::to_string(index) + ": " + e.what());
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+    };
+
+    auto should_stop = [&](size_t num_evaluated) -> bool
+    {
+        return isBudgetExhausted(num_evaluated, start_time);
+    };
+
+    refinement_.run(evaluate, should_stop);
+
+    Logger::info("Number of evaluations: " + std::to_string(eval_num));
+
+    // Close the output file
+    closeOutputFile();
+
+    Logger::info("=== Finished adaptive parameter search ===");
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+void AdaptiveParameterSearch::setThreshold(double threshold)
+{
+    refinement_.setThreshold(threshold);
+}
+
+void AdaptiveParameterSearch::setMinCellSize(double min_cell_size)
+{
+    refinement_.setMinCellSize(min_cell_size);
+}
+
+void AdaptiveParameterSearch::setScoreTolerance(double score_tolerance)
+{
+    refinement_.setScoreTolerance(score_tolerance);
+}
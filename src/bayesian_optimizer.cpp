@@ -0,0 +1,106 @@
+#include "bayesian_optimizer.h"
+
+BayesianOptimizer::BayesianOptimizer(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
+                                     std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler,
+                                     OptimizationObjective objective, size_t max_evaluations, uint64_t seed) : ParameterSearch(inputParamsRanges, outputCriteria, modelHandler),
+                                                                                                               objective_(objective),
+                                                                                                               max_evaluations_(max_evaluations),
+                                                                                                               seed_(seed)
+{
+    objective_.validate(outputCriteria_.size());
+    if (max_evaluations < 1)
+    {
+        throw std::invalid_argument("max_evaluations must be greater than 0");
+    }
+}
+
+void BayesianOptimizer::run()
+{
+    Logger::info("=== Starting Bayesian optimization ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+    Logger::info("Evaluation budget: " + std::to_string(max_evaluations_));
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    // Only feasible configurations can be the best one
+    BatchEvaluator evaluate = makeBatchEvaluator(max_evaluations_, [this](const std::vector<double> &results)
+                                                 { return objective_.isFeasible(results) ? objective_.evaluate(results) : std::numeric_limits<double>::quiet_NaN(); });
+    size_t num_dims = inputParamsRanges_.size();
+
+    BayesianProposer proposer(num_dims, objective_.getNumConstraints(), seed_);
+    size_t batch_size = batch_size_ > 0 ? batch_size_ : num_workers_;
+    std::vector<std::vector<double>> next_points = LatinHypercubeSampler(seed_).generate(num_initial_, num_dims);
+
+    while (evaluate.allows(1))
+    {
+        // Do not exceed the evaluation and step budgets
+        size_t num_evaluated = evaluate.getNumEvaluated();
+        size_t remaining = max_evaluations_ - num_evaluated;
+        if (step_budget_ > 0)
+        {
+            remaining = std::min(remaining, step_budget_ - num_evaluated);
+        }
+        if (next_points.empty())
+        {
+            next_points = proposer.propose(std::min(batch_size, remaining));
+        }
+        if (next_points.size() > remaining)
+        {
+            next_points.resize(remaining);
+        }
+
+        std::vector<std::vector<double>> results = evaluate(next_points);
+
+        // Update the surrogate with the results
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            size_t index = num_evaluated + i;
+            if (results[i].empty())
+            {
+                proposer.addObservation(next_points[i], std::numeric_limits<double>::quiet_NaN(), {});
+                continue;
+            }
+
+            double objective = objective_.evaluate(results[i]);
+            proposer.addObservation(next_points[i], objective, objective_.getConstraintSlacks(results[i]));
+
+            Logger::info("Objective of step with index " + std::to_string(index) + ": " + std::to_string(objective) + (objective_.isFeasible(results[i]) ? "" : " (infeasible)"));
+        }
+        next_points.clear();
+
+        if (best_index_ >= 0)
+        {
+            Logger::info("Best objective so far: " + std::to_string(best_objective_) + " at index " + std::to_string(best_index_));
+        }
+    }
+
+    if (best_index_ < 0)
+    {
+        Logger::info("No feasible configuration found.");
+    }
+
+    // Close the output file
+    closeOutputFile();
+
+    Logger::info("=== Finished Bayesian optimization ===");
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+void BayesianOptimizer::setNumInitial(size_t num_initial)
+{
+    if (num_initial < 2)
+    {
+        throw std::invalid_argument("num_initial must be at least 2");
+    }
+    num_initial_ = num_initial;
+}
+
+void BayesianOptimizer::setBatchSize(size_t batch_size)
+{
+    if (batch_size < 1)
+    {
+        throw std::invalid_argument("batch_size must be at least 1");
+    }
+    batch_size_ = batch_size;
+}
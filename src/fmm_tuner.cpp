@@ -0,0 +1,191 @@
+#include "fmm_tuner.h"
+
+FmmTuner::FmmTuner(std::vector<std::shared_ptr<InputParamRangeInterface>> fmmSettings, std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria,
+                   CCTools::ModelHandler &modelHandler, std::vector<Json::Value> reference_config, double tolerance, bool relative) : ParameterSearch(fmmSettings, outputCriteria, modelHandler),
+                                                                                                                                  reference_config_(reference_config),
+                                                                                                                                  tolerance_(tolerance),
+                                                                                                                                  relative_(relative)
+{
+    if (reference_config_.size() != inputParamsRanges_.size())
+    {
+        throw std::invalid_argument("Reference configuration must have one value per FMM setting");
+    }
+    if (!(tolerance > 0.0))
+    {
+        throw std::invalid_argument("tolerance must be greater than 0");
+    }
+}
+
+void FmmTuner::run()
+{
+    Logger::info("=== Starting FMM tuning ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+    Logger::info("Tolerance: " + std::to_string(tolerance_) + (relative_ ? " (relative)" : ""));
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    // Get all parameter ranges, values are produced on demand
+    std::vector<std::shared_ptr<ParamRange>> param_ranges = getLazyParamRanges(inputParamsRanges_);
+
+    // Check what computations are necessary for the output criteria
+    std::vector<std::type_index> required_calculations = getRequiredCalculations(outputCriteria_);
+
+    resetBest();
+    reference_runtime_ = std::numeric_limits<double>::quiet_NaN();
+
+    std::string tuning_file_path = output_file_path.substr(0, output_file_path.size() - std::string(".csv").size()) + "_tuning.csv";
+    std::ofstream tuning_file(tuning_file_path);
+    tuning_file << "index,runtime,error,meets_target" << std::endl;
+
+    // Start time for the time budget
+    auto start_time = std::chrono::steady_clock::now();
+
+    // Reference
+    std::vector<double> reference;
+    try
+    {
+        Logger::info("== Evaluating the reference ==");
+        double runtime = 0.0;
+        std::vector<Json::Value> config = reference_config_;
+        reference = evaluateTimed(0, config, required_calculations, runtime);
+        reference_runtime_ = runtime;
+        tuning_file << 0 << "," << runtime << ",0,1" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        Logger::error("Error in reference evaluation: " + std::string(e.what()));
+        tuning_file.close();
+        closeOutputFile();
+        throw;
+    }
+
+    GridTraversal traversal(getRangeSizes(param_ranges), traversal_order_);
+    size_t num_steps = traversal.getNumSteps();
+    Logger::info("Number of candidate configurations: " + std::to_string(num_steps));
+
+    for (size_t step_num = 0; step_num < num_steps; step_num++)
+    {
+        // The reference counts as the first step of the budget
+        if (isBudgetExhausted(step_num + 1, start_time))
+        {
+            break;
+        }
+
+        size_t index = step_num + 1;
+        std::vector<Json::Value> config = getParameterConfiguration(traversal.getIndices(step_num), param_ranges);
+        try
+        {
+            Logger::info("== Starting candidate " + std::to_string(step_num) + " / " + std::to_string(num_steps - 1) + " with index " + std::to_string(index) + " ==");
+            double runtime = 0.0;
+            std::vector<double> values = evaluateTimed(index, config, required_calculations, runtime);
+            double error = getError(values, reference);
+            bool meets_target = error <= tolerance_;
+            tuning_file << index << "," << runtime << "," << error << "," << (meets_target ? 1 : 0) << std::endl;
+            Logger::info("Runtime " + std::to_string(runtime) + " s, error " + std::to_string(error) + (meets_target ? ", meets the target" : ""));
+
+            if (meets_target)
+            {
+                trackBest(index, runtime, config);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            Logger::error("Error in step with index " + std::to_string(index) + ": " + e.what());
+        }
+    }
+    tuning_file.close();
+
+    // Close the output file
+    closeOutputFile();
+
+    if (best_index_ >= 0)
+    {
+        std::string config_str;
+        for (size_t i = 0; i < inputParamsRanges_.size(); i++)
+        {
+            config_str += (i > 0 ? ", " : "") + inputParamsRanges_[i]->getColumnName() + ": " + inputParamsRanges_[i]->getConfigAsString(best_config_[i]);
+        }
+        Logger::info("Fastest settings meeting the target at index " + std::to_string(best_index_) + ": " + config_str);
+        Logger::info("Runtime " + std::to_string(best_objective_) + " s, reference " + std::to_string(reference_runtime_) + " s");
+    }
+    else
+    {
+        Logger::info("No candidate configuration meets the target.");
+    }
+    Logger::info("=== Finished FMM tuning ===");
+    Logger::info("Runtimes and errors saved to " + tuning_file_path);
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+std::vector<double> FmmTuner::evaluateTimed(size_t index, std::vector<Json::Value> &config, const std::vector<std::type_index> &required_calculations, double &runtime)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> values = evaluateConfiguration(index, config, required_calculations);
+    runtime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (values.empty())
+    {
+        throw std::runtime_error("Step was rejected");
+    }
+
+    // Repetitions only rerun the calculations, the configuration is still applied
+    for (size_t r = 1; r < num_repeats_; r++)
+    {
+        start = std::chrono::steady_clock::now();
+        runCalculations(required_calculations, modelCalculator_, modelHandler_, max_harmonic_order_);
+        runtime = std::min(runtime, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return values;
+}
+
+double FmmTuner::getError(const std::vector<double> &values, const std::vector<double> &reference) const
+{
+    double error = 0.0;
+    for (size_t c = 0; c < values.size(); c++)
+    {
+        double deviation = std::abs(values[c] - reference[c]);
+        if (relative_)
+        {
+            deviation /= std::max(std::abs(reference[c]), std::numeric_limits<double>::min());
+        }
+        // NaN never meets the target
+        error = std::isnan(deviation) ? std::numeric_limits<double>::infinity() : std::max(error, deviation);
+    }
+    return error;
+}
+
+void FmmTuner::setNumRepeats(size_t num_repeats)
+{
+    if (num_repeats < 1)
+    {
+        throw std::invalid_argument("num_repeats must be at least 1");
+    }
+    num_repeats_ = num_repeats;
+}
+
+bool FmmTuner::hasMetTarget() const
+{
+    return best_index_ >= 0;
+}
+
+double FmmTuner::getBestRuntime() const
+{
+    return best_objective_;
+}
+
+double FmmTuner::getReferenceRuntime() const
+{
+    return reference_runtime_;
+}
+
+void FmmTuner::writeTunedModel(const std::filesystem::path &model_path)
+{
+    if (best_index_ < 0)
+    {
+        throw std::runtime_error("No FMM settings met the target, no tuned model can be written");
+    }
+    applyParameterConfiguration(inputParamsRanges_, best_config_, modelHandler_);
+    applyDerivedInputs(best_config_, modelHandler_);
+    std::filesystem::copy_file(modelHandler_.getTempJsonPath(), model_path, std::filesystem::copy_options::overwrite_existing);
+    Logger::info("Tuned model written to " + model_path.string());
+}
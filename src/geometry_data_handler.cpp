@@ -0,0 +1,100 @@
+#include "geometry_data_handler.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+GeometryDataHandler::GeometryDataHandler(const rat::mdl::ShModelGroupPr &model_tree)
+{
+    // Meshes only, the field is never calculated
+    for (const rat::mdl::ShMeshDataPr &mesh : model_tree->create_meshes({}, rat::mdl::MeshSettings()))
+    {
+        addNodes(mesh->get_nodes());
+    }
+    if (num_nodes_ == 0)
+    {
+        throw std::runtime_error("The model tree contains no meshes.");
+    }
+    addCoilLengths(model_tree);
+}
+
+void GeometryDataHandler::addNodes(const arma::Mat<double> &nodes)
+{
+    for (arma::uword j = 0; j < nodes.n_cols; j++)
+    {
+        for (arma::uword d = 0; d < 3; d++)
+        {
+            min_[d] = std::min(min_[d], nodes(d, j));
+            max_[d] = std::max(max_[d], nodes(d, j));
+        }
+    }
+    num_nodes_ += nodes.n_cols;
+}
+
+void GeometryDataHandler::addConductorLength(double length)
+{
+    conductor_length_ += length;
+}
+
+std::pair<double, double> GeometryDataHandler::getMinMaxZValues() const
+{
+    if (num_nodes_ == 0)
+    {
+        throw std::runtime_error("No geometry available to compute the z values.");
+    }
+    return {min_[2], max_[2]};
+}
+
+CCTools::Cube3D GeometryDataHandler::getBoundingBox() const
+{
+    if (num_nodes_ == 0)
+    {
+        throw std::runtime_error("No geometry available to compute the bounding box.");
+    }
+    return CCTools::Cube3D(min_[0], max_[0], min_[1], max_[1], min_[2], max_[2]);
+}
+
+double GeometryDataHandler::getConductorLength() const
+{
+    return conductor_length_;
+}
+
+void GeometryDataHandler::addCoilLengths(const rat::mdl::ShModelPr &model)
+{
+    if (!model->get_enable())
+    {
+        return;
+    }
+
+    rat::mdl::ShModelCoilPr coil = std::dynamic_pointer_cast<rat::mdl::ModelCoil>(model);
+    if (coil != nullptr)
+    {
+        arma::field<arma::Mat<double>> coords = coil->get_input_path()->create_frame(rat::mdl::MeshSettings())->get_coords();
+        for (arma::uword s = 0; s < coords.n_elem; s++)
+        {
+            addConductorLength(getPolylineLength(coords(s)));
+        }
+        return;
+    }
+
+    rat::mdl::ShModelGroupPr group = std::dynamic_pointer_cast<rat::mdl::ModelGroup>(model);
+    if (group != nullptr)
+    {
+        for (const rat::mdl::ShModelPr &child : group->get_models())
+        {
+            addCoilLengths(child);
+        }
+    }
+}
+
+double GeometryDataHandler::getPolylineLength(const arma::Mat<double> &coords)
+{
+    double length = 0.0;
+    for (arma::uword j = 1; j < coords.n_cols; j++)
+    {
+        double dx = coords(0, j) - coords(0, j - 1);
+        double dy = coords(1, j) - coords(1, j - 1);
+        double dz = coords(2, j) - coords(2, j - 1);
+        length += std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+    return length;
+}
@@ -0,0 +1,84 @@
+#include "gradient_optimizer.h"
+
+GradientOptimizer::GradientOptimizer(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
+                                     std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler,
+                                     OptimizationObjective objective, size_t max_evaluations) : ParameterSearch(inputParamsRanges, outputCriteria, modelHandler),
+                                                                                                objective_(objective),
+                                                                                                max_evaluations_(max_evaluations),
+                                                                                                lbfgsb_(inputParamsRanges.size())
+{
+    objective_.validate(outputCriteria_.size());
+    checkContinuousInputs();
+    if (max_evaluations < 1)
+    {
+        throw std::invalid_argument("max_evaluations must be greater than 0");
+    }
+}
+
+void GradientOptimizer::run()
+{
+    Logger::info("=== Starting gradient optimization ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+    Logger::info("Evaluation budget: " + std::to_string(max_evaluations_));
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    auto objective = [this](const std::vector<double> &results)
+    {
+        return objective_.getPenalizedValue(results);
+    };
+    BatchEvaluator batch_evaluator = makeBatchEvaluator(max_evaluations_, objective);
+
+    auto evaluate = [&](const std::vector<std::vector<double>> &points) -> std::vector<double>
+    {
+        std::vector<std::vector<double>> results = batch_evaluator(points);
+
+        std::vector<double> values(results.size(), std::numeric_limits<double>::quiet_NaN());
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            if (!results[i].empty())
+            {
+                values[i] = objective(results[i]);
+            }
+        }
+
+        Logger::info("Best objective so far: " + std::to_string(best_objective_) + " at index " + std::to_string(best_index_));
+        return values;
+    };
+
+    // The optimizer needs the values of all points of a batch
+    auto should_stop = [&](size_t, size_t batch_size) -> bool
+    {
+        return !batch_evaluator.allows(batch_size);
+    };
+
+    lbfgsb_.setLineSearchBatchSize(num_workers_);
+    lbfgsb_.minimize(getStartPoint(), evaluate, should_stop);
+
+    if (lbfgsb_.getNumEvaluations() > 0 && best_index_ < 0)
+    {
+        Logger::error("Objective could not be evaluated at the start configuration.");
+    }
+    else if (lbfgsb_.hasConverged())
+    {
+        Logger::info("Optimizer converged after " + std::to_string(lbfgsb_.getNumIterations()) + " iterations and " + std::to_string(batch_evaluator.getNumEvaluated()) + " evaluations.");
+    }
+    Logger::info("Noise level of the objective: " + std::to_string(lbfgsb_.getNoiseLevel()));
+
+    // Close the output file
+    closeOutputFile();
+
+    Logger::info("=== Finished gradient optimization ===");
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+void GradientOptimizer::setFiniteDifferenceStep(size_t input_index, double step)
+{
+    lbfgsb_.setFiniteDifferenceStep(input_index, step);
+}
+
+void GradientOptimizer::setNoiseLevel(double noise_level)
+{
+    lbfgsb_.setNoiseLevel(noise_level);
+}
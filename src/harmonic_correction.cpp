@@ -0,0 +1,301 @@
+#include "harmonic_correction.h"
+
+HarmonicCorrection::HarmonicCorrection(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
+                                       std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler,
+                                       std::vector<size_t> correction_inputs, std::vector<size_t> corrected_criteria, double tolerance, size_t max_evaluations) : ParameterSearch(inputParamsRanges, outputCriteria, modelHandler),
+                                                                                                                                                               correction_inputs_(correction_inputs),
+                                                                                                                                                               corrected_criteria_(corrected_criteria),
+                                                                                                                                                               targets_(corrected_criteria.size(), 0.0),
+                                                                                                                                                               tolerance_(tolerance),
+                                                                                                                                                               max_evaluations_(max_evaluations),
+                                                                                                                                                               response_(correction_inputs.size(), corrected_criteria.size())
+{
+    std::vector<bool> is_used(inputParamsRanges_.size(), false);
+    for (size_t input_index : correction_inputs_)
+    {
+        if (input_index >= inputParamsRanges_.size() || is_used[input_index])
+        {
+            throw std::invalid_argument("Correction input " + std::to_string(input_index) + " does not exist or is given twice");
+        }
+        is_used[input_index] = true;
+    }
+    checkContinuousInputs(correction_inputs_);
+    std::vector<bool> is_corrected(outputCriteria_.size(), false);
+    for (size_t criterion_index : corrected_criteria_)
+    {
+        if (criterion_index >= outputCriteria_.size() || is_corrected[criterion_index])
+        {
+            throw std::invalid_argument("Corrected criterion " + std::to_string(criterion_index) + " does not exist or is given twice");
+        }
+        is_corrected[criterion_index] = true;
+    }
+
+    // Every evaluation is a harmonics-only calculation
+    for (std::type_index calculation : getRequiredCalculations(outputCriteria_))
+    {
+        if (calculation != std::type_index(typeid(CCTools::HarmonicsDataHandler)))
+        {
+            throw std::invalid_argument("All output criteria of the harmonic correction must only require the harmonics calculation");
+        }
+    }
+
+    if (!(tolerance > 0.0))
+    {
+        throw std::invalid_argument("tolerance must be greater than 0");
+    }
+    if (max_evaluations < 1)
+    {
+        throw std::invalid_argument("max_evaluations must be greater than 0");
+    }
+}
+
+void HarmonicCorrection::run()
+{
+    Logger::info("=== Starting harmonic correction ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+    Logger::info("Correction inputs: " + std::to_string(correction_inputs_.size()) + ", corrected criteria: " + std::to_string(corrected_criteria_.size()));
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    // Largest deviation of a corrected criterion from its target
+    auto get_distance = [this](const std::vector<double> &y) -> double
+    {
+        if (y.empty())
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        double distance = 0.0;
+        for (size_t i = 0; i < y.size(); i++)
+        {
+            distance = std::max(distance, std::abs(y[i] - targets_[i]));
+        }
+        return std::isnan(distance) ? std::numeric_limits<double>::infinity() : distance;
+    };
+
+    // Corrected criteria of the values of all output criteria
+    auto get_corrected = [this](const std::vector<double> &results)
+    {
+        std::vector<double> y;
+        for (size_t criterion_index : corrected_criteria_)
+        {
+            y.push_back(results[criterion_index]);
+        }
+        return y;
+    };
+
+    converged_ = false;
+    BatchEvaluator batch_evaluator = makeBatchEvaluator(max_evaluations_, [&](const std::vector<double> &results)
+                                                        { return get_distance(get_corrected(results)); });
+    const std::vector<std::shared_ptr<ParamRange>> &param_ranges = batch_evaluator.getParamRanges();
+
+    // Start configuration, the correction inputs vary continuously between the bounds of their ranges
+    std::vector<Json::Value> base_config = start_config_;
+    if (base_config.empty())
+    {
+        for (size_t i = 0; i < param_ranges.size(); i++)
+        {
+            base_config.push_back(param_ranges[i]->sample(0.5));
+        }
+    }
+    size_t n = correction_inputs_.size();
+    std::vector<double> x(n), lower(n), upper(n), steps(n);
+    for (size_t j = 0; j < n; j++)
+    {
+        std::shared_ptr<ParamRange> range = param_ranges[correction_inputs_[j]];
+        double first = range->sample(0.0).asDouble();
+        double last = range->sample(1.0).asDouble();
+        lower[j] = std::min(first, last);
+        upper[j] = std::max(first, last);
+        x[j] = base_config[correction_inputs_[j]].asDouble();
+        steps[j] = relative_step_ * (upper[j] - lower[j]);
+        if (!(steps[j] > 0.0))
+        {
+            throw std::invalid_argument("Range of correction input " + inputParamsRanges_[correction_inputs_[j]]->getColumnName() + " has zero width");
+        }
+        if (x[j] + steps[j] > upper[j])
+        {
+            steps[j] = -steps[j];
+        }
+    }
+
+    // Evaluates the corrected criteria for values of the correction inputs, empty for failed steps
+    auto evaluate = [&](const std::vector<std::vector<double>> &points) -> std::vector<std::vector<double>>
+    {
+        std::vector<std::vector<Json::Value>> configs;
+        for (const std::vector<double> &point : points)
+        {
+            std::vector<Json::Value> config = base_config;
+            for (size_t j = 0; j < n; j++)
+            {
+                config[correction_inputs_[j]] = Json::Value(point[j]);
+            }
+            configs.push_back(config);
+        }
+
+        std::vector<std::vector<double>> results = batch_evaluator.evaluate(configs);
+
+        std::vector<std::vector<double>> outputs(results.size());
+        for (size_t k = 0; k < results.size(); k++)
+        {
+            if (!results[k].empty())
+            {
+                outputs[k] = get_corrected(results[k]);
+            }
+        }
+        return outputs;
+    };
+
+    // Measures the Jacobian around x, the reference outputs y are evaluated in the same batch if not known
+    auto linearize = [&](std::vector<double> &y) -> bool
+    {
+        bool with_reference = y.empty();
+        std::vector<std::vector<double>> points;
+        if (with_reference)
+        {
+            points.push_back(x);
+        }
+        for (size_t j = 0; j < n; j++)
+        {
+            std::vector<double> point = x;
+            point[j] += steps[j];
+            points.push_back(point);
+        }
+        if (!batch_evaluator.allows(points.size()))
+        {
+            return false;
+        }
+
+        Logger::info("Measuring the Jacobian with " + std::to_string(points.size()) + " harmonics calculations.");
+        std::vector<std::vector<double>> outputs = evaluate(points);
+        if (with_reference)
+        {
+            y = outputs[0];
+            outputs.erase(outputs.begin());
+        }
+        for (const std::vector<double> &output : outputs)
+        {
+            if (output.empty() || y.empty())
+            {
+                Logger::error("Jacobian could not be measured because a harmonics calculation failed.");
+                return false;
+            }
+        }
+        response_.setFromDifferences(x, y, steps, outputs);
+        return true;
+    };
+
+    std::vector<double> y;
+    bool fresh_jacobian = false;
+    if (response_.hasJacobian())
+    {
+        Logger::info("Using the Jacobian of the previous run.");
+        if (batch_evaluator.allows(1))
+        {
+            y = evaluate({x})[0];
+        }
+    }
+    else
+    {
+        fresh_jacobian = linearize(y);
+        if (!fresh_jacobian)
+        {
+            y.clear();
+        }
+    }
+
+    while (!y.empty())
+    {
+        if (get_distance(y) <= tolerance_)
+        {
+            converged_ = true;
+            break;
+        }
+
+        // Solve the linear model and verify the solution
+        std::vector<double> x_next = response_.solve(x, y, targets_, lower, upper);
+        if (!batch_evaluator.allows(1))
+        {
+            break;
+        }
+        std::vector<double> y_next = evaluate({x_next})[0];
+        if (get_distance(y_next) <= tolerance_)
+        {
+            converged_ = true;
+            break;
+        }
+
+        bool improved = get_distance(y_next) < get_distance(y);
+        if (fresh_jacobian && !improved)
+        {
+            Logger::info("The linear correction does not reduce the residual further. The targets cannot be reached with the correction inputs.");
+            break;
+        }
+        if (improved)
+        {
+            x = x_next;
+            y = y_next;
+        }
+
+        // Re-linearize around the best configuration
+        Logger::info("Residual " + std::to_string(get_distance(y)) + " exceeds the tolerance, re-linearizing.");
+        if (!linearize(y))
+        {
+            break;
+        }
+        fresh_jacobian = true;
+    }
+
+    if (converged_)
+    {
+        Logger::info("Harmonics corrected after " + std::to_string(batch_evaluator.getNumEvaluated()) + " evaluations. Solution at index " + std::to_string(best_index_) + ".");
+    }
+    else
+    {
+        Logger::info("Harmonics not corrected within the tolerance after " + std::to_string(batch_evaluator.getNumEvaluated()) + " evaluations. Closest configuration at index " + std::to_string(best_index_) + ".");
+    }
+
+    // Close the output file
+    closeOutputFile();
+
+    Logger::info("=== Finished harmonic correction ===");
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+void HarmonicCorrection::setTargets(const std::vector<double> &targets)
+{
+    if (targets.size() != corrected_criteria_.size())
+    {
+        throw std::invalid_argument("Number of targets does not match the number of corrected criteria");
+    }
+    targets_ = targets;
+}
+
+void HarmonicCorrection::setRelativeStep(double relative_step)
+{
+    if (!(relative_step > 0.0 && relative_step <= 0.5))
+    {
+        throw std::invalid_argument("relative_step must be greater than 0 and at most 0.5");
+    }
+    relative_step_ = relative_step;
+}
+
+void HarmonicCorrection::resetJacobian()
+{
+    response_.reset();
+}
+
+bool HarmonicCorrection::hasConverged() const
+{
+    return converged_;
+}
+
+long HarmonicCorrection::getSolutionIndex() const
+{
+    return best_index_;
+}
+
+std::vector<Json::Value> HarmonicCorrection::getSolution() const
+{
+    return best_config_;
+}
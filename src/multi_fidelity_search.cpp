@@ -0,0 +1,253 @@
+#include "multi_fidelity_search.h"
+
+MultiFidelitySearch::MultiFidelitySearch(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
+                                         std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler,
+                                         OptimizationObjective objective, double top_fraction) : ParameterSearch(inputParamsRanges, outputCriteria, modelHandler),
+                                                                                                 objective_(objective),
+                                                                                                 top_fraction_(top_fraction),
+                                                                                                 num_model_inputs_(inputParamsRanges.size())
+{
+    objective_.validate(outputCriteria_.size());
+    if (!(top_fraction > 0.0 && top_fraction <= 1.0))
+    {
+        throw std::invalid_argument("top_fraction must be greater than 0 and at most 1");
+    }
+}
+
+void MultiFidelitySearch::setLowFidelitySetting(const std::string &calc_name, const std::string &setting, const Json::Value &value)
+{
+    // Column names must be unique if the same setting is overridden for several calculations
+    std::string suffix = "_" + calc_name;
+    std::replace(suffix.begin(), suffix.end(), ' ', '_');
+    std::shared_ptr<InputFmmSetting> fmm_setting = std::make_shared<InputFmmSetting>(calc_name, setting, std::vector<Json::Value>{value}, suffix);
+
+    // The value in the model is the full-fidelity value, throws if the setting does not exist
+    Json::Value full_fidelity_value;
+    try
+    {
+        full_fidelity_value = modelHandler_.getValueByName(fmm_setting->getJSONName(), fmm_setting->getJSONChildren(), fmm_setting->getJSONTarget());
+    }
+    catch (const std::runtime_error &e)
+    {
+        Logger::error("Invalid FMM setting " + fmm_setting->getColumnName() + ": " + std::string(e.what()));
+        throw;
+    }
+
+    inputParamsRanges_.push_back(fmm_setting);
+    low_fidelity_values_.push_back(value);
+    full_fidelity_values_.push_back(full_fidelity_value);
+}
+
+void MultiFidelitySearch::setBoundaryMargin(double margin)
+{
+    if (!(margin >= 0.0))
+    {
+        throw std::invalid_argument("margin must not be negative");
+    }
+    boundary_margin_ = margin;
+}
+
+void MultiFidelitySearch::run()
+{
+    if (low_fidelity_values_.empty())
+    {
+        throw std::runtime_error("No low-fidelity FMM setting set, see setLowFidelitySetting()");
+    }
+
+    Logger::info("=== Starting multi-fidelity search ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    // Parameter ranges of the model inputs only, the FMM settings are set per fidelity
+    std::vector<std::shared_ptr<InputParamRangeInterface>> model_inputs(inputParamsRanges_.begin(), inputParamsRanges_.begin() + num_model_inputs_);
+    std::vector<std::shared_ptr<ParamRange>> param_ranges = getLazyParamRanges(model_inputs);
+
+    // Configurations of the sweep
+    std::vector<std::vector<Json::Value>> sweep_configs;
+    if (sampler_ != nullptr)
+    {
+        for (const std::vector<double> &point : sampler_->generate(num_samples_, param_ranges.size()))
+        {
+            sweep_configs.push_back(getParameterConfiguration(point, param_ranges));
+        }
+    }
+    else
+    {
+        GridTraversal traversal(getRangeSizes(param_ranges), traversal_order_);
+        for (size_t step_num = 0; step_num < traversal.getNumSteps(); step_num++)
+        {
+            sweep_configs.push_back(getParameterConfiguration(traversal.getIndices(step_num), param_ranges));
+        }
+    }
+    Logger::info("Number of low-fidelity steps: " + std::to_string(sweep_configs.size()));
+
+    pairs_.clear();
+    BatchEvaluator batch_evaluator = makeBatchEvaluator(0);
+
+    // Evaluate configurations with the FMM settings of one fidelity in batches, stops when the budget is spent
+    auto evaluate = [&](const std::vector<std::vector<Json::Value>> &configs, const std::vector<Json::Value> &fmm_values, std::vector<size_t> &indices)
+    {
+        std::vector<std::vector<double>> results;
+        size_t batch_size = std::max<size_t>(num_workers_, 1);
+        for (size_t first = 0; first < configs.size() && batch_evaluator.allows(1); first += batch_size)
+        {
+            size_t count = std::min(batch_size, configs.size() - first);
+            if (step_budget_ > 0)
+            {
+                count = std::min(count, step_budget_ - batch_evaluator.getNumEvaluated());
+            }
+
+            std::vector<std::vector<Json::Value>> batch;
+            for (size_t i = first; i < first + count; i++)
+            {
+                batch.push_back(configs[i]);
+                batch.back().insert(batch.back().end(), fmm_values.begin(), fmm_values.end());
+            }
+            size_t first_index = batch_evaluator.getNumEvaluated();
+            std::vector<std::vector<double>> batch_results = batch_evaluator.evaluate(batch);
+            for (size_t i = 0; i < batch_results.size(); i++)
+            {
+                indices.push_back(first_index + i);
+            }
+            results.insert(results.end(), batch_results.begin(), batch_results.end());
+        }
+        return results;
+    };
+
+    // Low-fidelity sweep
+    std::vector<size_t> low_indices;
+    std::vector<std::vector<double>> low_results = evaluate(sweep_configs, low_fidelity_values_, low_indices);
+
+    // Rank the successful configurations
+    std::vector<size_t> ranked;
+    std::vector<double> ranking_values(low_results.size(), std::numeric_limits<double>::infinity());
+    for (size_t i = 0; i < low_results.size(); i++)
+    {
+        if (!low_results[i].empty())
+        {
+            double value = objective_.getPenalizedValue(low_results[i]);
+            ranking_values[i] = std::isnan(value) ? std::numeric_limits<double>::infinity() : value;
+            ranked.push_back(i);
+        }
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [&](size_t a, size_t b)
+                     { return ranking_values[a] < ranking_values[b]; });
+
+    // Top fraction plus the configurations close to a constraint bound
+    size_t num_top = static_cast<size_t>(std::ceil(top_fraction_ * ranked.size()));
+    std::vector<size_t> selected;
+    for (size_t r = 0; r < ranked.size(); r++)
+    {
+        bool near_boundary = false;
+        for (double slack : objective_.getConstraintSlacks(low_results[ranked[r]]))
+        {
+            near_boundary = near_boundary || std::abs(slack) <= boundary_margin_;
+        }
+        if (r < num_top || (boundary_margin_ > 0.0 && near_boundary))
+        {
+            selected.push_back(ranked[r]);
+        }
+    }
+    Logger::info("Re-running " + std::to_string(selected.size()) + " of " + std::to_string(ranked.size()) + " successful configurations at full fidelity.");
+
+    // Full-fidelity re-runs
+    std::vector<std::vector<Json::Value>> rerun_configs;
+    for (size_t i : selected)
+    {
+        rerun_configs.push_back(sweep_configs[i]);
+    }
+    std::vector<size_t> high_indices;
+    std::vector<std::vector<double>> high_results = evaluate(rerun_configs, full_fidelity_values_, high_indices);
+
+    for (size_t k = 0; k < high_results.size(); k++)
+    {
+        size_t i = selected[k];
+        pairs_.push_back({low_indices[i], high_indices[k], sweep_configs[i], low_results[i], high_results[k]});
+        if (!high_results[k].empty())
+        {
+            trackBest(high_indices[k], objective_.getPenalizedValue(high_results[k]), sweep_configs[i]);
+        }
+    }
+
+    // Leave the model at full fidelity
+    for (size_t k = 0; k < full_fidelity_values_.size(); k++)
+    {
+        inputParamsRanges_[num_model_inputs_ + k]->applyParamConfig(modelHandler_, full_fidelity_values_[k]);
+    }
+
+    // Close the output file
+    closeOutputFile();
+
+    std::string fidelity_file_path = writeFidelityFile(output_file_path);
+
+    if (best_index_ >= 0)
+    {
+        Logger::info("Best full-fidelity configuration at index " + std::to_string(best_index_) + " with objective " + std::to_string(best_objective_) + ".");
+    }
+    Logger::info("=== Finished multi-fidelity search ===");
+    Logger::info("Fidelity pairs saved to " + fidelity_file_path);
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+std::string MultiFidelitySearch::writeFidelityFile(const std::string &output_file_path)
+{
+    std::string fidelity_file_path = output_file_path.substr(0, output_file_path.size() - std::string(".csv").size()) + "_fidelity.csv";
+    std::ofstream fidelity_file(fidelity_file_path);
+
+    fidelity_file << "index_low,index_high,";
+    for (size_t i = 0; i < num_model_inputs_; i++)
+    {
+        fidelity_file << inputParamsRanges_[i]->getColumnName() << ",";
+    }
+    for (size_t c = 0; c < outputCriteria_.size(); c++)
+    {
+        fidelity_file << outputCriteria_[c]->getColumnName() << "_low," << outputCriteria_[c]->getColumnName() << "_high";
+        if (c < outputCriteria_.size() - 1)
+        {
+            fidelity_file << ",";
+        }
+    }
+    fidelity_file << std::endl;
+
+    // Differences of the pairs where both fidelities succeeded
+    std::vector<double> sum_squares(outputCriteria_.size(), 0.0);
+    std::vector<double> max_abs(outputCriteria_.size(), 0.0);
+    size_t num_complete = 0;
+
+    for (const FidelityPair &pair : pairs_)
+    {
+        fidelity_file << pair.low_index << "," << pair.high_index << ",";
+        for (size_t i = 0; i < num_model_inputs_; i++)
+        {
+            inputParamsRanges_[i]->writeValue(fidelity_file, pair.config[i]);
+        }
+        bool complete = !pair.high_values.empty();
+        for (size_t c = 0; c < outputCriteria_.size(); c++)
+        {
+            double high = complete ? pair.high_values[c] : std::numeric_limits<double>::quiet_NaN();
+            fidelity_file << pair.low_values[c] << "," << high;
+            if (c < outputCriteria_.size() - 1)
+            {
+                fidelity_file << ",";
+            }
+            if (complete)
+            {
+                sum_squares[c] += (pair.low_values[c] - high) * (pair.low_values[c] - high);
+                max_abs[c] = std::max(max_abs[c], std::abs(pair.low_values[c] - high));
+            }
+        }
+        fidelity_file << std::endl;
+        num_complete += complete ? 1 : 0;
+    }
+    fidelity_file.close();
+
+    for (size_t c = 0; c < outputCriteria_.size() && num_complete > 0; c++)
+    {
+        Logger::info("Low-fidelity error of " + outputCriteria_[c]->getColumnName() + ": RMS " + std::to_string(std::sqrt(sum_squares[c] / num_complete)) +
+                     ", max " + std::to_string(max_abs[c]));
+    }
+
+    return fidelity_file_path;
+}
@@ -0,0 +1,154 @@
+#include "multi_objective_search.h"
+
+MultiObjectiveSearch::MultiObjectiveSearch(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
+                                           std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler,
+                                           std::vector<OptimizationObjective> objectives, size_t population_size, size_t num_generations, uint64_t seed) : ParameterSearch(inputParamsRanges, outputCriteria, modelHandler),
+                                                                                                                                                          objectives_(objectives),
+                                                                                                                                                          population_size_(population_size),
+                                                                                                                                                          num_generations_(num_generations),
+                                                                                                                                                          seed_(seed)
+{
+    if (objectives_.size() < 2)
+    {
+        throw std::invalid_argument("At least 2 objectives are required");
+    }
+    for (const OptimizationObjective &objective : objectives_)
+    {
+        objective.validate(outputCriteria_.size());
+    }
+    if (population_size < 4)
+    {
+        throw std::invalid_argument("population_size must be at least 4");
+    }
+    if (num_generations < 1)
+    {
+        throw std::invalid_argument("num_generations must be greater than 0");
+    }
+}
+
+void MultiObjectiveSearch::run()
+{
+    Logger::info("=== Starting multi-objective search ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+    Logger::info("Objectives: " + std::to_string(objectives_.size()) + ", population size: " + std::to_string(population_size_) + ", generations: " + std::to_string(num_generations_));
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    BatchEvaluator evaluate = makeBatchEvaluator(0);
+
+    NSGA2 nsga2(inputParamsRanges_.size(), population_size_, seed_);
+    archive_indices_.clear();
+    archive_configs_.clear();
+    archive_results_.clear();
+    pareto_front_.clear();
+
+    for (size_t generation = 0; generation < num_generations_; generation++)
+    {
+        // A generation is only evaluated as a whole
+        if (!evaluate.allows(population_size_))
+        {
+            break;
+        }
+
+        Logger::info("Generation " + std::to_string(generation + 1) + "/" + std::to_string(num_generations_));
+        std::vector<std::vector<double>> points = nsga2.ask();
+        size_t first_index = evaluate.getNumEvaluated();
+        std::vector<std::vector<double>> results = evaluate(points);
+
+        // Objectives and summed constraint violations, failed steps are infinitely infeasible
+        std::vector<std::vector<double>> objective_values(results.size());
+        std::vector<double> violations(results.size(), std::numeric_limits<double>::infinity());
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            objective_values[i].assign(objectives_.size(), std::numeric_limits<double>::infinity());
+            if (results[i].empty())
+            {
+                continue;
+            }
+
+            violations[i] = 0.0;
+            for (size_t m = 0; m < objectives_.size(); m++)
+            {
+                objective_values[i][m] = objectives_[m].evaluate(results[i]);
+                for (double slack : objectives_[m].getConstraintSlacks(results[i]))
+                {
+                    violations[i] += std::isnan(slack) ? std::numeric_limits<double>::infinity() : std::max(-slack, 0.0);
+                }
+            }
+
+            archive_indices_.push_back(first_index + i);
+            archive_configs_.push_back(getParameterConfiguration(points[i], evaluate.getParamRanges()));
+            archive_results_.push_back(results[i]);
+        }
+        nsga2.tell(objective_values, violations);
+    }
+
+    // Close the output file
+    closeOutputFile();
+
+    std::string pareto_file_path = writeParetoFile(output_file_path);
+
+    Logger::info("=== Finished multi-objective search ===");
+    Logger::info("Pareto front of " + std::to_string(pareto_front_.size()) + " configurations saved to " + pareto_file_path);
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+std::vector<size_t> MultiObjectiveSearch::getParetoFront() const
+{
+    return pareto_front_;
+}
+
+std::string MultiObjectiveSearch::writeParetoFile(const std::string &output_file_path)
+{
+    // Objectives of the feasible evaluations
+    std::vector<size_t> feasible;
+    std::vector<std::vector<double>> objective_values;
+    for (size_t k = 0; k < archive_results_.size(); k++)
+    {
+        bool is_feasible = true;
+        std::vector<double> values;
+        for (const OptimizationObjective &objective : objectives_)
+        {
+            is_feasible = is_feasible && objective.isFeasible(archive_results_[k]);
+            values.push_back(objective.evaluate(archive_results_[k]));
+        }
+        if (is_feasible)
+        {
+            feasible.push_back(k);
+            objective_values.push_back(values);
+        }
+    }
+
+    std::vector<size_t> front;
+    if (!feasible.empty())
+    {
+        front = NSGA2::nonDominatedSort(objective_values, std::vector<double>(feasible.size(), 0.0)).front();
+        std::sort(front.begin(), front.end());
+    }
+
+    // Same format as the output file
+    std::string pareto_file_path = output_file_path.substr(0, output_file_path.size() - std::string(".csv").size()) + "_pareto.csv";
+    std::ofstream pareto_file(pareto_file_path);
+    pareto_file << "index,";
+    writeInputColumnNames(pareto_file);
+    for (size_t i = 0; i < outputCriteria_.size(); i++)
+    {
+        pareto_file << outputCriteria_[i]->getColumnName();
+        if (i < outputCriteria_.size() - 1)
+        {
+            pareto_file << ",";
+        }
+    }
+    pareto_file << std::endl;
+
+    for (size_t f : front)
+    {
+        size_t k = feasible[f];
+        pareto_front_.push_back(archive_indices_[k]);
+        writeStepToOutputFile(archive_indices_[k], pareto_file, archive_configs_[k], archive_results_[k]);
+    }
+    pareto_file.close();
+
+    return pareto_file_path;
+}
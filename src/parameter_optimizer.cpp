@@ -0,0 +1,93 @@
+#include "parameter_optimizer.h"
+
+ParameterOptimizer::ParameterOptimizer(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
+                                       std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler,
+                                       OptimizationObjective objective, OptimizerMethod method, size_t max_evaluations) : ParameterSearch(inputParamsRanges, outputCriteria, modelHandler),
+                                                                                                                          objective_(objective),
+                                                                                                                          method_(method),
+                                                                                                                          max_evaluations_(max_evaluations)
+{
+    objective_.validate(outputCriteria_.size());
+    checkContinuousInputs();
+    if (max_evaluations < 1)
+    {
+        throw std::invalid_argument("max_evaluations must be greater than 0");
+    }
+}
+
+void ParameterOptimizer::run()
+{
+    Logger::info("=== Starting parameter optimization ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+    Logger::info("Method: " + to_string(method_));
+    Logger::info("Evaluation budget: " + std::to_string(max_evaluations_));
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    std::vector<double> start = getStartPoint();
+    std::unique_ptr<LocalOptimizer> optimizer;
+    if (method_ == NELDER_MEAD)
+    {
+        optimizer = std::make_unique<NelderMead>(start, step_size_);
+    }
+    else
+    {
+        optimizer = std::make_unique<CMAES>(start, step_size_, seed_);
+    }
+
+    auto objective = [this](const std::vector<double> &results)
+    {
+        return objective_.getPenalizedValue(results);
+    };
+    BatchEvaluator evaluate = makeBatchEvaluator(max_evaluations_, objective);
+
+    while (!optimizer->hasConverged())
+    {
+        // The optimizer needs the values of all points it asked for
+        std::vector<std::vector<double>> points = optimizer->ask();
+        if (!evaluate.allows(points.size()))
+        {
+            break;
+        }
+
+        std::vector<std::vector<double>> results = evaluate(points);
+
+        std::vector<double> values(results.size(), std::numeric_limits<double>::infinity());
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            if (!results[i].empty())
+            {
+                values[i] = objective(results[i]);
+            }
+        }
+        optimizer->tell(values);
+
+        Logger::info("Best objective so far: " + std::to_string(best_objective_) + " at index " + std::to_string(best_index_));
+    }
+
+    if (optimizer->hasConverged())
+    {
+        Logger::info("Optimizer converged after " + std::to_string(evaluate.getNumEvaluated()) + " evaluations.");
+    }
+
+    // Close the output file
+    closeOutputFile();
+
+    Logger::info("=== Finished parameter optimization ===");
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+void ParameterOptimizer::setInitialStepSize(double step_size)
+{
+    if (!(step_size > 0.0))
+    {
+        throw std::invalid_argument("step_size must be greater than 0");
+    }
+    step_size_ = step_size;
+}
+
+void ParameterOptimizer::setSeed(uint64_t seed)
+{
+    seed_ = seed;
+}
@@ -1,4 +1,11 @@
 #include "parameter_search.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <numeric>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 ParameterSearch::ParameterSearch(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
                                  std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler) : inputParamsRanges_(inputParamsRanges),
@@ -8,63 +15,1050 @@ ParameterSearch::ParameterSearch(std::vector<std::shared_ptr<InputParamRangeInte
     modelHandler_ = modelHandler;
     modelCalculator_ = CCTools::ModelCalculator(modelHandler.getTempJsonPath());
 
+    // Only compute the multipole orders that are read by the output criteria
+    max_harmonic_order_ = getMaxHarmonicOrder(outputCriteria_);
+    if (max_harmonic_order_ > 0)
+    {
+        Logger::info("Harmonics calculations compute multipoles up to order " + std::to_string(max_harmonic_order_) + ", the highest order read by the output criteria.");
+    }
+
     // Check if the input params are valid
     checkInputParams(inputParamsRanges_);
 }
 
-void ParameterSearch::run()
+void ParameterSearch::run()
+{
+    Logger::info("=== Starting parameter search ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    // Get all parameter ranges, values are produced on demand
+    std::vector<std::shared_ptr<ParamRange>> param_ranges = getLazyParamRanges(inputParamsRanges_);
+
+    // Check what computations are necessary for the output criteria
+    std::vector<std::type_index> required_calculations = getRequiredCalculations(outputCriteria_);
+
+    if (sampler_ != nullptr)
+    {
+        runSamples(param_ranges, required_calculations);
+    }
+    else
+    {
+        runGrid(param_ranges, required_calculations);
+    }
+
+    // Close the output file
+    closeOutputFile();
+
+    Logger::info("=== Finished parameter search ===");
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+void ParameterSearch::runGrid(const std::vector<std::shared_ptr<ParamRange>> &param_ranges, const std::vector<std::type_index> &required_calculations)
+{
+    // Map steps to grid points in the selected traversal order. Throws if the number of grid points overflows.
+    GridTraversal traversal(getRangeSizes(param_ranges), traversal_order_);
+
+    // Compute the number of steps
+    size_t num_steps = traversal.getNumSteps();
+
+    Logger::info("Number of steps: " + std::to_string(num_steps));
+    Logger::info("Traversal order: " + to_string(traversal_order_));
+    if (num_shards_ > 1)
+    {
+        Logger::info("Running shard " + std::to_string(shard_index_) + " / " + std::to_string(num_shards_ - 1));
+    }
+
+    // Start time for the time budget
+    auto start_time = std::chrono::steady_clock::now();
+    size_t num_attempted = 0;
+    std::vector<DeferredStep> deferred_steps;
+
+    // Loop over all steps of this shard
+    for (size_t step_num = shard_index_; step_num < num_steps; step_num = getNextShardStep(step_num, num_steps, num_shards_), num_attempted++)
+    {
+        // Stop cleanly if the budget is spent, deferred steps are not attempted yet
+        if (isBudgetExhausted(num_attempted - deferred_steps.size(), start_time))
+        {
+            break;
+        }
+
+        // Canonical grid index of the step, written to the output file
+        size_t grid_index = step_num;
+
+        try
+        {
+            // Get the next input param configuration
+            std::vector<size_t> indices = traversal.getIndices(step_num);
+            grid_index = traversal.getGridIndex(indices);
+            std::vector<Json::Value> next_config = getParameterConfiguration(indices, param_ranges);
+
+            Logger::info("== Starting step " + std::to_string(step_num) + " / " + std::to_string(num_steps - 1) + " with index " + std::to_string(grid_index) + " ==");
+
+            // Center of the grid cell of each parameter
+            std::vector<double> unit_point(indices.size());
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                unit_point[i] = (indices[i] + 0.5) / param_ranges[i]->size();
+            }
+            if (!evaluateSweepStep(grid_index, next_config, unit_point, required_calculations))
+            {
+                deferred_steps.push_back({grid_index, next_config, unit_point});
+            }
+        }
+        catch (const std::exception &e)
+        {
+            Logger::error("Error in step with index " + std::to_string(grid_index) + ": " + e.what());
+            continue;
+        }
+    }
+
+    runDeferredSteps(deferred_steps, required_calculations, start_time, num_attempted - deferred_steps.size());
+}
+
+void ParameterSearch::runSamples(const std::vector<std::shared_ptr<ParamRange>> &param_ranges, const std::vector<std::type_index> &required_calculations)
+{
+    // Generate the space-filling design on the unit cube
+    std::vector<std::vector<double>> points = sampler_->generate(num_samples_, param_ranges.size());
+
+    Logger::info("Number of samples: " + std::to_string(num_samples_));
+    Logger::info("Sampler: " + sampler_->getName());
+    if (num_shards_ > 1)
+    {
+        Logger::info("Running shard " + std::to_string(shard_index_) + " / " + std::to_string(num_shards_ - 1));
+    }
+
+    // Start time for the time budget
+    auto start_time = std::chrono::steady_clock::now();
+    size_t num_attempted = 0;
+    std::vector<DeferredStep> deferred_steps;
+
+    // Loop over all samples of this shard
+    for (size_t sample_num = shard_index_; sample_num < points.size(); sample_num += num_shards_, num_attempted++)
+    {
+        // Stop cleanly if the budget is spent, deferred samples are not attempted yet
+        if (isBudgetExhausted(num_attempted - deferred_steps.size(), start_time))
+        {
+            break;
+        }
+
+        try
+        {
+            // Map the sample point to an input param configuration
+            std::vector<Json::Value> next_config = getParameterConfiguration(points[sample_num], param_ranges);
+
+            Logger::info("== Starting sample " + std::to_string(sample_num) + " / " + std::to_string(points.size() - 1) + " ==");
+
+            if (!evaluateSweepStep(sample_num, next_config, points[sample_num], required_calculations))
+            {
+                deferred_steps.push_back({sample_num, next_config, points[sample_num]});
+            }
+        }
+        catch (const std::exception &e)
+        {
+            Logger::error("Error in sample with index " + std::to_string(sample_num) + ": " + e.what());
+            continue;
+        }
+    }
+
+    runDeferredSteps(deferred_steps, required_calculations, start_time, num_attempted - deferred_steps.size());
+}
+
+bool ParameterSearch::evaluateSweepStep(size_t index, std::vector<Json::Value> &config, const std::vector<double> &unit_point, const std::vector<std::type_index> &required_calculations, bool is_deferred)
+{
+    if (failure_predictor_ == nullptr)
+    {
+        evaluateConfiguration(index, config, required_calculations);
+        return true;
+    }
+
+    bool predicted_failure = is_deferred || failure_predictor_->predictFailureProbability(unit_point) >= failure_threshold_;
+    if (predicted_failure && !is_deferred)
+    {
+        if (failure_policy_ == DEFER_LIKELY_FAILURES)
+        {
+            Logger::info("Step with index " + std::to_string(index) + " is likely to fail, deferred to the end.");
+            return false;
+        }
+        Logger::info("Step with index " + std::to_string(index) + " is likely to fail, skipped.");
+        std::vector<double> output_values(outputCriteria_.size(), std::numeric_limits<double>::quiet_NaN());
+        writeStepToOutputFile(index, outputFile_, config, output_values, "skipped:predicted_failure");
+        return true;
+    }
+
+    size_t num_pruned_before = num_pruned_steps_;
+    try
+    {
+        evaluateConfiguration(index, config, required_calculations);
+    }
+    catch (const std::exception &)
+    {
+        failure_predictor_->addObservation(unit_point, true);
+        failure_statistics_.add(predicted_failure, true);
+        throw;
+    }
+
+    // Pruned steps have not been simulated
+    if (num_pruned_steps_ == num_pruned_before)
+    {
+        failure_predictor_->addObservation(unit_point, false);
+        failure_statistics_.add(predicted_failure, false);
+    }
+    return true;
+}
+
+void ParameterSearch::runDeferredSteps(std::vector<DeferredStep> &deferred_steps, const std::vector<std::type_index> &required_calculations, std::chrono::steady_clock::time_point start_time, size_t num_attempted)
+{
+    if (!deferred_steps.empty())
+    {
+        Logger::info("Evaluating " + std::to_string(deferred_steps.size()) + " deferred steps.");
+    }
+    for (DeferredStep &step : deferred_steps)
+    {
+        if (isBudgetExhausted(num_attempted++, start_time))
+        {
+            break;
+        }
+        try
+        {
+            Logger::info("== Starting deferred step with index " + std::to_string(step.index) + " ==");
+            evaluateSweepStep(step.index, step.config, step.unit_point, required_calculations, true);
+        }
+        catch (const std::exception &e)
+        {
+            Logger::error("Error in step with index " + std::to_string(step.index) + ": " + e.what());
+        }
+    }
+
+    if (failure_predictor_ != nullptr)
+    {
+        const FailurePredictionStatistics &stats = failure_statistics_;
+        Logger::info("Failure prediction: " + std::to_string(stats.true_positives) + " true and " + std::to_string(stats.false_positives) + " false positives, " +
+                     std::to_string(stats.false_negatives) + " missed failures, precision " + std::to_string(stats.getPrecision()) + ", recall " + std::to_string(stats.getRecall()));
+    }
+}
+
+std::vector<double> ParameterSearch::evaluateConfiguration(size_t index, std::vector<Json::Value> &config, const std::vector<std::type_index> &required_calculations)
+{
+    // Infeasible configurations are never applied
+    std::string reason;
+    if (!checkFeasibility(config, reason))
+    {
+        std::vector<double> output_values(outputCriteria_.size(), std::numeric_limits<double>::quiet_NaN());
+        writeStepToOutputFile(index, outputFile_, config, output_values, "pruned:" + reason);
+        return {};
+    }
+
+    // Criteria that write files per step name them by the index in the output file
+    for (auto &output_criterion : outputCriteria_)
+    {
+        output_criterion->setStepIndex(index);
+    }
+
+    // Apply paramater configuration for the current step
+    applyParameterConfiguration(inputParamsRanges_, config, modelHandler_);
+    applyDerivedInputs(config, modelHandler_);
+
+    // Run the necessary calculations and compute the output criteria, in a child process if the step has a timeout
+    std::string status;
+    std::vector<double> output_values = hasStepTimeout(required_calculations) ? computeOutputsIsolated(required_calculations, status)
+                                                                              : computeOutputs(required_calculations, modelCalculator_, modelHandler_, status);
+    if (status.empty() && hasStatusColumn())
+    {
+        status = "accepted";
+    }
+
+    // Write the output values to the output file
+    writeStepToOutputFile(index, outputFile_, config, output_values, status);
+
+    // Rejected and timed-out steps count as failed for the search modes
+    if (status.rfind("rejected", 0) == 0 || status.rfind("timeout", 0) == 0)
+    {
+        return {};
+    }
+
+    return output_values;
+}
+
+std::vector<std::vector<double>> ParameterSearch::evaluateBatch(size_t first_index, std::vector<std::vector<Json::Value>> &configs, const std::vector<std::type_index> &required_calculations)
+{
+    std::vector<std::vector<double>> results(configs.size());
+
+    // Check if all output criteria can be computed on the workers
+    bool parallel = num_workers_ > 1 && configs.size() > 1;
+    for (auto &output_criterion : outputCriteria_)
+    {
+        parallel = parallel && output_criterion->supportsParallelEvaluation();
+    }
+
+    if (!parallel)
+    {
+        for (size_t i = 0; i < configs.size(); i++)
+        {
+            try
+            {
+                Logger::info("== Starting step with index " + std::to_string(first_index + i) + " ==");
+                results[i] = evaluateConfiguration(first_index + i, configs[i], required_calculations);
+            }
+            catch (const std::exception &e)
+            {
+                Logger::error("Error in step with index " + std::to_string(first_index + i) + ": " + e.what());
+            }
+        }
+        return results;
+    }
+
+    initWorkers();
+
+    Logger::info("== Starting steps with indices " + std::to_string(first_index) + " to " + std::to_string(first_index + configs.size() - 1) + " on " + std::to_string(num_workers_) + " workers ==");
+
+    // Workers take the next configuration until all are evaluated, infeasible configurations are pruned beforehand
+    std::vector<std::string> errors(configs.size());
+    std::vector<std::string> statuses(configs.size());
+    std::vector<bool> is_pruned(configs.size(), false);
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        std::string reason;
+        if (!checkFeasibility(configs[i], reason))
+        {
+            is_pruned[i] = true;
+            statuses[i] = "pruned:" + reason;
+            results[i].assign(outputCriteria_.size(), std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+    std::atomic<size_t> next_config{0};
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < std::min(num_workers_, configs.size()); w++)
+    {
+        threads.emplace_back([&, w]()
+                             {
+            WorkerContext &worker = *workers_[w];
+            for (size_t i = next_config++; i < configs.size(); i = next_config++)
+            {
+                if (is_pruned[i])
+                {
+                    continue;
+                }
+                try
+                {
+                    applyParameterConfiguration(inputParamsRanges_, configs[i], worker.model_handler);
+                    applyDerivedInputs(configs[i], worker.model_handler);
+                    results[i] = computeOutputs(required_calculations, worker.model_calculator, worker.model_handler, statuses[i]);
+                }
+                catch (const std::exception &e)
+                {
+                    errors[i] = e.what();
+                    results[i].clear();
+                }
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // Write the results in index order
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        if (!errors[i].empty())
+        {
+            Logger::error("Error in step with index " + std::to_string(first_index + i) + ": " + errors[i]);
+            continue;
+        }
+        if (statuses[i].empty() && hasStatusColumn())
+        {
+            statuses[i] = "accepted";
+        }
+        writeStepToOutputFile(first_index + i, outputFile_, configs[i], results[i], statuses[i]);
+        if (statuses[i].rfind("rejected", 0) == 0 || is_pruned[i])
+        {
+            results[i].clear();
+        }
+    }
+
+    return results;
+}
+
+std::vector<double> ParameterSearch::computeOutputs(const std::vector<std::type_index> &required_calculations, CCTools::ModelCalculator &modelCalculator, CCTools::ModelHandler &modelHandler, std::string &status) const
+{
+    status.clear();
+
+    // Report the phases to the watchdog of isolated steps
+    auto start_phase = [&](const std::string &phase)
+    {
+        if (phase_listener_)
+        {
+            phase_listener_(phase);
+        }
+    };
+
+    if (acceptance_bounds_.empty())
+    {
+        std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> calc_results;
+        for (const std::type_index &calculation : required_calculations)
+        {
+            if (phase_listener_)
+            {
+                start_phase(getCalculationName(calculation));
+            }
+            std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> results = runCalculations({calculation}, modelCalculator, modelHandler, max_harmonic_order_);
+            calc_results.insert(calc_results.end(), results.begin(), results.end());
+        }
+        start_phase("criteria");
+        return computeCriteria(calc_results, outputCriteria_);
+    }
+
+    std::vector<double> output_values(outputCriteria_.size(), std::numeric_limits<double>::quiet_NaN());
+    std::vector<bool> is_computed(outputCriteria_.size(), false);
+    std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> calc_results;
+    std::set<std::type_index> finished_calculations;
+
+    // Compute the criteria whose calculations are finished, returns false if one of them is outside its bounds.
+    // Criteria without calculations (e.g. the strain energy optimization of OutputPathConnectV2StrainEnergy) can be the most expensive ones, they are computed after the last stage.
+    auto compute_and_check = [&](bool is_last_stage) -> bool
+    {
+        start_phase("criteria");
+        for (size_t c = 0; c < outputCriteria_.size(); c++)
+        {
+            std::vector<std::type_index> criterion_calculations = outputCriteria_[c]->getRequiredCalculations();
+            bool is_ready = criterion_calculations.empty() ? is_last_stage
+                                                           : std::all_of(criterion_calculations.begin(), criterion_calculations.end(), [&](const std::type_index &calculation)
+                                                                         { return finished_calculations.count(calculation) > 0; });
+            if (is_computed[c] || !is_ready)
+            {
+                continue;
+            }
+            output_values[c] = computeCriteria(calc_results, {outputCriteria_[c]})[0];
+            is_computed[c] = true;
+
+            auto bounds = acceptance_bounds_.find(c);
+            if (bounds != acceptance_bounds_.end() && !(output_values[c] >= bounds->second.first && output_values[c] <= bounds->second.second))
+            {
+                status = "rejected:" + outputCriteria_[c]->getColumnName();
+                Logger::info("Step rejected: " + outputCriteria_[c]->getColumnName() + " = " + std::to_string(output_values[c]) + " is outside [" +
+                             std::to_string(bounds->second.first) + ", " + std::to_string(bounds->second.second) + "]");
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<std::type_index> stages = getStagedCalculations(required_calculations);
+    for (size_t stage = 0; stage < stages.size(); stage++)
+    {
+        if (phase_listener_)
+        {
+            start_phase(getCalculationName(stages[stage]));
+        }
+        std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> stage_results = runCalculations({stages[stage]}, modelCalculator, modelHandler, max_harmonic_order_);
+        calc_results.insert(calc_results.end(), stage_results.begin(), stage_results.end());
+        finished_calculations.insert(stages[stage]);
+        if (!compute_and_check(stage + 1 == stages.size()))
+        {
+            return output_values;
+        }
+    }
+    if (stages.empty() && !compute_and_check(true))
+    {
+        return output_values;
+    }
+
+    status = "accepted";
+    return output_values;
+}
+
+std::string ParameterSearch::getCalculationName(const std::type_index &calculation)
+{
+    if (calculation == std::type_index(typeid(CCTools::HarmonicsDataHandler)))
+    {
+        return "harmonics";
+    }
+    if (calculation == std::type_index(typeid(CCTools::MeshDataHandler)))
+    {
+        return "mesh";
+    }
+    if (calculation == std::type_index(typeid(GeometryDataHandler)))
+    {
+        return "geometry";
+    }
+    std::string type_name = calculation.name();
+    throw std::invalid_argument("Unknown calculation type " + type_name);
+}
+
+bool ParameterSearch::hasStepTimeout(const std::vector<std::type_index> &required_calculations) const
+{
+    // Every step computes the criteria
+    if (phase_timeouts_.count("criteria") > 0)
+    {
+        return true;
+    }
+    return std::any_of(required_calculations.begin(), required_calculations.end(), [&](const std::type_index &calculation)
+                       { return phase_timeouts_.count(getCalculationName(calculation)) > 0; });
+}
+
+namespace
+{
+    /**
+     * @brief Write all of a string to a file descriptor.
+     */
+    void writeAll(int fd, const std::string &data)
+    {
+        for (size_t written = 0; written < data.size();)
+        {
+            ssize_t n = write(fd, data.data() + written, data.size() - written);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                return;
+            }
+            written += n;
+        }
+    }
+}
+
+std::vector<double> ParameterSearch::computeOutputsIsolated(const std::vector<std::type_index> &required_calculations, std::string &status)
+{
+    // The worker threads would be copied into the child in an undefined state
+    if (!workers_.empty())
+    {
+        throw std::runtime_error("Steps cannot be isolated once parallel workers exist");
+    }
+
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        throw std::runtime_error("Could not create pipe for isolated step: " + std::string(std::strerror(errno)));
+    }
+
+    // Buffered output would otherwise be written by both processes
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        throw std::runtime_error("Could not fork isolated step: " + std::string(std::strerror(errno)));
+    }
+
+    if (pid == 0)
+    {
+        // Child: report each phase, then send the results line by line
+        close(fds[0]);
+        phase_listener_ = [&](const std::string &phase)
+        {
+            writeAll(fds[1], "phase " + phase + "\n");
+        };
+        std::ostringstream message;
+        message << std::setprecision(17) << "result\n";
+        try
+        {
+            std::string child_status;
+            std::vector<double> output_values = computeOutputs(required_calculations, modelCalculator_, modelHandler_, child_status);
+            message << "ok\n"
+                    << child_status << "\n";
+            for (double value : output_values)
+            {
+                message << value << "\n";
+            }
+
+            // The state of the criteria would otherwise die with the child, one JSON line per criterion
+            Json::StreamWriterBuilder writer;
+            writer["indentation"] = "";
+            writer["useSpecialFloats"] = true;
+            for (auto &output_criterion : outputCriteria_)
+            {
+                message << Json::writeString(writer, output_criterion->getState()) << "\n";
+            }
+        }
+        catch (const std::exception &e)
+        {
+            message.str("");
+            message << "result\nerror\n"
+                    << e.what();
+        }
+        writeAll(fds[1], message.str());
+        std::cout.flush();
+        std::cerr.flush();
+        // Skip the destructors and exit handlers of the parent's state
+        _exit(0);
+    }
+
+    // Parent: follow the phases of the child and kill it once a phase exceeds its timeout
+    close(fds[1]);
+    std::string data;
+    size_t parsed = 0;
+    size_t result_start = std::string::npos;
+    std::string phase;
+    bool timed_out = false;
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    char buffer[4096];
+    while (true)
+    {
+        int wait_ms = -1;
+        if (deadline != std::chrono::steady_clock::time_point::max())
+        {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0)
+            {
+                timed_out = true;
+                break;
+            }
+            wait_ms = static_cast<int>(std::min<long long>(remaining, std::numeric_limits<int>::max()));
+        }
+        pollfd pfd{fds[0], POLLIN, 0};
+        int ready = poll(&pfd, 1, wait_ms);
+        if (ready == 0 || (ready < 0 && errno == EINTR))
+        {
+            continue;
+        }
+        ssize_t n = ready < 0 ? -1 : read(fds[0], buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            break;
+        }
+        data.append(buffer, n);
+
+        // Start the clock of each new phase, the results are not watched
+        for (size_t end = data.find('\n', parsed); result_start == std::string::npos && end != std::string::npos; end = data.find('\n', parsed))
+        {
+            std::string line = data.substr(parsed, end - parsed);
+            parsed = end + 1;
+            if (line == "result")
+            {
+                result_start = parsed;
+                deadline = std::chrono::steady_clock::time_point::max();
+                break;
+            }
+            phase = line.substr(std::string("phase ").size());
+            auto timeout = phase_timeouts_.find(phase);
+            deadline = timeout == phase_timeouts_.end() ? std::chrono::steady_clock::time_point::max()
+                                                        : std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout->second);
+        }
+    }
+    close(fds[0]);
+
+    if (timed_out)
+    {
+        kill(pid, SIGKILL);
+    }
+    int wait_status = 0;
+    while (waitpid(pid, &wait_status, 0) < 0 && errno == EINTR)
+    {
+    }
+
+    if (timed_out)
+    {
+        Logger::error("Step exceeded the " + std::to_string(phase_timeouts_[phase].count()) + " s timeout of the " + phase + " phase, its calculations were stopped.");
+        status = "timeout:" + phase;
+        return std::vector<double>(outputCriteria_.size(), std::numeric_limits<double>::quiet_NaN());
+    }
+    std::string result = result_start == std::string::npos ? "" : data.substr(result_start);
+    if (result.rfind("error\n", 0) == 0)
+    {
+        throw std::runtime_error(result.substr(6));
+    }
+    if (result.rfind("ok\n", 0) != 0)
+    {
+        if (WIFSIGNALED(wait_status))
+        {
+            throw std::runtime_error("Isolated step was terminated by signal " + std::to_string(WTERMSIG(wait_status)));
+        }
+        throw std::runtime_error("Isolated step ended without results");
+    }
+
+    std::istringstream in(result.substr(3));
+    std::getline(in, status);
+    std::vector<double> output_values;
+    std::string line;
+    while (output_values.size() < outputCriteria_.size() && std::getline(in, line))
+    {
+        // std::stod parses "nan" and "inf", operator>> does not
+        output_values.push_back(std::stod(line));
+    }
+    if (output_values.size() != outputCriteria_.size())
+    {
+        throw std::runtime_error("Isolated step returned " + std::to_string(output_values.size()) + " values for " + std::to_string(outputCriteria_.size()) + " output criteria");
+    }
+
+    // Restore the state the computation left in the criteria of the child
+    Json::CharReaderBuilder reader;
+    reader["allowSpecialFloats"] = true;
+    for (auto &output_criterion : outputCriteria_)
+    {
+        Json::Value state;
+        std::string errors;
+        if (!std::getline(in, line))
+        {
+            throw std::runtime_error("Isolated step returned no state for output criterion " + output_criterion->getColumnName());
+        }
+        std::istringstream state_in(line);
+        if (!Json::parseFromStream(reader, state_in, &state, &errors))
+        {
+            throw std::runtime_error("Isolated step returned an invalid state for output criterion " + output_criterion->getColumnName() + ": " + errors);
+        }
+        if (!state.isNull())
+        {
+            output_criterion->setState(state);
+        }
+    }
+    return output_values;
+}
+
+void ParameterSearch::initWorkers()
+{
+    if (workers_.size() == num_workers_)
+    {
+        return;
+    }
+    workers_.clear();
+
+    std::filesystem::path model_path = modelHandler_.getTempJsonPath();
+    for (size_t w = 0; w < num_workers_; w++)
+    {
+        // Each worker gets its own copy of the current model
+        std::filesystem::path worker_path = getWorkerModelPath(w);
+        std::filesystem::copy_file(model_path, worker_path, std::filesystem::copy_options::overwrite_existing);
+
+        CCTools::ModelHandler worker_handler(worker_path);
+        CCTools::ModelCalculator worker_calculator(worker_handler.getTempJsonPath());
+        workers_.push_back(std::make_unique<WorkerContext>(WorkerContext{worker_handler, worker_calculator}));
+    }
+}
+
+std::filesystem::path ParameterSearch::getWorkerModelPath(size_t worker)
+{
+    std::string model_name = modelHandler_.getTempJsonPath().filename().string();
+    return std::filesystem::temp_directory_path() / ("worker_" + std::to_string(getpid()) + "_" + std::to_string(search_id_) + "_" + std::to_string(worker) + "_" + model_name);
+}
+
+bool ParameterSearch::isBudgetExhausted(size_t num_attempted, std::chrono::steady_clock::time_point start_time) const
+{
+    if (step_budget_ > 0 && num_attempted >= step_budget_)
+    {
+        Logger::info("Step budget of " + std::to_string(step_budget_) + " steps reached. Stopping parameter search after " + std::to_string(num_attempted) + " steps.");
+        return true;
+    }
+    if (time_budget_ > std::chrono::duration<double>::zero() && std::chrono::steady_clock::now() - start_time >= time_budget_)
+    {
+        Logger::info("Time budget of " + std::to_string(time_budget_.count()) + " s reached. Stopping parameter search after " + std::to_string(num_attempted) + " steps.");
+        return true;
+    }
+    return false;
+}
+
+ParameterSearch::BatchEvaluator::BatchEvaluator(ParameterSearch &search, std::vector<std::shared_ptr<ParamRange>> param_ranges, std::vector<std::type_index> required_calculations,
+                                                size_t max_evaluations, std::function<double(const std::vector<double> &)> objective) : search_(search),
+                                                                                                                                       param_ranges_(std::move(param_ranges)),
+                                                                                                                                       required_calculations_(std::move(required_calculations)),
+                                                                                                                                       max_evaluations_(max_evaluations),
+                                                                                                                                       objective_(std::move(objective)),
+                                                                                                                                       start_time_(std::chrono::steady_clock::now())
+{
+}
+
+std::vector<std::vector<double>> ParameterSearch::BatchEvaluator::operator()(const std::vector<std::vector<double>> &points)
+{
+    std::vector<std::vector<Json::Value>> configs;
+    for (const std::vector<double> &point : points)
+    {
+        configs.push_back(getParameterConfiguration(point, param_ranges_));
+    }
+    return evaluate(std::move(configs));
+}
+
+std::vector<std::vector<double>> ParameterSearch::BatchEvaluator::evaluate(std::vector<std::vector<Json::Value>> configs)
+{
+    std::vector<std::vector<double>> results = search_.evaluateBatch(num_evaluated_, configs, required_calculations_);
+    for (size_t i = 0; i < results.size() && objective_; i++)
+    {
+        if (!results[i].empty())
+        {
+            search_.trackBest(num_evaluated_ + i, objective_(results[i]), configs[i]);
+        }
+    }
+    num_evaluated_ += results.size();
+    return results;
+}
+
+bool ParameterSearch::BatchEvaluator::allows(size_t batch_size) const
+{
+    bool exceeds_budget = (max_evaluations_ > 0 && num_evaluated_ + batch_size > max_evaluations_) ||
+                          (search_.step_budget_ > 0 && num_evaluated_ + batch_size > search_.step_budget_);
+    if (exceeds_budget)
+    {
+        Logger::info("Evaluation budget does not allow another batch of " + std::to_string(batch_size) + ". Stopping after " + std::to_string(num_evaluated_) + " evaluations.");
+        return false;
+    }
+    return !search_.isBudgetExhausted(num_evaluated_, start_time_);
+}
+
+size_t ParameterSearch::BatchEvaluator::getNumEvaluated() const
+{
+    return num_evaluated_;
+}
+
+const std::vector<std::shared_ptr<ParamRange>> &ParameterSearch::BatchEvaluator::getParamRanges() const
+{
+    return param_ranges_;
+}
+
+ParameterSearch::BatchEvaluator ParameterSearch::makeBatchEvaluator(size_t max_evaluations, std::function<double(const std::vector<double> &)> objective)
+{
+    resetBest();
+    return BatchEvaluator(*this, getLazyParamRanges(inputParamsRanges_), getRequiredCalculations(outputCriteria_), max_evaluations, std::move(objective));
+}
+
+void ParameterSearch::setStartConfiguration(const std::vector<Json::Value> &config)
+{
+    if (config.size() != inputParamsRanges_.size())
+    {
+        throw std::invalid_argument("Number of values does not match the number of input parameters");
+    }
+
+    // Check that every value can be located in its range
+    std::vector<std::shared_ptr<ParamRange>> param_ranges = getLazyParamRanges(inputParamsRanges_);
+    for (size_t i = 0; i < config.size(); i++)
+    {
+        param_ranges[i]->getUnitPosition(config[i]);
+    }
+    start_config_ = config;
+}
+
+std::vector<double> ParameterSearch::getStartPoint()
+{
+    std::vector<std::shared_ptr<ParamRange>> param_ranges = getLazyParamRanges(inputParamsRanges_);
+    std::vector<double> start(param_ranges.size(), 0.5);
+    for (size_t i = 0; i < start_config_.size(); i++)
+    {
+        start[i] = param_ranges[i]->getUnitPosition(start_config_[i]);
+    }
+    return start;
+}
+
+void ParameterSearch::resetBest()
+{
+    best_index_ = -1;
+    best_objective_ = std::numeric_limits<double>::infinity();
+    best_config_.clear();
+}
+
+bool ParameterSearch::trackBest(size_t index, double objective, const std::vector<Json::Value> &config)
+{
+    if (!(objective < best_objective_))
+    {
+        return false;
+    }
+    best_index_ = static_cast<long>(index);
+    best_objective_ = objective;
+    best_config_ = config;
+    return true;
+}
+
+long ParameterSearch::getBestIndex() const
+{
+    return best_index_;
+}
+
+double ParameterSearch::getBestObjective() const
+{
+    return best_objective_;
+}
+
+std::vector<Json::Value> ParameterSearch::getBestConfiguration() const
+{
+    return best_config_;
+}
+
+void ParameterSearch::setSampler(std::shared_ptr<Sampler> sampler, size_t num_samples)
+{
+    if (sampler != nullptr && num_samples == 0)
+    {
+        throw std::invalid_argument("num_samples must be greater than 0");
+    }
+    sampler_ = sampler;
+    num_samples_ = num_samples;
+}
+
+void ParameterSearch::setNumWorkers(size_t num_workers)
+{
+    if (num_workers < 1)
+    {
+        throw std::invalid_argument("num_workers must be at least 1");
+    }
+    if (num_workers > 1 && !phase_timeouts_.empty())
+    {
+        throw std::invalid_argument("Parallel workers cannot be combined with timeouts");
+    }
+    if (num_workers != num_workers_)
+    {
+        workers_.clear();
+    }
+    num_workers_ = num_workers;
+}
+
+void ParameterSearch::setAcceptanceBounds(size_t criterion_index, double lower, double upper)
 {
-    Logger::info("=== Starting parameter search ===");
-    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+    if (criterion_index >= outputCriteria_.size())
+    {
+        throw std::invalid_argument("Output criterion " + std::to_string(criterion_index) + " does not exist");
+    }
+    if (!(lower <= upper))
+    {
+        throw std::invalid_argument("lower must not be greater than upper");
+    }
+    acceptance_bounds_[criterion_index] = {lower, upper};
+}
 
-    // Initialize the output file
-    std::string output_file_path = initOutputFile();
+void ParameterSearch::addDerivedInput(std::shared_ptr<InputParamRangeInterface> input, std::function<Json::Value(const std::vector<Json::Value> &)> function)
+{
+    if (!function)
+    {
+        throw std::invalid_argument("Function of derived input parameter " + input->getColumnName() + " is empty");
+    }
+    std::vector<std::shared_ptr<InputParamRangeInterface>> derived_input = {input};
+    checkInputParams(derived_input);
+    derived_inputs_.push_back({input, function});
+}
 
-    // Get all parameter ranges
-    std::vector<std::vector<Json::Value>> param_ranges = getParamRanges(inputParamsRanges_);
+void ParameterSearch::setFailurePrediction(FailurePolicy policy, double threshold, size_t k, size_t min_observations)
+{
+    if (!(threshold > 0.0 && threshold <= 1.0))
+    {
+        throw std::invalid_argument("threshold must be in (0, 1]");
+    }
+    failure_predictor_ = std::make_shared<FailurePredictor>(k, min_observations);
+    failure_policy_ = policy;
+    failure_threshold_ = threshold;
+}
 
-    // Compute the number of steps
-    size_t num_steps = getNumSteps(param_ranges);
+const FailurePredictionStatistics &ParameterSearch::getFailurePredictionStatistics() const
+{
+    return failure_statistics_;
+}
 
-    Logger::info("Number of steps: " + std::to_string(num_steps));
+void ParameterSearch::addFeasibilityPredicate(std::string name, std::function<bool(const std::vector<Json::Value> &)> predicate)
+{
+    if (!predicate)
+    {
+        throw std::invalid_argument("Feasibility predicate " + name + " is empty");
+    }
+    feasibility_predicates_.push_back({name, predicate});
+}
 
-    // Check what computations are necessary for the output criteria
-    std::vector<std::type_index> required_calculations_ = getRequiredCalculations(outputCriteria_);
+size_t ParameterSearch::getNumPrunedSteps() const
+{
+    return num_pruned_steps_;
+}
 
-    // Loop over all steps
-    for (size_t step_num = 0; step_num < num_steps; step_num++)
+bool ParameterSearch::checkFeasibility(const std::vector<Json::Value> &config, std::string &reason)
+{
+    reason.clear();
+    for (size_t i = 0; i < inputParamsRanges_.size() && reason.empty(); i++)
     {
-        try
+        if (!inputParamsRanges_[i]->isFeasible(config[i]))
+        {
+            reason = inputParamsRanges_[i]->getColumnName();
+        }
+    }
+    for (size_t p = 0; p < feasibility_predicates_.size() && reason.empty(); p++)
+    {
+        if (!feasibility_predicates_[p].second(config))
         {
-            Logger::info("== Starting step with index " + std::to_string(step_num) + " / " + std::to_string(num_steps - 1) + " ==");
+            reason = feasibility_predicates_[p].first;
+        }
+    }
+    if (reason.empty())
+    {
+        return true;
+    }
 
-            // Get the next input param configuration
-            std::vector<Json::Value> next_config = getParameterConfiguration(step_num, param_ranges);
+    num_pruned_steps_++;
+    Logger::info("Step pruned before simulation, infeasible: " + reason);
+    return false;
+}
 
-            // Apply paramater configuration for the current step
-            applyParameterConfiguration(inputParamsRanges_, next_config, modelHandler_);
+bool ParameterSearch::hasStatusColumn()
+{
+    if (!acceptance_bounds_.empty() || !feasibility_predicates_.empty() || !phase_timeouts_.empty() || (failure_predictor_ != nullptr && failure_policy_ == SKIP_LIKELY_FAILURES))
+    {
+        return true;
+    }
+    return std::any_of(inputParamsRanges_.begin(), inputParamsRanges_.end(), [](const std::shared_ptr<InputParamRangeInterface> &input)
+                       { return input->hasFeasibilityPredicate(); });
+}
 
-            // Run the necessary calculations
-            std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> calc_results = runCalculations(required_calculations_, modelCalculator_, modelHandler_);
+void ParameterSearch::applyDerivedInputs(const std::vector<Json::Value> &config, CCTools::ModelHandler &modelHandler) const
+{
+    for (const auto &[input, function] : derived_inputs_)
+    {
+        input->applyParamConfig(modelHandler, function(config));
+    }
+}
 
-            // Compute the output criteria
-            std::vector<double> output_values = computeCriteria(calc_results, outputCriteria_);
+void ParameterSearch::setTraversalOrder(TraversalOrder order)
+{
+    traversal_order_ = order;
+}
 
-            // Write the output values to the output file
-            writeStepToOutputFile(step_num, outputFile_, next_config, output_values);
-        }
-        catch (const std::exception &e)
-        {
-            Logger::error("Error in step " + std::to_string(step_num) + ": " + e.what());
-            continue;
-        }
+void ParameterSearch::setStepBudget(size_t max_steps)
+{
+    step_budget_ = max_steps;
+}
+
+void ParameterSearch::setTimeBudget(std::chrono::duration<double> max_duration)
+{
+    time_budget_ = max_duration;
+}
+
+void ParameterSearch::setCalculationTimeout(const std::type_index &calculation, std::chrono::duration<double> timeout)
+{
+    std::string name = getCalculationName(calculation);
+    if (timeout <= std::chrono::duration<double>::zero())
+    {
+        phase_timeouts_.erase(name);
+        return;
+    }
+    if (num_workers_ > 1)
+    {
+        throw std::invalid_argument("Timeouts cannot be combined with parallel workers");
     }
+    phase_timeouts_[name] = timeout;
+}
 
-    // Close the output file
-    closeOutputFile();
+void ParameterSearch::setCriteriaTimeout(std::chrono::duration<double> timeout)
+{
+    if (timeout <= std::chrono::duration<double>::zero())
+    {
+        phase_timeouts_.erase("criteria");
+        return;
+    }
+    if (num_workers_ > 1)
+    {
+        throw std::invalid_argument("Timeouts cannot be combined with parallel workers");
+    }
+    phase_timeouts_["criteria"] = timeout;
+}
 
-    Logger::info("=== Finished parameter search ===");
-    Logger::info("All results been saved to the output file " + output_file_path);
+void ParameterSearch::setShard(size_t shard_index, size_t num_shards)
+{
+    if (num_shards == 0 || shard_index >= num_shards)
+    {
+        throw std::invalid_argument("shard_index must be less than num_shards");
+    }
+    shard_index_ = shard_index;
+    num_shards_ = num_shards;
 }
 
 void ParameterSearch::checkInputParams(std::vector<std::shared_ptr<InputParamRangeInterface>> &inputParamsRanges)
@@ -92,6 +1086,25 @@ void ParameterSearch::checkInputParams(std::vector<std::shared_ptr<InputParamRan
     Logger::info("All input parameters are valid.");
 }
 
+void ParameterSearch::checkContinuousInputs(const std::vector<size_t> &input_indices)
+{
+    for (size_t i : input_indices)
+    {
+        if (!inputParamsRanges_[i]->getParamRange()->isContinuous())
+        {
+            throw std::invalid_argument("Input parameter " + inputParamsRanges_[i]->getColumnName() +
+                                        " has a discrete range, use a LinearParamRange or GeometricParamRange for continuous optimization");
+        }
+    }
+}
+
+void ParameterSearch::checkContinuousInputs()
+{
+    std::vector<size_t> input_indices(inputParamsRanges_.size());
+    std::iota(input_indices.begin(), input_indices.end(), 0);
+    checkContinuousInputs(input_indices);
+}
+
 std::string ParameterSearch::initOutputFile()
 {
     // Check if the output directory exists
@@ -116,10 +1129,7 @@ std::string ParameterSearch::initOutputFile()
     // Write the index and the column names of the input params and output criteria to the file
     outputFile_ << "index,";
     // input params
-    for (size_t i = 0; i < inputParamsRanges_.size(); i++)
-    {
-        outputFile_ << inputParamsRanges_[i]->getColumnName() << ",";
-    }
+    writeInputColumnNames(outputFile_);
     // output criteria
     for (size_t i = 0; i < outputCriteria_.size(); i++)
     {
@@ -129,6 +1139,13 @@ std::string ParameterSearch::initOutputFile()
             outputFile_ << ",";
         }
     }
+    // status of staged evaluation and pruning
+    if (hasStatusColumn())
+    {
+        outputFile_ << ",status";
+    }
+    num_pruned_steps_ = 0;
+    failure_statistics_ = FailurePredictionStatistics();
 
     // Write a newline
     outputFile_ << std::endl;
@@ -148,6 +1165,16 @@ std::vector<std::vector<Json::Value>> ParameterSearch::getParamRanges(std::vecto
     return param_ranges;
 }
 
+std::vector<std::shared_ptr<ParamRange>> ParameterSearch::getLazyParamRanges(std::vector<std::shared_ptr<InputParamRangeInterface>> &inputParamsRanges)
+{
+    std::vector<std::shared_ptr<ParamRange>> param_ranges;
+    for (size_t i = 0; i < inputParamsRanges.size(); i++)
+    {
+        param_ranges.push_back(inputParamsRanges[i]->getParamRange());
+    }
+    return param_ranges;
+}
+
 size_t ParameterSearch::getNumSteps(const std::vector<std::vector<Json::Value>> &param_ranges)
 {
     if (param_ranges.size() == 0)
@@ -155,14 +1182,19 @@ size_t ParameterSearch::getNumSteps(const std::vector<std::vector<Json::Value>>
         throw std::runtime_error("No parameter ranges provided. Number of steps cannot be calculated.");
     }
 
-    size_t num_steps = 1;
+    // Overflow-checked product of the range sizes
+    return GridTraversal(getRangeSizes(param_ranges)).getNumSteps();
+}
 
-    for (size_t i = 0; i < param_ranges.size(); i++)
+size_t ParameterSearch::getNumSteps(const std::vector<std::shared_ptr<ParamRange>> &param_ranges)
+{
+    if (param_ranges.size() == 0)
     {
-        num_steps *= param_ranges[i].size();
+        throw std::runtime_error("No parameter ranges provided. Number of steps cannot be calculated.");
     }
 
-    return num_steps;
+    // Overflow-checked product of the range sizes
+    return GridTraversal(getRangeSizes(param_ranges)).getNumSteps();
 }
 
 std::vector<std::type_index> ParameterSearch::getRequiredCalculations(std::vector<std::shared_ptr<OutputCriterionInterface>> &outputCriteria)
@@ -183,6 +1215,161 @@ std::vector<std::type_index> ParameterSearch::getRequiredCalculations(std::vecto
     return required_calculations;
 }
 
+size_t ParameterSearch::getMaxHarmonicOrder(std::vector<std::shared_ptr<OutputCriterionInterface>> &outputCriteria)
+{
+    size_t max_order = 0;
+    for (const std::shared_ptr<OutputCriterionInterface> &criterion : outputCriteria)
+    {
+        std::vector<std::type_index> criterion_calculations = criterion->getRequiredCalculations();
+        if (std::find(criterion_calculations.begin(), criterion_calculations.end(), std::type_index(typeid(CCTools::HarmonicsDataHandler))) == criterion_calculations.end())
+        {
+            continue;
+        }
+
+        // A criterion without a declared order may read all of them
+        size_t order = criterion->getMaxHarmonicOrder();
+        if (order == 0)
+        {
+            return 0;
+        }
+        max_order = std::max(max_order, order);
+    }
+    return max_order;
+}
+
+namespace
+{
+    /**
+     * @brief Call a function on every rat::mdl::calcharmonics node of a JSON tree.
+     */
+    void forEachHarmonicsCalculation(Json::Value &node, const std::function<void(Json::Value &)> &function)
+    {
+        if (node.isObject())
+        {
+            if (node.isMember("type") && node["type"].isString() && node["type"].asString() == "rat::mdl::calcharmonics")
+            {
+                function(node);
+            }
+            for (const std::string &member : node.getMemberNames())
+            {
+                forEachHarmonicsCalculation(node[member], function);
+            }
+        }
+        else if (node.isArray())
+        {
+            for (Json::Value &child : node)
+            {
+                forEachHarmonicsCalculation(child, function);
+            }
+        }
+    }
+
+    /**
+     * @brief Apply a function to the harmonics calculations of a model file, the file is only written if a calculation changed.
+     */
+    void editHarmonicsCalculations(const std::filesystem::path &model_path, const std::function<bool(Json::Value &)> &edit)
+    {
+        std::ifstream in(model_path);
+        Json::Value model;
+        Json::CharReaderBuilder reader;
+        std::string errors;
+        if (!in || !Json::parseFromStream(reader, in, &model, &errors))
+        {
+            throw std::runtime_error("Model file " + model_path.string() + " could not be read: " + errors);
+        }
+        in.close();
+
+        bool changed = false;
+        forEachHarmonicsCalculation(model, [&](Json::Value &calculation)
+                                    { changed = edit(calculation) || changed; });
+        if (!changed)
+        {
+            return;
+        }
+
+        std::ofstream out(model_path);
+        if (!out)
+        {
+            throw std::runtime_error("Model file " + model_path.string() + " could not be written.");
+        }
+        Json::StreamWriterBuilder writer;
+        writer["indentation"] = "\t";
+        out << Json::writeString(writer, model);
+    }
+}
+
+std::map<std::string, Json::Value> ParameterSearch::setHarmonicsOrder(const std::filesystem::path &model_path, size_t max_order)
+{
+    if (max_order == 0)
+    {
+        throw std::invalid_argument("max_order must be greater than 0");
+    }
+
+    std::map<std::string, Json::Value> previous_num_max;
+    editHarmonicsCalculations(model_path, [&](Json::Value &calculation)
+                              {
+        if (calculation["num_max"].isIntegral() && calculation["num_max"].asUInt64() == max_order)
+        {
+            return false;
+        }
+        previous_num_max[calculation["name"].asString()] = calculation["num_max"];
+        calculation["num_max"] = static_cast<Json::Int>(max_order);
+        return true; });
+    return previous_num_max;
+}
+
+void ParameterSearch::restoreHarmonicsOrder(const std::filesystem::path &model_path, const std::map<std::string, Json::Value> &num_max)
+{
+    if (num_max.empty())
+    {
+        return;
+    }
+    editHarmonicsCalculations(model_path, [&](Json::Value &calculation)
+                              {
+        auto previous = num_max.find(calculation["name"].asString());
+        if (previous == num_max.end())
+        {
+            return false;
+        }
+        calculation["num_max"] = previous->second;
+        return true; });
+}
+
+size_t ParameterSearch::getNextShardStep(size_t step_num, size_t num_steps, size_t num_shards)
+{
+    // Compare before adding, the sum can wrap around for grids close to the size_t limit
+    if (num_steps - step_num <= num_shards)
+    {
+        return num_steps;
+    }
+    return step_num + num_shards;
+}
+
+std::vector<std::type_index> ParameterSearch::getStagedCalculations(const std::vector<std::type_index> &required_calculations)
+{
+    auto cost = [](const std::type_index &type)
+    {
+        if (type == std::type_index(typeid(GeometryDataHandler)))
+        {
+            return 0;
+        }
+        if (type == std::type_index(typeid(CCTools::HarmonicsDataHandler)))
+        {
+            return 1;
+        }
+        if (type == std::type_index(typeid(CCTools::MeshDataHandler)))
+        {
+            return 2;
+        }
+        return 3;
+    };
+
+    std::vector<std::type_index> staged_calculations = required_calculations;
+    std::stable_sort(staged_calculations.begin(), staged_calculations.end(), [&](const std::type_index &a, const std::type_index &b)
+                     { return cost(a) < cost(b); });
+    return staged_calculations;
+}
+
 void ParameterSearch::applyParameterConfiguration(std::vector<std::shared_ptr<InputParamRangeInterface>> &inputParamsRanges, std::vector<Json::Value> &next_config, CCTools::ModelHandler &model_handler)
 {
 
@@ -210,51 +1397,98 @@ void ParameterSearch::applyParameterConfiguration(std::vector<std::shared_ptr<In
 
 std::vector<Json::Value> ParameterSearch::getParameterConfiguration(size_t step_num, std::vector<std::vector<Json::Value>> &param_ranges)
 {
-    size_t n = param_ranges.size();
-    if (n == 0)
+    if (param_ranges.size() == 0)
     {
         throw std::invalid_argument("param_ranges cannot be empty");
     }
 
     // Calculate sizes of each parameter range
-    std::vector<size_t> sizes(n);
-    for (size_t i = 0; i < n; ++i)
+    std::vector<size_t> sizes = getRangeSizes(param_ranges);
+    for (size_t size : sizes)
     {
-        sizes[i] = param_ranges[i].size();
-        if (sizes[i] == 0)
+        if (size == 0)
         {
             throw std::invalid_argument("Parameter range cannot be empty");
         }
     }
 
-    // Calculate total number of configurations
-    size_t total_steps = getNumSteps(param_ranges);
+    // Generate parameter configuration based on step_num in lexicographic order
+    GridTraversal traversal(sizes);
+    return getParameterConfiguration(traversal.getIndices(step_num), param_ranges);
+}
+
+std::vector<Json::Value> ParameterSearch::getParameterConfiguration(const std::vector<size_t> &indices, std::vector<std::vector<Json::Value>> &param_ranges)
+{
+    size_t n = param_ranges.size();
+    if (indices.size() != n)
+    {
+        throw std::invalid_argument("Number of indices does not match the number of parameter ranges");
+    }
+
+    std::vector<Json::Value> configuration(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        configuration[i] = param_ranges[i].at(indices[i]);
+    }
+
+    return configuration;
+}
+
+std::vector<Json::Value> ParameterSearch::getParameterConfiguration(const std::vector<size_t> &indices, const std::vector<std::shared_ptr<ParamRange>> &param_ranges)
+{
+    size_t n = param_ranges.size();
+    if (indices.size() != n)
+    {
+        throw std::invalid_argument("Number of indices does not match the number of parameter ranges");
+    }
 
-    if (step_num >= total_steps)
+    std::vector<Json::Value> configuration(n);
+    for (size_t i = 0; i < n; ++i)
     {
-        throw std::out_of_range("step_num exceeds total configurations");
+        configuration[i] = param_ranges[i]->at(indices[i]);
     }
 
-    // Calculate strides
-    std::vector<size_t> strides(n);
-    strides[n - 1] = 1;
-    for (int i = n - 2; i >= 0; --i)
+    return configuration;
+}
+
+std::vector<Json::Value> ParameterSearch::getParameterConfiguration(const std::vector<double> &point, const std::vector<std::shared_ptr<ParamRange>> &param_ranges)
+{
+    size_t n = param_ranges.size();
+    if (point.size() != n)
     {
-        strides[i] = sizes[i + 1] * strides[i + 1];
+        throw std::invalid_argument("Number of coordinates does not match the number of parameter ranges");
     }
 
-    // Generate parameter configuration based on step_num
     std::vector<Json::Value> configuration(n);
     for (size_t i = 0; i < n; ++i)
     {
-        size_t index = (step_num / strides[i]) % sizes[i];
-        configuration[i] = param_ranges[i][index];
+        configuration[i] = param_ranges[i]->sample(point[i]);
     }
 
     return configuration;
 }
 
-std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> ParameterSearch::runCalculations(std::vector<std::type_index> required_calculations, CCTools::ModelCalculator &modelCalculator, CCTools::ModelHandler &modelHandler)
+std::vector<size_t> ParameterSearch::getRangeSizes(const std::vector<std::shared_ptr<ParamRange>> &param_ranges)
+{
+    std::vector<size_t> sizes(param_ranges.size());
+    for (size_t i = 0; i < param_ranges.size(); ++i)
+    {
+        sizes[i] = param_ranges[i]->size();
+    }
+    return sizes;
+}
+
+std::vector<size_t> ParameterSearch::getRangeSizes(const std::vector<std::vector<Json::Value>> &param_ranges)
+{
+    std::vector<size_t> sizes(param_ranges.size());
+    for (size_t i = 0; i < param_ranges.size(); ++i)
+    {
+        sizes[i] = param_ranges[i].size();
+    }
+    return sizes;
+}
+
+std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> ParameterSearch::runCalculations(std::vector<std::type_index> required_calculations, CCTools::ModelCalculator &modelCalculator, CCTools::ModelHandler &modelHandler, size_t max_harmonic_order)
 {
     // Return vector
     std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> calc_results;
@@ -265,9 +1499,25 @@ std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> ParameterSearch::ru
         // Check for harmonics calculation
         if (type == std::type_index(typeid(CCTools::HarmonicsDataHandler)))
         {
+            // Trim the order only for this calculation, the model file is shared with the caller and other searches
+            std::map<std::string, Json::Value> num_max;
+            if (max_harmonic_order > 0)
+            {
+                num_max = setHarmonicsOrder(modelHandler.getTempJsonPath(), max_harmonic_order);
+            }
+
             // Run
             CCTools::HarmonicsDataHandler handler;
-            modelCalculator.reload_and_calc_harmonics(modelHandler.getTempJsonPath(), handler);
+            try
+            {
+                modelCalculator.reload_and_calc_harmonics(modelHandler.getTempJsonPath(), handler);
+            }
+            catch (...)
+            {
+                restoreHarmonicsOrder(modelHandler.getTempJsonPath(), num_max);
+                throw;
+            }
+            restoreHarmonicsOrder(modelHandler.getTempJsonPath(), num_max);
             calc_results.push_back(std::make_shared<CCTools::HarmonicsDataHandler>(handler));
         }
         // Check for mesh calculation
@@ -278,6 +1528,13 @@ std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> ParameterSearch::ru
             modelCalculator.reload_and_calc_mesh(modelHandler.getTempJsonPath(), handler);
             calc_results.push_back(std::make_shared<CCTools::MeshDataHandler>(handler));
         }
+        // Check for geometry calculation
+        else if (type == std::type_index(typeid(GeometryDataHandler)))
+        {
+            // Build the meshes only, no field calculation
+            modelCalculator.reload();
+            calc_results.push_back(std::make_shared<GeometryDataHandler>(modelCalculator.get_model_tree()));
+        }
         else
         {
             std::string type_name = type.name();
@@ -332,16 +1589,13 @@ std::vector<double> ParameterSearch::computeCriteria(std::vector<std::shared_ptr
     return output_values;
 }
 
-void ParameterSearch::writeStepToOutputFile(size_t step_num, std::ofstream &outputFile, std::vector<Json::Value> &input_values, std::vector<double> &output_values)
+void ParameterSearch::writeStepToOutputFile(size_t step_num, std::ofstream &outputFile, std::vector<Json::Value> &input_values, std::vector<double> &output_values, const std::string &status)
 {
     // Write the step number
     outputFile << step_num << ",";
 
-    // Write the input values
-    for (size_t i = 0; i < input_values.size(); i++)
-    {
-        outputFile << input_values[i] << ",";
-    }
+    // Write the input values and derived input values
+    writeInputValues(outputFile, input_values);
 
     // Write the output values
     for (size_t i = 0; i < output_values.size(); i++)
@@ -353,16 +1607,50 @@ void ParameterSearch::writeStepToOutputFile(size_t step_num, std::ofstream &outp
         }
     }
 
+    // Write the status
+    if (!status.empty())
+    {
+        outputFile << "," << status;
+    }
+
     // Write a newline
     outputFile << std::endl;
 }
 
+void ParameterSearch::writeInputColumnNames(std::ostream &out)
+{
+    for (size_t i = 0; i < inputParamsRanges_.size(); i++)
+    {
+        out << inputParamsRanges_[i]->getColumnName() << ",";
+    }
+    for (const auto &derived_input : derived_inputs_)
+    {
+        out << derived_input.first->getColumnName() << ",";
+    }
+}
+
+void ParameterSearch::writeInputValues(std::ostream &out, const std::vector<Json::Value> &input_values)
+{
+    for (size_t i = 0; i < input_values.size(); i++)
+    {
+        inputParamsRanges_[i]->writeValue(out, input_values[i]);
+    }
+    for (const auto &[input, function] : derived_inputs_)
+    {
+        input->writeValue(out, function(input_values));
+    }
+}
+
 void ParameterSearch::closeOutputFile()
 {
     // Close the output file
     if (outputFile_.is_open())
     {
         outputFile_.close();
+        if (num_pruned_steps_ > 0)
+        {
+            Logger::info("Pruned " + std::to_string(num_pruned_steps_) + " infeasible steps before simulation.");
+        }
     }
 }
 
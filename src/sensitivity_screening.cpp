@@ -0,0 +1,123 @@
+#include "sensitivity_screening.h"
+
+SensitivityScreening::SensitivityScreening(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
+                                           std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler,
+                                           size_t num_trajectories, size_t num_levels, uint64_t seed) : ParameterSearch(inputParamsRanges, outputCriteria, modelHandler),
+                                                                                                        num_trajectories_(num_trajectories),
+                                                                                                        num_levels_(num_levels),
+                                                                                                        seed_(seed)
+{
+    if (num_trajectories < 2)
+    {
+        throw std::invalid_argument("num_trajectories must be at least 2");
+    }
+    if (num_levels < 2 || num_levels % 2 != 0)
+    {
+        throw std::invalid_argument("num_levels must be even and at least 2");
+    }
+}
+
+void SensitivityScreening::run()
+{
+    Logger::info("=== Starting sensitivity screening ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    BatchEvaluator evaluate = makeBatchEvaluator(0);
+    size_t num_inputs = inputParamsRanges_.size();
+
+    MorrisDesign design(num_inputs, num_levels_, seed_);
+    std::vector<std::vector<std::vector<double>>> trajectories = design.generate(num_trajectories_);
+    size_t trajectory_length = num_inputs + 1;
+
+    Logger::info("Number of trajectories: " + std::to_string(num_trajectories_) + ", number of steps: " + std::to_string(num_trajectories_ * trajectory_length));
+
+    // Enough trajectories per batch to keep all workers busy
+    size_t trajectories_per_batch = std::max<size_t>(1, (num_workers_ + trajectory_length - 1) / trajectory_length);
+
+    std::vector<std::vector<std::vector<double>>> outputs;
+    for (size_t first = 0; first < trajectories.size(); first += trajectories_per_batch)
+    {
+        size_t count = std::min(trajectories_per_batch, trajectories.size() - first);
+
+        // Only whole trajectories give elementary effects
+        if (!evaluate.allows(trajectory_length))
+        {
+            break;
+        }
+        if (step_budget_ > 0)
+        {
+            count = std::min(count, (step_budget_ - evaluate.getNumEvaluated()) / trajectory_length);
+        }
+
+        std::vector<std::vector<double>> points;
+        for (size_t t = first; t < first + count; t++)
+        {
+            points.insert(points.end(), trajectories[t].begin(), trajectories[t].end());
+        }
+
+        std::vector<std::vector<double>> results = evaluate(points);
+        for (size_t t = 0; t < count; t++)
+        {
+            outputs.emplace_back(results.begin() + t * trajectory_length, results.begin() + (t + 1) * trajectory_length);
+        }
+    }
+    Logger::info("Evaluated " + std::to_string(outputs.size()) + " trajectories.");
+
+    trajectories.resize(outputs.size());
+    statistics_ = MorrisDesign::analyze(trajectories, outputs, outputCriteria_.size());
+
+    // Close the output file
+    closeOutputFile();
+
+    std::string summary_file_path = writeSummaryFile(output_file_path);
+
+    // Log the most important input parameter of each criterion
+    for (size_t o = 0; o < outputCriteria_.size() && !statistics_.empty(); o++)
+    {
+        size_t most_important = 0;
+        for (size_t i = 1; i < statistics_.size(); i++)
+        {
+            if (statistics_[i][o].mu_star > statistics_[most_important][o].mu_star)
+            {
+                most_important = i;
+            }
+        }
+        Logger::info("Most important input parameter for " + outputCriteria_[o]->getColumnName() + ": " + inputParamsRanges_[most_important]->getColumnName() +
+                     " (mu* = " + std::to_string(statistics_[most_important][o].mu_star) + ")");
+    }
+
+    Logger::info("=== Finished sensitivity screening ===");
+    Logger::info("Sensitivity statistics saved to " + summary_file_path);
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+std::vector<std::vector<MorrisStatistics>> SensitivityScreening::getStatistics() const
+{
+    return statistics_;
+}
+
+std::string SensitivityScreening::writeSummaryFile(const std::string &output_file_path)
+{
+    std::string summary_file_path = output_file_path.substr(0, output_file_path.size() - std::string(".csv").size()) + "_morris.csv";
+    std::ofstream summary_file(summary_file_path);
+
+    summary_file << "input,criterion,mu,mu_star,sigma,num_effects" << std::endl;
+    for (size_t i = 0; i < statistics_.size(); i++)
+    {
+        // Zipped input parameters are one input of the screening
+        std::string input_name = inputParamsRanges_[i]->getColumnName();
+        std::replace(input_name.begin(), input_name.end(), ',', '+');
+        for (size_t o = 0; o < statistics_[i].size(); o++)
+        {
+            const MorrisStatistics &s = statistics_[i][o];
+            summary_file << input_name << "," << outputCriteria_[o]->getColumnName() << ","
+                         << s.mu << "," << s.mu_star << "," << s.sigma << "," << s.num_effects << std::endl;
+        }
+    }
+    summary_file.close();
+
+    return summary_file_path;
+}
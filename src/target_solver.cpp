@@ -0,0 +1,175 @@
+#include "target_solver.h"
+
+TargetSolver::TargetSolver(std::vector<std::shared_ptr<InputParamRangeInterface>> inputParamsRanges,
+                           std::vector<std::shared_ptr<OutputCriterionInterface>> outputCriteria, CCTools::ModelHandler &modelHandler,
+                           std::vector<SolveTarget> targets, size_t max_evaluations) : ParameterSearch(inputParamsRanges, outputCriteria, modelHandler),
+                                                                                      targets_(targets),
+                                                                                      max_evaluations_(max_evaluations)
+{
+    if (targets_.empty())
+    {
+        throw std::invalid_argument("At least one target is required");
+    }
+    std::vector<bool> is_varied(inputParamsRanges_.size(), false);
+    for (const SolveTarget &target : targets_)
+    {
+        if (target.input_index >= inputParamsRanges_.size())
+        {
+            throw std::invalid_argument("Target refers to input parameter " + std::to_string(target.input_index) + " which does not exist");
+        }
+        if (target.criterion_index >= outputCriteria_.size())
+        {
+            throw std::invalid_argument("Target refers to criterion " + std::to_string(target.criterion_index) + " which does not exist");
+        }
+        if (is_varied[target.input_index])
+        {
+            throw std::invalid_argument("Input parameter " + inputParamsRanges_[target.input_index]->getColumnName() + " is varied for more than one target");
+        }
+        if (!(target.tolerance > 0.0))
+        {
+            throw std::invalid_argument("Target tolerance must be greater than 0");
+        }
+        is_varied[target.input_index] = true;
+    }
+    std::vector<size_t> varied_inputs;
+    for (const SolveTarget &target : targets_)
+    {
+        varied_inputs.push_back(target.input_index);
+    }
+    checkContinuousInputs(varied_inputs);
+    if (max_evaluations < 1)
+    {
+        throw std::invalid_argument("max_evaluations must be greater than 0");
+    }
+}
+
+void TargetSolver::run()
+{
+    Logger::info("=== Starting target solver ===");
+    Logger::info("Model file: " + modelHandler_.getTempJsonPath().filename().string());
+    for (const SolveTarget &target : targets_)
+    {
+        Logger::info("Target: " + outputCriteria_[target.criterion_index]->getColumnName() + " = " + std::to_string(target.target) + " +/- " + std::to_string(target.tolerance) +
+                     " by varying " + inputParamsRanges_[target.input_index]->getColumnName());
+    }
+
+    // Initialize the output file
+    std::string output_file_path = initOutputFile();
+
+    converged_ = false;
+
+    // Distance to the targets in units of their tolerances
+    auto get_distance = [this](const std::vector<double> &results)
+    {
+        double distance = 0.0;
+        for (const SolveTarget &target : targets_)
+        {
+            distance = std::max(distance, std::abs(results[target.criterion_index] - target.target) / target.tolerance);
+        }
+        return distance;
+    };
+    BatchEvaluator batch_evaluator = makeBatchEvaluator(max_evaluations_, get_distance);
+
+    // Start point in the unit cube, the input parameters that are not varied keep their start values
+    std::vector<double> base_point = getStartPoint();
+
+    // Evaluates the residuals of all targets at points of the unit cube of the varied input parameters
+    auto evaluate = [&](const std::vector<std::vector<double>> &points) -> std::vector<std::vector<double>>
+    {
+        std::vector<std::vector<double>> full_points;
+        for (const std::vector<double> &point : points)
+        {
+            full_points.push_back(base_point);
+            for (size_t t = 0; t < targets_.size(); t++)
+            {
+                full_points.back()[targets_[t].input_index] = point[t];
+            }
+        }
+
+        std::vector<std::vector<double>> results = batch_evaluator(full_points);
+
+        std::vector<std::vector<double>> residuals(results.size());
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            for (size_t t = 0; t < targets_.size() && !results[i].empty(); t++)
+            {
+                residuals[i].push_back(results[i][targets_[t].criterion_index] - targets_[t].target);
+            }
+        }
+        return residuals;
+    };
+
+    // The solvers need the values of all points of a batch
+    auto should_stop = [&](size_t, size_t batch_size) -> bool
+    {
+        return !batch_evaluator.allows(batch_size);
+    };
+
+    if (targets_.size() == 1)
+    {
+        BrentSolver solver(targets_[0].tolerance);
+        solver.setNumScanPoints(std::max<size_t>(num_workers_, 7));
+        solver.solve([&](const std::vector<double> &points)
+                     {
+                         std::vector<std::vector<double>> unit_points;
+                         for (double point : points)
+                         {
+                             unit_points.push_back({point});
+                         }
+                         std::vector<double> values;
+                         for (const std::vector<double> &residuals : evaluate(unit_points))
+                         {
+                             values.push_back(residuals.empty() ? std::numeric_limits<double>::quiet_NaN() : residuals[0]);
+                         }
+                         return values; },
+                     should_stop);
+        converged_ = solver.hasConverged();
+        if (!solver.wasBracketed())
+        {
+            Logger::info("The target is not enclosed by the values over the parameter range.");
+        }
+    }
+    else
+    {
+        std::vector<double> tolerances;
+        std::vector<double> start;
+        for (const SolveTarget &target : targets_)
+        {
+            tolerances.push_back(target.tolerance);
+            start.push_back(base_point[target.input_index]);
+        }
+        BroydenSolver solver(tolerances);
+        solver.solve(start, evaluate, should_stop);
+        converged_ = solver.hasConverged();
+    }
+
+    if (converged_)
+    {
+        Logger::info("All targets reached after " + std::to_string(batch_evaluator.getNumEvaluated()) + " evaluations. Solution at index " + std::to_string(best_index_) + ".");
+    }
+    else
+    {
+        Logger::info("Targets not reached after " + std::to_string(batch_evaluator.getNumEvaluated()) + " evaluations. Closest configuration at index " + std::to_string(best_index_) + ".");
+    }
+
+    // Close the output file
+    closeOutputFile();
+
+    Logger::info("=== Finished target solver ===");
+    Logger::info("All results been saved to the output file " + output_file_path);
+}
+
+bool TargetSolver::hasConverged() const
+{
+    return converged_;
+}
+
+long TargetSolver::getSolutionIndex() const
+{
+    return best_index_;
+}
+
+std::vector<Json::Value> TargetSolver::getSolution() const
+{
+    return best_config_;
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+#include "adaptive_refinement.hh"
+#include <vector>
+#include <set>
+#include <cmath>
+
+TEST(AdaptiveRefinementTest, RefinesAroundThresholdCrossing)
+{
+    AdaptiveRefinement refinement(1, 3);
+    refinement.setThreshold(0.0);
+    refinement.setMinCellSize(1.0 / 1024);
+    refinement.setScoreTolerance(1e9);
+
+    refinement.run([](const std::vector<double> &x)
+                   { return x[0] - 0.3; },
+                   [](size_t) { return false; });
+
+    // Only the cells enclosing the zero crossing are refined, down to the minimum cell size
+    const std::vector<std::vector<double>> &points = refinement.getPoints();
+    double closest = 1.0;
+    for (const auto &point : points)
+    {
+        closest = std::min(closest, std::abs(point[0] - 0.3));
+    }
+    EXPECT_LT(closest, 1.0 / 1024);
+    EXPECT_LT(points.size(), 20);
+    EXPECT_FALSE(refinement.wasStopped());
+}
+
+TEST(AdaptiveRefinementTest, EvaluatesEveryPointOnceAndRespectsStopCondition)
+{
+    AdaptiveRefinement refinement(2, 3);
+
+    size_t num_calls = 0;
+    std::set<std::vector<double>> seen;
+    refinement.run([&](const std::vector<double> &x)
+                   {
+                       num_calls++;
+                       EXPECT_TRUE(seen.insert(x).second);
+                       return std::exp(10 * x[0]) + x[1];
+                   },
+                   [](size_t num_evaluated) { return num_evaluated >= 40; });
+
+    EXPECT_EQ(num_calls, 40);
+    EXPECT_EQ(refinement.getPoints().size(), 40);
+    EXPECT_TRUE(refinement.wasStopped());
+
+    // The steep direction is refined more often than the flat one
+    std::set<double> x0, x1;
+    for (const auto &point : refinement.getPoints())
+    {
+        x0.insert(point[0]);
+        x1.insert(point[1]);
+    }
+    EXPECT_GT(x0.size(), x1.size());
+}
+
+TEST(AdaptiveRefinementTest, FailedPointsAreNotRefined)
+{
+    AdaptiveRefinement refinement(1, 2);
+    refinement.run([](const std::vector<double> &x)
+                   { return x[0] > 0.5 ? std::nan("") : x[0]; },
+                   [](size_t) { return false; });
+
+    EXPECT_EQ(refinement.getPoints().size(), 2);
+    EXPECT_DOUBLE_EQ(refinement.getValue({0.0}), 0.0);
+    EXPECT_THROW(refinement.getValue({0.5}), std::out_of_range);
+    EXPECT_THROW(AdaptiveRefinement(0), std::invalid_argument);
+}
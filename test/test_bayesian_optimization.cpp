@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+#include "gaussian_process.hh"
+#include "bayesian_proposer.hh"
+#include "optimization_objective.hh"
+#include <vector>
+#include <cmath>
+
+TEST(GaussianProcessTest, InterpolatesTrainingData)
+{
+    arma::mat X(6, 1);
+    arma::vec y(6);
+    for (arma::uword i = 0; i < 6; i++)
+    {
+        X(i, 0) = i / 5.0;
+        y(i) = std::sin(6.0 * X(i, 0));
+    }
+
+    GaussianProcess gp;
+    gp.fit(X, y);
+
+    for (arma::uword i = 0; i < 6; i++)
+    {
+        double mean, variance;
+        gp.predict(X.row(i), mean, variance);
+        EXPECT_NEAR(mean, y(i), 0.05);
+        EXPECT_LT(variance, 0.05);
+    }
+
+    // Uncertainty grows away from the data
+    double mean_near, variance_near, mean_far, variance_far;
+    gp.predict(X.row(2), mean_near, variance_near);
+    arma::rowvec far(1);
+    far(0) = 3.0;
+    gp.predict(far, mean_far, variance_far);
+    EXPECT_GT(variance_far, variance_near);
+}
+
+TEST(GaussianProcessTest, InvalidInputsThrow)
+{
+    GaussianProcess gp;
+    arma::rowvec x(1);
+    double mean, variance;
+    EXPECT_THROW(gp.predict(x, mean, variance), std::runtime_error);
+    EXPECT_THROW(gp.fit(arma::mat(3, 1), arma::vec(2)), std::invalid_argument);
+}
+
+TEST(BayesianProposerTest, ExpectedImprovement)
+{
+    // No uncertainty: plain improvement
+    EXPECT_DOUBLE_EQ(BayesianProposer::expectedImprovement(1.0, 0.0, 3.0), 2.0);
+    EXPECT_DOUBLE_EQ(BayesianProposer::expectedImprovement(4.0, 0.0, 3.0), 0.0);
+
+    // Mean at the best value: sigma * phi(0)
+    EXPECT_NEAR(BayesianProposer::expectedImprovement(3.0, 2.0, 3.0), 2.0 / std::sqrt(2.0 * M_PI), 1e-12);
+}
+
+TEST(BayesianProposerTest, FindsConstrainedMinimum)
+{
+    // Minimize (x0 - 0.7)^2 + (x1 - 0.2)^2 subject to x0 <= 0.6, the constrained minimum is at (0.6, 0.2)
+    auto f = [](const std::vector<double> &x)
+    { return (x[0] - 0.7) * (x[0] - 0.7) + (x[1] - 0.2) * (x[1] - 0.2); };
+
+    BayesianProposer proposer(2, 1, 3);
+    for (int batch = 0; batch < 8; batch++)
+    {
+        for (const std::vector<double> &x : proposer.propose(batch == 0 ? 6 : 3))
+        {
+            ASSERT_EQ(x.size(), 2);
+            proposer.addObservation(x, f(x), {0.6 - x[0]});
+        }
+    }
+
+    long best = proposer.getBestObservation();
+    ASSERT_GE(best, 0);
+    EXPECT_NEAR(proposer.getPoint(best)[0], 0.6, 0.05);
+    EXPECT_NEAR(proposer.getPoint(best)[1], 0.2, 0.05);
+    EXPECT_LT(proposer.getObjective(best), 0.02);
+}
+
+TEST(BayesianProposerTest, BatchProposalsAreDistinct)
+{
+    BayesianProposer proposer(1, 0, 5);
+    for (double x : {0.0, 0.3, 0.6, 1.0})
+    {
+        proposer.addObservation({x}, (x - 0.4) * (x - 0.4), {});
+    }
+    proposer.addObservation({0.5}, std::nan(""), {});
+
+    std::vector<std::vector<double>> batch = proposer.propose(3);
+    ASSERT_EQ(batch.size(), 3);
+    EXPECT_NE(batch[0], batch[1]);
+    EXPECT_NE(batch[1], batch[2]);
+    EXPECT_EQ(proposer.getNumObservations(), 4);
+}
+
+TEST(OptimizationObjectiveTest, EvaluatesTermsAndConstraints)
+{
+    OptimizationObjective objective;
+    objective.addTerm(0, 1.0, true);
+    objective.addTerm(1, 2.0, true);
+    objective.addUpperBound(2, 100.0);
+    objective.addLowerBound(0, -5.0);
+
+    std::vector<double> values = {-1.0, 0.5, 120.0};
+    EXPECT_DOUBLE_EQ(objective.evaluate(values), 2.0);
+    EXPECT_EQ(objective.getConstraintSlacks(values), std::vector<double>({-20.0, 4.0}));
+    EXPECT_FALSE(objective.isFeasible(values));
+
+    values[2] = 80.0;
+    EXPECT_TRUE(objective.isFeasible(values));
+
+    EXPECT_NO_THROW(objective.validate(3));
+    EXPECT_THROW(objective.validate(2), std::invalid_argument);
+    EXPECT_THROW(OptimizationObjective().validate(3), std::invalid_argument);
+}
@@ -0,0 +1,45 @@
+#include "gtest/gtest.h"
+#include "failure_predictor.hh"
+#include <vector>
+#include <cmath>
+
+TEST(FailurePredictorTest, PredictsFromNearestObservations)
+{
+    EXPECT_THROW(FailurePredictor(0, 10), std::invalid_argument);
+    EXPECT_THROW(FailurePredictor(5, 4), std::invalid_argument);
+
+    FailurePredictor predictor(3, 4);
+
+    // Failures at the upper end of the range
+    predictor.addObservation({0.0}, false);
+    predictor.addObservation({0.2}, false);
+    predictor.addObservation({0.4}, false);
+    EXPECT_DOUBLE_EQ(predictor.predictFailureProbability({1.0}), 0.0);
+
+    predictor.addObservation({0.8}, true);
+    predictor.addObservation({0.9}, true);
+    EXPECT_EQ(predictor.getNumObservations(), 5u);
+    EXPECT_DOUBLE_EQ(predictor.predictFailureProbability({1.0}), 2.0 / 3.0);
+    EXPECT_DOUBLE_EQ(predictor.predictFailureProbability({0.1}), 0.0);
+
+    EXPECT_THROW(predictor.addObservation({0.5, 0.5}, false), std::invalid_argument);
+}
+
+TEST(FailurePredictorTest, PrecisionAndRecall)
+{
+    FailurePredictionStatistics stats;
+    EXPECT_TRUE(std::isnan(stats.getPrecision()));
+    EXPECT_TRUE(std::isnan(stats.getRecall()));
+
+    stats.add(true, true);
+    stats.add(true, false);
+    stats.add(false, true);
+    stats.add(false, true);
+    stats.add(false, false);
+    EXPECT_EQ(stats.true_positives, 1u);
+    EXPECT_EQ(stats.false_positives, 1u);
+    EXPECT_EQ(stats.false_negatives, 2u);
+    EXPECT_EQ(stats.true_negatives, 1u);
+    EXPECT_DOUBLE_EQ(stats.getPrecision(), 0.5);
+    EXPECT_DOUBLE_EQ(stats.getRecall(), 1.0 / 3.0);
+}
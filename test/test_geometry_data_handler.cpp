@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "geometry_data_handler.h"
+#include "output_max_z.hh"
+#include "output_min_z.hh"
+#include "output_conductor_length.hh"
+
+TEST(GeometryDataHandlerTest, ExtentsCoverAllNodes)
+{
+    GeometryDataHandler handler;
+    EXPECT_THROW(handler.getMinMaxZValues(), std::runtime_error);
+    EXPECT_THROW(handler.getBoundingBox(), std::runtime_error);
+
+    arma::Mat<double> coil1(3, 2);
+    coil1(0, 0) = -0.1;
+    coil1(1, 0) = 0.0;
+    coil1(2, 0) = -0.3;
+    coil1(0, 1) = 0.1;
+    coil1(1, 1) = 0.2;
+    coil1(2, 1) = 0.1;
+    arma::Mat<double> coil2(3, 1);
+    coil2(0, 0) = 0.0;
+    coil2(1, 0) = -0.2;
+    coil2(2, 0) = 0.4;
+    handler.addNodes(coil1);
+    handler.addNodes(coil2);
+
+    std::pair<double, double> z = handler.getMinMaxZValues();
+    EXPECT_DOUBLE_EQ(z.first, -0.3);
+    EXPECT_DOUBLE_EQ(z.second, 0.4);
+
+    CCTools::Cube3D box = handler.getBoundingBox();
+    EXPECT_DOUBLE_EQ(box.x_min, -0.1);
+    EXPECT_DOUBLE_EQ(box.x_max, 0.1);
+    EXPECT_DOUBLE_EQ(box.y_min, -0.2);
+    EXPECT_DOUBLE_EQ(box.y_max, 0.2);
+}
+
+TEST(GeometryDataHandlerTest, CriteriaReadTheGeometry)
+{
+    auto handler = std::make_shared<GeometryDataHandler>();
+    arma::Mat<double> nodes(3, 2);
+    nodes(0, 0) = 0.0;
+    nodes(1, 0) = 0.0;
+    nodes(2, 0) = -0.5;
+    nodes(0, 1) = 0.0;
+    nodes(1, 1) = 0.0;
+    nodes(2, 1) = 0.25;
+    handler->addNodes(nodes);
+    handler->addConductorLength(12.5);
+    handler->addConductorLength(7.5);
+
+    std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> results = {handler};
+    EXPECT_DOUBLE_EQ(OutputMinZ().computeCriterion(results), -0.5);
+    EXPECT_DOUBLE_EQ(OutputMaxZ().computeCriterion(results), 0.25);
+    EXPECT_DOUBLE_EQ(OutputConductorLength().computeCriterion(results), 20.0);
+}
@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+#include "grid_traversal.hh"
+#include <vector>
+#include <set>
+#include <cstdlib>
+
+class GridTraversalTest : public ::testing::Test
+{
+protected:
+    // Setup and teardown can be added here if needed
+};
+
+TEST_F(GridTraversalTest, LexicographicOrderMatchesMixedRadix)
+{
+    GridTraversal traversal({2, 3, 4});
+    ASSERT_EQ(traversal.getNumSteps(), 2u * 3u * 4u);
+
+    for (size_t step = 0; step < traversal.getNumSteps(); step++)
+    {
+        std::vector<size_t> indices = traversal.getIndices(step);
+        EXPECT_EQ(indices[0], step / 12);
+        EXPECT_EQ(indices[1], (step / 4) % 3);
+        EXPECT_EQ(indices[2], step % 4);
+        EXPECT_EQ(traversal.getGridIndex(indices), step);
+    }
+
+    EXPECT_THROW(traversal.getIndices(traversal.getNumSteps()), std::out_of_range);
+}
+
+TEST_F(GridTraversalTest, GrayCodeChangesOneParameterByOnePosition)
+{
+    std::vector<std::vector<size_t>> all_sizes = {{4}, {2, 2}, {3, 1, 4}, {5, 3, 2}, {2, 3, 2, 3}};
+
+    for (const auto &sizes : all_sizes)
+    {
+        GridTraversal traversal(sizes, GRAY_CODE);
+        std::set<size_t> visited;
+
+        std::vector<size_t> previous = traversal.getIndices(0);
+        visited.insert(traversal.getGridIndex(previous));
+
+        for (size_t step = 1; step < traversal.getNumSteps(); step++)
+        {
+            std::vector<size_t> current = traversal.getIndices(step);
+
+            size_t num_changed = 0;
+            for (size_t i = 0; i < sizes.size(); i++)
+            {
+                ASSERT_LT(current[i], sizes[i]);
+                if (current[i] != previous[i])
+                {
+                    num_changed++;
+                    EXPECT_EQ(std::abs(static_cast<long>(current[i]) - static_cast<long>(previous[i])), 1);
+                }
+            }
+            EXPECT_EQ(num_changed, 1u) << "at step " << step;
+
+            visited.insert(traversal.getGridIndex(current));
+            previous = current;
+        }
+
+        // every grid point is visited exactly once
+        EXPECT_EQ(visited.size(), traversal.getNumSteps());
+    }
+}
+
+TEST_F(GridTraversalTest, CoarseToFineVisitsEveryGridPointOnce)
+{
+    std::vector<std::vector<size_t>> all_sizes = {{1}, {9}, {4, 7}, {3, 1, 5}, {2, 3, 2, 6}};
+
+    for (const auto &sizes : all_sizes)
+    {
+        GridTraversal traversal(sizes, COARSE_TO_FINE);
+        std::set<size_t> visited;
+        for (size_t step = 0; step < traversal.getNumSteps(); step++)
+        {
+            std::vector<size_t> indices = traversal.getIndices(step);
+            for (size_t i = 0; i < sizes.size(); i++)
+            {
+                ASSERT_LT(indices[i], sizes[i]);
+            }
+            visited.insert(traversal.getGridIndex(indices));
+        }
+        EXPECT_EQ(visited.size(), traversal.getNumSteps());
+    }
+}
+
+TEST_F(GridTraversalTest, CoarseToFinePrefixCoversWholeSpace)
+{
+    // Bisection order of a single range: 0, 1, 1/2, 1/4, 3/4, ...
+    std::vector<size_t> order = GridTraversal::getBisectionOrder(9);
+    ASSERT_EQ(order.size(), 9u);
+    EXPECT_EQ(order[0], 0u);
+    EXPECT_EQ(order[1], 8u);
+    EXPECT_EQ(order[2], 4u);
+    EXPECT_EQ(order[3], 2u);
+    EXPECT_EQ(order[4], 6u);
+
+    // The first steps of a 9x9 grid are its corners {0, 8} x {0, 8}, then the midpoints are added
+    GridTraversal traversal({9, 9}, COARSE_TO_FINE);
+    std::set<std::vector<size_t>> coarse;
+    for (size_t step = 0; step < 4; step++)
+    {
+        coarse.insert(traversal.getIndices(step));
+    }
+    std::set<std::vector<size_t>> expected = {{0, 0}, {0, 8}, {8, 0}, {8, 8}};
+    EXPECT_EQ(coarse, expected);
+    for (size_t step = 4; step < 9; step++)
+    {
+        coarse.insert(traversal.getIndices(step));
+    }
+    expected = {{0, 0}, {0, 4}, {0, 8}, {4, 0}, {4, 4}, {4, 8}, {8, 0}, {8, 4}, {8, 8}};
+    EXPECT_EQ(coarse, expected);
+
+    // The first quarter of the steps reaches both halves of every range
+    size_t num_prefix = traversal.getNumSteps() / 4;
+    for (size_t i = 0; i < 2; i++)
+    {
+        bool lower_half = false, upper_half = false;
+        for (size_t step = 0; step < num_prefix; step++)
+        {
+            size_t index = traversal.getIndices(step)[i];
+            lower_half |= index < 4;
+            upper_half |= index > 4;
+        }
+        EXPECT_TRUE(lower_half && upper_half);
+    }
+}
+
+TEST_F(GridTraversalTest, ThrowsForInvalidInputs)
+{
+    EXPECT_THROW(GridTraversal({}), std::invalid_argument);
+
+    GridTraversal traversal({2, 2});
+    EXPECT_THROW(traversal.getGridIndex({1}), std::invalid_argument);
+
+    // an empty range yields no steps
+    GridTraversal empty_traversal({3, 0});
+    EXPECT_EQ(empty_traversal.getNumSteps(), 0u);
+}
+
+TEST_F(GridTraversalTest, OverflowingGridThrows)
+{
+    size_t large = static_cast<size_t>(1) << 40;
+    EXPECT_THROW(GridTraversal({large, large}), std::overflow_error);
+
+    // An empty range yields no grid points instead of an overflow
+    GridTraversal empty({large, large, 0});
+    EXPECT_EQ(empty.getNumSteps(), 0);
+}
@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+#include "CustomIterationLog.hh"
+#include "iteration_observer.hh"
+#include <memory>
+#include <sstream>
+
+class IterationLogTest : public ::testing::Test
+{
+protected:
+    // Feed one set of iteration messages to the log as the optimizer does
+    static void logIteration(CustomIterationLog &log, int iter, double fval, double ercf, double lcf, bool with_ccf, double ccf = 0.0)
+    {
+        log.msg("\033[33m%4d\033[0m %12.6e ", iter, fval);
+        log.msg(0, "%12.6e ", ercf);
+        log.msg(0, "\033[31m%12.6e\033[0m ", lcf);
+        if (with_ccf)
+        {
+            log.msg(0, "%12.6e ", ccf);
+        }
+        log.msg("%s", "");
+    }
+};
+
+TEST_F(IterationLogTest, CapturesLastIterationValues)
+{
+    CustomIterationLog log;
+
+    logIteration(log, 1, 10.0, 0.1, 0.2, false);
+    logIteration(log, 2, 5.0, 0.01, 0.02, true, 0.03);
+
+    CustomIterationLog::IterationValues values = log.get_last_iteration_values();
+    EXPECT_EQ(values.iter, 2);
+    EXPECT_DOUBLE_EQ(values.fval, 5.0);
+    EXPECT_DOUBLE_EQ(values.ercf, 0.01);
+    EXPECT_DOUBLE_EQ(values.lcf, 0.02);
+    EXPECT_TRUE(values.has_ccf);
+    EXPECT_DOUBLE_EQ(values.ccf, 0.03);
+}
+
+TEST_F(IterationLogTest, IgnoresUnrelatedMessages)
+{
+    CustomIterationLog log;
+
+    log.msg("%s", "Optimizing control points");
+    log.msg(2, "%s", "");
+    logIteration(log, 7, 1.5, 0.5, 0.25, false);
+    log.msg(-2, "%s", "");
+
+    CustomIterationLog::IterationValues values = log.get_last_iteration_values();
+    EXPECT_EQ(values.iter, 7);
+    EXPECT_DOUBLE_EQ(values.fval, 1.5);
+    EXPECT_FALSE(values.has_ccf);
+}
+
+TEST_F(IterationLogTest, ObserverRecordsHistory)
+{
+    CustomIterationLog log;
+    auto history = std::make_shared<IterationHistory>(2);
+    log.setObserver(history);
+
+    for (int i = 0; i < 5; i++)
+    {
+        logIteration(log, i, 10.0 - i, 0.1 * i, 0.2 * i, i % 2 == 0, 0.3 * i);
+    }
+
+    // the buffer grows beyond its initial capacity
+    ASSERT_EQ(history->size(), 5u);
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(history->at(i).iter, i);
+        EXPECT_DOUBLE_EQ(history->at(i).fval, 10.0 - i);
+        EXPECT_EQ(history->at(i).has_ccf, i % 2 == 0);
+    }
+    EXPECT_EQ(history->last().iter, 4);
+    EXPECT_THROW(history->at(5), std::out_of_range);
+
+    // export as CSV rows
+    std::ostringstream oss;
+    history->writeCSV(oss, "3,");
+    std::istringstream iss(oss.str());
+    std::string line;
+    size_t num_lines = 0;
+    while (std::getline(iss, line))
+    {
+        EXPECT_EQ(line.rfind("3,", 0), 0u);
+        num_lines++;
+    }
+    EXPECT_EQ(num_lines, 5u);
+
+    history->clear();
+    EXPECT_TRUE(history->empty());
+}
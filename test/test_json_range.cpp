@@ -216,3 +216,74 @@ TEST_F(JsonRangeTest, PathConnect2RangeTest){
 
 }
 
+
+TEST_F(JsonRangeTest, PathConnect2DecodeConfigTest){
+    // 8 control points: 7 u, 4 v (from the fifth point) and 1 w (from the eighth point) per set
+    Json::Value x(Json::arrayValue);
+    for (int i = 0; i < 12; i++)
+    {
+        x.append(i < 7 ? 1.0 : 2.0);
+    }
+
+    auto [uvw1, uvw2] = JsonRange::pathconnect2_decode_config(x, 8, true, true);
+    EXPECT_DOUBLE_EQ(uvw1(0, 0), 0.0);
+    EXPECT_DOUBLE_EQ(uvw1(0, 7), 7.0);
+    EXPECT_DOUBLE_EQ(uvw1(1, 3), 0.0);
+    EXPECT_DOUBLE_EQ(uvw1(1, 7), 8.0);
+    EXPECT_DOUBLE_EQ(uvw1(2, 6), 0.0);
+    EXPECT_DOUBLE_EQ(uvw1(2, 7), 2.0);
+    for (arma::uword i = 0; i < 8; i++)
+    {
+        EXPECT_DOUBLE_EQ(uvw2(0, i), uvw1(0, i));
+        EXPECT_DOUBLE_EQ(uvw2(1, i), uvw1(1, i));
+        EXPECT_DOUBLE_EQ(uvw2(2, i), uvw1(2, i));
+    }
+
+    // without w, the last element is not used
+    EXPECT_THROW(JsonRange::pathconnect2_decode_config(x, 8, true, false), std::invalid_argument);
+
+    // the second set follows the first one
+    Json::Value x_asymmetric = x;
+    for (int i = 0; i < 12; i++)
+    {
+        x_asymmetric.append(-1.0);
+    }
+    auto [uvw1_asymmetric, uvw2_asymmetric] = JsonRange::pathconnect2_decode_config(x_asymmetric, 8, false, true);
+    EXPECT_DOUBLE_EQ(uvw1_asymmetric(0, 7), 7.0);
+    EXPECT_DOUBLE_EQ(uvw2_asymmetric(0, 7), -7.0);
+    EXPECT_DOUBLE_EQ(uvw2_asymmetric(2, 7), -1.0);
+    EXPECT_THROW(JsonRange::pathconnect2_decode_config(x_asymmetric, 8, true, true), std::invalid_argument);
+}
+
+TEST_F(JsonRangeTest, PathConnect2ApplyConfigTest){
+    // SetUp
+    std::string filepath = TEST_DATA_DIR + "sext_test.json";
+    CCTools::ModelHandler modelHandler(filepath);
+    CCTools::ModelCalculator modelCalculator(modelHandler.getTempJsonPath());
+    rat::mdl::ShModelGroupPr model_tree = modelCalculator.get_model_tree();
+    rat::mdl::ShPathConnect2Pr connectV2 = JsonRangeTest::findConnectV2(model_tree);
+
+    std::vector<Json::Value> configs = JsonRange::pathconnect2_range(connectV2, 5);
+
+    // applying a config must yield the same x vector
+    for (const auto &config : configs)
+    {
+        ASSERT_NO_THROW({
+            JsonRange::pathconnect2_apply_config(connectV2, config);
+        });
+
+        std::vector<double> x = connectV2->get_x0();
+        ASSERT_EQ(x.size(), config.size());
+        for (Json::ArrayIndex i = 0; i < config.size(); i++)
+        {
+            EXPECT_NEAR(x[i], config[i].asDouble(), 1e-12);
+        }
+    }
+
+    // configs of the wrong size must be rejected
+    Json::Value invalid_config(Json::arrayValue);
+    invalid_config.append(0.0);
+    EXPECT_THROW({
+        JsonRange::pathconnect2_apply_config(connectV2, invalid_config);
+    }, std::invalid_argument);
+}
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "lbfgsb.hh"
+#include <vector>
+#include <cmath>
+#include <random>
+
+namespace
+{
+    LBFGSB::BatchEvaluator makeEvaluator(std::function<double(const std::vector<double> &)> f, size_t &num_batches)
+    {
+        return [f, &num_batches](const std::vector<std::vector<double>> &points)
+        {
+            num_batches++;
+            std::vector<double> values;
+            for (const std::vector<double> &x : points)
+            {
+                values.push_back(f(x));
+            }
+            return values;
+        };
+    }
+
+    bool neverStop(size_t, size_t)
+    {
+        return false;
+    }
+}
+
+TEST(LBFGSBTest, MinimizesQuadraticWithBatchedGradients)
+{
+    auto f = [](const std::vector<double> &x)
+    { return (x[0] - 0.3) * (x[0] - 0.3) + 10.0 * (x[1] - 0.6) * (x[1] - 0.6) + (x[0] - 0.3) * (x[1] - 0.6); };
+
+    size_t num_batches = 0;
+    LBFGSB lbfgsb(2);
+    lbfgsb.minimize({0.9, 0.1}, makeEvaluator(f, num_batches), neverStop);
+
+    EXPECT_TRUE(lbfgsb.hasConverged());
+    EXPECT_NEAR(lbfgsb.getBestPoint()[0], 0.3, 1e-3);
+    EXPECT_NEAR(lbfgsb.getBestPoint()[1], 0.6, 1e-3);
+    EXPECT_LT(lbfgsb.getBestValue(), 1e-6);
+
+    // Every gradient is one batch, so there are far fewer batches than evaluations
+    EXPECT_LT(num_batches * 2, lbfgsb.getNumEvaluations());
+}
+
+TEST(LBFGSBTest, StopsAtActiveBound)
+{
+    // Unconstrained minimum at (1.5, 0.4), the bounded minimum is at (1, 0.4)
+    auto f = [](const std::vector<double> &x)
+    { return (x[0] - 1.5) * (x[0] - 1.5) + (x[1] - 0.4) * (x[1] - 0.4); };
+
+    size_t num_batches = 0;
+    LBFGSB lbfgsb(2);
+    lbfgsb.setLineSearchBatchSize(4);
+    lbfgsb.minimize({0.2, 0.9}, makeEvaluator(f, num_batches), neverStop);
+
+    EXPECT_NEAR(lbfgsb.getBestPoint()[0], 1.0, 1e-9);
+    EXPECT_NEAR(lbfgsb.getBestPoint()[1], 0.4, 1e-3);
+}
+
+TEST(LBFGSBTest, AdaptsPerturbationToNoise)
+{
+    // Quadratic with deterministic noise of amplitude 1e-6
+    auto f = [](const std::vector<double> &x)
+    { return (x[0] - 0.5) * (x[0] - 0.5) + 1e-6 * std::sin(1e7 * x[0]); };
+
+    size_t num_batches = 0;
+    LBFGSB lbfgsb(1);
+    lbfgsb.setFiniteDifferenceStep(0, 1e-6);
+    lbfgsb.minimize({0.1}, makeEvaluator(f, num_batches), neverStop);
+
+    EXPECT_GT(lbfgsb.getNoiseLevel(), 1e-7);
+    EXPECT_LT(lbfgsb.getNoiseLevel(), 1e-5);
+    EXPECT_GT(lbfgsb.getFiniteDifferenceSteps()[0], 1e-6);
+    EXPECT_NEAR(lbfgsb.getBestPoint()[0], 0.5, 1e-2);
+}
+
+TEST(LBFGSBTest, EstimateNoise)
+{
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> normal(0.0, 1e-3);
+    std::vector<double> values;
+    for (int i = 0; i < 7; i++)
+    {
+        values.push_back(2.0 + 0.1 * i + normal(rng));
+    }
+    double noise = LBFGSB::estimateNoise(values);
+    EXPECT_GT(noise, 2e-4);
+    EXPECT_LT(noise, 5e-3);
+
+    // A straight line has no noise
+    EXPECT_NEAR(LBFGSB::estimateNoise({1.0, 2.0, 3.0, 4.0, 5.0}), 0.0, 1e-12);
+    EXPECT_TRUE(std::isnan(LBFGSB::estimateNoise({1.0, NAN, 3.0, 4.0})));
+}
+
+TEST(LBFGSBTest, RespectsStopCondition)
+{
+    auto f = [](const std::vector<double> &x)
+    { return x[0] * x[0]; };
+
+    size_t num_batches = 0;
+    LBFGSB lbfgsb(1);
+    lbfgsb.minimize({0.9}, makeEvaluator(f, num_batches), [](size_t evaluated, size_t batch_size)
+                    { return evaluated + batch_size > 12; });
+
+    EXPECT_LE(lbfgsb.getNumEvaluations(), 12u);
+    EXPECT_FALSE(lbfgsb.hasConverged());
+    EXPECT_THROW(lbfgsb.setFiniteDifferenceStep(1, 1e-3), std::out_of_range);
+    EXPECT_THROW(lbfgsb.setFiniteDifferenceStep(0, 0.5), std::invalid_argument);
+}
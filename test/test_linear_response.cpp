@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "linear_response.hh"
+#include <vector>
+#include <cmath>
+
+namespace
+{
+    // Linear model of two multipoles responding to two scaling values
+    std::vector<double> multipoles(const std::vector<double> &x)
+    {
+        return {0.3 + 2.0 * x[0] - 0.5 * x[1], -0.1 + 0.4 * x[0] + 1.5 * x[1]};
+    }
+
+    LinearResponse measure(const std::vector<double> &x, const std::vector<double> &steps)
+    {
+        std::vector<std::vector<double>> perturbed;
+        for (size_t j = 0; j < x.size(); j++)
+        {
+            std::vector<double> point = x;
+            point[j] += steps[j];
+            perturbed.push_back(multipoles(point));
+        }
+        LinearResponse response(2, 2);
+        response.setFromDifferences(x, multipoles(x), steps, perturbed);
+        return response;
+    }
+}
+
+TEST(LinearResponseTest, CancelsLinearHarmonicsInOneStep)
+{
+    std::vector<double> x = {0.0, 0.0};
+    LinearResponse response = measure(x, {0.1, -0.1});
+
+    EXPECT_NEAR(response.getJacobian()(0, 0), 2.0, 1e-12);
+    EXPECT_NEAR(response.getJacobian()(1, 1), 1.5, 1e-12);
+
+    std::vector<double> solution = response.solve(x, multipoles(x), {0.0, 0.0}, {-1.0, -1.0}, {1.0, 1.0});
+    std::vector<double> y = multipoles(solution);
+    EXPECT_NEAR(y[0], 0.0, 1e-9);
+    EXPECT_NEAR(y[1], 0.0, 1e-9);
+}
+
+TEST(LinearResponseTest, KeepsInputsWithinBounds)
+{
+    // The unconstrained solution needs x0 < -0.1, x0 is held at the bound and x1 takes over
+    std::vector<double> x = {0.0, 0.0};
+    LinearResponse response = measure(x, {0.1, 0.1});
+
+    std::vector<double> solution = response.solve(x, multipoles(x), {0.0, 0.0}, {-0.1, -1.0}, {1.0, 1.0});
+    EXPECT_DOUBLE_EQ(solution[0], -0.1);
+    EXPECT_GE(solution[1], -1.0);
+    EXPECT_LE(solution[1], 1.0);
+}
+
+TEST(LinearResponseTest, LeastSquaresAndMinimumNorm)
+{
+    // One input, two outputs: least squares
+    LinearResponse tall(1, 2);
+    tall.setFromDifferences({0.0}, {1.0, 1.0}, {1.0}, {{2.0, 3.0}});
+    std::vector<double> solution = tall.solve({0.0}, {1.0, 1.0}, {0.0, 0.0}, {-10.0}, {10.0});
+    EXPECT_NEAR(solution[0], -(1.0 + 2.0) / (1.0 + 4.0), 1e-9);
+
+    // Two inputs, one output: minimum-norm step
+    LinearResponse wide(2, 1);
+    wide.setFromDifferences({0.0, 0.0}, {1.0}, {1.0, 1.0}, {{2.0}, {2.0}});
+    solution = wide.solve({0.0, 0.0}, {1.0}, {0.0}, {-10.0, -10.0}, {10.0, 10.0});
+    EXPECT_NEAR(solution[0], -0.5, 1e-9);
+    EXPECT_NEAR(solution[1], -0.5, 1e-9);
+}
+
+TEST(LinearResponseTest, InvalidUseThrows)
+{
+    LinearResponse response(2, 2);
+    EXPECT_FALSE(response.hasJacobian());
+    EXPECT_THROW(response.solve({0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {1.0, 1.0}), std::runtime_error);
+    EXPECT_THROW(response.setFromDifferences({0.0}, {0.0, 0.0}, {1.0}, {{0.0, 0.0}}), std::invalid_argument);
+    EXPECT_THROW(response.setFromDifferences({0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}, {{0.0, 0.0}, {0.0, 0.0}}), std::invalid_argument);
+    EXPECT_THROW(LinearResponse(0, 1), std::invalid_argument);
+}
@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+#include "nelder_mead.hh"
+#include "cma_es.hh"
+#include <vector>
+#include <memory>
+#include <cmath>
+
+// Separable quadratic with its minimum at (0.3, 0.4, 0.5)
+static double quadratic(const std::vector<double> &x)
+{
+    double value = 0.0;
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        double d = x[i] - 0.3 - 0.1 * i;
+        value += (i + 1) * d * d;
+    }
+    return value;
+}
+
+// Run an optimizer until it converges or the budget is spent, returns the number of evaluations
+static size_t runOptimizer(LocalOptimizer &optimizer, double (*f)(const std::vector<double> &), size_t budget)
+{
+    size_t num_evaluated = 0;
+    while (!optimizer.hasConverged() && num_evaluated < budget)
+    {
+        std::vector<std::vector<double>> points = optimizer.ask();
+        std::vector<double> values;
+        for (const std::vector<double> &x : points)
+        {
+            for (double xi : x)
+            {
+                EXPECT_GE(xi, 0.0);
+                EXPECT_LE(xi, 1.0);
+            }
+            values.push_back(f(x));
+        }
+        optimizer.tell(values);
+        num_evaluated += points.size();
+    }
+    return num_evaluated;
+}
+
+TEST(LocalOptimizerTest, NelderMeadConvergesOnQuadratic)
+{
+    NelderMead optimizer({0.5, 0.5, 0.5}, 0.1);
+    size_t num_evaluated = runOptimizer(optimizer, quadratic, 1000);
+
+    EXPECT_TRUE(optimizer.hasConverged());
+    EXPECT_LT(num_evaluated, 500);
+    EXPECT_NEAR(optimizer.getBestPoint()[0], 0.3, 1e-3);
+    EXPECT_NEAR(optimizer.getBestPoint()[2], 0.5, 1e-3);
+}
+
+TEST(LocalOptimizerTest, CMAESConvergesOnQuadraticWithFullPopulations)
+{
+    CMAES optimizer({0.5, 0.5, 0.5}, 0.2, 1);
+    EXPECT_EQ(optimizer.getPopulationSize(), 7);
+    EXPECT_EQ(optimizer.ask().size(), 7);
+    EXPECT_THROW(optimizer.tell({1.0}), std::invalid_argument);
+
+    runOptimizer(optimizer, quadratic, 3000);
+
+    EXPECT_TRUE(optimizer.hasConverged());
+    EXPECT_NEAR(optimizer.getBestPoint()[1], 0.4, 1e-3);
+    EXPECT_LT(optimizer.getBestValue(), 1e-6);
+}
+
+TEST(LocalOptimizerTest, OptimizersRespectBoundsAndFailures)
+{
+    // Minimum outside the unit cube, failed evaluations above 0.9
+    auto f = [](const std::vector<double> &x)
+    { return x[0] > 0.9 ? std::nan("") : (x[0] + 0.5) * (x[0] + 0.5); };
+
+    std::vector<std::unique_ptr<LocalOptimizer>> optimizers;
+    optimizers.push_back(std::make_unique<NelderMead>(std::vector<double>{0.8}, 0.15));
+    optimizers.push_back(std::make_unique<CMAES>(std::vector<double>{0.8}, 0.3, 2));
+    for (auto &optimizer : optimizers)
+    {
+        size_t num_evaluated = 0;
+        while (!optimizer->hasConverged() && num_evaluated < 2000)
+        {
+            std::vector<std::vector<double>> points = optimizer->ask();
+            std::vector<double> values;
+            for (const std::vector<double> &x : points)
+            {
+                values.push_back(f(x));
+            }
+            optimizer->tell(values);
+            num_evaluated += points.size();
+        }
+        EXPECT_NEAR(optimizer->getBestPoint()[0], 0.0, 1e-3);
+    }
+}
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include "morris_design.hh"
+#include <vector>
+#include <cmath>
+
+TEST(MorrisDesignTest, TrajectoriesMoveEachDimensionOnce)
+{
+    MorrisDesign design(3, 4, 1);
+    double delta = design.getDelta();
+    EXPECT_NEAR(delta, 2.0 / 3.0, 1e-12);
+
+    std::vector<std::vector<std::vector<double>>> trajectories = design.generate(10);
+    ASSERT_EQ(trajectories.size(), 10u);
+    for (const auto &trajectory : trajectories)
+    {
+        ASSERT_EQ(trajectory.size(), 4u);
+        std::vector<int> moved(3, 0);
+        for (size_t k = 0; k + 1 < trajectory.size(); k++)
+        {
+            for (size_t i = 0; i < 3; i++)
+            {
+                double step = trajectory[k + 1][i] - trajectory[k][i];
+                if (step != 0.0)
+                {
+                    EXPECT_NEAR(std::abs(step), delta, 1e-12);
+                    moved[i]++;
+                }
+                EXPECT_GE(trajectory[k + 1][i], 0.0);
+                EXPECT_LE(trajectory[k + 1][i], 1.0);
+            }
+        }
+        EXPECT_EQ(moved, (std::vector<int>{1, 1, 1}));
+    }
+
+    EXPECT_THROW(MorrisDesign(0), std::invalid_argument);
+    EXPECT_THROW(MorrisDesign(2, 3), std::invalid_argument);
+}
+
+TEST(MorrisDesignTest, AnalyzeRanksInputs)
+{
+    // y0 = 4 x0 + x1^2, y1 = x0 * x2; x1 is nonlinear, x2 only matters for y1
+    MorrisDesign design(3, 4, 7);
+    std::vector<std::vector<std::vector<double>>> trajectories = design.generate(20);
+    std::vector<std::vector<std::vector<double>>> outputs;
+    for (const auto &trajectory : trajectories)
+    {
+        std::vector<std::vector<double>> values;
+        for (const auto &x : trajectory)
+        {
+            values.push_back({4.0 * x[0] + x[1] * x[1], x[0] * x[2]});
+        }
+        outputs.push_back(values);
+    }
+
+    std::vector<std::vector<MorrisStatistics>> statistics = MorrisDesign::analyze(trajectories, outputs, 2);
+    ASSERT_EQ(statistics.size(), 3u);
+
+    EXPECT_NEAR(statistics[0][0].mu_star, 4.0, 1e-9);
+    EXPECT_NEAR(statistics[0][0].mu, 4.0, 1e-9);
+    EXPECT_NEAR(statistics[0][0].sigma, 0.0, 1e-9);
+    EXPECT_EQ(statistics[0][0].num_effects, 20u);
+    EXPECT_GT(statistics[1][0].sigma, 0.0);
+    EXPECT_LT(statistics[1][0].mu_star, statistics[0][0].mu_star);
+    EXPECT_NEAR(statistics[2][0].mu_star, 0.0, 1e-12);
+    EXPECT_GT(statistics[2][1].mu_star, 0.0);
+}
+
+TEST(MorrisDesignTest, AnalyzeSkipsFailedEvaluations)
+{
+    MorrisDesign design(2, 4, 3);
+    std::vector<std::vector<std::vector<double>>> trajectories = design.generate(2);
+    std::vector<std::vector<std::vector<double>>> outputs(2);
+    for (size_t t = 0; t < 2; t++)
+    {
+        for (const auto &x : trajectories[t])
+        {
+            outputs[t].push_back({x[0] + x[1]});
+        }
+    }
+    // The failed middle point removes both effects of the first trajectory
+    outputs[0][1].clear();
+
+    std::vector<std::vector<MorrisStatistics>> statistics = MorrisDesign::analyze(trajectories, outputs, 1);
+    EXPECT_EQ(statistics[0][0].num_effects + statistics[1][0].num_effects, 2u);
+
+    outputs[1][1].clear();
+    statistics = MorrisDesign::analyze(trajectories, outputs, 1);
+    EXPECT_EQ(statistics[0][0].num_effects, 0u);
+    EXPECT_TRUE(std::isnan(statistics[0][0].mu_star));
+}
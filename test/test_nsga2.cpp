@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "nsga2.hh"
+#include <vector>
+#include <cmath>
+
+TEST(NSGA2Test, Dominates)
+{
+    EXPECT_TRUE(NSGA2::dominates({1.0, 2.0}, 0.0, {1.0, 3.0}, 0.0));
+    EXPECT_FALSE(NSGA2::dominates({1.0, 2.0}, 0.0, {1.0, 2.0}, 0.0));
+    EXPECT_FALSE(NSGA2::dominates({1.0, 3.0}, 0.0, {2.0, 2.0}, 0.0));
+
+    // Feasible dominates infeasible, smaller violation dominates larger
+    EXPECT_TRUE(NSGA2::dominates({5.0, 5.0}, 0.0, {1.0, 1.0}, 0.1));
+    EXPECT_TRUE(NSGA2::dominates({5.0, 5.0}, 0.1, {1.0, 1.0}, 0.2));
+    EXPECT_FALSE(NSGA2::dominates({1.0, 1.0}, INFINITY, {5.0, 5.0}, 0.2));
+}
+
+TEST(NSGA2Test, NonDominatedSortAndCrowding)
+{
+    std::vector<std::vector<double>> objectives = {{1.0, 4.0}, {2.0, 2.0}, {4.0, 1.0}, {3.0, 3.0}, {5.0, 5.0}};
+    std::vector<std::vector<size_t>> fronts = NSGA2::nonDominatedSort(objectives, std::vector<double>(5, 0.0));
+
+    ASSERT_EQ(fronts.size(), 3u);
+    EXPECT_EQ(fronts[0], (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(fronts[1], (std::vector<size_t>{3}));
+    EXPECT_EQ(fronts[2], (std::vector<size_t>{4}));
+
+    std::vector<double> distances = NSGA2::crowdingDistance(fronts[0], objectives);
+    EXPECT_TRUE(std::isinf(distances[0]));
+    EXPECT_NEAR(distances[1], 1.0 + 1.0, 1e-12);
+    EXPECT_TRUE(std::isinf(distances[2]));
+}
+
+TEST(NSGA2Test, ApproximatesParetoFront)
+{
+    // Schaffer-like problem on [0, 1]^2: f1 = x0, f2 = (1 - x0)^2 + x1, the Pareto front has x1 = 0
+    NSGA2 nsga2(2, 20, 7);
+    for (int generation = 0; generation < 30; generation++)
+    {
+        std::vector<std::vector<double>> points = nsga2.ask();
+        ASSERT_EQ(points.size(), 20u);
+
+        std::vector<std::vector<double>> objectives;
+        for (const std::vector<double> &x : points)
+        {
+            EXPECT_GE(x[0], 0.0);
+            EXPECT_LE(x[1], 1.0);
+            objectives.push_back({x[0], (1.0 - x[0]) * (1.0 - x[0]) + x[1]});
+        }
+        nsga2.tell(objectives, std::vector<double>(points.size(), 0.0));
+    }
+    EXPECT_EQ(nsga2.getGeneration(), 30u);
+
+    // The offspring of the converged population lie close to the front and spread along it
+    std::vector<std::vector<double>> points = nsga2.ask();
+    double mean_x1 = 0.0;
+    double min_x0 = 1.0, max_x0 = 0.0;
+    for (const std::vector<double> &x : points)
+    {
+        mean_x1 += x[1] / points.size();
+        min_x0 = std::min(min_x0, x[0]);
+        max_x0 = std::max(max_x0, x[0]);
+    }
+    EXPECT_LT(mean_x1, 0.05);
+    EXPECT_GT(max_x0 - min_x0, 0.5);
+}
+
+TEST(NSGA2Test, InvalidArgumentsThrow)
+{
+    EXPECT_THROW(NSGA2(0, 10, 0), std::invalid_argument);
+    EXPECT_THROW(NSGA2(2, 3, 0), std::invalid_argument);
+
+    NSGA2 nsga2(2, 4, 0);
+    nsga2.ask();
+    EXPECT_THROW(nsga2.tell({{1.0, 1.0}}, {0.0}), std::invalid_argument);
+}
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include "param_range.hh"
+#include "json_range.hh"
+#include <json/json.h>
+#include <vector>
+#include <memory>
+
+TEST(ParamRangeTest, LinearRangeMatchesDoubleLinear)
+{
+    std::vector<Json::Value> expected = JsonRange::double_linear(1.0, 2.0, 5);
+    LinearParamRange range(1.0, 2.0, 5);
+
+    ASSERT_EQ(range.size(), expected.size());
+    for (size_t i = 0; i < range.size(); i++)
+    {
+        EXPECT_DOUBLE_EQ(range.at(i).asDouble(), expected[i].asDouble());
+    }
+    EXPECT_THROW(range.at(5), std::out_of_range);
+}
+
+TEST(ParamRangeTest, LinearRangeHandlesLargeSizesWithoutMaterializing)
+{
+    size_t num_steps = static_cast<size_t>(1) << 40;
+    LinearParamRange range(0.0, 1.0, num_steps);
+
+    EXPECT_EQ(range.size(), num_steps);
+    EXPECT_DOUBLE_EQ(range.at(0).asDouble(), 0.0);
+    EXPECT_DOUBLE_EQ(range.at(num_steps - 1).asDouble(), 1.0);
+}
+
+TEST(ParamRangeTest, LinearRangeInvalidInputsThrow)
+{
+    EXPECT_THROW(LinearParamRange(0.0, 1.0, 1), std::invalid_argument);
+    EXPECT_THROW(LinearParamRange(1.0, 0.0, 3), std::invalid_argument);
+}
+
+TEST(ParamRangeTest, GeometricRangeHasConstantRatio)
+{
+    GeometricParamRange range(1.0, 1000.0, 4);
+
+    ASSERT_EQ(range.size(), 4);
+    EXPECT_DOUBLE_EQ(range.at(0).asDouble(), 1.0);
+    EXPECT_NEAR(range.at(1).asDouble(), 10.0, 1e-12);
+    EXPECT_NEAR(range.at(2).asDouble(), 100.0, 1e-10);
+    EXPECT_DOUBLE_EQ(range.at(3).asDouble(), 1000.0);
+
+    EXPECT_THROW(GeometricParamRange(0.0, 1.0, 3), std::invalid_argument);
+    EXPECT_THROW(GeometricParamRange(-1.0, 1.0, 3), std::invalid_argument);
+}
+
+TEST(ParamRangeTest, ScaledRangeScalesValues)
+{
+    auto base = std::make_shared<LinearParamRange>(0.0, 10.0, 3);
+    ScaledParamRange range(base, 1.0 / 1000);
+
+    ASSERT_EQ(range.size(), 3);
+    EXPECT_DOUBLE_EQ(range.at(1).asDouble(), 0.005);
+    EXPECT_THROW(ScaledParamRange(nullptr, 1.0), std::invalid_argument);
+}
+
+TEST(ParamRangeTest, ListRangeMaterializesValues)
+{
+    std::vector<Json::Value> values = {Json::Value(1), Json::Value("a"), Json::Value(true)};
+    ListParamRange range(values);
+
+    EXPECT_EQ(range.materialize(), values);
+    EXPECT_THROW(range.at(3), std::out_of_range);
+}
+
+TEST(ParamRangeTest, SampleMapsUnitIntervalToRange)
+{
+    LinearParamRange linear(1.0, 3.0, 3);
+    EXPECT_DOUBLE_EQ(linear.sample(0.0).asDouble(), 1.0);
+    EXPECT_DOUBLE_EQ(linear.sample(0.3).asDouble(), 1.6);
+    EXPECT_DOUBLE_EQ(linear.sample(2.0).asDouble(), 3.0);
+
+    GeometricParamRange geometric(1.0, 100.0, 3);
+    EXPECT_NEAR(geometric.sample(0.5).asDouble(), 10.0, 1e-12);
+
+    ScaledParamRange scaled(std::make_shared<LinearParamRange>(0.0, 10.0, 2), 0.1);
+    EXPECT_DOUBLE_EQ(scaled.sample(0.5).asDouble(), 0.5);
+
+    ListParamRange list({Json::Value("a"), Json::Value("b"), Json::Value("c")});
+    EXPECT_EQ(list.sample(0.0).asString(), "a");
+    EXPECT_EQ(list.sample(0.5).asString(), "b");
+    EXPECT_EQ(list.sample(1.0).asString(), "c");
+
+    EXPECT_THROW(ListParamRange({}).sample(0.5), std::out_of_range);
+}
+
+TEST(ParamRangeTest, GetUnitPositionInvertsSample)
+{
+    LinearParamRange linear(1.0, 3.0, 3);
+    EXPECT_DOUBLE_EQ(linear.getUnitPosition(linear.sample(0.3)), 0.3);
+
+    GeometricParamRange geometric(1.0, 100.0, 3);
+    EXPECT_NEAR(geometric.getUnitPosition(Json::Value(10.0)), 0.5, 1e-12);
+
+    ScaledParamRange scaled(std::make_shared<LinearParamRange>(0.0, 10.0, 2), 0.1);
+    EXPECT_DOUBLE_EQ(scaled.getUnitPosition(Json::Value(0.25)), 0.25);
+
+    // Dividing 7.3 deg in [rad] by the factor does not give 7.3 exactly
+    const double deg = std::acos(-1.0) / 180.0;
+    ScaledParamRange scaled_list(std::make_shared<ListParamRange>(std::vector<Json::Value>{Json::Value(7.1), Json::Value(7.3)}), deg);
+    ASSERT_NE(scaled_list.at(1).asDouble() / deg, 7.3);
+    EXPECT_DOUBLE_EQ(scaled_list.getUnitPosition(scaled_list.at(1)), 0.75);
+    EXPECT_THROW(scaled_list.getUnitPosition(Json::Value(7.2 * deg)), std::invalid_argument);
+
+    ListParamRange list({Json::Value("a"), Json::Value("b")});
+    EXPECT_DOUBLE_EQ(list.getUnitPosition(Json::Value("b")), 0.75);
+    EXPECT_EQ(list.sample(list.getUnitPosition(Json::Value("b"))).asString(), "b");
+    EXPECT_THROW(list.getUnitPosition(Json::Value("c")), std::invalid_argument);
+}
+
+TEST(ParamRangeTest, OnlyLinearAndGeometricRangesAreContinuous)
+{
+    auto linear = std::make_shared<LinearParamRange>(1.0, 3.0, 3);
+    auto list = std::make_shared<ListParamRange>(std::vector<Json::Value>{Json::Value(1.0), Json::Value(2.0), Json::Value(3.0)});
+
+    EXPECT_TRUE(linear->isContinuous());
+    EXPECT_TRUE(GeometricParamRange(1.0, 100.0, 3).isContinuous());
+    EXPECT_FALSE(list->isContinuous());
+    EXPECT_TRUE(ScaledParamRange(linear, 0.1).isContinuous());
+    EXPECT_FALSE(ScaledParamRange(list, 0.1).isContinuous());
+    EXPECT_TRUE(ZippedParamRange({linear, linear}).isContinuous());
+    EXPECT_FALSE(ZippedParamRange({linear, list}).isContinuous());
+}
+
+TEST(ParamRangeTest, ZippedRangeAdvancesInLockstep)
+{
+    ZippedParamRange zipped({std::make_shared<LinearParamRange>(1.0, 3.0, 3), std::make_shared<ListParamRange>(std::vector<Json::Value>{Json::Value("a"), Json::Value("b"), Json::Value("c")})});
+    ASSERT_EQ(zipped.size(), 3);
+    EXPECT_DOUBLE_EQ(zipped.at(1)[0].asDouble(), 2.0);
+    EXPECT_EQ(zipped.at(1)[1].asString(), "b");
+    EXPECT_THROW(zipped.at(3), std::out_of_range);
+
+    Json::Value sampled = zipped.sample(1.0);
+    EXPECT_DOUBLE_EQ(sampled[0].asDouble(), 3.0);
+    EXPECT_EQ(sampled[1].asString(), "c");
+    EXPECT_DOUBLE_EQ(zipped.getUnitPosition(zipped.sample(0.25)), 0.25);
+
+    EXPECT_THROW(ZippedParamRange({}), std::invalid_argument);
+    EXPECT_THROW(ZippedParamRange({std::make_shared<LinearParamRange>(1.0, 3.0, 3), std::make_shared<LinearParamRange>(1.0, 3.0, 2)}), std::invalid_argument);
+}
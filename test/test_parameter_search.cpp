@@ -1,5 +1,17 @@
 #include "gtest/gtest.h"
 #include "parameter_search.h"
+#include "adaptive_parameter_search.h"
+#include "bayesian_optimizer.h"
+#include "parameter_optimizer.h"
+#include "multi_objective_search.h"
+#include "gradient_optimizer.h"
+#include "target_solver.h"
+#include "harmonic_correction.h"
+#include "sensitivity_screening.h"
+#include "multi_fidelity_search.h"
+#include "fmm_tuner.h"
+#include "input_fmm_setting.hh"
+#include "input_zipped.hh"
 #include "input_layer_pitch.hh"
 #include "input_param_range_interface.h"
 #include "input_multipole_scaling.hh"
@@ -11,13 +23,17 @@
 #include "constants.h"
 #include "model_handler.h"
 #include "model_calculator.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <typeindex>
+#include <unistd.h>
 #include <output_max_z.hh>
 #include <output_min_z.hh>
+#include <output_conductor_length.hh>
 #include <output_max_von_mises.hh>
 #include <input_cct_winding_angle.hh>
 #include <input_pathconnectv2_uvw.hh>
@@ -25,23 +41,77 @@
 #include <rat/models/modelclip.hh>
 #include <json_range.hh>
 #include <output_pathconnectv2_strain_energy.hh>
+#include <response_surface.hh>
 
 class TestableParameterSearch : public ParameterSearch
 {
 public:
     using ParameterSearch::applyParameterConfiguration;
+    using ParameterSearch::checkFeasibility;
     using ParameterSearch::checkInputParams;
+    using ParameterSearch::closeOutputFile;
     using ParameterSearch::computeCriteria;
+    using ParameterSearch::evaluateConfiguration;
+    using ParameterSearch::getLazyParamRanges;
+    using ParameterSearch::getBestConfiguration;
+    using ParameterSearch::getBestIndex;
+    using ParameterSearch::getBestObjective;
+    using ParameterSearch::getMaxHarmonicOrder;
+    using ParameterSearch::getNextShardStep;
     using ParameterSearch::getNumSteps;
     using ParameterSearch::getParameterConfiguration;
     using ParameterSearch::getParamRanges;
+    using ParameterSearch::getRangeSizes;
     using ParameterSearch::getRequiredCalculations;
+    using ParameterSearch::getStartPoint;
+    using ParameterSearch::getWorkerModelPath;
+    using ParameterSearch::getStagedCalculations;
     using ParameterSearch::initOutputFile;
+    using ParameterSearch::outputFile_;
+    using ParameterSearch::resetBest;
+    using ParameterSearch::setStartConfiguration;
+    using ParameterSearch::trackBest;
+    using ParameterSearch::hasStatusColumn;
     using ParameterSearch::ParameterSearch;
     using ParameterSearch::runCalculations;
     using ParameterSearch::writeStepToOutputFile;
 };
 
+/**
+ * Output criterion without required calculations that counts how often it is computed.
+ */
+class CountingCriterion : public OutputCriterionInterface
+{
+public:
+    CountingCriterion()
+    {
+        column_name_ = "counting";
+    }
+
+    double computeCriterion(std::vector<std::shared_ptr<CCTools::CalcResultHandlerBase>> calcResults) override
+    {
+        return static_cast<double>(++num_computations);
+    }
+
+    void setStepIndex(size_t index) override
+    {
+        step_index = index;
+    }
+
+    Json::Value getState() override
+    {
+        return Json::Value(static_cast<Json::UInt64>(num_computations));
+    }
+
+    void setState(const Json::Value &state) override
+    {
+        num_computations = state.asUInt64();
+    }
+
+    size_t num_computations = 0;
+    size_t step_index = 0;
+};
+
 class ParameterSearchTest : public ::testing::Test
 {
 protected:
@@ -58,6 +128,11 @@ protected:
         inputs.push_back(std::make_shared<InputLayerPitch>("custom cct outer", std::vector<Json::Value>{2.05}, "_outer"));
         inputs.push_back(std::make_shared<InputLayerPitch>("custom cct inner", std::vector<Json::Value>{2.09, 2.1, 2.11, 2.12}, "_inner"));
 
+        // The same input parameters with continuous ranges, for the optimizers
+        continuousInputs.clear();
+        continuousInputs.push_back(std::make_shared<InputLayerPitch>("custom cct outer", std::make_shared<LinearParamRange>(2.05, 2.05, 2), "_outer"));
+        continuousInputs.push_back(std::make_shared<InputLayerPitch>("custom cct inner", std::make_shared<LinearParamRange>(2.09, 2.12, 4), "_inner"));
+
         // Create output criteria
         outputs.clear();
         for (size_t i = 1; i <= 10; i++)
@@ -77,11 +152,109 @@ protected:
     {
     }
 
+    /**
+     * Read the newest output file in `OUTPUT_DIR_PATH`.
+     * @param suffix The end of the file name, e.g. "_pareto.csv" for the Pareto front of a multi-objective search.
+     * @return The header and the rows of the file, split into cells.
+     */
+    static std::vector<std::vector<std::string>> readLatestOutputFile(const std::string &suffix = ".csv")
+    {
+        const std::string prefix = "CCTSim_output_";
+        const size_t timestamp_length = std::string("YYYY_MM_DD_HH_MM_SS").size();
+        std::filesystem::path latest;
+        for (const auto &entry : std::filesystem::directory_iterator(OUTPUT_DIR_PATH))
+        {
+            std::string name = entry.path().filename().string();
+            if (name.rfind(prefix, 0) != 0 || name.size() != prefix.size() + timestamp_length + suffix.size() ||
+                name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+            {
+                continue;
+            }
+            if (latest.empty() || entry.last_write_time() > std::filesystem::last_write_time(latest))
+            {
+                latest = entry.path();
+            }
+        }
+
+        std::vector<std::vector<std::string>> rows;
+        std::ifstream file(latest);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (!line.empty())
+            {
+                rows.push_back(ResponseSurface::splitLine(line));
+            }
+        }
+        return rows;
+    }
+
+    /**
+     * Get the position of a column in the header of an output file, throws if there is none.
+     */
+    static size_t getColumn(const std::vector<std::string> &header, const std::string &name)
+    {
+        auto it = std::find(header.begin(), header.end(), name);
+        if (it == header.end())
+        {
+            throw std::out_of_range("No column " + name);
+        }
+        return it - header.begin();
+    }
+
+    /**
+     * Get the position of the row with an index in the rows of an output file, throws if there is none.
+     */
+    static size_t getRow(const std::vector<std::vector<std::string>> &rows, long index)
+    {
+        for (size_t r = 1; r < rows.size(); r++)
+        {
+            if (std::stol(rows[r][0]) == index)
+            {
+                return r;
+            }
+        }
+        throw std::out_of_range("No row with index " + std::to_string(index));
+    }
+
+    /**
+     * Sum of the absolute values of some columns of a row, the objective of the optimizer tests.
+     */
+    static double getAbsoluteSum(const std::vector<std::vector<std::string>> &rows, size_t row, const std::vector<std::string> &columns)
+    {
+        double sum = 0.0;
+        for (const std::string &column : columns)
+        {
+            sum += std::abs(std::stod(rows[row][getColumn(rows[0], column)]));
+        }
+        return sum;
+    }
+
+    /**
+     * Check that the best index of an optimizer is the row with the smallest objective in the output file.
+     * The output file has 6 significant digits, so the objectives are compared with a relative tolerance.
+     */
+    static void expectBestRow(const std::vector<std::vector<std::string>> &rows, long best_index, double best_objective, const std::vector<std::string> &columns)
+    {
+        ASSERT_GE(best_index, 0);
+        double best_row_objective = getAbsoluteSum(rows, getRow(rows, best_index), columns);
+        EXPECT_NEAR(best_objective, best_row_objective, 1e-5 * best_row_objective);
+        for (size_t r = 1; r < rows.size(); r++)
+        {
+            double objective = getAbsoluteSum(rows, r, columns);
+            if (!std::isnan(objective))
+            {
+                EXPECT_GE(objective, best_row_objective * (1.0 - 1e-5)) << "Row with index " << rows[r][0] << " is better than the best index " << best_index;
+            }
+        }
+    }
+
     // Member variables
     std::string model_path;
     std::shared_ptr<CCTools::ModelHandler> modelHandler;
     std::shared_ptr<CCTools::ModelCalculator> modelCalculator;
     std::vector<std::shared_ptr<InputParamRangeInterface>> inputs;
+    std::vector<std::shared_ptr<InputParamRangeInterface>> continuousInputs;
     std::vector<std::shared_ptr<OutputCriterionInterface>> outputs;
     std::shared_ptr<TestableParameterSearch> parameterSearch;
 };
@@ -163,6 +336,834 @@ TEST_F(ParameterSearchTest, RunDoesNotThrowWithCorrectInputs)
     });
 }
 
+TEST_F(ParameterSearchTest, CoarseToFineBudgetEvaluatesRangeEndsFirst)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(2));
+
+    TestableParameterSearch testParameterSearch(inputs, testOutputs, *modelHandler);
+    testParameterSearch.setTraversalOrder(COARSE_TO_FINE);
+    testParameterSearch.setStepBudget(2);
+    testParameterSearch.setTimeBudget(std::chrono::hours(1));
+    testParameterSearch.run();
+
+    // The budget allows the first level, the ends of the inner pitch range
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 2);
+    size_t inner = getColumn(rows[0], inputs[1]->getColumnName());
+    EXPECT_EQ(rows[1][0], "0");
+    EXPECT_NEAR(std::stod(rows[1][inner]), 2.09e-3, 1e-9);
+    EXPECT_EQ(rows[2][0], "3");
+    EXPECT_NEAR(std::stod(rows[2][inner]), 2.12e-3, 1e-9);
+}
+
+TEST_F(ParameterSearchTest, SamplerWritesOneRowPerSample)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(2));
+
+    TestableParameterSearch testParameterSearch(inputs, testOutputs, *modelHandler);
+    testParameterSearch.setSampler(std::make_shared<LatinHypercubeSampler>(42), 2);
+    testParameterSearch.run();
+
+    // The index column holds the sample number, the Latin hypercube puts one sample into each half of the inner pitch range
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 2);
+    size_t inner = getColumn(rows[0], inputs[1]->getColumnName());
+    EXPECT_EQ(rows[1][0], "0");
+    EXPECT_EQ(rows[2][0], "1");
+    double first = std::stod(rows[1][inner]);
+    double second = std::stod(rows[2][inner]);
+    EXPECT_NE(first < 2.105e-3, second < 2.105e-3);
+    for (double pitch : {first, second})
+    {
+        EXPECT_GE(pitch, 2.09e-3 - 1e-9);
+        EXPECT_LE(pitch, 2.12e-3 + 1e-9);
+    }
+    EXPECT_THROW(testParameterSearch.setSampler(std::make_shared<SobolSampler>(1), 0), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, AdaptiveRunStopsAtStepBudget)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(2));
+
+    AdaptiveParameterSearch adaptiveSearch(inputs, testOutputs, *modelHandler, 0, 2);
+    adaptiveSearch.setThreshold(0.0);
+    adaptiveSearch.setStepBudget(3);
+    adaptiveSearch.run();
+
+    // A threshold of 0 refines everywhere, so only the budget stops the search
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    EXPECT_EQ(rows.size(), 1 + 3);
+    EXPECT_THROW(AdaptiveParameterSearch(inputs, testOutputs, *modelHandler, 1), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, AdaptiveRunTreatsRejectedStepsAsFailed)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(2));
+
+    // No b2 is accepted, so every evaluation has no values
+    AdaptiveParameterSearch adaptiveSearch(inputs, testOutputs, *modelHandler, 0);
+    adaptiveSearch.setAcceptanceBounds(0, 1e9, 2e9);
+    adaptiveSearch.setThreshold(0.0);
+    adaptiveSearch.run();
+
+    // Each of the four cells of the coarse grid stops at its first failed corner and none is refined
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 4);
+    for (size_t r = 1; r < rows.size(); r++)
+    {
+        EXPECT_EQ(rows[r].back(), "rejected:" + testOutputs[0]->getColumnName());
+    }
+}
+
+TEST_F(ParameterSearchTest, BayesianOptimizerFindsBestOfBudget)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(5));
+
+    OptimizationObjective objective;
+    objective.addTerm(0, 1.0, true);
+    objective.addTerm(1, 1.0, true);
+
+    BayesianOptimizer optimizer(inputs, testOutputs, *modelHandler, objective, 4, 1);
+    optimizer.setNumInitial(2);
+    optimizer.setNumWorkers(2);
+    optimizer.run();
+
+    // The initial design and one batch of proposals use up the budget
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 4);
+    for (size_t r = 1; r < rows.size(); r++)
+    {
+        EXPECT_EQ(rows[r][0], std::to_string(r - 1));
+    }
+    expectBestRow(rows, optimizer.getBestIndex(), optimizer.getBestObjective(), {testOutputs[0]->getColumnName(), testOutputs[1]->getColumnName()});
+    EXPECT_THROW(optimizer.setNumWorkers(0), std::invalid_argument);
+
+    OptimizationObjective invalid_objective;
+    invalid_objective.addTerm(2);
+    EXPECT_THROW(BayesianOptimizer(inputs, testOutputs, *modelHandler, invalid_objective, 4), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, StartPointAndBestEvaluationAreShared)
+{
+    // Center of the ranges without a start configuration
+    EXPECT_EQ(parameterSearch->getStartPoint(), std::vector<double>(2, 0.5));
+
+    // Discrete ranges start in the center of the bin of the value
+    std::vector<Json::Value> start = {inputs[0]->getRange()[0], inputs[1]->getRange()[2]};
+    parameterSearch->setStartConfiguration(start);
+    std::vector<double> start_point = parameterSearch->getStartPoint();
+    EXPECT_DOUBLE_EQ(start_point[0], 0.5);
+    EXPECT_DOUBLE_EQ(start_point[1], 0.625);
+    EXPECT_THROW(parameterSearch->setStartConfiguration({start[0]}), std::invalid_argument);
+    EXPECT_THROW(parameterSearch->setStartConfiguration({start[0], Json::Value(1.0)}), std::invalid_argument);
+
+    parameterSearch->resetBest();
+    EXPECT_EQ(parameterSearch->getBestIndex(), -1);
+    EXPECT_TRUE(parameterSearch->trackBest(3, 2.0, start));
+    EXPECT_FALSE(parameterSearch->trackBest(4, std::numeric_limits<double>::quiet_NaN(), {}));
+    EXPECT_FALSE(parameterSearch->trackBest(5, 2.0, {}));
+    EXPECT_EQ(parameterSearch->getBestIndex(), 3);
+    EXPECT_DOUBLE_EQ(parameterSearch->getBestObjective(), 2.0);
+    EXPECT_EQ(parameterSearch->getBestConfiguration(), start);
+
+    parameterSearch->resetBest();
+    EXPECT_EQ(parameterSearch->getBestIndex(), -1);
+    EXPECT_TRUE(std::isinf(parameterSearch->getBestObjective()));
+    EXPECT_TRUE(parameterSearch->getBestConfiguration().empty());
+}
+
+TEST_F(ParameterSearchTest, ParameterOptimizerFindsBestWithinBudget)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+
+    OptimizationObjective objective;
+    objective.addTerm(0, 1.0, true);
+
+    for (OptimizerMethod method : {NELDER_MEAD, CMA_ES})
+    {
+        ParameterOptimizer optimizer(continuousInputs, testOutputs, *modelHandler, objective, method, 8);
+        optimizer.setInitialStepSize(0.2);
+        optimizer.run();
+
+        std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+        EXPECT_GT(rows.size(), 1);
+        EXPECT_LE(rows.size(), 1 + 8);
+        expectBestRow(rows, optimizer.getBestIndex(), optimizer.getBestObjective(), {testOutputs[0]->getColumnName()});
+    }
+
+    ParameterOptimizer optimizer(continuousInputs, testOutputs, *modelHandler, objective, NELDER_MEAD, 8);
+    EXPECT_THROW(optimizer.setStartConfiguration({}), std::invalid_argument);
+    EXPECT_THROW(optimizer.setInitialStepSize(0.0), std::invalid_argument);
+    EXPECT_THROW(ParameterOptimizer(inputs, testOutputs, *modelHandler, objective, NELDER_MEAD, 8), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, GradientOptimizerFindsBestWithinBudget)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+
+    OptimizationObjective objective;
+    objective.addTerm(0, 1.0, true);
+
+    GradientOptimizer optimizer(continuousInputs, testOutputs, *modelHandler, objective, 12);
+    optimizer.setFiniteDifferenceStep(0, 0.01);
+    optimizer.setNoiseLevel(1e-9);
+    optimizer.run();
+
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    EXPECT_GT(rows.size(), 1);
+    EXPECT_LE(rows.size(), 1 + 12);
+    expectBestRow(rows, optimizer.getBestIndex(), optimizer.getBestObjective(), {testOutputs[0]->getColumnName()});
+
+    EXPECT_THROW(optimizer.setFiniteDifferenceStep(continuousInputs.size(), 0.01), std::out_of_range);
+    EXPECT_THROW(optimizer.setNoiseLevel(-1.0), std::invalid_argument);
+
+    // Discrete ranges have no gradient
+    EXPECT_THROW(GradientOptimizer(inputs, testOutputs, *modelHandler, objective, 12), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, TargetSolverReachesTargetWithinBudget)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+
+    // b3 of an inner pitch between two scan points is a target that can be reached
+    TestableParameterSearch search(continuousInputs, testOutputs, *modelHandler);
+    std::vector<Json::Value> config = {Json::Value(2.05e-3), Json::Value(2.1125e-3)};
+    search.initOutputFile();
+    double target = search.evaluateConfiguration(0, config, search.getRequiredCalculations(testOutputs)).at(0);
+    search.closeOutputFile();
+    double tolerance = std::max(1e-3, 0.01 * std::abs(target));
+
+    TargetSolver solver(continuousInputs, testOutputs, *modelHandler, {{1, 0, target, tolerance}}, 15);
+    solver.run();
+    EXPECT_TRUE(solver.hasConverged());
+
+    // The solution is the row of the output file closest to the target
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    EXPECT_LE(rows.size(), 1 + 15);
+    size_t row = getRow(rows, solver.getSolutionIndex());
+    EXPECT_NEAR(std::stod(rows[row][getColumn(rows[0], testOutputs[0]->getColumnName())]), target, tolerance);
+    ASSERT_EQ(solver.getSolution().size(), continuousInputs.size());
+    EXPECT_NEAR(std::stod(rows[row][getColumn(rows[0], continuousInputs[1]->getColumnName())]), solver.getSolution()[1].asDouble(), 1e-8);
+
+    EXPECT_THROW(TargetSolver(continuousInputs, testOutputs, *modelHandler, {}, 10), std::invalid_argument);
+    EXPECT_THROW(TargetSolver(continuousInputs, testOutputs, *modelHandler, {{0, 1, 0.0, 1e-3}}, 10), std::invalid_argument);
+    EXPECT_THROW(TargetSolver(continuousInputs, testOutputs, *modelHandler, {{0, 0, 0.0, 0.0}}, 10), std::invalid_argument);
+    EXPECT_THROW(TargetSolver(inputs, testOutputs, *modelHandler, {{0, 0, 0.0, 1e-3}}, 10), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, HarmonicCorrectionReachesTargetAndReusesJacobian)
+{
+    // b3 of an inner pitch away from the start configuration is a target that can be reached
+    std::vector<std::type_index> required_calculations = parameterSearch->getRequiredCalculations(outputs);
+    std::vector<Json::Value> config = {Json::Value(2.05e-3), Json::Value(2.1125e-3)};
+    parameterSearch->initOutputFile();
+    double target = parameterSearch->evaluateConfiguration(0, config, required_calculations).at(5);
+    parameterSearch->closeOutputFile();
+    double tolerance = std::max(1e-3, 0.01 * std::abs(target));
+
+    // Correct b3 with the inner layer pitch
+    HarmonicCorrection correction(continuousInputs, outputs, *modelHandler, {1}, {5}, tolerance, 6);
+    correction.setTargets({target});
+    correction.run();
+    EXPECT_TRUE(correction.hasConverged());
+
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    size_t b3 = getColumn(rows[0], outputs[5]->getColumnName());
+    EXPECT_LE(rows.size(), 1 + 6);
+    EXPECT_NEAR(std::stod(rows[getRow(rows, correction.getSolutionIndex())][b3]), target, tolerance);
+    EXPECT_EQ(correction.getSolution().size(), continuousInputs.size());
+
+    // The second run reuses the Jacobian, so it needs fewer evaluations
+    correction.run();
+    std::vector<std::vector<std::string>> second_rows = readLatestOutputFile();
+    EXPECT_LT(second_rows.size(), rows.size());
+    EXPECT_NEAR(std::stod(second_rows[getRow(second_rows, correction.getSolutionIndex())][b3]), target, tolerance);
+
+    std::vector<std::shared_ptr<OutputCriterionInterface>> mesh_outputs = outputs;
+    mesh_outputs.push_back(std::make_shared<OutputMaxVonMises>());
+    EXPECT_THROW(HarmonicCorrection(continuousInputs, mesh_outputs, *modelHandler, {1}, {5}, 1e-3, 6), std::invalid_argument);
+    EXPECT_THROW(HarmonicCorrection(continuousInputs, outputs, *modelHandler, {1, 1}, {5}, 1e-3, 6), std::invalid_argument);
+    EXPECT_THROW(HarmonicCorrection(inputs, outputs, *modelHandler, {1}, {5}, 1e-3, 6), std::invalid_argument);
+    EXPECT_THROW(correction.setTargets({0.0, 0.0}), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, SensitivityScreeningEvaluatesWholeTrajectories)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+    testOutputs.push_back(std::make_shared<OutputMaxCurvature>());
+
+    SensitivityScreening screening(inputs, testOutputs, *modelHandler, 2);
+    screening.setNumWorkers(2);
+    screening.run();
+
+    // Each trajectory moves every input once
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    EXPECT_EQ(rows.size(), 1 + 2 * (inputs.size() + 1));
+
+    // The outer pitch has a single value and no effect, the inner pitch changes b3
+    std::vector<std::vector<MorrisStatistics>> statistics = screening.getStatistics();
+    ASSERT_EQ(statistics.size(), inputs.size());
+    ASSERT_EQ(statistics[0].size(), testOutputs.size());
+    for (size_t o = 0; o < testOutputs.size(); o++)
+    {
+        EXPECT_EQ(statistics[0][o].num_effects, 2u);
+        EXPECT_DOUBLE_EQ(statistics[0][o].mu_star, 0.0);
+    }
+    EXPECT_GT(statistics[1][0].mu_star, 0.0);
+
+    // One row per input and criterion in the summary
+    EXPECT_EQ(readLatestOutputFile("_morris.csv").size(), 1 + inputs.size() * testOutputs.size());
+
+    EXPECT_THROW(SensitivityScreening(inputs, testOutputs, *modelHandler, 1), std::invalid_argument);
+    EXPECT_THROW(SensitivityScreening(inputs, testOutputs, *modelHandler, 2, 3), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, TimedOutStepsAreRecordedAndSkipped)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(1));
+    TestableParameterSearch search(inputs, testOutputs, *modelHandler);
+    std::vector<std::type_index> required_calculations = search.getRequiredCalculations(testOutputs);
+    std::vector<Json::Value> config = {Json::Value(2.05e-3), Json::Value(2.1e-3)};
+    EXPECT_THROW(search.setCalculationTimeout(typeid(int), std::chrono::seconds(1)), std::invalid_argument);
+
+    // A generous timeout gives the same result as the evaluation in the main process
+    std::vector<double> reference = search.computeCriteria(search.runCalculations(required_calculations, *modelCalculator, *modelHandler), testOutputs);
+    search.setCalculationTimeout(typeid(CCTools::HarmonicsDataHandler), std::chrono::hours(1));
+    search.setCriteriaTimeout(std::chrono::hours(1));
+    std::string outputFilePath = search.initOutputFile();
+    std::vector<double> isolated = search.evaluateConfiguration(0, config, required_calculations);
+
+    // A calculation that cannot finish in time is killed and recorded
+    search.setCalculationTimeout(typeid(CCTools::HarmonicsDataHandler), std::chrono::nanoseconds(1));
+    std::vector<double> timed_out;
+    EXPECT_NO_THROW({
+        timed_out = search.evaluateConfiguration(1, config, required_calculations);
+    });
+    search.closeOutputFile();
+    ASSERT_EQ(isolated.size(), 1);
+    EXPECT_DOUBLE_EQ(isolated[0], reference[0]);
+    EXPECT_TRUE(timed_out.empty());
+
+    std::ifstream outputFile(outputFilePath);
+    std::string header, row;
+    std::getline(outputFile, header);
+    EXPECT_EQ(header.substr(header.rfind(',') + 1), "status");
+    std::getline(outputFile, row);
+    EXPECT_EQ(row.substr(row.rfind(',') + 1), "accepted");
+    std::getline(outputFile, row);
+    EXPECT_EQ(row.substr(row.rfind(',') + 1), "timeout:harmonics");
+    EXPECT_EQ(ResponseSurface::splitLine(row)[3], "nan");
+
+    // Isolation is not combined with parallel workers
+    EXPECT_THROW(search.setNumWorkers(2), std::invalid_argument);
+
+    // Removing the timeouts removes the status column
+    search.setCalculationTimeout(typeid(CCTools::HarmonicsDataHandler), std::chrono::seconds(0));
+    search.setCriteriaTimeout(std::chrono::seconds(0));
+    EXPECT_FALSE(search.hasStatusColumn());
+    search.setNumWorkers(2);
+    EXPECT_THROW(search.setCriteriaTimeout(std::chrono::seconds(1)), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, IsolatedStepsReturnTheCriterionState)
+{
+    auto counting = std::make_shared<CountingCriterion>();
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs = {counting};
+    TestableParameterSearch search(inputs, testOutputs, *modelHandler);
+    std::vector<Json::Value> config = {Json::Value(2.05e-3), Json::Value(2.1e-3)};
+
+    // The criteria are computed in a child process, their state is sent back with the results
+    search.setCriteriaTimeout(std::chrono::hours(1));
+    search.initOutputFile();
+    std::vector<double> first = search.evaluateConfiguration(0, config, {});
+    std::vector<double> second = search.evaluateConfiguration(1, config, {});
+    search.closeOutputFile();
+    ASSERT_EQ(second.size(), 1);
+    EXPECT_DOUBLE_EQ(first[0], 1.0);
+    EXPECT_DOUBLE_EQ(second[0], 2.0);
+    EXPECT_EQ(counting->num_computations, 2u);
+}
+
+TEST_F(ParameterSearchTest, FailurePredictionRecordsOutcomes)
+{
+    std::vector<std::shared_ptr<InputParamRangeInterface>> testInputs;
+    testInputs.push_back(std::make_shared<InputLayerPitch>("custom cct outer", std::vector<Json::Value>{2.05, 2.15}, "_outer"));
+    testInputs.push_back(std::make_shared<InputLayerPitch>("custom cct inner", std::vector<Json::Value>{2.09, 2.1, 2.11}, "_inner"));
+
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(1));
+    TestableParameterSearch search(testInputs, testOutputs, *modelHandler);
+    EXPECT_THROW(search.setFailurePrediction(DEFER_LIKELY_FAILURES, 0.0), std::invalid_argument);
+    EXPECT_THROW(search.setFailurePrediction(DEFER_LIKELY_FAILURES, 0.5, 5, 2), std::invalid_argument);
+    search.setFailurePrediction(SKIP_LIKELY_FAILURES, 0.5, 2, 4);
+    search.run();
+
+    // Every step is evaluated and none is predicted to fail without failures
+    const FailurePredictionStatistics &stats = search.getFailurePredictionStatistics();
+    EXPECT_EQ(stats.true_positives + stats.false_positives, 0u);
+    EXPECT_EQ(stats.true_positives + stats.false_positives + stats.false_negatives + stats.true_negatives, 6u);
+    EXPECT_EQ(stats.false_negatives, 0u);
+
+    // Skipping adds a status column
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 6);
+    EXPECT_EQ(rows[0].back(), "status");
+    for (size_t r = 1; r < rows.size(); r++)
+    {
+        EXPECT_EQ(rows[r][0], std::to_string(r - 1));
+        EXPECT_EQ(rows[r].back(), "accepted");
+    }
+
+    // The first step with the larger outer pitch fails, the nearest neighbor of the next step is that failure
+    TestableParameterSearch deferring_search(testInputs, testOutputs, *modelHandler);
+    auto outer = std::make_shared<InputLayerPitch>("custom cct outer", std::vector<Json::Value>{0.0}, "_derived");
+    deferring_search.addDerivedInput(outer, [](const std::vector<Json::Value> &config)
+                                     {
+                                         if (config[0].asDouble() > 2.1e-3 && config[1].asDouble() < 2.095e-3)
+                                         {
+                                             throw std::runtime_error("Outer pitch too large");
+                                         }
+                                         return config[0]; });
+    deferring_search.setFailurePrediction(DEFER_LIKELY_FAILURES, 0.5, 1, 3);
+    deferring_search.run();
+
+    // The failed step has no row, the deferred step succeeds at the end
+    rows = readLatestOutputFile();
+    std::vector<std::string> indices;
+    for (size_t r = 1; r < rows.size(); r++)
+    {
+        indices.push_back(rows[r][0]);
+    }
+    EXPECT_EQ(indices, (std::vector<std::string>{"0", "1", "2", "5", "4"}));
+
+    const FailurePredictionStatistics &deferring_stats = deferring_search.getFailurePredictionStatistics();
+    EXPECT_EQ(deferring_stats.true_positives, 0u);
+    EXPECT_EQ(deferring_stats.false_positives, 1u);
+    EXPECT_EQ(deferring_stats.false_negatives, 1u);
+    EXPECT_EQ(deferring_stats.true_negatives, 4u);
+}
+
+TEST_F(ParameterSearchTest, InfeasibleStepsArePrunedBeforeSimulation)
+{
+    std::vector<std::shared_ptr<InputParamRangeInterface>> testInputs;
+    testInputs.push_back(std::make_shared<InputLayerPitch>("custom cct outer", std::vector<Json::Value>{2.05, 2.15}, "_outer"));
+    testInputs.push_back(std::make_shared<InputLayerPitch>("custom cct inner", std::vector<Json::Value>{2.09, 2.1, 2.5}, "_inner"));
+    testInputs[1]->setFeasibilityPredicate([](const Json::Value &pitch)
+                                           { return pitch.asDouble() < 2.2e-3; });
+
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(1));
+    TestableParameterSearch search(testInputs, testOutputs, *modelHandler);
+    EXPECT_THROW(search.addFeasibilityPredicate("empty", nullptr), std::invalid_argument);
+    search.addFeasibilityPredicate("outer_below_inner", [](const std::vector<Json::Value> &config)
+                                   { return config[0].asDouble() < config[1].asDouble(); });
+    search.setNumWorkers(2);
+    search.run();
+
+    // Both inner 2.5 steps, and outer 2.15 with both remaining inner pitches
+    EXPECT_EQ(search.getNumPrunedSteps(), 4);
+
+    // Pruned steps are written with NaN and the name of the failed predicate, the input predicates are checked first
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 6);
+    std::vector<std::string> statuses = {"accepted", "accepted", "pruned:layer_pitch_inner",
+                                         "pruned:outer_below_inner", "pruned:outer_below_inner", "pruned:layer_pitch_inner"};
+    for (size_t index = 0; index < statuses.size(); index++)
+    {
+        const std::vector<std::string> &row = rows[getRow(rows, index)];
+        EXPECT_EQ(row.back(), statuses[index]);
+        EXPECT_EQ(std::isnan(std::stod(row[1 + testInputs.size()])), statuses[index] != "accepted");
+    }
+
+    std::vector<Json::Value> config = {Json::Value(2.05e-3), Json::Value(2.5e-3)};
+    std::string reason;
+    EXPECT_FALSE(search.checkFeasibility(config, reason));
+    EXPECT_EQ(reason, "layer_pitch_inner");
+    config[1] = Json::Value(2.0e-3);
+    EXPECT_FALSE(search.checkFeasibility(config, reason));
+    EXPECT_EQ(reason, "outer_below_inner");
+    config[1] = Json::Value(2.1e-3);
+    EXPECT_TRUE(search.checkFeasibility(config, reason));
+    EXPECT_TRUE(reason.empty());
+}
+
+TEST_F(ParameterSearchTest, ZippedAndDerivedInputsShrinkTheGrid)
+{
+    std::vector<std::shared_ptr<InputParamRangeInterface>> testInputs;
+    testInputs.push_back(std::make_shared<InputZipped>(std::vector<std::shared_ptr<InputParamRangeInterface>>{
+        std::make_shared<InputLayerPitch>("custom cct outer", std::vector<Json::Value>{2.05, 2.06, 2.07}, "_outer"),
+        std::make_shared<InputLayerPitch>("custom cct inner", std::vector<Json::Value>{2.09, 2.1, 2.11}, "_inner")}));
+    EXPECT_THROW(InputZipped({testInputs[0]}), std::invalid_argument);
+
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(1));
+    TestableParameterSearch search(testInputs, testOutputs, *modelHandler);
+
+    // Three steps instead of nine
+    auto paramRanges = search.getLazyParamRanges(testInputs);
+    EXPECT_EQ(search.getNumSteps(paramRanges), 3);
+
+    // The outer pitch follows the inner pitch of the zipped group
+    auto outer = std::make_shared<InputLayerPitch>("custom cct outer", std::vector<Json::Value>{0.0}, "_derived");
+    EXPECT_THROW(search.addDerivedInput(outer, nullptr), std::invalid_argument);
+    search.addDerivedInput(outer, [](const std::vector<Json::Value> &config)
+                           { return Json::Value(config[0][1].asDouble() * 0.98); });
+
+    std::string outputFilePath = search.initOutputFile();
+    std::vector<Json::Value> config = {paramRanges[0]->at(2)};
+    std::vector<double> values = search.evaluateConfiguration(0, config, search.getRequiredCalculations(testOutputs));
+    search.closeOutputFile();
+    EXPECT_EQ(values.size(), 1);
+    EXPECT_NEAR(modelHandler->getValueByName("custom cct outer", {"omega"}, "scaling").asDouble(), 2.11e-3 * 0.98, 1e-12);
+
+    // One column per zipped and derived input
+    std::ifstream outputFile(outputFilePath);
+    std::string header, row;
+    std::getline(outputFile, header);
+    std::getline(outputFile, row);
+    EXPECT_EQ(header, "index,layer_pitch_outer,layer_pitch_inner,layer_pitch_derived,b1");
+    EXPECT_EQ(std::count(row.begin(), row.end(), ','), 4);
+}
+
+TEST_F(ParameterSearchTest, HarmonicsOrderFollowsCriteria)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputAMultipole>(1));
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+    testOutputs.push_back(std::make_shared<OutputMaxVonMises>());
+    EXPECT_EQ(TestableParameterSearch::getMaxHarmonicOrder(testOutputs), 3);
+
+    std::vector<std::shared_ptr<OutputCriterionInterface>> meshOutputs = {std::make_shared<OutputMaxVonMises>()};
+    EXPECT_EQ(TestableParameterSearch::getMaxHarmonicOrder(meshOutputs), 0);
+
+    // Searches with different orders on the same model do not change its order
+    Json::Value num_max = modelHandler->getValueByName("Cylyndrical Harmonics", {}, "num_max");
+    std::vector<std::shared_ptr<OutputCriterionInterface>> firstOutputs = {std::make_shared<OutputBMultipole>(1)};
+    auto first = std::make_unique<TestableParameterSearch>(inputs, firstOutputs, *modelHandler);
+    TestableParameterSearch search(inputs, testOutputs, *modelHandler);
+    first.reset();
+    EXPECT_EQ(modelHandler->getValueByName("Cylyndrical Harmonics", {}, "num_max"), num_max);
+    search.run();
+    EXPECT_EQ(modelHandler->getValueByName("Cylyndrical Harmonics", {}, "num_max"), num_max);
+
+    // b3 is still computed with the trimmed order
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 4);
+    for (size_t r = 1; r < rows.size(); r++)
+    {
+        EXPECT_TRUE(std::isfinite(std::stod(rows[r][getColumn(rows[0], testOutputs[1]->getColumnName())])));
+    }
+}
+
+TEST_F(ParameterSearchTest, TrimmedHarmonicsOrderKeepsMultipoles)
+{
+    // Reference with all orders of the model
+    std::vector<std::type_index> harmonics = {std::type_index(typeid(CCTools::HarmonicsDataHandler))};
+    auto reference = std::dynamic_pointer_cast<CCTools::HarmonicsDataHandler>(parameterSearch->runCalculations(harmonics, *modelCalculator, *modelHandler)[0]);
+    Json::Value reference_radius = modelHandler->getValueByName("Cylyndrical Harmonics", {}, "reference_radius");
+
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    for (size_t n = 1; n <= 3; n++)
+    {
+        testOutputs.push_back(std::make_shared<OutputBMultipole>(n));
+    }
+    TestableParameterSearch search(inputs, testOutputs, *modelHandler);
+    Json::Value num_max = modelHandler->getValueByName("Cylyndrical Harmonics", {}, "num_max");
+
+    // b1..b3 keep their values and their normalization to the main component at the reference radius
+    auto trimmed = std::dynamic_pointer_cast<CCTools::HarmonicsDataHandler>(search.runCalculations(harmonics, *modelCalculator, *modelHandler, 3)[0]);
+    EXPECT_EQ(modelHandler->getValueByName("Cylyndrical Harmonics", {}, "num_max"), num_max);
+    EXPECT_EQ(modelHandler->getValueByName("Cylyndrical Harmonics", {}, "reference_radius"), reference_radius);
+    auto reference_bn = reference->get_bn();
+    auto trimmed_bn = trimmed->get_bn();
+    for (size_t n = 0; n < 3; n++)
+    {
+        EXPECT_NEAR(trimmed_bn[n], reference_bn[n], 1e-9 * std::max(1.0, std::abs(reference_bn[n])));
+    }
+    std::vector<double> values = search.computeCriteria({trimmed}, testOutputs);
+    std::vector<double> reference_values = search.computeCriteria({reference}, testOutputs);
+    for (size_t n = 0; n < 3; n++)
+    {
+        EXPECT_NEAR(values[n], reference_values[n], 1e-9 * std::max(1.0, std::abs(reference_values[n])));
+    }
+}
+
+TEST_F(ParameterSearchTest, GeometryCriteriaRunWithoutFieldCalculation)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputMinZ>());
+    testOutputs.push_back(std::make_shared<OutputMaxZ>());
+    testOutputs.push_back(std::make_shared<OutputConductorLength>());
+    TestableParameterSearch search(inputs, testOutputs, *modelHandler);
+
+    std::vector<std::type_index> required = search.getRequiredCalculations(testOutputs);
+    ASSERT_EQ(required.size(), 1);
+    EXPECT_EQ(required[0], std::type_index(typeid(GeometryDataHandler)));
+    search.run();
+
+    // Every step has a geometry
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 4);
+    for (size_t r = 1; r < rows.size(); r++)
+    {
+        double min_z = std::stod(rows[r][getColumn(rows[0], testOutputs[0]->getColumnName())]);
+        double max_z = std::stod(rows[r][getColumn(rows[0], testOutputs[1]->getColumnName())]);
+        EXPECT_LT(min_z, max_z);
+        EXPECT_GT(std::stod(rows[r][getColumn(rows[0], testOutputs[2]->getColumnName())]), 0.0);
+    }
+}
+
+TEST_F(ParameterSearchTest, StagedEvaluationRejectsBeforeMeshCalculation)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputMaxVonMises>());
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+    TestableParameterSearch search(inputs, testOutputs, *modelHandler);
+
+    // Harmonics run before the mesh
+    std::vector<std::type_index> staged = search.getStagedCalculations(search.getRequiredCalculations(testOutputs));
+    ASSERT_EQ(staged.size(), 2);
+    EXPECT_EQ(staged[0], std::type_index(typeid(CCTools::HarmonicsDataHandler)));
+    EXPECT_EQ(staged[1], std::type_index(typeid(CCTools::MeshDataHandler)));
+
+    EXPECT_THROW(search.setAcceptanceBounds(2, -1.0, 1.0), std::invalid_argument);
+    EXPECT_THROW(search.setAcceptanceBounds(1, 1.0, -1.0), std::invalid_argument);
+
+    // No b3 is accepted, so the mesh calculation never starts
+    search.setAcceptanceBounds(1, 1e9, 2e9);
+    std::string outputFilePath = search.initOutputFile();
+    auto paramRanges = search.getParamRanges(inputs);
+    std::vector<Json::Value> config = search.getParameterConfiguration(0, paramRanges);
+    std::vector<double> values = search.evaluateConfiguration(0, config, search.getRequiredCalculations(testOutputs));
+    search.closeOutputFile();
+    EXPECT_TRUE(values.empty());
+
+    std::ifstream outputFile(outputFilePath);
+    std::string headerLine, line;
+    std::getline(outputFile, headerLine);
+    std::getline(outputFile, line);
+    EXPECT_EQ(headerLine.substr(headerLine.rfind(',') + 1), "status");
+    EXPECT_EQ(line.substr(line.rfind(',') + 1), "rejected:" + testOutputs[1]->getColumnName());
+
+    std::vector<std::string> tokens;
+    std::stringstream lineStream(line);
+    std::string token;
+    while (std::getline(lineStream, token, ','))
+    {
+        tokens.push_back(token);
+    }
+    ASSERT_EQ(tokens.size(), 1 + inputs.size() + testOutputs.size() + 1);
+    EXPECT_EQ(tokens[1 + inputs.size()], "nan");
+}
+
+TEST_F(ParameterSearchTest, StagedEvaluationComputesCriteriaWithoutCalculationsLast)
+{
+    auto counting = std::make_shared<CountingCriterion>();
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs = {counting, std::make_shared<OutputBMultipole>(3)};
+    TestableParameterSearch search(inputs, testOutputs, *modelHandler);
+    std::vector<std::type_index> required_calculations = search.getRequiredCalculations(testOutputs);
+    auto paramRanges = search.getParamRanges(inputs);
+    std::vector<Json::Value> config = search.getParameterConfiguration(0, paramRanges);
+
+    // A step rejected by b3 never computes the criterion without calculations
+    search.setAcceptanceBounds(1, 1e9, 2e9);
+    search.initOutputFile();
+    EXPECT_TRUE(search.evaluateConfiguration(0, config, required_calculations).empty());
+    EXPECT_EQ(counting->num_computations, 0u);
+
+    // An accepted step computes it after the harmonics
+    search.setAcceptanceBounds(1, -1e9, 1e9);
+    std::vector<double> values = search.evaluateConfiguration(1, config, required_calculations);
+    search.closeOutputFile();
+    ASSERT_EQ(values.size(), 2);
+    EXPECT_EQ(counting->num_computations, 1u);
+    EXPECT_DOUBLE_EQ(values[0], 1.0);
+
+    // The criteria know the index of the step in the output file
+    EXPECT_EQ(counting->step_index, 1u);
+}
+
+TEST_F(ParameterSearchTest, MultiFidelitySearchRerunsBestAtFullFidelity)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+    OptimizationObjective objective;
+    objective.addTerm(0, 1.0, true);
+
+    MultiFidelitySearch search(inputs, testOutputs, *modelHandler, objective, 0.5);
+    EXPECT_THROW(search.run(), std::runtime_error);
+    EXPECT_ANY_THROW(search.setLowFidelitySetting("Cylyndrical Harmonics", "no_such_setting", 3));
+    search.setLowFidelitySetting("Cylyndrical Harmonics", "num_exp", 3);
+    search.setNumWorkers(2);
+    search.run();
+
+    // The sweep at low fidelity, then the better half again at the full fidelity of the model
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 4 + 2);
+    size_t num_exp = getColumn(rows[0], "fmm_num_exp_Cylyndrical_Harmonics");
+    size_t inner = getColumn(rows[0], inputs[1]->getColumnName());
+    std::string b3 = testOutputs[0]->getColumnName();
+    for (size_t r = 1; r <= 4; r++)
+    {
+        EXPECT_EQ(std::stoi(rows[r][num_exp]), 3);
+    }
+    for (size_t r = 5; r <= 6; r++)
+    {
+        EXPECT_NE(std::stoi(rows[r][num_exp]), 3);
+    }
+
+    // The re-runs are the low-fidelity configurations with the smallest objective, best first
+    std::vector<size_t> ranked = {1, 2, 3, 4};
+    std::stable_sort(ranked.begin(), ranked.end(), [&](size_t a, size_t b)
+                     { return getAbsoluteSum(rows, a, {b3}) < getAbsoluteSum(rows, b, {b3}); });
+    EXPECT_EQ(rows[5][inner], rows[ranked[0]][inner]);
+    EXPECT_EQ(rows[6][inner], rows[ranked[1]][inner]);
+
+    // The best configuration is the better of the full-fidelity re-runs
+    EXPECT_GE(search.getBestIndex(), 4);
+    std::vector<std::vector<std::string>> reruns = {rows[0], rows[5], rows[6]};
+    expectBestRow(reruns, search.getBestIndex(), search.getBestObjective(), {b3});
+
+    EXPECT_THROW(MultiFidelitySearch(inputs, testOutputs, *modelHandler, objective, 0.0), std::invalid_argument);
+    EXPECT_THROW(search.setBoundaryMargin(-1.0), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, FmmTunerPicksFastestCandidateMeetingTarget)
+{
+    std::vector<std::shared_ptr<InputParamRangeInterface>> settings;
+    settings.push_back(std::make_shared<InputFmmSetting>(InputFmmSetting("Cylyndrical Harmonics", "num_exp", {Json::Value(3), Json::Value(5)})));
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+
+    EXPECT_THROW(FmmTuner(settings, testOutputs, *modelHandler, {}, 1e-3), std::invalid_argument);
+    EXPECT_THROW(FmmTuner(settings, testOutputs, *modelHandler, {Json::Value(9)}, 0.0), std::invalid_argument);
+
+    FmmTuner tuner(settings, testOutputs, *modelHandler, {Json::Value(9)}, 1e6);
+    EXPECT_THROW(tuner.setNumRepeats(0), std::invalid_argument);
+    EXPECT_THROW(tuner.writeTunedModel(std::filesystem::temp_directory_path() / "cctsim_tuned.json"), std::runtime_error);
+
+    tuner.run();
+
+    // The reference and both candidates
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 3);
+    size_t num_exp = getColumn(rows[0], settings[0]->getColumnName());
+    EXPECT_EQ(std::stoi(rows[1][num_exp]), 9);
+    EXPECT_EQ(std::stoi(rows[2][num_exp]), 3);
+    EXPECT_EQ(std::stoi(rows[3][num_exp]), 5);
+
+    // Every candidate meets a loose tolerance, the fastest one is the best
+    std::vector<std::vector<std::string>> tuning_rows = readLatestOutputFile("_tuning.csv");
+    ASSERT_EQ(tuning_rows.size(), 1 + 3);
+    ASSERT_TRUE(tuner.hasMetTarget());
+    size_t runtime = getColumn(tuning_rows[0], "runtime");
+    size_t best_row = std::stod(tuning_rows[2][runtime]) <= std::stod(tuning_rows[3][runtime]) ? 2 : 3;
+    for (size_t r = 1; r < tuning_rows.size(); r++)
+    {
+        EXPECT_EQ(tuning_rows[r][getColumn(tuning_rows[0], "meets_target")], "1");
+    }
+    EXPECT_EQ(tuner.getBestIndex(), std::stol(tuning_rows[best_row][0]));
+    EXPECT_NEAR(tuner.getBestRuntime(), std::stod(tuning_rows[best_row][runtime]), 1e-5 * tuner.getBestRuntime());
+    ASSERT_EQ(tuner.getBestConfiguration().size(), 1);
+    EXPECT_EQ(tuner.getBestConfiguration()[0].asInt(), std::stoi(rows[best_row][num_exp]));
+    EXPECT_NEAR(tuner.getReferenceRuntime(), std::stod(tuning_rows[1][runtime]), 1e-5 * tuner.getReferenceRuntime());
+
+    std::filesystem::path tuned_path = std::filesystem::temp_directory_path() / "cctsim_tuned.json";
+    EXPECT_NO_THROW(tuner.writeTunedModel(tuned_path));
+    EXPECT_TRUE(std::filesystem::exists(tuned_path));
+    std::filesystem::remove(tuned_path);
+}
+
+TEST_F(ParameterSearchTest, MultiObjectiveSearchWritesNonDominatedFront)
+{
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputBMultipole>(3));
+    testOutputs.push_back(std::make_shared<OutputMaxCurvature>());
+
+    OptimizationObjective field_quality;
+    field_quality.addTerm(0, 1.0, true);
+    OptimizationObjective mechanics;
+    mechanics.addTerm(1);
+
+    MultiObjectiveSearch search(inputs, testOutputs, *modelHandler, {field_quality, mechanics}, 4, 2);
+    search.setNumWorkers(2);
+    search.run();
+
+    // Two generations of four
+    std::vector<std::vector<std::string>> rows = readLatestOutputFile();
+    ASSERT_EQ(rows.size(), 1 + 8);
+
+    // No evaluation is better than a member of the front in both objectives
+    std::vector<size_t> front = search.getParetoFront();
+    ASSERT_FALSE(front.empty());
+    std::string b3 = testOutputs[0]->getColumnName();
+    std::string curvature = testOutputs[1]->getColumnName();
+    for (size_t index : front)
+    {
+        size_t member = getRow(rows, index);
+        for (size_t r = 1; r < rows.size(); r++)
+        {
+            bool dominates = getAbsoluteSum(rows, r, {b3}) < getAbsoluteSum(rows, member, {b3}) &&
+                             std::stod(rows[r][getColumn(rows[0], curvature)]) < std::stod(rows[member][getColumn(rows[0], curvature)]);
+            EXPECT_FALSE(dominates) << "Row with index " << rows[r][0] << " dominates the front member with index " << index;
+        }
+    }
+    EXPECT_EQ(readLatestOutputFile("_pareto.csv").size(), 1 + front.size());
+
+    // A generation is only started if it fits into the step budget
+    search.setStepBudget(6);
+    search.run();
+    EXPECT_EQ(readLatestOutputFile().size(), 1 + 4);
+
+    EXPECT_THROW(MultiObjectiveSearch(inputs, testOutputs, *modelHandler, {field_quality}, 4, 2), std::invalid_argument);
+    EXPECT_THROW(MultiObjectiveSearch(inputs, testOutputs, *modelHandler, {field_quality, mechanics}, 3, 2), std::invalid_argument);
+}
+
+TEST_F(ParameterSearchTest, WorkerModelsAreUniquePerSearch)
+{
+    // Two searches on the same model do not overwrite the model copies of each other's workers
+    TestableParameterSearch other(inputs, outputs, *modelHandler);
+    EXPECT_NE(parameterSearch->getWorkerModelPath(0), other.getWorkerModelPath(0));
+    EXPECT_NE(parameterSearch->getWorkerModelPath(0), parameterSearch->getWorkerModelPath(1));
+    EXPECT_NE(parameterSearch->getWorkerModelPath(0).filename().string().find(std::to_string(getpid())), std::string::npos);
+}
+
+TEST_F(ParameterSearchTest, ShardStepsDoNotWrapAround)
+{
+    EXPECT_EQ(TestableParameterSearch::getNextShardStep(1, 10, 3), 4);
+    EXPECT_EQ(TestableParameterSearch::getNextShardStep(7, 10, 3), 10);
+    EXPECT_EQ(TestableParameterSearch::getNextShardStep(9, 10, 3), 10);
+
+    // The sum would wrap around to a step of the grid
+    size_t max = std::numeric_limits<size_t>::max();
+    EXPECT_EQ(TestableParameterSearch::getNextShardStep(max - 2, max, 4), max);
+    EXPECT_EQ(TestableParameterSearch::getNextShardStep(max - 5, max, 4), max - 1);
+}
+
+TEST_F(ParameterSearchTest, GetParameterConfigurationFromUnitPoint)
+{
+    std::vector<std::shared_ptr<ParamRange>> ranges = {std::make_shared<LinearParamRange>(1.0, 3.0, 3),
+                                                       std::make_shared<ListParamRange>(std::vector<Json::Value>{Json::Value("a"), Json::Value("b")})};
+
+    std::vector<Json::Value> config = TestableParameterSearch::getParameterConfiguration(std::vector<double>{0.25, 0.75}, ranges);
+
+    ASSERT_EQ(config.size(), 2);
+    EXPECT_DOUBLE_EQ(config[0].asDouble(), 1.5);
+    EXPECT_EQ(config[1].asString(), "b");
+    EXPECT_THROW(TestableParameterSearch::getParameterConfiguration(std::vector<double>{0.5}, ranges), std::invalid_argument);
+}
+
 TEST_F(ParameterSearchTest, InitOutputFileCreatesFileWithCorrectFormatting)
 {
     // Call initOutputFile
@@ -301,6 +1302,28 @@ TEST_F(ParameterSearchTest, GetParameterConfigurationReturnsCorrectValues)
     }
 }
 
+TEST_F(ParameterSearchTest, GetParameterConfigurationIsIndependentOfTraversalOrder)
+{
+    std::vector<std::shared_ptr<InputParamRangeInterface>> testInputs;
+    testInputs.push_back(std::make_shared<InputLayerPitch>("custom cct outer", std::vector<Json::Value>{2.05, 2.06, 2.07}, "_outer"));
+    testInputs.push_back(std::make_shared<InputLayerPitch>("custom cct inner", std::vector<Json::Value>{2.09, 2.1}, "_inner"));
+    auto paramRanges = parameterSearch->getParamRanges(testInputs);
+
+    GridTraversal traversal(parameterSearch->getRangeSizes(paramRanges), GRAY_CODE);
+    ASSERT_EQ(traversal.getNumSteps(), parameterSearch->getNumSteps(paramRanges));
+
+    for (size_t stepNum = 0; stepNum < traversal.getNumSteps(); ++stepNum)
+    {
+        std::vector<size_t> indices = traversal.getIndices(stepNum);
+        size_t gridIndex = traversal.getGridIndex(indices);
+
+        // The configuration of a grid point is the same as the one of its canonical grid index
+        auto config = parameterSearch->getParameterConfiguration(indices, paramRanges);
+        auto canonicalConfig = parameterSearch->getParameterConfiguration(gridIndex, paramRanges);
+        EXPECT_EQ(config, canonicalConfig);
+    }
+}
+
 TEST_F(ParameterSearchTest, RunCalculationsReturnsCorrectHandlers)
 {
     auto requiredCalculations = parameterSearch->getRequiredCalculations(outputs);
@@ -403,6 +1426,119 @@ TEST_F(ParameterSearchTest, InputPathConnect2UVW_and_OutputPathConnectV2StrainEn
     ASSERT_NEAR(strain_energy, 7.54e2, 1e-6); 
 }
 
+TEST_F(ParameterSearchTest, OutputPathConnectV2StrainEnergyMultiStart){
+    // Set path to model file
+    std::string model_path = TEST_DATA_DIR + "sext_test.json";
+
+    // Create model handler
+    CCTools::ModelHandler modelHandler(model_path);
+
+    // find connectV2
+    CCTools::ModelCalculator modelCalculator(modelHandler.getTempJsonPath());
+    rat::mdl::ShModelGroupPr model_tree = modelCalculator.get_model_tree();
+    rat::mdl::ShPathConnect2Pr connectV2 = findConnectV2(model_tree);
+
+    // apply the default config
+    std::vector<Json::Value> default_uvw_config = JsonRange::pathconnect2_range(connectV2, 1);
+    InputPathConnectV2UVW input("ConnectV2 Cable in", default_uvw_config, connectV2);
+    input.applyParamConfig(modelHandler, default_uvw_config[0]);
+
+    // run three starts concurrently
+    OutputPathConnectV2StrainEnergy output(modelCalculator, findConnectV2, "", 3);
+    double strain_energy = output.computeCriterion({});
+
+    OutputPathConnectV2StrainEnergy::MultiStartResult result = output.getLastMultiStartResult();
+    ASSERT_EQ(result.fvals.size(), 3);
+    EXPECT_DOUBLE_EQ(strain_energy, result.best);
+    EXPECT_LE(result.best, result.mean);
+    EXPECT_LE(result.mean, result.worst);
+
+    // the state restores the statistics and the history, e.g. in the parent of an isolated step
+    OutputPathConnectV2StrainEnergy restored(modelCalculator, findConnectV2, "", 3);
+    EXPECT_TRUE(restored.getState().isNull());
+    restored.setState(output.getState());
+    OutputPathConnectV2StrainEnergy::MultiStartResult restored_result = restored.getLastMultiStartResult();
+    EXPECT_EQ(restored_result.best_start, result.best_start);
+    EXPECT_DOUBLE_EQ(restored_result.best, result.best);
+    EXPECT_EQ(restored_result.num_failed, result.num_failed);
+    ASSERT_EQ(restored_result.fvals.size(), result.fvals.size());
+    ASSERT_NE(restored.getLastIterationHistory(), nullptr);
+    ASSERT_EQ(restored.getLastIterationHistory()->size(), output.getLastIterationHistory()->size());
+    EXPECT_DOUBLE_EQ(restored.getLastIterationHistory()->last().fval, output.getLastIterationHistory()->last().fval);
+
+    // the first start uses the configured state, so the best start cannot be worse than the single start value
+    EXPECT_LE(strain_energy, 7.54e2 + 1e-6);
+}
+
+TEST_F(ParameterSearchTest, OutputPathConnectV2StrainEnergyHistoryIsNamedByStep){
+    CCTools::ModelHandler modelHandler(TEST_DATA_DIR + "sext_test.json");
+    CCTools::ModelCalculator modelCalculator(modelHandler.getTempJsonPath());
+    rat::mdl::ShPathConnect2Pr connectV2 = findConnectV2(modelCalculator.get_model_tree());
+    std::vector<Json::Value> default_uvw_config = JsonRange::pathconnect2_range(connectV2, 1);
+    InputPathConnectV2UVW input("ConnectV2 Cable in", default_uvw_config, connectV2);
+    input.applyParamConfig(modelHandler, default_uvw_config[0]);
+
+    std::filesystem::path history_dir = std::filesystem::temp_directory_path() / "cctsim_history_test";
+    std::filesystem::remove_all(history_dir);
+    OutputPathConnectV2StrainEnergy output(modelCalculator, findConnectV2);
+    output.enableIterationHistoryExport(history_dir.string());
+
+    // The file has the index of the step in the output file, not the number of computations
+    output.setStepIndex(7);
+    output.computeCriterion({});
+    EXPECT_TRUE(std::filesystem::exists(history_dir / "pathconnect2_strain_energy_history_7.csv"));
+    EXPECT_FALSE(std::filesystem::exists(history_dir / "pathconnect2_strain_energy_history_0.csv"));
+    std::filesystem::remove_all(history_dir);
+}
+
+TEST_F(ParameterSearchTest, ArrayInputsKeepOutputColumnsAligned)
+{
+    CCTools::ModelHandler modelHandler(TEST_DATA_DIR + "sext_test.json");
+    CCTools::ModelCalculator modelCalculator(modelHandler.getTempJsonPath());
+    rat::mdl::ShPathConnect2Pr connectV2 = findConnectV2(modelCalculator.get_model_tree());
+    std::vector<Json::Value> uvw_configs = JsonRange::pathconnect2_range(connectV2, 2);
+
+    // A zipped group of array-valued inputs next to a plain array-valued input
+    std::vector<std::shared_ptr<InputParamRangeInterface>> testInputs;
+    testInputs.push_back(std::make_shared<InputZipped>(std::vector<std::shared_ptr<InputParamRangeInterface>>{
+        std::make_shared<InputPathConnectV2UVW>("ConnectV2 Cable in", uvw_configs, connectV2, "_a"),
+        std::make_shared<InputPathConnectV2UVW>("ConnectV2 Cable in", uvw_configs, connectV2, "_b")}));
+    testInputs.push_back(std::make_shared<InputPathConnectV2UVW>("ConnectV2 Cable in", uvw_configs, connectV2, "_c"));
+
+    std::vector<std::shared_ptr<OutputCriterionInterface>> testOutputs;
+    testOutputs.push_back(std::make_shared<OutputMaxZ>());
+    TestableParameterSearch search(testInputs, testOutputs, modelHandler);
+
+    std::string outputFilePath = search.initOutputFile();
+    auto paramRanges = search.getLazyParamRanges(testInputs);
+    for (size_t i = 0; i < uvw_configs.size(); i++)
+    {
+        std::vector<Json::Value> config = {paramRanges[0]->at(i), paramRanges[1]->at(i)};
+        std::vector<double> output_values = {1.0};
+        search.writeStepToOutputFile(i, search.outputFile_, config, output_values);
+    }
+    search.closeOutputFile();
+
+    std::ifstream outputFile(outputFilePath);
+    std::string header, row;
+    std::getline(outputFile, header);
+    EXPECT_EQ(header, "index,pathconnect2_uvw_a,pathconnect2_uvw_b,pathconnect2_uvw_c,z_max");
+    size_t num_rows = 0;
+    while (std::getline(outputFile, row))
+    {
+        std::vector<std::string> cells = ResponseSurface::splitLine(row);
+        ASSERT_EQ(cells.size(), 5);
+
+        // Each array is one cell of compact JSON
+        Json::Value parsed;
+        std::istringstream cell(cells[3]);
+        cell >> parsed;
+        EXPECT_EQ(parsed, uvw_configs[num_rows]);
+        num_rows++;
+    }
+    EXPECT_EQ(num_rows, uvw_configs.size());
+}
+
 TEST_F(ParameterSearchTest, ComputeCriteriaReturnsVectorOfCorrectSize)
 {
     auto requiredCalculations = parameterSearch->getRequiredCalculations(outputs);
@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include "sampler.hh"
+#include <vector>
+#include <set>
+#include <cmath>
+
+// Check that every interval [j/n, (j+1)/n) of every dimension contains exactly one point
+static void expectStratified(const std::vector<std::vector<double>> &points, size_t num_dims)
+{
+    size_t n = points.size();
+    for (size_t d = 0; d < num_dims; d++)
+    {
+        std::set<size_t> strata;
+        for (const auto &point : points)
+        {
+            ASSERT_EQ(point.size(), num_dims);
+            ASSERT_GE(point[d], 0.0);
+            ASSERT_LT(point[d], 1.0);
+            strata.insert(static_cast<size_t>(std::floor(point[d] * n)));
+        }
+        EXPECT_EQ(strata.size(), n) << "Dimension " << d << " is not stratified";
+    }
+}
+
+TEST(SamplerTest, LatinHypercubeIsStratifiedAndSeeded)
+{
+    LatinHypercubeSampler sampler(7);
+    std::vector<std::vector<double>> points = sampler.generate(50, 4);
+
+    ASSERT_EQ(points.size(), 50);
+    expectStratified(points, 4);
+
+    EXPECT_EQ(points, LatinHypercubeSampler(7).generate(50, 4));
+    EXPECT_NE(points, LatinHypercubeSampler(8).generate(50, 4));
+}
+
+TEST(SamplerTest, SobolUnscrambledMatchesKnownPoints)
+{
+    SobolSampler sampler(0);
+    std::vector<std::vector<double>> points = sampler.generate(4, 2);
+
+    std::vector<std::vector<double>> expected = {{0.0, 0.0}, {0.5, 0.5}, {0.75, 0.25}, {0.25, 0.75}};
+    EXPECT_EQ(points, expected);
+}
+
+TEST(SamplerTest, ScrambledSobolIsStratifiedForPowersOfTwo)
+{
+    SobolSampler sampler(123);
+    std::vector<std::vector<double>> points = sampler.generate(64, SobolSampler::getMaxDims());
+
+    expectStratified(points, SobolSampler::getMaxDims());
+    EXPECT_EQ(points, SobolSampler(123).generate(64, SobolSampler::getMaxDims()));
+    EXPECT_THROW(sampler.generate(4, SobolSampler::getMaxDims() + 1), std::invalid_argument);
+}
+
+TEST(SamplerTest, HaltonUsesPrimeBases)
+{
+    HaltonSampler sampler;
+    std::vector<std::vector<double>> points = sampler.generate(3, 3);
+
+    EXPECT_DOUBLE_EQ(points[0][0], 0.5);
+    EXPECT_DOUBLE_EQ(points[1][0], 0.25);
+    EXPECT_DOUBLE_EQ(points[0][1], 1.0 / 3);
+    EXPECT_DOUBLE_EQ(points[2][1], 1.0 / 9);
+    EXPECT_DOUBLE_EQ(points[2][2], 3.0 / 5);
+}
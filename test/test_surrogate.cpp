@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "response_surface.hh"
+#include <vector>
+#include <cmath>
+#include <random>
+#include <fstream>
+#include <filesystem>
+
+namespace
+{
+    double testFunction(const std::vector<double> &x)
+    {
+        return std::sin(3.0 * x[0]) + 0.5 * x[1] * x[1];
+    }
+
+    std::vector<std::vector<double>> gridPoints(size_t n)
+    {
+        std::vector<std::vector<double>> points;
+        for (size_t i = 0; i < n; i++)
+        {
+            for (size_t j = 0; j < n; j++)
+            {
+                points.push_back({static_cast<double>(i) / (n - 1), 2.0 + 3.0 * j / (n - 1)});
+            }
+        }
+        return points;
+    }
+}
+
+TEST(SurrogateTest, RbfInterpolatesScatteredData)
+{
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::vector<double>> x;
+    std::vector<double> y;
+    for (int i = 0; i < 60; i++)
+    {
+        x.push_back({uniform(rng), 2.0 + 3.0 * uniform(rng), 5.0});
+        y.push_back(testFunction(x.back()));
+    }
+
+    RbfSurrogate rbf;
+    rbf.fit(x, y);
+    EXPECT_NEAR(rbf.predict(x[7]), y[7], 1e-8);
+    EXPECT_NEAR(rbf.predict({0.5, 3.5, 5.0}), testFunction({0.5, 3.5}), 0.05);
+    EXPECT_GT(rbf.getCrossValidationError(), 0.0);
+    EXPECT_LT(rbf.getCrossValidationError(), 0.1);
+}
+
+TEST(SurrogateTest, PolynomialChaosFitsPolynomialExactly)
+{
+    std::vector<std::vector<double>> x = gridPoints(5);
+    std::vector<double> y;
+    for (const auto &point : x)
+    {
+        y.push_back(1.0 + 2.0 * point[0] - point[0] * point[1] + 0.25 * point[1] * point[1]);
+    }
+
+    PolynomialChaosSurrogate pce(2);
+    pce.fit(x, y);
+    EXPECT_EQ(pce.getNumTerms(), 6u);
+    EXPECT_NEAR(pce.predict({0.3, 4.1}), 1.0 + 0.6 - 0.3 * 4.1 + 0.25 * 4.1 * 4.1, 1e-6);
+    EXPECT_LT(pce.getCrossValidationError(), 1e-6);
+
+    PolynomialChaosSurrogate too_large(8);
+    EXPECT_THROW(too_large.fit({{0.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}}, {1.0, 2.0, 3.0}), std::invalid_argument);
+}
+
+TEST(SurrogateTest, TensorSplineInterpolatesGrid)
+{
+    std::vector<std::vector<double>> x = gridPoints(9);
+    std::vector<double> y;
+    for (const auto &point : x)
+    {
+        y.push_back(testFunction(point));
+    }
+
+    TensorSplineSurrogate spline;
+    spline.fit(x, y);
+    EXPECT_NEAR(spline.predict(x[20]), y[20], 1e-12);
+    EXPECT_NEAR(spline.predict({0.4, 3.3}), testFunction({0.4, 3.3}), 0.01);
+    EXPECT_LT(spline.getCrossValidationError(), 0.05);
+
+    // Linear along an input with two values
+    TensorSplineSurrogate linear;
+    linear.fit({{0.0, 0.0}, {0.0, 1.0}, {1.0, 0.0}, {1.0, 1.0}}, {0.0, 1.0, 2.0, 3.0});
+    EXPECT_NEAR(linear.predict({0.5, 0.5}), 1.5, 1e-12);
+    EXPECT_TRUE(std::isnan(linear.getCrossValidationError()));
+
+    x.pop_back();
+    y.pop_back();
+    EXPECT_THROW(spline.fit(x, y), std::invalid_argument);
+}
+
+TEST(SurrogateTest, ResponseSurfaceFitSaveLoad)
+{
+    std::filesystem::path results_path = std::filesystem::temp_directory_path() / "cctsim_surrogate_results.csv";
+    std::filesystem::path surrogate_path = std::filesystem::temp_directory_path() / "cctsim_surrogate.txt";
+    {
+        std::ofstream results(results_path);
+        results << "index,pitch_inner,pitch_outer,B3,B5" << std::endl;
+        size_t index = 0;
+        for (const auto &point : gridPoints(6))
+        {
+            results << index++ << "," << point[0] << "," << point[1] << "," << testFunction(point) << "," << point[0] + point[1] << std::endl;
+        }
+        // Failed step
+        results << index++ << ",0.5,2.5," << std::endl;
+    }
+
+    for (std::string type : {"rbf", "pce", "spline"})
+    {
+        ResponseSurface surface;
+        surface.fit(results_path.string(), 2, type);
+        EXPECT_EQ(surface.getNumSkippedRows(), 1u);
+        EXPECT_EQ(surface.getInputNames(), (std::vector<std::string>{"pitch_inner", "pitch_outer"}));
+        EXPECT_EQ(surface.getCriterionNames(), (std::vector<std::string>{"B3", "B5"}));
+        surface.save(surrogate_path.string());
+
+        ResponseSurface loaded;
+        loaded.load(surrogate_path.string());
+        std::vector<std::vector<double>> points = {{0.33, 2.7}, {0.9, 4.2}};
+        std::vector<std::vector<double>> expected = surface.predict(points);
+        std::vector<std::vector<double>> predicted = loaded.predict(points);
+        for (size_t i = 0; i < points.size(); i++)
+        {
+            EXPECT_NEAR(predicted[i][0], expected[i][0], 1e-12) << type;
+            EXPECT_NEAR(predicted[i][1], points[i][0] + points[i][1], 1e-6) << type;
+        }
+        EXPECT_EQ(loaded.getCriterionNames(), surface.getCriterionNames());
+        EXPECT_EQ(loaded.getCrossValidationErrors().size(), 2u);
+    }
+
+    ResponseSurface surface;
+    EXPECT_THROW(surface.fit(results_path.string(), 2, "kriging"), std::invalid_argument);
+    EXPECT_THROW(surface.fit(results_path.string(), 4, "rbf"), std::invalid_argument);
+
+    std::filesystem::remove(results_path);
+    std::filesystem::remove(surrogate_path);
+}
+
+TEST(SurrogateTest, ResponseSurfaceIgnoresStatusColumn)
+{
+    std::filesystem::path results_path = std::filesystem::temp_directory_path() / "cctsim_surrogate_status.csv";
+    {
+        std::ofstream results(results_path);
+        results << "index,pitch_inner,pitch_outer,B3,max_von_mises,status" << std::endl;
+        size_t index = 0;
+        for (const auto &point : gridPoints(4))
+        {
+            results << index++ << "," << point[0] << "," << point[1] << "," << point[0] << "," << point[1] << ",accepted" << std::endl;
+        }
+        // Rejected before the mesh calculation
+        results << index++ << ",0.5,2.5,7,nan,rejected:B3" << std::endl;
+    }
+
+    ResponseSurface surface;
+    surface.fit(results_path.string(), 2, "rbf");
+    EXPECT_EQ(surface.getNumSkippedRows(), 0u);
+    EXPECT_EQ(surface.getCriterionNames(), (std::vector<std::string>{"B3", "max_von_mises"}));
+    std::vector<std::vector<double>> predicted = surface.predict({{0.5, 2.5}});
+    EXPECT_NEAR(predicted[0][0], 7.0, 1e-8);
+    EXPECT_NEAR(predicted[0][1], 2.5, 1e-6);
+
+    std::filesystem::remove(results_path);
+}
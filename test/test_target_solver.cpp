@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+#include "brent_solver.hh"
+#include "broyden_solver.hh"
+#include <vector>
+#include <cmath>
+
+namespace
+{
+    bool neverStop(size_t, size_t)
+    {
+        return false;
+    }
+}
+
+TEST(BrentSolverTest, FindsRootWithFewEvaluations)
+{
+    // z_max grows monotonically with the pitch, find the pitch for z_max = 0.7
+    auto f = [](double x)
+    { return 0.2 + 0.8 * x * x + 0.1 * std::sin(3.0 * x) - 0.7; };
+
+    BrentSolver solver(1e-6);
+    solver.solve([&f](const std::vector<double> &points)
+                 {
+                     std::vector<double> values;
+                     for (double x : points)
+                     {
+                         values.push_back(f(x));
+                     }
+                     return values; },
+                 neverStop);
+
+    EXPECT_TRUE(solver.hasConverged());
+    EXPECT_TRUE(solver.wasBracketed());
+    EXPECT_LE(std::abs(f(solver.getSolution())), 1e-6);
+    EXPECT_LT(solver.getNumEvaluations(), 10u);
+}
+
+TEST(BrentSolverTest, ScansForBracket)
+{
+    // Same sign at both ends, two roots inside
+    auto f = [](double x)
+    { return (x - 0.3) * (x - 0.8); };
+
+    BrentSolver solver(1e-8);
+    solver.solve([&f](const std::vector<double> &points)
+                 {
+                     std::vector<double> values;
+                     for (double x : points)
+                     {
+                         values.push_back(f(x));
+                     }
+                     return values; },
+                 neverStop);
+
+    EXPECT_TRUE(solver.hasConverged());
+    EXPECT_NEAR(solver.getSolution(), 0.3, 1e-6);
+}
+
+TEST(BrentSolverTest, ReportsClosestPointWithoutRoot)
+{
+    BrentSolver solver(1e-8);
+    solver.solve([](const std::vector<double> &points)
+                 {
+                     std::vector<double> values;
+                     for (double x : points)
+                     {
+                         values.push_back(1.0 + (x - 0.5) * (x - 0.5));
+                     }
+                     return values; },
+                 neverStop);
+
+    EXPECT_FALSE(solver.hasConverged());
+    EXPECT_FALSE(solver.wasBracketed());
+    EXPECT_NEAR(solver.getSolution(), 0.5, 1e-12);
+    EXPECT_THROW(BrentSolver(0.0), std::invalid_argument);
+}
+
+TEST(BroydenSolverTest, SolvesCoupledTargets)
+{
+    // Two smooth coupled criteria with the solution at (0.4, 0.65)
+    auto residuals = [](const std::vector<double> &x)
+    {
+        return std::vector<double>{x[0] + 0.3 * x[1] * x[1] - (0.4 + 0.3 * 0.65 * 0.65),
+                                   100.0 * (std::sin(x[1]) + 0.2 * x[0] - (std::sin(0.65) + 0.2 * 0.4))};
+    };
+
+    BroydenSolver solver({1e-6, 1e-4});
+    solver.solve({0.5, 0.5}, [&residuals](const std::vector<std::vector<double>> &points)
+                 {
+                     std::vector<std::vector<double>> values;
+                     for (const std::vector<double> &x : points)
+                     {
+                         values.push_back(residuals(x));
+                     }
+                     return values; },
+                 neverStop);
+
+    EXPECT_TRUE(solver.hasConverged());
+    EXPECT_NEAR(solver.getSolution()[0], 0.4, 1e-4);
+    EXPECT_NEAR(solver.getSolution()[1], 0.65, 1e-4);
+    EXPECT_LT(solver.getNumEvaluations(), 15u);
+}
+
+TEST(BroydenSolverTest, RespectsStopCondition)
+{
+    BroydenSolver solver({1e-12, 1e-12});
+    solver.solve({0.5, 0.5}, [](const std::vector<std::vector<double>> &points)
+                 {
+                     std::vector<std::vector<double>> values;
+                     for (const std::vector<double> &x : points)
+                     {
+                         values.push_back({std::exp(x[0]) - 1.5, x[1] * x[1] - 0.2});
+                     }
+                     return values; },
+                 [](size_t evaluated, size_t batch_size)
+                 { return evaluated + batch_size > 5; });
+
+    EXPECT_LE(solver.getNumEvaluations(), 5u);
+    EXPECT_FALSE(solver.getSolution().empty());
+    EXPECT_THROW(BroydenSolver({}), std::invalid_argument);
+    EXPECT_THROW(BroydenSolver({1.0, -1.0}), std::invalid_argument);
+}
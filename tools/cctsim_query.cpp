@@ -0,0 +1,150 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include "response_surface.hh"
+
+/**
+ * Fit surrogates of the output criteria to a results CSV and answer point queries from them.
+ *
+ *   cctsim_query fit <results.csv> <num_inputs> <rbf|pce|spline> <surrogate_file>
+ *   cctsim_query info <surrogate_file>
+ *   cctsim_query query <surrogate_file> [points.csv]
+ *
+ * Points are read one per line (comma-separated input values in the order of the input columns) from the file or from stdin;
+ * lines that are not numbers, e.g. a header, are skipped. The predictions are written as CSV to stdout, each criterion followed by
+ * its leave-one-out cross-validation error.
+ */
+
+static void printUsage()
+{
+    std::cerr << "Usage:\n"
+              << "  cctsim_query fit <results.csv> <num_inputs> <rbf|pce|spline> <surrogate_file>\n"
+              << "  cctsim_query info <surrogate_file>\n"
+              << "  cctsim_query query <surrogate_file> [points.csv]\n";
+}
+
+static int fit(const std::string &results_path, size_t num_inputs, const std::string &type, const std::string &surrogate_path)
+{
+    auto start = std::chrono::steady_clock::now();
+    ResponseSurface surface;
+    surface.fit(results_path, num_inputs, type);
+    surface.save(surrogate_path);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cerr << "Fitted " << surface.getCriterionNames().size() << " " << type << " surrogates in " << seconds << " s";
+    if (surface.getNumSkippedRows() > 0)
+    {
+        std::cerr << ", skipped " << surface.getNumSkippedRows() << " rows";
+    }
+    std::cerr << "\n";
+    std::vector<double> errors = surface.getCrossValidationErrors();
+    for (size_t c = 0; c < errors.size(); c++)
+    {
+        std::cerr << "  " << surface.getCriterionNames()[c] << ": cross-validation RMSE " << errors[c] << "\n";
+    }
+    return 0;
+}
+
+static int info(const std::string &surrogate_path)
+{
+    ResponseSurface surface;
+    surface.load(surrogate_path);
+    std::cout << "inputs:";
+    for (const std::string &name : surface.getInputNames())
+    {
+        std::cout << " " << name;
+    }
+    std::cout << "\ncriterion,cv_rmse\n";
+    std::vector<double> errors = surface.getCrossValidationErrors();
+    for (size_t c = 0; c < errors.size(); c++)
+    {
+        std::cout << surface.getCriterionNames()[c] << "," << errors[c] << "\n";
+    }
+    return 0;
+}
+
+static int query(const std::string &surrogate_path, std::istream &in)
+{
+    ResponseSurface surface;
+    surface.load(surrogate_path);
+    size_t num_inputs = surface.getInputNames().size();
+
+    std::vector<std::vector<double>> points;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::vector<double> values;
+        if (ResponseSurface::parseNumbers(ResponseSurface::splitLine(line), values) && values.size() == num_inputs)
+        {
+            points.push_back(values);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::vector<double>> predictions = surface.predict(points);
+    double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> errors = surface.getCrossValidationErrors();
+    std::cout << std::setprecision(10);
+    for (const std::string &name : surface.getInputNames())
+    {
+        std::cout << name << ",";
+    }
+    for (size_t c = 0; c < errors.size(); c++)
+    {
+        std::cout << surface.getCriterionNames()[c] << "," << surface.getCriterionNames()[c] << "_cv_rmse" << (c + 1 < errors.size() ? "," : "\n");
+    }
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        for (double value : points[i])
+        {
+            std::cout << value << ",";
+        }
+        for (size_t c = 0; c < errors.size(); c++)
+        {
+            std::cout << predictions[i][c] << "," << errors[c] << (c + 1 < errors.size() ? "," : "\n");
+        }
+    }
+    std::cerr << "Answered " << points.size() << " queries in " << microseconds << " us\n";
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    try
+    {
+        if (args.size() == 5 && args[0] == "fit")
+        {
+            return fit(args[1], std::stoul(args[2]), args[3], args[4]);
+        }
+        if (args.size() == 2 && args[0] == "info")
+        {
+            return info(args[1]);
+        }
+        if (args.size() == 2 && args[0] == "query")
+        {
+            return query(args[1], std::cin);
+        }
+        if (args.size() == 3 && args[0] == "query")
+        {
+            std::ifstream points_file(args[2]);
+            if (!points_file.is_open())
+            {
+                std::cerr << "Points file could not be opened: " << args[2] << "\n";
+                return 1;
+            }
+            return query(args[1], points_file);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,249 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <json/json.h>
+#include "fmm_tuner.h"
+#include "input_fmm_setting.hh"
+#include "output_a_multipole.hh"
+#include "output_b_multipole.hh"
+#include "output_max_curvature.hh"
+#include "output_max_von_mises.hh"
+#include "model_handler.h"
+
+/**
+ * Find the fastest FMM settings of a calculation that reproduce a high-accuracy reference within a tolerance.
+ *
+ *   cctsim_tune <model.json> <harmonics|mesh> <tolerance> [options]
+ *
+ * The accuracy is measured on the multipoles a_1..a_10, b_1..b_10 (harmonics) or on the maximum curvature and von Mises stress (mesh).
+ * Options:
+ *   --calc <name>            'name' of the calculation, default is the first calculation of the type in the model
+ *   --num-exp <v,v,...>      candidate values of 'num_exp', default 3,4,5,6,7,8
+ *   --num-refine <v,v,...>   candidate values of 'num_refine', default 60,120,240,480
+ *   --max-levels <v,v,...>   candidate values of 'max_levels', not tuned by default
+ *   --reference-num-exp <v>  'num_exp' of the reference, default is the largest candidate + 3
+ *   --relative               the tolerance is relative to the reference values
+ *   --repeats <n>            timed repetitions of each candidate, the fastest counts, default 1
+ *   --output <tuned.json>    write a copy of the model with the tuned settings
+ *
+ * Settings that are not tuned keep their values in the model, also for the reference. The results are written to the output directory
+ * like a grid search, the runtimes and errors to the file with the suffix `_tuning.csv`.
+ */
+
+static void printUsage()
+{
+    std::cerr << "Usage:\n"
+              << "  cctsim_tune <model.json> <harmonics|mesh> <tolerance> [--calc <name>] [--num-exp <v,...>] [--num-refine <v,...>]\n"
+              << "              [--max-levels <v,...>] [--reference-num-exp <v>] [--relative] [--repeats <n>] [--output <tuned.json>]\n";
+}
+
+static std::vector<double> parseList(const std::string &list)
+{
+    std::vector<double> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        values.push_back(std::stod(item));
+    }
+    if (values.empty())
+    {
+        throw std::invalid_argument("Empty list of candidate values");
+    }
+    return values;
+}
+
+/**
+ * @brief Find the 'name' of the first node of a type in the model tree.
+ */
+static bool findCalculationName(const Json::Value &node, const std::string &type, std::string &name)
+{
+    if (node.isObject())
+    {
+        if (node.isMember("type") && node["type"].isString() && node["type"].asString() == type && node.isMember("name"))
+        {
+            name = node["name"].asString();
+            return true;
+        }
+        for (const std::string &member : node.getMemberNames())
+        {
+            if (findCalculationName(node[member], type, name))
+            {
+                return true;
+            }
+        }
+    }
+    else if (node.isArray())
+    {
+        for (const Json::Value &child : node)
+        {
+            if (findCalculationName(child, type, name))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        std::string model_path = argv[1];
+        std::string target = argv[2];
+        double tolerance = std::stod(argv[3]);
+        if (target != "harmonics" && target != "mesh")
+        {
+            printUsage();
+            return 1;
+        }
+
+        std::string calc_name;
+        std::vector<double> num_exp = {3, 4, 5, 6, 7, 8};
+        std::vector<double> num_refine = {60, 120, 240, 480};
+        std::vector<double> max_levels;
+        double reference_num_exp = -1;
+        bool relative = false;
+        size_t repeats = 1;
+        std::string output_path;
+        for (int i = 4; i < argc; i++)
+        {
+            std::string option = argv[i];
+            bool has_value = i + 1 < argc;
+            if (option == "--relative")
+            {
+                relative = true;
+            }
+            else if (option == "--calc" && has_value)
+            {
+                calc_name = argv[++i];
+            }
+            else if (option == "--num-exp" && has_value)
+            {
+                num_exp = parseList(argv[++i]);
+            }
+            else if (option == "--num-refine" && has_value)
+            {
+                num_refine = parseList(argv[++i]);
+            }
+            else if (option == "--max-levels" && has_value)
+            {
+                max_levels = parseList(argv[++i]);
+            }
+            else if (option == "--reference-num-exp" && has_value)
+            {
+                reference_num_exp = std::stod(argv[++i]);
+            }
+            else if (option == "--repeats" && has_value)
+            {
+                repeats = std::stoul(argv[++i]);
+            }
+            else if (option == "--output" && has_value)
+            {
+                output_path = argv[++i];
+            }
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+
+        if (calc_name.empty())
+        {
+            std::ifstream file(model_path);
+            Json::Value model;
+            file >> model;
+            std::string type = target == "harmonics" ? "rat::mdl::calcharmonics" : "rat::mdl::calcmesh";
+            if (!findCalculationName(model, type, calc_name))
+            {
+                std::cerr << "No calculation of type " << type << " in " << model_path << "\n";
+                return 1;
+            }
+        }
+
+        CCTools::ModelHandler modelHandler(model_path);
+
+        // The reference is the most accurate expansion, the other settings are at their model values
+        if (reference_num_exp < 0)
+        {
+            reference_num_exp = *std::max_element(num_exp.begin(), num_exp.end()) + 3;
+        }
+        std::vector<std::shared_ptr<InputParamRangeInterface>> inputs;
+        std::vector<Json::Value> reference;
+        auto addSetting = [&](const std::string &setting, const std::vector<double> &candidates, bool is_integer, Json::Value reference_value)
+        {
+            std::vector<Json::Value> range;
+            for (double value : candidates)
+            {
+                range.push_back(is_integer ? Json::Value(static_cast<int>(value)) : Json::Value(value));
+            }
+            inputs.push_back(std::make_shared<InputFmmSetting>(InputFmmSetting(calc_name, setting, range)));
+            reference.push_back(reference_value);
+        };
+        addSetting("num_exp", num_exp, true, Json::Value(static_cast<int>(reference_num_exp)));
+        addSetting("num_refine", num_refine, false, modelHandler.getValueByName(calc_name, {"stngs"}, "num_refine"));
+        if (!max_levels.empty())
+        {
+            addSetting("max_levels", max_levels, true, modelHandler.getValueByName(calc_name, {"stngs"}, "max_levels"));
+        }
+
+        std::vector<std::shared_ptr<OutputCriterionInterface>> outputs;
+        if (target == "harmonics")
+        {
+            for (size_t n = 1; n <= 10; n++)
+            {
+                outputs.push_back(std::make_shared<OutputAMultipole>(OutputAMultipole(n)));
+            }
+            for (size_t n = 1; n <= 10; n++)
+            {
+                outputs.push_back(std::make_shared<OutputBMultipole>(OutputBMultipole(n)));
+            }
+        }
+        else
+        {
+            outputs.push_back(std::make_shared<OutputMaxCurvature>(OutputMaxCurvature()));
+            outputs.push_back(std::make_shared<OutputMaxVonMises>(OutputMaxVonMises()));
+        }
+
+        FmmTuner tuner(inputs, outputs, modelHandler, reference, tolerance, relative);
+        tuner.setNumRepeats(repeats);
+        tuner.run();
+
+        if (!tuner.hasMetTarget())
+        {
+            std::cerr << "No candidate settings of " << calc_name << " meet the tolerance " << tolerance << "\n";
+            return 2;
+        }
+
+        std::vector<Json::Value> best = tuner.getBestConfiguration();
+        std::cout << "calculation: " << calc_name << "\n";
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            std::cout << inputs[i]->getColumnName() << ": " << inputs[i]->getConfigAsString(best[i]) << "\n";
+        }
+        std::cout << "runtime: " << tuner.getBestRuntime() << " s (reference " << tuner.getReferenceRuntime() << " s)\n";
+
+        if (!output_path.empty())
+        {
+            tuner.writeTunedModel(output_path);
+            std::cout << "tuned model: " << output_path << "\n";
+        }
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}